@@ -410,7 +410,9 @@ extern DECLSPEC void SDLCALL SDL_PauseAudioDevice(SDL_AudioDeviceID dev,
  *
  *  This function returns NULL and sets the SDL error message if the
  *  wave file cannot be opened, uses an unknown data format, or is
- *  corrupt.  Currently raw and MS-ADPCM WAVE files are supported.
+ *  corrupt.  Currently raw, MS-ADPCM and IMA-ADPCM WAVE files are supported.
+ *
+ *  To play a long file without loading all of it, use SDL_NewWAVReader().
  */
 extern DECLSPEC SDL_AudioSpec *SDLCALL SDL_LoadWAV_RW(SDL_RWops * src,
                                                       int freesrc,
@@ -430,6 +432,80 @@ extern DECLSPEC SDL_AudioSpec *SDLCALL SDL_LoadWAV_RW(SDL_RWops * src,
  */
 extern DECLSPEC void SDLCALL SDL_FreeWAV(Uint8 * audio_buf);
 
+/**
+ *  \name WAVE streaming
+ *
+ *  These functions read a WAVE file a piece at a time, so long files like
+ *  music can be played from an SDL_RWops without loading all of it.
+ *  PCM data is read straight from the source, and ADPCM data is decoded
+ *  one block at a time as it is read, so the memory used doesn't depend on
+ *  the length of the file. The formats are the ones SDL_LoadWAV_RW()
+ *  supports.
+ *
+ *  The source must be seekable.
+ */
+/* @{ */
+/* this is opaque to the outside world. */
+struct _SDL_WAVReader;
+typedef struct _SDL_WAVReader SDL_WAVReader;
+
+/**
+ *  Read the header of a WAVE file and get ready to read its audio data
+ *
+ *  \param src The source of the WAVE data
+ *  \param freesrc Non-zero to close \c src when the reader is freed, or if
+ *                 this function fails
+ *  \param spec Filled in with the format of the audio data the reader gives
+ *  \return A new reader, or NULL on error (call SDL_GetError() for details)
+ *
+ *  \sa SDL_WAVReaderRead
+ *  \sa SDL_WAVReaderSeek
+ *  \sa SDL_FreeWAVReader
+ */
+extern DECLSPEC SDL_WAVReader * SDLCALL SDL_NewWAVReader(SDL_RWops * src,
+                                                         int freesrc,
+                                                         SDL_AudioSpec * spec);
+
+/**
+ *  Read and decode audio data from the current position
+ *
+ *  \param reader The reader to read from
+ *  \param buf The buffer to fill, in the format given by SDL_NewWAVReader()
+ *  \param len The size of \c buf in bytes; only whole sample frames are read
+ *  \return The number of bytes read, 0 at the end of the data, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_WAVReaderRead(SDL_WAVReader * reader,
+                                              void *buf, int len);
+
+/**
+ *  Move to a sample frame in the audio data
+ *
+ *  Seeking in ADPCM data decodes from the start of the block that holds
+ *  \c frame, which is at most a few thousand samples.
+ *
+ *  \param reader The reader to seek
+ *  \param frame The sample frame to read next, up to SDL_WAVReaderLength()
+ *  \return 0 on success or -1 on error (call SDL_GetError() for details)
+ */
+extern DECLSPEC int SDLCALL SDL_WAVReaderSeek(SDL_WAVReader * reader,
+                                              Uint32 frame);
+
+/**
+ *  Get the sample frame that will be read next
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_WAVReaderTell(SDL_WAVReader * reader);
+
+/**
+ *  Get the length of the audio data, in sample frames
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_WAVReaderLength(SDL_WAVReader * reader);
+
+/**
+ *  Free a reader, and close its source if it was made with \c freesrc set
+ */
+extern DECLSPEC void SDLCALL SDL_FreeWAVReader(SDL_WAVReader * reader);
+/* @} *//* WAVE streaming */
+
 /**
  *  This function takes a source format and rate and a destination format
  *  and rate, and initializes the \c cvt structure with information needed
@@ -459,6 +535,111 @@ extern DECLSPEC int SDLCALL SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
  */
 extern DECLSPEC int SDLCALL SDL_ConvertAudio(SDL_AudioCVT * cvt);
 
+/* SDL_AudioStream is a new audio conversion interface.
+   The benefits vs SDL_AudioCVT:
+    - it can handle resampling data in chunks without generating
+      artifacts, when it doesn't have the complete buffer available.
+    - it can handle incoming data in any variable size.
+    - You push data as you have it, and pull it when you need it
+ */
+/* this is opaque to the outside world. */
+struct _SDL_AudioStream;
+typedef struct _SDL_AudioStream SDL_AudioStream;
+
+/**
+ *  Create a new audio stream
+ *
+ *  \param src_format The format of the source audio
+ *  \param src_channels The number of channels of the source audio
+ *  \param src_rate The sampling rate of the source audio
+ *  \param dst_format The format of the desired audio output
+ *  \param dst_channels The number of channels of the desired audio output
+ *  \param dst_rate The sampling rate of the desired audio output
+ *  \return An audio stream, or NULL on error (call SDL_GetError() for details)
+ *
+ *  \note A stream is not thread safe; use it from one thread at a time.
+ *
+ *  \sa SDL_AudioStreamPut
+ *  \sa SDL_AudioStreamGet
+ *  \sa SDL_AudioStreamAvailable
+ *  \sa SDL_AudioStreamFlush
+ *  \sa SDL_AudioStreamClear
+ *  \sa SDL_FreeAudioStream
+ */
+extern DECLSPEC SDL_AudioStream * SDLCALL SDL_NewAudioStream(const SDL_AudioFormat src_format,
+                                                             const Uint8 src_channels,
+                                                             const int src_rate,
+                                                             const SDL_AudioFormat dst_format,
+                                                             const Uint8 dst_channels,
+                                                             const int dst_rate);
+
+/**
+ *  Add data to be converted/resampled to the stream
+ *
+ *  \param stream The stream the audio data is being added to
+ *  \param buf A pointer to the audio data to add
+ *  \param len The number of bytes to write to the stream
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \note \c len doesn't have to be a multiple of the source sample frame
+ *        size; a partial frame is kept until the rest of it is added.
+ *
+ *  \sa SDL_NewAudioStream
+ *  \sa SDL_AudioStreamGet
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamPut(SDL_AudioStream *stream, const void *buf, int len);
+
+/**
+ *  Get converted/resampled data from the stream
+ *
+ *  \param stream The stream the audio is being requested from
+ *  \param buf A buffer to fill with audio data
+ *  \param len The maximum number of bytes to fill, a multiple of the
+ *             destination sample frame size
+ *  \return The number of bytes read from the stream, or -1 on error
+ *
+ *  \sa SDL_NewAudioStream
+ *  \sa SDL_AudioStreamPut
+ *  \sa SDL_AudioStreamAvailable
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamGet(SDL_AudioStream *stream, void *buf, int len);
+
+/**
+ *  Get the number of converted/resampled bytes available.
+ *
+ *  \sa SDL_NewAudioStream
+ *  \sa SDL_AudioStreamGet
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamAvailable(SDL_AudioStream *stream);
+
+/**
+ *  Tell the stream that you're done sending data, and anything being
+ *  buffered should be converted/resampled and made available immediately.
+ *
+ *  It is legal to add more data to a stream after flushing, but there
+ *  will be audio gaps in the output. Generally this is intended to signal
+ *  the end of input, so the complete output becomes available.
+ *
+ *  \sa SDL_AudioStreamPut
+ *  \sa SDL_AudioStreamGet
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamFlush(SDL_AudioStream *stream);
+
+/**
+ *  Clear any pending data in the stream without converting it
+ *
+ *  \sa SDL_NewAudioStream
+ *  \sa SDL_AudioStreamFlush
+ */
+extern DECLSPEC void SDLCALL SDL_AudioStreamClear(SDL_AudioStream *stream);
+
+/**
+ *  Free an audio stream
+ *
+ *  \sa SDL_NewAudioStream
+ */
+extern DECLSPEC void SDLCALL SDL_FreeAudioStream(SDL_AudioStream *stream);
+
 #define SDL_MIX_MAXVOLUME 128
 /**
  *  This takes two audio buffers of the playing audio format and mixes
@@ -480,6 +661,158 @@ extern DECLSPEC void SDLCALL SDL_MixAudioFormat(Uint8 * dst,
                                                 SDL_AudioFormat format,
                                                 Uint32 len, int volume);
 
+/* SDL_AudioMixer mixes any number of voices into one buffer.
+   The benefits vs calling SDL_MixAudioFormat() for each sound:
+    - every voice is summed in float and clipped once at the end, so
+      loud voices don't clip each other part way through the mix.
+    - voices have their own format, gain and stereo pan.
+    - the output is made a small block at a time, so the mix stays in
+      the cache instead of going over the whole output once per voice.
+ */
+/* this is opaque to the outside world. */
+struct _SDL_AudioMixer;
+typedef struct _SDL_AudioMixer SDL_AudioMixer;
+
+/**
+ *  Create a new audio mixer
+ *
+ *  \param format The format of the mixed output
+ *  \param channels The number of channels of the mixed output, 1 or 2
+ *  \param rate The sampling rate of the mixed output
+ *  \return An audio mixer, or NULL on error (call SDL_GetError() for details)
+ *
+ *  \note The mixer functions are thread safe, so voices can be changed
+ *        while the audio callback renders the mixer.
+ *
+ *  \sa SDL_AudioMixerAddBuffer
+ *  \sa SDL_AudioMixerAddStream
+ *  \sa SDL_AudioMixerRender
+ *  \sa SDL_AudioMixerCallback
+ *  \sa SDL_FreeAudioMixer
+ */
+extern DECLSPEC SDL_AudioMixer * SDLCALL SDL_NewAudioMixer(SDL_AudioFormat format,
+                                                           Uint8 channels,
+                                                           int rate);
+
+/**
+ *  Start playing a buffer of audio on a new voice
+ *
+ *  The buffer is read in place, so it must stay valid until the voice is
+ *  removed or has finished playing. It must be at the mixer's rate; the
+ *  format and the number of channels can be anything SDL_BuildAudioCVT()
+ *  accepts.
+ *
+ *  \param mixer The mixer to add the voice to
+ *  \param format The format of the audio in \c buf
+ *  \param channels The number of channels of the audio in \c buf
+ *  \param buf A pointer to the audio data
+ *  \param len The number of bytes in \c buf
+ *  \param loop SDL_TRUE to start over at the end, SDL_FALSE to remove the
+ *              voice when it gets to the end
+ *  \return The voice, a positive number, or -1 on error
+ *
+ *  \sa SDL_AudioMixerSetVoiceVolume
+ *  \sa SDL_AudioMixerVoicePlaying
+ *  \sa SDL_AudioMixerRemoveVoice
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerAddBuffer(SDL_AudioMixer *mixer,
+                                                    SDL_AudioFormat format,
+                                                    Uint8 channels,
+                                                    const void *buf,
+                                                    Uint32 len,
+                                                    SDL_bool loop);
+
+/**
+ *  Add a voice that plays audio as you supply it
+ *
+ *  Audio given to SDL_AudioMixerPutVoice() is converted and resampled to
+ *  the mixer's format with an SDL_AudioStream. The voice plays silence
+ *  when it runs out, and keeps playing until it is removed.
+ *
+ *  \param mixer The mixer to add the voice to
+ *  \param format The format of the audio that will be put on the voice
+ *  \param channels The number of channels of that audio
+ *  \param rate The sampling rate of that audio
+ *  \return The voice, a positive number, or -1 on error
+ *
+ *  \sa SDL_AudioMixerPutVoice
+ *  \sa SDL_AudioMixerRemoveVoice
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerAddStream(SDL_AudioMixer *mixer,
+                                                    SDL_AudioFormat format,
+                                                    Uint8 channels,
+                                                    int rate);
+
+/**
+ *  Give a voice from SDL_AudioMixerAddStream() more audio to play
+ *
+ *  \param mixer The mixer the voice belongs to
+ *  \param voice The voice to add the audio to
+ *  \param buf A pointer to the audio data to add
+ *  \param len The number of bytes to add
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_AudioMixerAddStream
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerPutVoice(SDL_AudioMixer *mixer, int voice,
+                                                   const void *buf, int len);
+
+/**
+ *  Set the gain and stereo position of a voice
+ *
+ *  \param mixer The mixer the voice belongs to
+ *  \param voice The voice to change
+ *  \param gain The factor to scale the voice by, 1.0f leaves it as it is
+ *  \param pan -1.0f is all the way left, 1.0f all the way right, and 0.0f
+ *             leaves both sides at full gain. Ignored for mono output.
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerSetVoiceVolume(SDL_AudioMixer *mixer, int voice,
+                                                         float gain, float pan);
+
+/**
+ *  Check whether a voice is still playing
+ *
+ *  \return SDL_FALSE if the voice finished its buffer or was removed.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_AudioMixerVoicePlaying(SDL_AudioMixer *mixer, int voice);
+
+/**
+ *  Stop a voice and remove it from the mixer
+ *
+ *  \return 0 on success, or -1 if the voice isn't playing.
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerRemoveVoice(SDL_AudioMixer *mixer, int voice);
+
+/**
+ *  Mix the next part of every voice into a buffer
+ *
+ *  \param mixer The mixer to render
+ *  \param buf A buffer to fill with the mixed audio; its contents are
+ *             replaced, not mixed into
+ *  \param len The number of bytes to fill, a multiple of the output sample
+ *             frame size
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_AudioMixerCallback
+ */
+extern DECLSPEC int SDLCALL SDL_AudioMixerRender(SDL_AudioMixer *mixer, void *buf, int len);
+
+/**
+ *  An SDL_AudioCallback that renders the SDL_AudioMixer in \c userdata
+ *
+ *  Open the device with the mixer's format, channels and rate, and set
+ *  SDL_AudioSpec::userdata to the mixer.
+ */
+extern DECLSPEC void SDLCALL SDL_AudioMixerCallback(void *userdata, Uint8 * stream, int len);
+
+/**
+ *  Free an audio mixer and all of its voices
+ *
+ *  \sa SDL_NewAudioMixer
+ */
+extern DECLSPEC void SDLCALL SDL_FreeAudioMixer(SDL_AudioMixer *mixer);
+
 /**
  *  Queue more audio on non-callback devices.
  *
@@ -640,6 +973,104 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetQueuedAudioSize(SDL_AudioDeviceID dev);
 extern DECLSPEC void SDLCALL SDL_ClearQueuedAudio(SDL_AudioDeviceID dev);
 
 
+/**
+ *  The number of buckets in SDL_AudioDeviceStats::callback_histogram
+ */
+#define SDL_AUDIO_STATS_HISTOGRAM_BUCKETS 16
+
+/**
+ *  Timing counters for an open audio device, for picking buffer sizes.
+ *
+ *  All times are in microseconds. The play period counters only apply to
+ *  playback devices; they measure the time between two buffers being
+ *  handed to the audio hardware.
+ *
+ *  Underruns are estimated from the play period, assuming the device has
+ *  two buffers in flight, as most SDL drivers do: a period longer than two
+ *  buffers means the hardware ran out of audio. The headroom is how much
+ *  of those two buffers was left when the next one arrived.
+ *
+ *  Drivers that run the audio callback on a thread of their own only
+ *  report buffer_us and queued_us.
+ */
+typedef struct SDL_AudioDeviceStats
+{
+    Uint32 buffer_us;           /**< How long one device buffer plays */
+    Uint32 queued_us;           /**< Audio queued or converted but not yet given to the device */
+    Uint32 callbacks;           /**< Number of times the audio callback ran */
+    Uint32 callback_max_us;     /**< Longest audio callback */
+    Uint64 callback_total_us;   /**< Time spent in the audio callback */
+    Uint32 callback_histogram[SDL_AUDIO_STATS_HISTOGRAM_BUCKETS]; /**< Callback durations, bucket 0 under 1 us, bucket n from 2^(n-1) up to 2^n us, the last one everything longer */
+    Uint32 conversions;         /**< Number of times audio went through the format conversion */
+    Uint32 convert_max_us;      /**< Longest conversion */
+    Uint64 convert_total_us;    /**< Time spent converting audio */
+    Uint32 plays;               /**< Number of buffers handed to the device */
+    Uint32 play_period_last_us; /**< Most recent time between two buffers */
+    Uint32 play_period_min_us;  /**< Shortest time between two buffers */
+    Uint32 play_period_max_us;  /**< Longest time between two buffers */
+    Uint64 play_period_total_us; /**< Sum of all plays - 1 periods, for the average */
+    Uint32 late_wakes;          /**< Periods more than half a buffer longer than one buffer */
+    Uint32 underruns;           /**< Periods longer than two buffers */
+    Sint32 min_headroom_us;     /**< Least headroom seen, negative after an underrun */
+} SDL_AudioDeviceStats;
+
+/**
+ *  Get the timing counters of an open audio device.
+ *
+ *  The counters are kept by the device's audio thread from the moment the
+ *  device is opened, or since the last SDL_ResetAudioDeviceStats() call.
+ *
+ *  \param dev The device ID to query
+ *  \param stats Filled in with the device's counters
+ *  
+eturn 0 on success or -1 on error (call SDL_GetError() for details)
+ *
+ *  \sa SDL_ResetAudioDeviceStats
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID dev,
+                                                    SDL_AudioDeviceStats *stats);
+
+/**
+ *  Set the timing counters of an open audio device back to zero.
+ *
+ *  This is useful to measure a single part of a program, like a level of a
+ *  game, or to drop the startup period, where the first buffers are usually
+ *  late.
+ *
+ *  \param dev The device ID whose counters to reset
+ *
+ *  \sa SDL_GetAudioDeviceStats
+ */
+extern DECLSPEC void SDLCALL SDL_ResetAudioDeviceStats(SDL_AudioDeviceID dev);
+
+/**
+ *  Get how far an open audio device has gotten through its audio.
+ *
+ *  This counts the sample frames SDL has handed to the device, or read from
+ *  it for a capture device, at the sample rate of the device's audio spec
+ *  as given to the app. A paused playback device still plays silence, which
+ *  counts too; a paused capture device doesn't read anything. The position
+ *  of a playback device is ahead of what can be heard by the audio the
+ *  hardware is holding.
+ *
+ *  For a disk audio device rendering offline (see
+ *  SDL_HINT_AUDIO_DISK_OFFLINE), this is exactly how much audio was written
+ *  to the file, so it can be used as the app's clock to render the same
+ *  output every time, no matter how fast the machine is.
+ *
+ *  The position is counted by SDL's audio thread. Drivers that run the
+ *  audio callback on a thread of their own (Core Audio, Emscripten, Haiku
+ *  and NaCl) don't go through it, and always report 0.
+ *
+ *  \param dev The device ID to query
+ *  \return The number of sample frames, or 0 on error (call SDL_GetError()
+ *          for details)
+ *
+ *  \sa SDL_GetAudioDeviceStats
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_GetAudioDevicePosition(SDL_AudioDeviceID dev);
+
+
 /**
  *  \name Audio lock functions
  *
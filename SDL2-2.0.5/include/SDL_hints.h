@@ -707,6 +707,152 @@ extern "C" {
  */
 #define SDL_HINT_RPI_VIDEO_LAYER           "SDL_RPI_VIDEO_LAYER"
 
+/**
+ * \brief A variable controlling how many threads large software blits may use.
+ *
+ * When set, unscaled blits covering at least SDL_HINT_BLIT_THREADS_MIN_PIXELS
+ * pixels are split into row bands that run on an internal worker pool. This
+ * applies to SDL_BlitSurface(), SDL_ConvertSurface() and SDL_ConvertPixels().
+ *
+ * The variable can be set to the following values:
+ *   "0" or "1" - Blits run on the calling thread only (default)
+ *   "N"        - Blits are split across up to N threads, including the caller
+ */
+#define SDL_HINT_BLIT_THREADS "SDL_BLIT_THREADS"
+
+/**
+ * \brief The smallest blit, in destination pixels, that is split across threads.
+ *
+ * This only has an effect when SDL_HINT_BLIT_THREADS is greater than 1.
+ * The default is 65536 (256x256).
+ */
+#define SDL_HINT_BLIT_THREADS_MIN_PIXELS "SDL_BLIT_THREADS_MIN_PIXELS"
+
+/**
+ * \brief A mask of SDL_CPU_* flags the software blitters may use.
+ *
+ * This is meant for testing the slower code paths on a fast machine. It
+ * never enables features the CPU doesn't have, and "0" leaves only the
+ * plain C blitters. The default is empty, which uses everything detected.
+ */
+#define SDL_HINT_BLIT_CPU_FEATURES "SDL_BLIT_CPU_FEATURES"
+
+/**
+ * \brief A variable controlling whether new surfaces get SIMD aligned rows.
+ *
+ * Pixels of surfaces allocated by SDL always start on a 64 byte boundary.
+ * When this is enabled, the pitch of new surfaces is also rounded up to a
+ * multiple of 64 bytes so that every row starts on that boundary, which lets
+ * the vectorized blitters run on every row of the surface.
+ *
+ * The variable can be set to the following values:
+ *   "0"       - Rows are padded to 4 bytes (default)
+ *   "1"       - Rows are padded to 64 bytes
+ */
+#define SDL_HINT_SURFACE_ALIGNED_PITCH "SDL_SURFACE_ALIGNED_PITCH"
+
+/**
+ * \brief The number of bytes SDL may keep cached for temporary surfaces.
+ *
+ * Renderers and pixel conversions reuse the pixel buffers of their temporary
+ * surfaces instead of allocating new ones for every call. Freed buffers are
+ * kept until this limit is reached, and all of them are released when the
+ * application receives SDL_APP_LOWMEMORY. Lowering the limit frees cached
+ * buffers down to it, and setting it to "0" disables caching.
+ * The default is 67108864 (64 MB), an empty value goes back to it.
+ */
+#define SDL_HINT_SURFACE_POOL_SIZE "SDL_SURFACE_POOL_SIZE"
+
+/**
+ * \brief A variable controlling the YUV to RGB conversion of software YUV textures.
+ *
+ * This is read when the texture is created.
+ *
+ * The variable can be set to the following values:
+ *   "JPEG"       - Full range BT.601, as used by JPEG (default)
+ *   "BT601"      - Limited range (16-235) BT.601, as used by SD video
+ *   "BT709"      - Limited range (16-235) BT.709, as used by HD video
+ *   "BT709_FULL" - Full range BT.709
+ */
+#define SDL_HINT_YUV_CONVERSION_MODE "SDL_YUV_CONVERSION_MODE"
+
+/**
+ * \brief The number of threads converting frames from SDL_UpdateYUVTextureAsync().
+ *
+ * The threads are shared by all textures and started with the first frame
+ * that needs converting. The default is one less than the number of CPUs,
+ * at least 1 and at most 8.
+ */
+#define SDL_HINT_RENDER_YUV_THREADS "SDL_RENDER_YUV_THREADS"
+
+/**
+ * \brief The number of buffers a texture uses for SDL_UpdateYUVTextureAsync().
+ *
+ * This is read when the first frame is queued for a texture.
+ *
+ * The variable can be set to the following values:
+ *   "2" - Double buffering, a new frame waits while the previous one is converted
+ *   "3" - Triple buffering, a new frame can be converted while another waits to be drawn (default)
+ */
+#define SDL_HINT_RENDER_YUV_BUFFERS "SDL_RENDER_YUV_BUFFERS"
+
+/**
+ * \brief A variable controlling whether lines drawn by the renderer are anti-aliased.
+ *
+ * This is checked each time lines are drawn. Anti-aliased lines are drawn
+ * the same way as lines wider than a pixel, see SDL_SetRenderDrawLineWidth().
+ *
+ * This variable can be set to the following values:
+ *   "0"       - Lines have hard edges (default)
+ *   "1"       - Line edges are blended with the partial pixel coverage
+ */
+#define SDL_HINT_RENDER_LINE_ANTIALIASING "SDL_RENDER_LINE_ANTIALIASING"
+
+/**
+ * \brief A variable limiting the width and height of a renderer's textures.
+ *
+ * This is checked when a renderer is created, and lowers the maximum
+ * texture size it reports. Bigger static and streaming textures are split
+ * into tiles, the same way they are on renderers that really have a small
+ * limit, which makes this mostly useful for testing. Target textures can't
+ * be bigger than the limit.
+ *
+ * By default the renderer's own limit is used.
+ */
+#define SDL_HINT_RENDER_MAX_TEXTURE_SIZE "SDL_RENDER_MAX_TEXTURE_SIZE"
+
+/**
+ * \brief A variable controlling the quality of audio resampling.
+ *
+ * This is read when an SDL_AudioCVT or SDL_AudioStream that changes the
+ * sample rate is built, and when an audio device is opened.
+ *
+ * The variable can be set to the following values:
+ *   "0" or "default" - Use the medium quality resampler (default)
+ *   "1" or "fast"    - Use the linear resamplers, cheap but with audible aliasing
+ *   "2" or "medium"  - Use a 16 tap windowed sinc filter
+ *   "3" or "best"    - Use a 64 tap windowed sinc filter
+ */
+#define SDL_HINT_AUDIO_RESAMPLING_MODE "SDL_AUDIO_RESAMPLING_MODE"
+
+/**
+ * \brief A variable controlling whether the disk audio driver renders faster than real time.
+ *
+ * This is checked when a disk audio device is opened. An offline playback
+ * device doesn't wait between buffers, so the audio callback runs as fast
+ * as the output file can be written, and an offline capture device reads
+ * its file as fast as the callback takes the data. Once it reaches the end
+ * of the file, it delivers silence in real time. A paused offline playback
+ * device waits to be unpaused without writing anything past the buffer it
+ * was working on. Use SDL_GetAudioDevicePosition() instead of the wall
+ * clock to keep time with the audio.
+ *
+ * This variable can be set to the following values:
+ *   "0"       - Disk audio devices play and capture in real time (default)
+ *   "1"       - Disk audio devices run as fast as they can
+ */
+#define SDL_HINT_AUDIO_DISK_OFFLINE "SDL_AUDIO_DISK_OFFLINE"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
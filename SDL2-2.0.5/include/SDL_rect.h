@@ -137,6 +137,58 @@ extern DECLSPEC SDL_bool SDLCALL SDL_IntersectRectAndLine(const SDL_Rect *
                                                           int *Y1, int *X2,
                                                           int *Y2);
 
+/**
+ *  \brief Clip an array of rectangles against a clipping rectangle.
+ *
+ *  Every rectangle that intersects \c clip is written to \c result, clipped
+ *  to \c clip, in its original order. \c result must have room for \c count
+ *  rectangles and may be the same array as \c rects.
+ *
+ *  \return The number of rectangles written to \c result, or -1 on error.
+ *
+ *  \sa SDL_IntersectRect
+ *  \sa SDL_CullRects
+ */
+extern DECLSPEC int SDLCALL SDL_IntersectRects(const SDL_Rect * rects,
+                                               int count,
+                                               const SDL_Rect * clip,
+                                               SDL_Rect * result);
+
+/**
+ *  \brief Remove the rectangles of an array that don't intersect a clipping
+ *         rectangle.
+ *
+ *  Every rectangle that intersects \c clip is copied unchanged to \c result,
+ *  in its original order. \c result must have room for \c count rectangles
+ *  and may be the same array as \c rects.
+ *
+ *  \return The number of rectangles written to \c result, or -1 on error.
+ *
+ *  \sa SDL_HasIntersection
+ *  \sa SDL_IntersectRects
+ */
+extern DECLSPEC int SDLCALL SDL_CullRects(const SDL_Rect * rects,
+                                          int count,
+                                          const SDL_Rect * clip,
+                                          SDL_Rect * result);
+
+/**
+ *  \brief Remove the points of an array that are outside a clipping
+ *         rectangle.
+ *
+ *  Every point inside \c clip is copied to \c result, in its original order.
+ *  \c result must have room for \c count points and may be the same array
+ *  as \c points.
+ *
+ *  \return The number of points written to \c result, or -1 on error.
+ *
+ *  \sa SDL_PointInRect
+ */
+extern DECLSPEC int SDLCALL SDL_ClipPoints(const SDL_Point * points,
+                                           int count,
+                                           const SDL_Rect * clip,
+                                           SDL_Point * result);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -233,6 +233,13 @@ extern DECLSPEC int SDLCALL SDL_GetRendererOutputSize(SDL_Renderer * renderer,
  *          active,  the format was unsupported, or the width or height were out
  *          of range.
  *
+ *  \note A static or streaming texture in a packed pixel format can be larger
+ *        than the renderer's max_texture_width and max_texture_height. It is
+ *        then backed by a grid of textures of at most that size, which
+ *        SDL_RenderCopy() and SDL_RenderCopyEx() draw together and updates
+ *        only touch where needed. Such a texture can't be used with
+ *        SDL_GL_BindTexture(), and render targets are still limited.
+ *
  *  \sa SDL_QueryTexture()
  *  \sa SDL_UpdateTexture()
  *  \sa SDL_DestroyTexture()
@@ -406,6 +413,42 @@ extern DECLSPEC int SDLCALL SDL_UpdateYUVTexture(SDL_Texture * texture,
                                                  const Uint8 *Uplane, int Upitch,
                                                  const Uint8 *Vplane, int Vpitch);
 
+/**
+ *  \brief Queue a new frame for a planar YV12 or IYUV texture.
+ *
+ *  The planes are copied before this function returns. If the renderer
+ *  doesn't support the format natively, the frame is converted on a
+ *  background thread while the application goes on decoding and rendering.
+ *  The next SDL_RenderCopy() or SDL_RenderCopyEx() of the texture shows the
+ *  newest frame that has finished converting; until then the texture keeps
+ *  showing the previous one. Frames that were never drawn are dropped when
+ *  newer ones finish.
+ *
+ *  Updating or locking the texture directly waits for the queued frames.
+ *
+ *  \param texture   The texture to update
+ *  \param Yplane    The raw pixel data for the Y plane of the whole texture.
+ *  \param Ypitch    The number of bytes between rows of pixel data for the Y plane.
+ *  \param Uplane    The raw pixel data for the U plane.
+ *  \param Upitch    The number of bytes between rows of pixel data for the U plane.
+ *  \param Vplane    The raw pixel data for the V plane.
+ *  \param Vpitch    The number of bytes between rows of pixel data for the V plane.
+ *
+ *  \return 0 on success, or -1 if the texture is not valid.
+ *
+ *  \note This function may be called from another thread than the one
+ *        rendering, but only from one thread at a time for each texture.
+ *        The texture must not be destroyed while a call is in progress.
+ *
+ *  \sa SDL_UpdateYUVTexture()
+ *  \sa SDL_HINT_RENDER_YUV_THREADS
+ *  \sa SDL_HINT_RENDER_YUV_BUFFERS
+ */
+extern DECLSPEC int SDLCALL SDL_UpdateYUVTextureAsync(SDL_Texture * texture,
+                                                      const Uint8 *Yplane, int Ypitch,
+                                                      const Uint8 *Uplane, int Upitch,
+                                                      const Uint8 *Vplane, int Vpitch);
+
 /**
  *  \brief Lock a portion of the texture for write-only pixel access.
  *
@@ -679,6 +722,36 @@ extern DECLSPEC int SDLCALL SDL_SetRenderDrawBlendMode(SDL_Renderer * renderer,
 extern DECLSPEC int SDLCALL SDL_GetRenderDrawBlendMode(SDL_Renderer * renderer,
                                                        SDL_BlendMode *blendMode);
 
+/**
+ *  \brief Set the width of lines drawn by SDL_RenderDrawLine() and SDL_RenderDrawLines().
+ *
+ *  \param renderer The renderer for which the line width should be set.
+ *  \param width The line width in pixels, scaled along with the rest of the
+ *               rendering. The default is 1.0.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \note Line ends are squared off half the width beyond the end points.
+ *
+ *  \sa SDL_GetRenderDrawLineWidth()
+ *  \sa SDL_HINT_RENDER_LINE_ANTIALIASING
+ */
+extern DECLSPEC int SDLCALL SDL_SetRenderDrawLineWidth(SDL_Renderer * renderer,
+                                                       float width);
+
+/**
+ *  \brief Get the width of lines drawn by the renderer.
+ *
+ *  \param renderer The renderer from which the line width should be queried.
+ *  \param width A pointer filled in with the current line width.
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_SetRenderDrawLineWidth()
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderDrawLineWidth(SDL_Renderer * renderer,
+                                                       float *width);
+
 /**
  *  \brief Clear the current rendering target with the drawing color
  *
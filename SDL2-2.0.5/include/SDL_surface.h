@@ -53,6 +53,7 @@ extern "C" {
 #define SDL_PREALLOC        0x00000001  /**< Surface uses preallocated memory */
 #define SDL_RLEACCEL        0x00000002  /**< Surface is RLE encoded */
 #define SDL_DONTFREE        0x00000004  /**< Surface is referenced internally */
+#define SDL_SIMD_ALIGNED    0x00000008  /**< Surface uses aligned memory */
 /* @} *//* Surface flags */
 
 /**
@@ -382,6 +383,37 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
                                               Uint32 dst_format,
                                               void * dst, int dst_pitch);
 
+/**
+ * \brief Copy a block of pixels of one format to another format, multiplying
+ *        the color channels by alpha for use with SDL_BLENDMODE_PREMULTIPLIED.
+ *
+ *  The destination format must be a packed 32-bit format with 8-bit alpha,
+ *  such as SDL_PIXELFORMAT_ARGB8888. \c src and \c dst may be the same
+ *  buffer to premultiply pixels in place.
+ *
+ *  \return 0 on success, or -1 if there was an error
+ */
+extern DECLSPEC int SDLCALL SDL_PremultiplyAlpha(int width, int height,
+                                                 Uint32 src_format,
+                                                 const void * src, int src_pitch,
+                                                 Uint32 dst_format,
+                                                 void * dst, int dst_pitch);
+
+/**
+ * \brief Get the counters of the pool SDL uses for temporary surface pixels.
+ *
+ *  The renderers and pixel conversions draw their short-lived buffers from
+ *  this pool, see SDL_HINT_SURFACE_POOL_SIZE.
+ *
+ *  \param hits    Filled in with the number of requests served from the pool
+ *  \param misses  Filled in with the number of requests that allocated memory
+ *  \param cached  Filled in with the number of bytes currently held by the pool
+ *
+ *  Any of the parameters may be NULL.
+ */
+extern DECLSPEC void SDLCALL SDL_GetSurfacePoolStats(Uint64 * hits, Uint64 * misses,
+                                                     Uint64 * cached);
+
 /**
  *  Performs a fast fill of the given rectangle with \c color.
  *
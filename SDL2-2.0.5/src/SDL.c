@@ -33,6 +33,9 @@
 #include "events/SDL_events_c.h"
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
+#include "render/SDL_yuv_queue_c.h"
+#include "video/SDL_blit_threads.h"
+#include "video/SDL_surface_pool.h"
 
 /* Initialization/Cleanup routines */
 #if !SDL_TIMERS_DISABLED
@@ -360,6 +363,10 @@ SDL_Quit(void)
     SDL_TicksQuit();
 #endif
 
+    SDL_BlitCPUFeaturesQuit();
+    SDL_BlitThreadsQuit();
+    SDL_SurfacePoolQuit();
+    SDL_YUVQueueQuit();
     SDL_ClearHints();
     SDL_AssertionsQuit();
     SDL_LogResetPriorities();
@@ -448,117 +448,156 @@ SDL_RemoveAudioDevice(const int iscapture, void *handle)
 
 /* buffer queueing support... */
 
+/* The audio thread is one end of the queue and the application the other:
+   the producer for playback devices, the consumer for capture devices. The
+   audio thread's side is lock-free; device->queue_lock only keeps several
+   application threads from using the queue at once. Rings the consumer is
+   done with are freed by the application's side, so the audio thread never
+   frees memory, and it only allocates when capture outgrows the ring. */
+
+static SDL_AudioQueueRing *
+create_audio_queue_ring(Uint32 minsize)
+{
+    SDL_AudioQueueRing *ring;
+    Uint32 size = SDL_AUDIOQUEUE_MINSIZE;
+
+    while (size < minsize) {
+        if (size >= 0x80000000) {
+            return NULL;  /* the positions can't tell full from empty past this. */
+        }
+        size *= 2;
+    }
+
+    ring = (SDL_AudioQueueRing *) SDL_malloc(sizeof (SDL_AudioQueueRing) + size);
+    if (ring != NULL) {
+        SDL_zerop(ring);
+        ring->data = (Uint8 *) (ring + 1);
+        ring->size = size;
+    }
+    return ring;
+}
+
 /* this expects that you managed thread safety elsewhere. */
 static void
-free_audio_queue(SDL_AudioBufferQueue *packet)
+free_audio_queue(SDL_AudioQueueRing *ring)
 {
-    while (packet) {
-        SDL_AudioBufferQueue *next = packet->next;
-        SDL_free(packet);
-        packet = next;
+    while (ring) {
+        SDL_AudioQueueRing *next = (SDL_AudioQueueRing *) ring->next;
+        SDL_free(ring);
+        ring = next;
     }
 }
 
-/* NOTE: This assumes you'll hold the mixer lock before calling! */
-static int
-queue_audio_to_device(SDL_AudioDevice *device, const Uint8 *data, Uint32 len)
+/* The consumer is done with this ring; the application's side frees it. */
+static void
+retire_audio_queue_ring(SDL_AudioDevice *device, SDL_AudioQueueRing *ring)
 {
-    SDL_AudioBufferQueue *orighead;
-    SDL_AudioBufferQueue *origtail;
-    Uint32 origlen;
-    Uint32 datalen;
+    void *retired;
 
-    orighead = device->buffer_queue_head;
-    origtail = device->buffer_queue_tail;
-    origlen = origtail ? origtail->datalen : 0;
+    do {
+        retired = SDL_AtomicGetPtr(&device->queue_retired);
+        ring->retired_next = (SDL_AudioQueueRing *) retired;
+    } while (!SDL_AtomicCASPtr(&device->queue_retired, retired, ring));
+}
 
-    while (len > 0) {
-        SDL_AudioBufferQueue *packet = device->buffer_queue_tail;
-        SDL_assert(!packet || (packet->datalen <= SDL_AUDIOBUFFERQUEUE_PACKETLEN));
-        if (!packet || (packet->datalen >= SDL_AUDIOBUFFERQUEUE_PACKETLEN)) {
-            /* tail packet missing or completely full; we need a new packet. */
-            packet = device->buffer_queue_pool;
-            if (packet != NULL) {
-                /* we have one available in the pool. */
-                device->buffer_queue_pool = packet->next;
-            } else {
-                /* Have to allocate a new one! */
-                packet = (SDL_AudioBufferQueue *) SDL_malloc(sizeof (SDL_AudioBufferQueue));
-                if (packet == NULL) {
-                    /* uhoh, reset so we've queued nothing new, free what we can. */
-                    if (!origtail) {
-                        packet = device->buffer_queue_head;  /* whole queue. */
-                    } else {
-                        packet = origtail->next;  /* what we added to existing queue. */
-                        origtail->next = NULL;
-                        origtail->datalen = origlen;
-                    }
-                    device->buffer_queue_head = orighead;
-                    device->buffer_queue_tail = origtail;
-                    device->buffer_queue_pool = NULL;
-
-                    free_audio_queue(packet);  /* give back what we can. */
-
-                    return SDL_OutOfMemory();
-                }
-            }
-            packet->datalen = 0;
-            packet->startpos = 0;
-            packet->next = NULL;
+/* Only call this from the application's side of the queue. */
+static void
+free_retired_audio_queue(SDL_AudioDevice *device)
+{
+    SDL_AudioQueueRing *ring = (SDL_AudioQueueRing *) SDL_AtomicSetPtr(&device->queue_retired, NULL);
 
-            SDL_assert((device->buffer_queue_head != NULL) == (device->queued_bytes != 0));
-            if (device->buffer_queue_tail == NULL) {
-                device->buffer_queue_head = packet;
-            } else {
-                device->buffer_queue_tail->next = packet;
-            }
-            device->buffer_queue_tail = packet;
+    while (ring) {
+        SDL_AudioQueueRing *next = ring->retired_next;
+        SDL_free(ring);
+        ring = next;
+    }
+}
+
+/* Copy into a ring with enough room, then publish it to the consumer. */
+static void
+write_audio_queue_ring(SDL_AudioDevice *device, SDL_AudioQueueRing *ring,
+                       const Uint8 *data, Uint32 len)
+{
+    const Uint32 head = (Uint32) SDL_AtomicGet(&ring->head);
+    const Uint32 offset = head & (ring->size - 1);
+    const Uint32 cpy = SDL_min(len, ring->size - offset);
+
+    SDL_memcpy(ring->data + offset, data, cpy);
+    SDL_memcpy(ring->data, data + cpy, len - cpy);
+
+    /* count it first, so the consumer can't take away more than was added. */
+    SDL_AtomicAdd(&device->queued_bytes, (int) len);
+    SDL_AtomicSet(&ring->head, (int) (head + len));
+}
+
+/* NOTE: Only one thread may produce at a time! */
+static int
+queue_audio_to_device(SDL_AudioDevice *device, const Uint8 *data, Uint32 len)
+{
+    SDL_AudioQueueRing *ring = device->queue_write;
+    const Uint32 used = (Uint32) SDL_AtomicGet(&ring->head) - (Uint32) SDL_AtomicGet(&ring->tail);
+    const Uint32 space = ring->size - used;
+
+    if (len > space) {
+        /* Fill this ring and move on to a bigger one. Allocate it before
+           writing anything, so running out of memory queues nothing. */
+        SDL_AudioQueueRing *next = create_audio_queue_ring(SDL_max(ring->size + 1, len - space));
+        if (next == NULL) {
+            return SDL_OutOfMemory();
         }
 
-        datalen = SDL_min(len, SDL_AUDIOBUFFERQUEUE_PACKETLEN - packet->datalen);
-        SDL_memcpy(packet->data + packet->datalen, data, datalen);
-        data += datalen;
-        len -= datalen;
-        packet->datalen += datalen;
-        device->queued_bytes += datalen;
+        write_audio_queue_ring(device, ring, data, space);
+        write_audio_queue_ring(device, next, data + space, len - space);
+        device->queue_write = next;
+        SDL_AtomicSetPtr(&ring->next, next);
+    } else {
+        write_audio_queue_ring(device, ring, data, len);
     }
 
     return 0;
 }
 
-/* NOTE: This assumes you'll hold the mixer lock before calling! */
+/* NOTE: Only one thread may consume at a time! A NULL stream drops data. */
 static Uint32
 dequeue_audio_from_device(SDL_AudioDevice *device, Uint8 *stream, Uint32 len)
 {
-    SDL_AudioBufferQueue *packet;
-    Uint8 *ptr = stream;
+    Uint32 total = 0;
 
-    while ((len > 0) && ((packet = device->buffer_queue_head) != NULL)) {
-        const Uint32 avail = packet->datalen - packet->startpos;
-        const Uint32 cpy = SDL_min(len, avail);
-        SDL_assert(device->queued_bytes >= avail);
-
-        SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
-        packet->startpos += cpy;
-        ptr += cpy;
-        device->queued_bytes -= cpy;
-        len -= cpy;
-
-        if (packet->startpos == packet->datalen) {  /* packet is done, put it in the pool. */
-            device->buffer_queue_head = packet->next;
-            SDL_assert((packet->next != NULL) || (packet == device->buffer_queue_tail));
-            packet->next = device->buffer_queue_pool;
-            device->buffer_queue_pool = packet;
+    while (len > 0) {
+        SDL_AudioQueueRing *ring = device->queue_read;
+        const Uint32 tail = (Uint32) SDL_AtomicGet(&ring->tail);
+        const Uint32 avail = (Uint32) SDL_AtomicGet(&ring->head) - tail;
+        Uint32 offset, cpy, first;
+
+        if (avail == 0) {
+            SDL_AudioQueueRing *next = (SDL_AudioQueueRing *) SDL_AtomicGetPtr(&ring->next);
+            if (next == NULL) {
+                break;  /* the queue is empty. */
+            }
+            /* the producer may have finished this ring before moving on. */
+            if ((Uint32) SDL_AtomicGet(&ring->head) != tail) {
+                continue;
+            }
+            device->queue_read = next;
+            retire_audio_queue_ring(device, ring);
+            continue;
         }
-    }
 
-    SDL_assert((device->buffer_queue_head != NULL) == (device->queued_bytes != 0));
+        offset = tail & (ring->size - 1);
+        cpy = SDL_min(len, avail);
+        first = SDL_min(cpy, ring->size - offset);
+        if (stream) {
+            SDL_memcpy(stream + total, ring->data + offset, first);
+            SDL_memcpy(stream + total + first, ring->data, cpy - first);
+        }
 
-    if (device->buffer_queue_head == NULL) {
-        device->buffer_queue_tail = NULL;  /* in case we drained the queue entirely. */
+        SDL_AtomicSet(&ring->tail, (int) (tail + cpy));
+        SDL_AtomicAdd(&device->queued_bytes, -((int) cpy));
+        total += cpy;
+        len -= cpy;
     }
 
-    return (Uint32) (ptr - stream);
+    return total;
 }
 
 static void SDLCALL
@@ -577,8 +616,7 @@ SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
     len -= (int) written;
 
     if (len > 0) {  /* fill any remaining space in the stream with silence. */
-        SDL_assert(device->buffer_queue_head == NULL);
-        SDL_memset(stream, device->spec.silence, len);
+        SDL_memset(stream, device->callbackspec.silence, len);
     }
 }
 
@@ -613,9 +651,10 @@ SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
     }
 
     if (len > 0) {
-        current_audio.impl.LockDevice(device);
+        SDL_LockMutex(device->queue_lock);
+        free_retired_audio_queue(device);
         rc = queue_audio_to_device(device, data, len);
-        current_audio.impl.UnlockDevice(device);
+        SDL_UnlockMutex(device->queue_lock);
     }
 
     return rc;
@@ -634,9 +673,10 @@ SDL_DequeueAudio(SDL_AudioDeviceID devid, void *data, Uint32 len)
         return 0;  /* just report zero bytes dequeued. */
     }
 
-    current_audio.impl.LockDevice(device);
+    SDL_LockMutex(device->queue_lock);
     rc = dequeue_audio_from_device(device, data, len);
-    current_audio.impl.UnlockDevice(device);
+    free_retired_audio_queue(device);
+    SDL_UnlockMutex(device->queue_lock);
     return rc;
 }
 
@@ -652,13 +692,15 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
 
     /* Nothing to do unless we're set up for queueing. */
     if (device->spec.callback == SDL_BufferQueueDrainCallback) {
-        current_audio.impl.LockDevice(device);
-        retval = device->queued_bytes + current_audio.impl.GetPendingBytes(device);
-        current_audio.impl.UnlockDevice(device);
+        retval = (Uint32) SDL_AtomicGet(&device->queued_bytes);
+        if (current_audio.impl.GetPendingBytes != SDL_AudioGetPendingBytes_Default) {
+            /* drivers count their own pending data with the device locked. */
+            current_audio.impl.LockDevice(device);
+            retval += current_audio.impl.GetPendingBytes(device);
+            current_audio.impl.UnlockDevice(device);
+        }
     } else if (device->spec.callback == SDL_BufferQueueFillCallback) {
-        current_audio.impl.LockDevice(device);
-        retval = device->queued_bytes;
-        current_audio.impl.UnlockDevice(device);
+        retval = (Uint32) SDL_AtomicGet(&device->queued_bytes);
     }
 
     return retval;
@@ -668,44 +710,185 @@ void
 SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 {
     SDL_AudioDevice *device = get_audio_device(devid);
-    SDL_AudioBufferQueue *packet;
 
-    if (!device) {
+    if (!device || !device->queue_lock) {
         return;  /* nothing to do. */
     }
 
-    /* Blank out the device and release the mutex. Free it afterwards. */
+    /* Drop everything as the consumer. For playback that's the audio
+       thread, so keep it out while we do. */
+    SDL_LockMutex(device->queue_lock);
     current_audio.impl.LockDevice(device);
+    dequeue_audio_from_device(device, NULL, 0xFFFFFFFF);
+    current_audio.impl.UnlockDevice(device);
+    free_retired_audio_queue(device);
+    SDL_UnlockMutex(device->queue_lock);
+}
 
-    /* merge the available pool and the current queue into one list. */
-    packet = device->buffer_queue_head;
-    if (packet) {
-        device->buffer_queue_tail->next = device->buffer_queue_pool;
-    } else {
-        packet = device->buffer_queue_pool;
+
+/* Timing counters kept by the audio threads */
+static Uint32
+SDL_AudioStatsMicroseconds(Uint64 start, Uint64 end)
+{
+    const Uint64 us = ((end - start) * 1000000) / SDL_GetPerformanceFrequency();
+    return (us > 0x7FFFFFFF) ? 0x7FFFFFFF : (Uint32) us;
+}
+
+static void
+SDL_RecordAudioCallback(SDL_AudioDevice *device, Uint64 start)
+{
+    const Uint32 us = SDL_AudioStatsMicroseconds(start, SDL_GetPerformanceCounter());
+    SDL_AudioDeviceStats *stats = &device->stats;
+    int bucket = 0;
+
+    while ((bucket < SDL_AUDIO_STATS_HISTOGRAM_BUCKETS - 1) && (us >> bucket)) {
+        ++bucket;
     }
 
-    /* Remove the queued packets from the device. */
-    device->buffer_queue_tail = NULL;
-    device->buffer_queue_head = NULL;
-    device->queued_bytes = 0;
-    device->buffer_queue_pool = packet;
+    SDL_AtomicLock(&device->stats_lock);
+    stats->callbacks++;
+    stats->callback_total_us += us;
+    stats->callback_max_us = SDL_max(stats->callback_max_us, us);
+    stats->callback_histogram[bucket]++;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
 
-    /* Keep up to two packets in the pool to reduce future malloc pressure. */
-    if (packet) {
-        if (!packet->next) {
-            packet = NULL;  /* one packet (the only one) for the pool. */
+static void
+SDL_RecordAudioConversion(SDL_AudioDevice *device, Uint64 start)
+{
+    const Uint32 us = SDL_AudioStatsMicroseconds(start, SDL_GetPerformanceCounter());
+    SDL_AudioDeviceStats *stats = &device->stats;
+
+    SDL_AtomicLock(&device->stats_lock);
+    stats->conversions++;
+    stats->convert_total_us += us;
+    stats->convert_max_us = SDL_max(stats->convert_max_us, us);
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+/* Remember how much converted audio is waiting in the device's stream */
+static void
+SDL_RecordAudioStreamLevel(SDL_AudioDevice *device)
+{
+    const int available = SDL_AudioStreamAvailable(device->stream);
+
+    SDL_AtomicLock(&device->stats_lock);
+    device->stats_stream_bytes = available;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+/* Call right before PlayDevice */
+static void
+SDL_RecordAudioPlay(SDL_AudioDevice *device)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+    SDL_AudioDeviceStats *stats = &device->stats;
+
+    SDL_AtomicLock(&device->stats_lock);
+    if (device->stats_last_play) {
+        const Uint32 period = SDL_AudioStatsMicroseconds(device->stats_last_play, now);
+        const Sint32 headroom = (Sint32) (2 * stats->buffer_us) - (Sint32) period;
+
+        if (stats->plays < 2) {
+            stats->play_period_min_us = period;
+            stats->min_headroom_us = headroom;
         } else {
-            SDL_AudioBufferQueue *next = packet->next->next;
-            packet->next->next = NULL;  /* two packets for the pool. */
-            packet = next;  /* rest will be freed. */
+            stats->play_period_min_us = SDL_min(stats->play_period_min_us, period);
+            stats->min_headroom_us = SDL_min(stats->min_headroom_us, headroom);
+        }
+        stats->play_period_last_us = period;
+        stats->play_period_max_us = SDL_max(stats->play_period_max_us, period);
+        stats->play_period_total_us += period;
+        if (period > stats->buffer_us + stats->buffer_us / 2) {
+            stats->late_wakes++;
+        }
+        if (headroom < 0) {
+            stats->underruns++;
         }
     }
+    stats->plays++;
+    device->stats_last_play = now;
+    device->position += device->spec.samples;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
 
-    current_audio.impl.UnlockDevice(device);
+/* Call after a full device buffer was captured */
+static void
+SDL_RecordAudioCapture(SDL_AudioDevice *device)
+{
+    SDL_AtomicLock(&device->stats_lock);
+    device->position += device->spec.samples;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+int
+SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    const SDL_AudioSpec *stream_spec;
+    Uint64 queued_frames, stream_frames;
+
+    if (!device) {
+        return -1;
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_AtomicLock(&device->stats_lock);
+    *stats = device->stats;
+    stream_frames = (Uint64) device->stats_stream_bytes;
+    SDL_AtomicUnlock(&device->stats_lock);
+
+    /* The queue holds audio in the app's format, the stream's output is in
+       the device's format for playback and the app's for capture. */
+    queued_frames = (Uint32) SDL_AtomicGet(&device->queued_bytes);
+    queued_frames /= device->callbackspec.channels * (SDL_AUDIO_BITSIZE(device->callbackspec.format) / 8);
+    stream_spec = device->iscapture ? &device->callbackspec : &device->spec;
+    stream_frames /= stream_spec->channels * (SDL_AUDIO_BITSIZE(stream_spec->format) / 8);
+    stats->queued_us = (Uint32) ((queued_frames * 1000000) / device->callbackspec.freq +
+                                 (stream_frames * 1000000) / stream_spec->freq);
+    return 0;
+}
+
+void
+SDL_ResetAudioDeviceStats(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    Uint32 buffer_us;
+
+    if (!device) {
+        return;
+    }
+
+    SDL_AtomicLock(&device->stats_lock);
+    buffer_us = device->stats.buffer_us;
+    SDL_zero(device->stats);
+    device->stats.buffer_us = buffer_us;
+    device->stats_last_play = 0;
+    device->stats_stream_bytes = 0;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
 
-    /* free any extra packets we didn't keep in the pool. */
-    free_audio_queue(packet);
+Uint64
+SDL_GetAudioDevicePosition(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    Uint64 position;
+
+    if (!device) {
+        return 0;
+    }
+
+    SDL_AtomicLock(&device->stats_lock);
+    position = device->position;
+    SDL_AtomicUnlock(&device->stats_lock);
+
+    /* The device's rate is the app's unless a stream converts between them */
+    if (device->spec.freq != device->callbackspec.freq) {
+        position = (position * device->callbackspec.freq) / device->spec.freq;
+    }
+    return position;
 }
 
 
@@ -714,12 +897,13 @@ static int SDLCALL
 SDL_RunAudio(void *devicep)
 {
     SDL_AudioDevice *device = (SDL_AudioDevice *) devicep;
-    const int silence = (int) device->spec.silence;
+    const int silence = (int) device->callbackspec.silence;
     const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
-    const int stream_len = (device->convert.needed) ? device->convert.len : device->spec.size;
-    Uint8 *stream;
+    const int data_len = device->callbackspec.size;
+    Uint8 *data;
     void *udata = device->spec.userdata;
     void (SDLCALL *callback) (void *, Uint8 *, int) = device->spec.callback;
+    Uint64 start;
 
     SDL_assert(!device->iscapture);
 
@@ -733,50 +917,74 @@ SDL_RunAudio(void *devicep)
     /* Loop, filling the audio buffers */
     while (!SDL_AtomicGet(&device->shutdown)) {
         /* Fill the current buffer with sound */
-        if (device->convert.needed) {
-            stream = device->convert.buf;
-        } else if (SDL_AtomicGet(&device->enabled)) {
-            stream = current_audio.impl.GetDeviceBuf(device);
+        if (!device->stream && SDL_AtomicGet(&device->enabled)) {
+            data = current_audio.impl.GetDeviceBuf(device);
         } else {
             /* if the device isn't enabled, we still write to the
-               fake_stream, so the app's callback will fire with
+               work_buffer, so the app's callback will fire with
                a regular frequency, in case they depend on that
                for timing or progress. They can use hotplug
-               now to know if the device failed. */
-            stream = NULL;
+               now to know if the device failed.
+               Streaming playback uses work_buffer, too. */
+            data = NULL;
         }
 
-        if (stream == NULL) {
-            stream = device->fake_stream;
+        if (data == NULL) {
+            data = device->work_buffer;
         }
 
         /* !!! FIXME: this should be LockDevice. */
         if ( SDL_AtomicGet(&device->enabled) ) {
             SDL_LockMutex(device->mixer_lock);
             if (SDL_AtomicGet(&device->paused)) {
-                SDL_memset(stream, silence, stream_len);
+                SDL_memset(data, silence, data_len);
             } else {
-                (*callback) (udata, stream, stream_len);
+                start = SDL_GetPerformanceCounter();
+                (*callback) (udata, data, data_len);
+                SDL_RecordAudioCallback(device, start);
             }
             SDL_UnlockMutex(device->mixer_lock);
         }
 
-        /* Convert the audio if necessary */
-        if (device->convert.needed && SDL_AtomicGet(&device->enabled)) {
-            SDL_ConvertAudio(&device->convert);
-            stream = current_audio.impl.GetDeviceBuf(device);
-            if (stream == NULL) {
-                stream = device->fake_stream;
-            } else {
-                SDL_memcpy(stream, device->convert.buf,
-                           device->convert.len_cvt);
+        if (device->stream && SDL_AtomicGet(&device->enabled)) {
+            /* Convert the audio, then play every full device buffer it
+               makes; the callback's buffer size doesn't have to match. */
+            start = SDL_GetPerformanceCounter();
+            if (SDL_AudioStreamPut(device->stream, data, data_len) < 0) {
+                /* if this fails...oh well. We'll play silence here. */
+                SDL_AudioStreamClear(device->stream);
+                SDL_RecordAudioStreamLevel(device);
+                SDL_Delay(delay);
+                continue;
             }
-        }
-
-        /* Ready current buffer for play and change current buffer */
-        if (stream == device->fake_stream) {
+            SDL_RecordAudioConversion(device, start);
+
+            while (SDL_AudioStreamAvailable(device->stream) >= (int) device->spec.size) {
+                int got;
+                data = current_audio.impl.GetDeviceBuf(device);
+                if (data == NULL) {
+                    /* device is busy; drop this buffer and wait for as
+                       long as it would have played. */
+                    SDL_AudioStreamGet(device->stream, device->work_buffer, device->spec.size);
+                    SDL_Delay(delay);
+                    continue;
+                }
+                got = SDL_AudioStreamGet(device->stream, data, device->spec.size);
+                if (got != (int) device->spec.size) {
+                    SDL_memset(data, device->spec.silence, device->spec.size);
+                }
+                SDL_RecordAudioStreamLevel(device);
+                SDL_RecordAudioPlay(device);
+                current_audio.impl.PlayDevice(device);
+                current_audio.impl.WaitDevice(device);
+            }
+            SDL_RecordAudioStreamLevel(device);
+        } else if (data == device->work_buffer) {
+            /* Nothing to play; pause like we queued a buffer to play. */
             SDL_Delay(delay);
         } else {
+            /* Ready current buffer for play and change current buffer */
+            SDL_RecordAudioPlay(device);
             current_audio.impl.PlayDevice(device);
             current_audio.impl.WaitDevice(device);
         }
@@ -797,10 +1005,12 @@ SDL_CaptureAudio(void *devicep)
     SDL_AudioDevice *device = (SDL_AudioDevice *) devicep;
     const int silence = (int) device->spec.silence;
     const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
-    const int stream_len = (device->convert.needed) ? device->convert.len : device->spec.size;
-    Uint8 *stream;
+    const int data_len = device->spec.size;
+    const int callback_len = device->callbackspec.size;
+    Uint8 *data;
     void *udata = device->spec.userdata;
     void (SDLCALL *callback) (void *, Uint8 *, int) = device->spec.callback;
+    Uint64 start;
 
     SDL_assert(device->iscapture);
 
@@ -818,18 +1028,22 @@ SDL_CaptureAudio(void *devicep)
 
         if (!SDL_AtomicGet(&device->enabled) || SDL_AtomicGet(&device->paused)) {
             SDL_Delay(delay);  /* just so we don't cook the CPU. */
+            if (device->stream) {
+                SDL_AudioStreamClear(device->stream);
+                SDL_RecordAudioStreamLevel(device);
+            }
             current_audio.impl.FlushCapture(device);  /* dump anything pending. */
             continue;
         }
 
         /* Fill the current buffer with sound */
-        still_need = stream_len;
-        if (device->convert.needed) {
-            ptr = stream = device->convert.buf;
-        } else {
-            /* just use the "fake" stream to hold data read from the device. */
-            ptr = stream = device->fake_stream;
-        }
+        still_need = data_len;
+
+        /* Use the work_buffer to hold data read from the device. */
+        data = device->work_buffer;
+        SDL_assert(data != NULL);
+
+        ptr = data;
 
         /* We still read from the device when "paused" to keep the state sane,
            and block when there isn't data so this thread isn't eating CPU.
@@ -851,19 +1065,46 @@ SDL_CaptureAudio(void *devicep)
             /* Keep any data we already read, silence the rest. */
             SDL_memset(ptr, silence, still_need);
         }
+        SDL_RecordAudioCapture(device);
+
+        if (device->stream) {
+            /* if this fails...oh well. */
+            start = SDL_GetPerformanceCounter();
+            SDL_AudioStreamPut(device->stream, data, data_len);
+            SDL_RecordAudioConversion(device, start);
+
+            /* Hand the app every full callback buffer the device data made */
+            while (SDL_AudioStreamAvailable(device->stream) >= callback_len) {
+                const int got = SDL_AudioStreamGet(device->stream, device->work_buffer, callback_len);
+                SDL_assert((got < 0) || (got == callback_len));
+                if (got != callback_len) {
+                    SDL_memset(device->work_buffer, device->callbackspec.silence, callback_len);
+                }
 
-        if (device->convert.needed) {
-            SDL_ConvertAudio(&device->convert);
-        }
-
-        /* !!! FIXME: this should be LockDevice. */
-        SDL_LockMutex(device->mixer_lock);
-        if (SDL_AtomicGet(&device->paused)) {
-            current_audio.impl.FlushCapture(device);  /* one snuck in! */
+                /* !!! FIXME: this should be LockDevice. */
+                SDL_LockMutex(device->mixer_lock);
+                if (SDL_AtomicGet(&device->paused)) {
+                    current_audio.impl.FlushCapture(device);  /* one snuck in! */
+                } else {
+                    start = SDL_GetPerformanceCounter();
+                    (*callback)(udata, device->work_buffer, callback_len);
+                    SDL_RecordAudioCallback(device, start);
+                }
+                SDL_UnlockMutex(device->mixer_lock);
+            }
+            SDL_RecordAudioStreamLevel(device);
         } else {
-            (*callback)(udata, stream, stream_len);
+            /* !!! FIXME: this should be LockDevice. */
+            SDL_LockMutex(device->mixer_lock);
+            if (SDL_AtomicGet(&device->paused)) {
+                current_audio.impl.FlushCapture(device);  /* one snuck in! */
+            } else {
+                start = SDL_GetPerformanceCounter();
+                (*callback)(udata, data, data_len);
+                SDL_RecordAudioCallback(device, start);
+            }
+            SDL_UnlockMutex(device->mixer_lock);
         }
-        SDL_UnlockMutex(device->mixer_lock);
     }
 
     current_audio.impl.FlushCapture(device);
@@ -1098,16 +1339,17 @@ close_audio_device(SDL_AudioDevice * device)
     if (device->mixer_lock != NULL) {
         SDL_DestroyMutex(device->mixer_lock);
     }
-    SDL_free(device->fake_stream);
-    if (device->convert.needed) {
-        SDL_free(device->convert.buf);
-    }
+    SDL_free(device->work_buffer);
+    SDL_FreeAudioStream(device->stream);
     if (device->hidden != NULL) {
         current_audio.impl.CloseDevice(device);
     }
 
-    free_audio_queue(device->buffer_queue_head);
-    free_audio_queue(device->buffer_queue_pool);
+    if (device->queue_lock != NULL) {
+        SDL_DestroyMutex(device->queue_lock);
+    }
+    free_audio_queue(device->queue_read);
+    free_retired_audio_queue(device);
 
     SDL_free(device);
 }
@@ -1184,7 +1426,7 @@ open_audio_device(const char *devname, int iscapture,
     SDL_AudioDeviceID id = 0;
     SDL_AudioSpec _obtained;
     SDL_AudioDevice *device;
-    SDL_bool build_cvt;
+    SDL_bool build_stream;
     void *handle = NULL;
     int i = 0;
 
@@ -1319,76 +1561,69 @@ open_audio_device(const char *devname, int iscapture,
     SDL_assert(device->hidden != NULL);
 
     /* See if we need to do any conversion */
-    build_cvt = SDL_FALSE;
+    build_stream = SDL_FALSE;
     if (obtained->freq != device->spec.freq) {
         if (allowed_changes & SDL_AUDIO_ALLOW_FREQUENCY_CHANGE) {
             obtained->freq = device->spec.freq;
         } else {
-            build_cvt = SDL_TRUE;
+            build_stream = SDL_TRUE;
         }
     }
     if (obtained->format != device->spec.format) {
         if (allowed_changes & SDL_AUDIO_ALLOW_FORMAT_CHANGE) {
             obtained->format = device->spec.format;
         } else {
-            build_cvt = SDL_TRUE;
+            build_stream = SDL_TRUE;
         }
     }
     if (obtained->channels != device->spec.channels) {
         if (allowed_changes & SDL_AUDIO_ALLOW_CHANNELS_CHANGE) {
             obtained->channels = device->spec.channels;
         } else {
-            build_cvt = SDL_TRUE;
+            build_stream = SDL_TRUE;
         }
     }
 
     /* If the audio driver changes the buffer size, accept it.
        This needs to be done after the format is modified above,
        otherwise it might not have the correct buffer size.
+       A stream decouples the two, so the app keeps the size it asked for.
      */
     if (device->spec.samples != obtained->samples) {
-        obtained->samples = device->spec.samples;
+        if (!build_stream) {
+            obtained->samples = device->spec.samples;
+        }
         SDL_CalculateAudioSpec(obtained);
     }
+    device->callbackspec = *obtained;
+    device->stats.buffer_us = (Uint32) (((Uint64) device->spec.samples * 1000000) / device->spec.freq);
 
-    if (build_cvt) {
-        /* Build an audio conversion block */
-        if (SDL_BuildAudioCVT(&device->convert,
-                              obtained->format, obtained->channels,
-                              obtained->freq,
-                              device->spec.format, device->spec.channels,
-                              device->spec.freq) < 0) {
+    if (build_stream) {
+        if (iscapture) {
+            device->stream = SDL_NewAudioStream(device->spec.format,
+                                  device->spec.channels, device->spec.freq,
+                                  obtained->format, obtained->channels, obtained->freq);
+        } else {
+            device->stream = SDL_NewAudioStream(obtained->format, obtained->channels,
+                                  obtained->freq, device->spec.format,
+                                  device->spec.channels, device->spec.freq);
+        }
+
+        if (!device->stream) {
             close_audio_device(device);
             return 0;
         }
-        if (device->convert.needed) {
-            device->convert.len = (int) (((double) device->spec.size) /
-                                         device->convert.len_ratio);
-
-            device->convert.buf =
-                (Uint8 *) SDL_malloc(device->convert.len *
-                                            device->convert.len_mult);
-            if (device->convert.buf == NULL) {
-                close_audio_device(device);
-                SDL_OutOfMemory();
-                return 0;
-            }
-        }
     }
 
     if (device->spec.callback == NULL) {  /* use buffer queueing? */
-        /* pool a few packets to start. Enough for two callbacks. */
-        const int packetlen = SDL_AUDIOBUFFERQUEUE_PACKETLEN;
-        const int wantbytes = ((device->convert.needed) ? device->convert.len : device->spec.size) * 2;
-        const int wantpackets = (wantbytes / packetlen) + ((wantbytes % packetlen) ? packetlen : 0);
-        for (i = 0; i < wantpackets; i++) {
-            SDL_AudioBufferQueue *packet = (SDL_AudioBufferQueue *) SDL_malloc(sizeof (SDL_AudioBufferQueue));
-            if (packet) { /* don't care if this fails, we'll deal later. */
-                packet->datalen = 0;
-                packet->startpos = 0;
-                packet->next = device->buffer_queue_pool;
-                device->buffer_queue_pool = packet;
-            }
+        /* start with a ring big enough for two callbacks. */
+        device->queue_lock = SDL_CreateMutex();
+        device->queue_read = create_audio_queue_ring(obtained->size * 2);
+        device->queue_write = device->queue_read;
+        if (!device->queue_lock || !device->queue_read) {
+            close_audio_device(device);
+            SDL_OutOfMemory();
+            return 0;
         }
 
         device->spec.callback = iscapture ? SDL_BufferQueueFillCallback : SDL_BufferQueueDrainCallback;
@@ -1398,6 +1633,20 @@ open_audio_device(const char *devname, int iscapture,
     /* add it to our list of open devices. */
     open_devices[id] = device;
 
+    /* Allocate a scratch buffer; used by our internal threads, and by
+       drivers with their own callback thread when converting. */
+    if (device->stream || !current_audio.impl.ProvidesOwnCallbackThread) {
+        device->work_buffer_len = SDL_max(device->spec.size, obtained->size);
+        SDL_assert(device->work_buffer_len > 0);
+
+        device->work_buffer = (Uint8 *) SDL_malloc(device->work_buffer_len);
+        if (device->work_buffer == NULL) {
+            close_audio_device(device);
+            SDL_OutOfMemory();
+            return 0;
+        }
+    }
+
     /* Start the audio thread if necessary */
     if (!current_audio.impl.ProvidesOwnCallbackThread) {
         /* Start the audio thread */
@@ -1406,20 +1655,6 @@ open_audio_device(const char *devname, int iscapture,
         const size_t stacksize = is_internal_thread ? 64 * 1024 : 0;
         char threadname[64];
 
-        /* Allocate a fake audio buffer; only used by our internal threads. */
-        Uint32 stream_len = (device->convert.needed) ? device->convert.len_cvt : 0;
-        if (device->spec.size > stream_len) {
-            stream_len = device->spec.size;
-        }
-        SDL_assert(stream_len > 0);
-
-        device->fake_stream = (Uint8 *) SDL_malloc(stream_len);
-        if (device->fake_stream == NULL) {
-            close_audio_device(device);
-            SDL_OutOfMemory();
-            return 0;
-        }
-
         SDL_snprintf(threadname, sizeof (threadname), "SDLAudioDev%d", (int) device->id);
         device->thread = SDL_CreateThreadInternal(iscapture ? SDL_CaptureAudio : SDL_RunAudio, threadname, stacksize, device);
 
@@ -1577,6 +1812,8 @@ SDL_AudioQuit(void)
 
     SDL_DestroyMutex(current_audio.detectionLock);
 
+    SDL_FreeResampleFilters();
+
     SDL_zero(current_audio);
     SDL_zero(open_devices);
 }
@@ -1655,13 +1892,7 @@ SDL_MixAudio(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
     /* Mix the user-level audio format */
     SDL_AudioDevice *device = get_audio_device(1);
     if (device != NULL) {
-        SDL_AudioFormat format;
-        if (device->convert.needed) {
-            format = device->convert.src_format;
-        } else {
-            format = device->spec.format;
-        }
-        SDL_MixAudioFormat(dst, src, format, len, volume);
+        SDL_MixAudioFormat(dst, src, device->callbackspec.format, len, volume);
     }
 }
 
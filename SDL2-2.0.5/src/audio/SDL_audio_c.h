@@ -49,4 +49,75 @@ typedef struct
 } SDL_AudioRateFilters;
 extern const SDL_AudioRateFilters sdl_audio_rate_filters[];
 
+/* Vectorized converters, from SDL_audiotypecvt_simd.c */
+#define SDL_AUDIO_CPU_SSE2  0x00000001
+#define SDL_AUDIO_CPU_AVX2  0x00000002
+#define SDL_AUDIO_CPU_NEON  0x00000004
+
+/* The SIMD support the audio converters may use. The SDL_AUDIO_CPU_FEATURES
+   environment variable masks this, "0" selects the plain C converters. */
+extern Uint32 SDL_GetAudioCPUFeatures(void);
+
+/* A vectorized type converter for these formats, or NULL if there isn't one.
+   final_fmt is the format the whole SDL_AudioCVT converts to. */
+extern SDL_AudioFilter SDL_ChooseAudioTypeCVT(SDL_AudioFormat src_fmt, SDL_AudioFormat dst_fmt,
+                                              SDL_AudioFormat final_fmt);
+
+/* A vectorized converter that changes both the type and the channel count
+   in one pass, or NULL if there isn't one. */
+extern SDL_AudioFilter SDL_ChooseAudioRemixCVT(SDL_AudioFormat src_fmt, int src_channels,
+                                               SDL_AudioFormat dst_fmt, int dst_channels,
+                                               SDL_AudioFormat final_fmt);
+
+/* Windowed sinc resampling, from SDL_audioresample.c */
+#define SDL_RESAMPLE_FAST   0   /* the linear resamplers */
+#define SDL_RESAMPLE_MEDIUM 1
+#define SDL_RESAMPLE_BEST   2
+
+/* A polyphase filter for one ratio of rates, shared by everything that
+   resamples at that ratio and quality. */
+typedef struct SDL_ResampleFilter
+{
+    int src_rate;           /* the ratio, in lowest terms */
+    int dst_rate;
+    int quality;
+    int half_taps;          /* an output frame needs this many input frames on each side */
+    int taps;               /* 2 * half_taps, a multiple of 4 */
+    int phases;             /* dst_rate, or fewer when interpolating between them */
+    SDL_bool interpolate;
+    float *coeffs;          /* taps coefficients for each phase (plus one if interpolating) */
+    int refcount;
+    struct SDL_ResampleFilter *next;
+} SDL_ResampleFilter;
+
+/* The quality SDL_HINT_AUDIO_RESAMPLING_MODE asks for */
+extern int SDL_GetResampleQuality(void);
+
+/* Get a filter from the cache, building it if needed. Returns NULL, with
+   the error set, if it can't be built. */
+extern SDL_ResampleFilter *SDL_AcquireResampleFilter(int src_rate, int dst_rate, int quality);
+extern void SDL_ReleaseResampleFilter(SDL_ResampleFilter *filter);
+
+/* Free the cached filters nothing is using any more */
+extern void SDL_FreeResampleFilters(void);
+
+/* Resample interleaved float frames. (*pos, *phase) is where the next output
+   frame is, at inbuf frame (*pos + *phase / filter->dst_rate); it's updated
+   as frames are made. Stops after maxframes, or at the first output frame
+   that needs input past the end of inbuf. The caller has to make sure there
+   are filter->half_taps - 1 frames before the first one. Returns the number
+   of frames made. */
+extern int SDL_ResampleAudio(const SDL_ResampleFilter *filter, int channels,
+                             const float *inbuf, int inframes, int *pos, Uint32 *phase,
+                             float *outbuf, int maxframes);
+
+/* Move (*pos, *phase) on by one output frame */
+extern void SDL_StepResampleAudio(const SDL_ResampleFilter *filter, int *pos, Uint32 *phase);
+
+/* Like SDL_ResampleAudio(), for one output frame whose window may reach
+   outside inbuf; the missing input is taken as silence. */
+extern void SDL_ResampleAudioFrameClipped(const SDL_ResampleFilter *filter, int channels,
+                                          const float *inbuf, int inframes, int pos, Uint32 phase,
+                                          float *outbuf);
+
 /* vi: set ts=4 sw=4 expandtab: */
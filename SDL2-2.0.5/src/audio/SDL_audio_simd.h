@@ -0,0 +1,45 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef _SDL_audio_simd_h
+#define _SDL_audio_simd_h
+
+/* Which vector instruction sets the audio code is built with.
+   SDL_GetAudioCPUFeatures() says which of them can be used at runtime. */
+
+#if defined(__SSE2__)
+#define SDL_SSE2_AUDIO  1
+#include <emmintrin.h>
+/* AVX2 code is compiled per function and chosen at runtime */
+#if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#define SDL_AVX2_AUDIO  1
+#define SDL_TARGETING(x)    __attribute__((target(x)))
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define SDL_NEON_AUDIO  1
+#include <arm_neon.h>
+#endif
+
+#endif /* _SDL_audio_simd_h */
+
+/* vi: set ts=4 sw=4 expandtab: */
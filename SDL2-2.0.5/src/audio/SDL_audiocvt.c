@@ -342,7 +342,7 @@ SDL_ConvertSurround(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
             src = (Uint8 *) (cvt->buf + cvt->len_cvt);
             dst = (Uint8 *) (cvt->buf + cvt->len_cvt * 3);
-            for (i = cvt->len_cvt; i; --i) {
+            for (i = cvt->len_cvt / 2; i; --i) {
                 dst -= 6;
                 src -= 2;
                 lf = src[0];
@@ -364,7 +364,7 @@ SDL_ConvertSurround(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
             src = (Sint8 *) cvt->buf + cvt->len_cvt;
             dst = (Sint8 *) cvt->buf + cvt->len_cvt * 3;
-            for (i = cvt->len_cvt; i; --i) {
+            for (i = cvt->len_cvt / 2; i; --i) {
                 dst -= 6;
                 src -= 2;
                 lf = src[0];
@@ -601,7 +601,7 @@ SDL_ConvertSurround_4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
             src = (Uint8 *) (cvt->buf + cvt->len_cvt);
             dst = (Uint8 *) (cvt->buf + cvt->len_cvt * 2);
-            for (i = cvt->len_cvt; i; --i) {
+            for (i = cvt->len_cvt / 2; i; --i) {
                 dst -= 4;
                 src -= 2;
                 lf = src[0];
@@ -621,7 +621,7 @@ SDL_ConvertSurround_4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 
             src = (Sint8 *) cvt->buf + cvt->len_cvt;
             dst = (Sint8 *) cvt->buf + cvt->len_cvt * 2;
-            for (i = cvt->len_cvt; i; --i) {
+            for (i = cvt->len_cvt / 2; i; --i) {
                 dst -= 4;
                 src -= 2;
                 lf = src[0];
@@ -810,39 +810,15 @@ SDL_ConvertSurround_4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 }
 
 
-int
-SDL_ConvertAudio(SDL_AudioCVT * cvt)
-{
-    /* !!! FIXME: (cvt) should be const; stack-copy it here. */
-    /* !!! FIXME: (actually, we can't...len_cvt needs to be updated. Grr.) */
-
-    /* Make sure there's data to convert */
-    if (cvt->buf == NULL) {
-        SDL_SetError("No buffer allocated for conversion");
-        return (-1);
-    }
-    /* Return okay if no conversion is necessary */
-    cvt->len_cvt = cvt->len;
-    if (cvt->filters[0] == NULL) {
-        return (0);
-    }
-
-    /* Set up the conversion and go! */
-    cvt->filter_index = 0;
-    cvt->filters[0] (cvt, cvt->src_format);
-    return (0);
-}
-
-
 static SDL_AudioFilter
-SDL_HandTunedTypeCVT(SDL_AudioFormat src_fmt, SDL_AudioFormat dst_fmt)
+SDL_HandTunedTypeCVT(SDL_AudioCVT * cvt, SDL_AudioFormat src_fmt, SDL_AudioFormat dst_fmt)
 {
     /*
      * Fill in any future conversions that are specialized to a
      *  processor, platform, compiler, or library here.
      */
 
-    return NULL;                /* no specialized converter code available. */
+    return SDL_ChooseAudioTypeCVT(src_fmt, dst_fmt, cvt->dst_format);
 }
 
 
@@ -859,7 +835,7 @@ SDL_BuildAudioTypeCVT(SDL_AudioCVT * cvt,
     if (src_fmt != dst_fmt) {
         const Uint16 src_bitsize = SDL_AUDIO_BITSIZE(src_fmt);
         const Uint16 dst_bitsize = SDL_AUDIO_BITSIZE(dst_fmt);
-        SDL_AudioFilter filter = SDL_HandTunedTypeCVT(src_fmt, dst_fmt);
+        SDL_AudioFilter filter = SDL_HandTunedTypeCVT(cvt, src_fmt, dst_fmt);
 
         /* No hand-tuned converter? Try the autogenerated ones. */
         if (filter == NULL) {
@@ -895,6 +871,108 @@ SDL_BuildAudioTypeCVT(SDL_AudioCVT * cvt,
 }
 
 
+/* Add the filters that change the channel count, if necessary. Updates
+   (cvt), and returns the number of channels the filters end up with. */
+static int
+SDL_BuildAudioChannelCVT(SDL_AudioCVT * cvt, int src_channels, int dst_channels)
+{
+    if ((src_channels == 1) && (dst_channels > 1)) {
+        cvt->filters[cvt->filter_index++] = SDL_ConvertStereo;
+        cvt->len_mult *= 2;
+        src_channels = 2;
+        cvt->len_ratio *= 2;
+    }
+    if ((src_channels == 2) && (dst_channels == 6)) {
+        cvt->filters[cvt->filter_index++] = SDL_ConvertSurround;
+        src_channels = 6;
+        cvt->len_mult *= 3;
+        cvt->len_ratio *= 3;
+    }
+    if ((src_channels == 2) && (dst_channels == 4)) {
+        cvt->filters[cvt->filter_index++] = SDL_ConvertSurround_4;
+        src_channels = 4;
+        cvt->len_mult *= 2;
+        cvt->len_ratio *= 2;
+    }
+    while ((src_channels * 2) <= dst_channels) {
+        cvt->filters[cvt->filter_index++] = SDL_ConvertStereo;
+        cvt->len_mult *= 2;
+        src_channels *= 2;
+        cvt->len_ratio *= 2;
+    }
+    if ((src_channels == 6) && (dst_channels <= 2)) {
+        cvt->filters[cvt->filter_index++] = SDL_ConvertStrip;
+        src_channels = 2;
+        cvt->len_ratio /= 3;
+    }
+    if ((src_channels == 6) && (dst_channels == 4)) {
+        cvt->filters[cvt->filter_index++] = SDL_ConvertStrip_2;
+        src_channels = 4;
+        cvt->len_ratio /= 2;
+    }
+    /* This assumes that 4 channel audio is in the format:
+       Left {front/back} + Right {front/back}
+       so converting to L/R stereo works properly.
+     */
+    while (((src_channels % 2) == 0) &&
+           ((src_channels / 2) >= dst_channels)) {
+        cvt->filters[cvt->filter_index++] = SDL_ConvertMono;
+        src_channels /= 2;
+        cvt->len_ratio /= 2;
+    }
+    if (src_channels != dst_channels) {
+        /* Uh oh.. */ ;
+    }
+    return src_channels;
+}
+
+
+/*
+ * Find a converter that changes both the data type and the channel count
+ *  in one pass, so the data only goes through memory once.
+ */
+static int
+SDL_BuildAudioRemixCVT(SDL_AudioCVT * cvt,
+                       SDL_AudioFormat src_fmt, int src_channels,
+                       SDL_AudioFormat dst_fmt, int dst_channels)
+{
+    const Uint16 src_bitsize = SDL_AUDIO_BITSIZE(src_fmt);
+    const Uint16 dst_bitsize = SDL_AUDIO_BITSIZE(dst_fmt);
+    SDL_AudioFilter filter;
+
+    if (src_fmt == dst_fmt || src_channels == dst_channels) {
+        return 0;
+    }
+
+    /* Only the vectorized ones; without them, the separate filters get
+       run a block at a time by SDL_ConvertAudio(), which keeps the data
+       in the cache just as well. */
+    filter = SDL_ChooseAudioRemixCVT(src_fmt, src_channels, dst_fmt, dst_channels, cvt->dst_format);
+    if (filter == NULL) {
+        return 0;
+    }
+
+    /* Update (cvt) the way the two filters this replaces would have */
+    cvt->filters[cvt->filter_index++] = filter;
+    if (src_bitsize < dst_bitsize) {
+        const int mult = (dst_bitsize / src_bitsize);
+        cvt->len_mult *= mult;
+        cvt->len_ratio *= mult;
+    } else if (src_bitsize > dst_bitsize) {
+        cvt->len_ratio /= (src_bitsize / dst_bitsize);
+    }
+    if (src_channels < dst_channels) {
+        const int mult = (dst_channels / src_channels);
+        cvt->len_mult *= mult;
+        cvt->len_ratio *= mult;
+    } else {
+        cvt->len_ratio /= (src_channels / dst_channels);
+    }
+
+    return 1;                   /* added a converter. */
+}
+
+
 static SDL_AudioFilter
 SDL_HandTunedResampleCVT(SDL_AudioCVT * cvt, int dst_channels,
                          int src_rate, int dst_rate)
@@ -988,6 +1066,312 @@ SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, int dst_channels,
     return 0;                   /* no conversion necessary. */
 }
 
+/* Recover the ratio of rates an SDL_AudioCVT was built for from its
+   rate_incr: the first convergent of the continued fraction that matches
+   it. Real rates are far enough apart that no other one can. */
+static void
+SDL_GetResampleRatio(const double ratio, int *src_rate, int *dst_rate)
+{
+    Sint64 h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+    double x = ratio;
+    int i;
+
+    for (i = 0; i < 64; i++) {
+        const double a = SDL_floor(x);
+        const Sint64 h2 = (Sint64) a * h1 + h0;
+        const Sint64 k2 = (Sint64) a * k1 + k0;
+        if (h2 > 0x7FFFFFFF || k2 > 0x7FFFFFFF) {
+            break;
+        }
+        h0 = h1;
+        h1 = h2;
+        k0 = k1;
+        k1 = k2;
+        if (SDL_fabs(((double) h1 / (double) k1) - ratio) <= ratio * 1e-14 || x == a) {
+            break;
+        }
+        x = 1.0 / (x - a);
+    }
+
+    *dst_rate = (int) SDL_max(h1, 1);
+    *src_rate = (int) SDL_max(k1, 1);
+}
+
+/* Windowed sinc resampling of native float data. The output is made after
+   the input in cvt->buf, then moved down to the start; input beyond either
+   end of the buffer is taken as silence. */
+static void
+SDL_ResampleCVT(SDL_AudioCVT * cvt, SDL_AudioFormat format, const int channels, const int quality)
+{
+    const int framesize = channels * sizeof (float);
+    const int inframes = cvt->len_cvt / framesize;
+    const int outframes = (int) (((double) inframes) * cvt->rate_incr);
+    const float *src = (const float *) cvt->buf;
+    float *dst = (float *) (cvt->buf + inframes * framesize);
+    SDL_ResampleFilter *filter;
+    int src_rate, dst_rate;
+    int pos = 0;
+    Uint32 phase = 0;
+    int i = 0;
+
+    SDL_GetResampleRatio(cvt->rate_incr, &src_rate, &dst_rate);
+    filter = SDL_AcquireResampleFilter(src_rate, dst_rate, quality);
+    if (filter) {
+        while (i < outframes) {
+            if ((pos < filter->half_taps - 1) || (pos + filter->half_taps >= inframes)) {
+                SDL_ResampleAudioFrameClipped(filter, channels, src, inframes, pos, phase, dst + i * channels);
+                SDL_StepResampleAudio(filter, &pos, &phase);
+                i++;
+            } else {
+                i += SDL_ResampleAudio(filter, channels, src, inframes, &pos, &phase,
+                                       dst + i * channels, outframes - i);
+            }
+        }
+        SDL_ReleaseResampleFilter(filter);
+    } else {
+        /* No memory for the filter table, interpolate linearly instead */
+        for (i = 0; i < outframes; i++) {
+            const double t = ((double) i) / cvt->rate_incr;
+            const int a = (int) t;
+            const int b = SDL_min(a + 1, inframes - 1);
+            const float frac = (float) (t - a);
+            int chan;
+            for (chan = 0; chan < channels; chan++) {
+                const float sa = src[a * channels + chan];
+                dst[i * channels + chan] = sa + (src[b * channels + chan] - sa) * frac;
+            }
+        }
+    }
+
+    SDL_memmove(cvt->buf, dst, outframes * framesize);
+    cvt->len_cvt = outframes * framesize;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+#define SDL_RESAMPLE_CVT(quality, chans) \
+    static void SDLCALL \
+    SDL_ResampleCVT_##quality##_c##chans(SDL_AudioCVT * cvt, SDL_AudioFormat format) \
+    { \
+        SDL_ResampleCVT(cvt, format, chans, SDL_RESAMPLE_##quality); \
+    }
+SDL_RESAMPLE_CVT(MEDIUM, 1)
+SDL_RESAMPLE_CVT(MEDIUM, 2)
+SDL_RESAMPLE_CVT(MEDIUM, 3)
+SDL_RESAMPLE_CVT(MEDIUM, 4)
+SDL_RESAMPLE_CVT(MEDIUM, 5)
+SDL_RESAMPLE_CVT(MEDIUM, 6)
+SDL_RESAMPLE_CVT(MEDIUM, 7)
+SDL_RESAMPLE_CVT(MEDIUM, 8)
+SDL_RESAMPLE_CVT(BEST, 1)
+SDL_RESAMPLE_CVT(BEST, 2)
+SDL_RESAMPLE_CVT(BEST, 3)
+SDL_RESAMPLE_CVT(BEST, 4)
+SDL_RESAMPLE_CVT(BEST, 5)
+SDL_RESAMPLE_CVT(BEST, 6)
+SDL_RESAMPLE_CVT(BEST, 7)
+SDL_RESAMPLE_CVT(BEST, 8)
+#undef SDL_RESAMPLE_CVT
+
+static const SDL_AudioFilter SDL_resample_cvt_filters[2][8] = {
+    { SDL_ResampleCVT_MEDIUM_c1, SDL_ResampleCVT_MEDIUM_c2, SDL_ResampleCVT_MEDIUM_c3,
+      SDL_ResampleCVT_MEDIUM_c4, SDL_ResampleCVT_MEDIUM_c5, SDL_ResampleCVT_MEDIUM_c6,
+      SDL_ResampleCVT_MEDIUM_c7, SDL_ResampleCVT_MEDIUM_c8 },
+    { SDL_ResampleCVT_BEST_c1, SDL_ResampleCVT_BEST_c2, SDL_ResampleCVT_BEST_c3,
+      SDL_ResampleCVT_BEST_c4, SDL_ResampleCVT_BEST_c5, SDL_ResampleCVT_BEST_c6,
+      SDL_ResampleCVT_BEST_c7, SDL_ResampleCVT_BEST_c8 }
+};
+
+/* Add a sinc resampler for AUDIO_F32SYS data */
+static int
+SDL_BuildAudioSincResampleCVT(SDL_AudioCVT * cvt, int dst_channels,
+                              int src_rate, int dst_rate, int quality)
+{
+    /* Build the filter table now, so a lack of memory shows up here */
+    SDL_ResampleFilter *filter = SDL_AcquireResampleFilter(src_rate, dst_rate, quality);
+    if (filter == NULL) {
+        return -1;
+    }
+    SDL_ReleaseResampleFilter(filter);
+
+    if (dst_channels > 8) {
+        return SDL_SetError("No conversion available for these rates");
+    }
+    cvt->filters[cvt->filter_index++] = SDL_resample_cvt_filters[quality - SDL_RESAMPLE_MEDIUM][dst_channels - 1];
+
+    /* The output is made after the input in the buffer */
+    if (src_rate < dst_rate) {
+        const double mult = ((double) dst_rate) / ((double) src_rate);
+        cvt->len_mult *= 1 + (int) SDL_ceil(mult);
+        cvt->len_ratio *= mult;
+    } else {
+        cvt->len_mult *= 2;
+        cvt->len_ratio /= ((double) src_rate) / ((double) dst_rate);
+    }
+    return 1;
+}
+
+
+/* SDL_ConvertAudio() takes large buffers through the filters a block at a
+   time, instead of passing the whole buffer through each filter in turn.
+   Every filter but the resamplers converts each sample frame on its own,
+   so a block can go through a run of them in a scratch buffer that stays
+   in the cache, and be written back before the next one is read. Blocks
+   are a whole number of frames of any format with up to 8 channels. */
+#define SDL_AUDIO_BLOCK_UNIT        (32 * 3 * 5 * 7)
+#define SDL_AUDIO_BLOCK_WORKING_SET (24 * 1024)
+
+static SDL_bool
+SDL_IsResampleFilter(SDL_AudioFilter filter)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_resample_cvt_filters[0]); i++) {
+        if (filter == SDL_resample_cvt_filters[0][i] || filter == SDL_resample_cvt_filters[1][i]) {
+            return SDL_TRUE;
+        }
+    }
+    for (i = 0; sdl_audio_rate_filters[i].filter != NULL; i++) {
+        if (filter == sdl_audio_rate_filters[i].filter) {
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Ends the filter chain of a copy made by SDL_RunAudioFilters(), keeping
+   the format the data ended up in. */
+static void SDLCALL
+SDL_EndAudioFilterRun(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    cvt->src_format = format;
+}
+
+/* Run (count) of the filters in (cvt), starting at (first), over (len)
+   bytes at (buf). (*format) is the format of the data going in, and is
+   updated to the format coming out. Returns the converted length. */
+static int
+SDL_RunAudioFilters(const SDL_AudioCVT * cvt, int first, int count,
+                    Uint8 * buf, int len, SDL_AudioFormat * format)
+{
+    SDL_AudioCVT run = *cvt;
+
+    SDL_memcpy(run.filters, &cvt->filters[first], count * sizeof (SDL_AudioFilter));
+    run.filters[count] = SDL_EndAudioFilterRun;
+    run.filter_index = 0;
+    run.buf = buf;
+    run.len_cvt = len;
+    run.filters[0] (&run, *format);
+
+    *format = run.src_format;
+    return run.len_cvt;
+}
+
+/* Run (count) frame by frame filters over all of cvt->buf, (block) bytes at
+   a time, through (scratch). Shrinking runs go from the start of the buffer
+   and growing ones from the end, so no block is overwritten before it has
+   been read. */
+static void
+SDL_RunAudioFiltersBlocked(SDL_AudioCVT * cvt, int first, int count,
+                           SDL_AudioFormat * format, Uint8 * scratch, int block)
+{
+    const SDL_AudioFormat in_format = *format;
+    const int len = cvt->len_cvt;
+    const int blocks = (len + block - 1) / block;
+    int outblock, outlen, i;
+
+    /* All but the last block are full, and grow or shrink the same */
+    SDL_memcpy(scratch, cvt->buf, block);
+    outblock = SDL_RunAudioFilters(cvt, first, count, scratch, block, format);
+
+    if (outblock <= block) {
+        SDL_memcpy(cvt->buf, scratch, outblock);
+        outlen = outblock;
+        for (i = 1; i < blocks; i++) {
+            const int inlen = SDL_min(block, len - i * block);
+            SDL_AudioFormat fmt = in_format;
+            int n;
+            SDL_memcpy(scratch, cvt->buf + i * block, inlen);
+            n = SDL_RunAudioFilters(cvt, first, count, scratch, inlen, &fmt);
+            SDL_memcpy(cvt->buf + outlen, scratch, n);
+            outlen += n;
+        }
+    } else {
+        /* The first block gets converted again, last */
+        outlen = 0;
+        for (i = blocks - 1; i >= 0; i--) {
+            const int inlen = SDL_min(block, len - i * block);
+            SDL_AudioFormat fmt = in_format;
+            int n;
+            SDL_memcpy(scratch, cvt->buf + i * block, inlen);
+            n = SDL_RunAudioFilters(cvt, first, count, scratch, inlen, &fmt);
+            SDL_memcpy(cvt->buf + i * outblock, scratch, n);
+            if (outlen == 0) {
+                outlen = i * outblock + n;
+            }
+        }
+    }
+    cvt->len_cvt = outlen;
+}
+
+int
+SDL_ConvertAudio(SDL_AudioCVT * cvt)
+{
+    SDL_AudioFormat format;
+    Uint8 *scratch = NULL;
+    int block, first, last;
+
+    /* !!! FIXME: (cvt) should be const; stack-copy it here. */
+    /* !!! FIXME: (actually, we can't...len_cvt needs to be updated. Grr.) */
+
+    /* Make sure there's data to convert */
+    if (cvt->buf == NULL) {
+        SDL_SetError("No buffer allocated for conversion");
+        return (-1);
+    }
+    /* Return okay if no conversion is necessary */
+    cvt->len_cvt = cvt->len;
+    if (cvt->filters[0] == NULL) {
+        return (0);
+    }
+
+    /* Buffers this small stay in the cache anyway, set up the conversion and go! */
+    block = SDL_AUDIO_BLOCK_UNIT * SDL_max(1, SDL_AUDIO_BLOCK_WORKING_SET / (SDL_AUDIO_BLOCK_UNIT * SDL_max(cvt->len_mult, 1)));
+    if (cvt->len < 2 * block) {
+        cvt->filter_index = 0;
+        cvt->filters[0] (cvt, cvt->src_format);
+        return (0);
+    }
+
+    /* Otherwise go through each run of frame by frame filters in blocks,
+       and through each resampler in one go. */
+    format = cvt->src_format;
+    first = 0;
+    while (first < SDL_arraysize(cvt->filters) && cvt->filters[first]) {
+        last = first + 1;
+        if (!SDL_IsResampleFilter(cvt->filters[first])) {
+            while (last < SDL_arraysize(cvt->filters) && cvt->filters[last] &&
+                   !SDL_IsResampleFilter(cvt->filters[last])) {
+                last++;
+            }
+        }
+        if ((last - first) > 1 && cvt->len_cvt >= 2 * block && scratch == NULL) {
+            scratch = (Uint8 *) SDL_malloc(block * SDL_max(cvt->len_mult, 1));
+        }
+        if ((last - first) > 1 && cvt->len_cvt >= 2 * block && scratch != NULL) {
+            SDL_RunAudioFiltersBlocked(cvt, first, last - first, &format, scratch, block);
+        } else {
+            cvt->len_cvt = SDL_RunAudioFilters(cvt, first, last - first, cvt->buf, cvt->len_cvt, &format);
+        }
+        first = last;
+    }
+    cvt->filter_index = first;
+
+    SDL_free(scratch);
+    return (0);
+}
+
 
 /* Creates a set of audio filters to convert from one format to another.
    Returns -1 if the format conversion is not supported, 0 if there's
@@ -999,6 +1383,9 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
                   SDL_AudioFormat src_fmt, Uint8 src_channels, int src_rate,
                   SDL_AudioFormat dst_fmt, Uint8 dst_channels, int dst_rate)
 {
+    SDL_AudioFormat work_fmt = dst_fmt;
+    int quality = SDL_RESAMPLE_FAST;
+
     /*
      * !!! FIXME: reorder filters based on which grow/shrink the buffer.
      * !!! FIXME: ideally, we should do everything that shrinks the buffer
@@ -1043,64 +1430,40 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
     cvt->len_ratio = 1.0;
     cvt->rate_incr = ((double) dst_rate) / ((double) src_rate);
 
-    /* Convert data types, if necessary. Updates (cvt). */
-    if (SDL_BuildAudioTypeCVT(cvt, src_fmt, dst_fmt) == -1) {
-        return -1;              /* shouldn't happen, but just in case... */
+    /* The sinc resamplers work on floats, so the channels and rate are
+       converted between two type conversions. They cost the same for every
+       channel, so new channels are only added after resampling. */
+    if (src_rate != dst_rate) {
+        quality = SDL_GetResampleQuality();
+        if (quality != SDL_RESAMPLE_FAST) {
+            work_fmt = AUDIO_F32SYS;
+        }
     }
 
-    /* Channel conversion */
-    if (src_channels != dst_channels) {
-        if ((src_channels == 1) && (dst_channels > 1)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertStereo;
-            cvt->len_mult *= 2;
-            src_channels = 2;
-            cvt->len_ratio *= 2;
-        }
-        if ((src_channels == 2) && (dst_channels == 6)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertSurround;
-            src_channels = 6;
-            cvt->len_mult *= 3;
-            cvt->len_ratio *= 3;
-        }
-        if ((src_channels == 2) && (dst_channels == 4)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertSurround_4;
-            src_channels = 4;
-            cvt->len_mult *= 2;
-            cvt->len_ratio *= 2;
-        }
-        while ((src_channels * 2) <= dst_channels) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertStereo;
-            cvt->len_mult *= 2;
-            src_channels *= 2;
-            cvt->len_ratio *= 2;
-        }
-        if ((src_channels == 6) && (dst_channels <= 2)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertStrip;
-            src_channels = 2;
-            cvt->len_ratio /= 3;
-        }
-        if ((src_channels == 6) && (dst_channels == 4)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertStrip_2;
-            src_channels = 4;
-            cvt->len_ratio /= 2;
-        }
-        /* This assumes that 4 channel audio is in the format:
-           Left {front/back} + Right {front/back}
-           so converting to L/R stereo works properly.
-         */
-        while (((src_channels % 2) == 0) &&
-               ((src_channels / 2) >= dst_channels)) {
-            cvt->filters[cvt->filter_index++] = SDL_ConvertMono;
-            src_channels /= 2;
-            cvt->len_ratio /= 2;
-        }
-        if (src_channels != dst_channels) {
-            /* Uh oh.. */ ;
+    /* Convert data types, if necessary, along with the channels if there's
+       a converter that does both at once. Updates (cvt). */
+    if (quality != SDL_RESAMPLE_FAST && src_channels < dst_channels) {
+        if (SDL_BuildAudioTypeCVT(cvt, src_fmt, work_fmt) == -1) {
+            return -1;
         }
+    } else if (SDL_BuildAudioRemixCVT(cvt, src_fmt, src_channels, work_fmt, dst_channels)) {
+        src_channels = dst_channels;
+    } else if (SDL_BuildAudioTypeCVT(cvt, src_fmt, work_fmt) == -1) {
+        return -1;              /* shouldn't happen, but just in case... */
+    } else {
+        src_channels = SDL_BuildAudioChannelCVT(cvt, src_channels, dst_channels);
     }
 
     /* Do rate conversion, if necessary. Updates (cvt). */
-    if (SDL_BuildAudioResampleCVT(cvt, dst_channels, src_rate, dst_rate) ==
+    if (quality != SDL_RESAMPLE_FAST) {
+        if (SDL_BuildAudioSincResampleCVT(cvt, src_channels, src_rate, dst_rate, quality) == -1) {
+            return -1;
+        }
+        SDL_BuildAudioChannelCVT(cvt, src_channels, dst_channels);
+        if (SDL_BuildAudioTypeCVT(cvt, work_fmt, dst_fmt) == -1) {
+            return -1;
+        }
+    } else if (SDL_BuildAudioResampleCVT(cvt, dst_channels, src_rate, dst_rate) ==
         -1) {
         return -1;              /* shouldn't happen, but just in case... */
     }
@@ -1118,4 +1481,544 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
 }
 
 
+/* Streaming conversion.
+
+   An SDL_AudioStream converts data as it trickles in. Whole input sample
+   frames are type/channel converted with an SDL_AudioCVT, resampled (if
+   the rates differ), converted again to the output type, and appended to
+   a FIFO that callers pull exact amounts from. The resampler is a sinc
+   filter that keeps the input frames its window still covers between
+   calls, or with SDL_HINT_AUDIO_RESAMPLING_MODE set to "fast", a linear
+   one that keeps its last input frame and its fractional position.
+   Partial input frames wait in a staging buffer until the rest of the
+   frame arrives. All buffers are reused between calls.
+
+   Resampling is done on native-endian float data. The resampler position
+   is kept as an integer frame index plus a fraction in units of
+   1/dst_rate, so no error accumulates over long streams.
+ */
+
+#define SDL_AUDIOSTREAM_MAX_FRAME_SIZE (8 * sizeof (float))
+
+struct _SDL_AudioStream
+{
+    SDL_AudioCVT cvt_before_resampling;
+    SDL_AudioCVT cvt_after_resampling;
+    SDL_AudioFormat src_format;
+    Uint8 src_channels;
+    int src_rate;
+    SDL_AudioFormat dst_format;
+    Uint8 dst_channels;
+    int dst_rate;
+    int src_sample_frame_size;
+    int dst_sample_frame_size;
+
+    /* Input bytes that don't make up a whole sample frame yet */
+    Uint8 staging_buffer[SDL_AUDIOSTREAM_MAX_FRAME_SIZE];
+    int staging_buffer_filled;
+
+    /* Scratch space for the conversion ahead of the resampler */
+    Uint8 *work_buffer;
+    int work_buffer_len;
+
+    /* Resampler state: the last input frame, and the position of the next
+       output frame as (resample_pos + resample_frac / dst_rate) in input
+       frames, where frame 0 is resampler_history. */
+    SDL_bool resampling;
+    int resample_step_int;
+    int resample_step_frac;
+    int resample_pos;
+    int resample_frac;
+    SDL_bool have_history;
+    float resampler_history[8];
+
+    /* Sinc resampler state: the input frames the filter window still
+       covers, starting with silence. The next output frame is at buffer
+       frame resample_pos, phase resample_phase. */
+    SDL_ResampleFilter *resample_filter;
+    float *resample_buffer;
+    int resample_buffer_frames;
+    int resample_buffer_alloc;
+    Uint32 resample_phase;
+
+    /* Converted output waiting to be read */
+    Uint8 *queue;
+    int queue_head;
+    int queue_tail;
+    int queue_alloc;
+};
+
+static void
+SDL_ResetAudioStreamResampler(SDL_AudioStream *stream)
+{
+    if (stream->resample_filter) {
+        /* Start on the first input frame, with silence before it. The
+           buffer always has room for this much. */
+        const int history = stream->resample_filter->half_taps - 1;
+        SDL_memset(stream->resample_buffer, 0, history * stream->dst_channels * sizeof (float));
+        stream->resample_buffer_frames = history;
+        stream->resample_pos = history;
+        stream->resample_phase = 0;
+        return;
+    }
+
+    /* Start exactly on the first input frame; the history isn't used until
+       a whole chunk has gone through. */
+    stream->resample_pos = 1;
+    stream->resample_frac = 0;
+    stream->have_history = SDL_FALSE;
+}
+
+/* Make room for (len) more bytes at the end of the output queue */
+static Uint8 *
+SDL_ReserveAudioStreamQueue(SDL_AudioStream *stream, int len)
+{
+    const int queued = stream->queue_tail - stream->queue_head;
+
+    if (stream->queue_tail + len > stream->queue_alloc) {
+        if (stream->queue_head > 0) {
+            SDL_memmove(stream->queue, stream->queue + stream->queue_head, queued);
+            stream->queue_head = 0;
+            stream->queue_tail = queued;
+        }
+        if (queued + len > stream->queue_alloc) {
+            int alloc = SDL_max(stream->queue_alloc * 2, queued + len);
+            Uint8 *ptr = (Uint8 *) SDL_realloc(stream->queue, alloc);
+            if (ptr == NULL) {
+                SDL_OutOfMemory();
+                return NULL;
+            }
+            stream->queue = ptr;
+            stream->queue_alloc = alloc;
+        }
+    }
+    return stream->queue + stream->queue_tail;
+}
+
+static Uint8 *
+SDL_EnsureAudioStreamWorkBuffer(SDL_AudioStream *stream, int len)
+{
+    if (len > stream->work_buffer_len) {
+        Uint8 *ptr = (Uint8 *) SDL_realloc(stream->work_buffer, len);
+        if (ptr == NULL) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        stream->work_buffer = ptr;
+        stream->work_buffer_len = len;
+    }
+    return stream->work_buffer;
+}
+
+/* Make room for (len) more bytes at the end of the sinc resampler's input */
+static float *
+SDL_ReserveAudioStreamResampleBuffer(SDL_AudioStream *stream, int len)
+{
+    const int framesize = stream->dst_channels * sizeof (float);
+    const int frames = stream->resample_buffer_frames + (len + framesize - 1) / framesize;
+
+    if (frames > stream->resample_buffer_alloc) {
+        const int alloc = SDL_max(stream->resample_buffer_alloc * 2, frames);
+        float *ptr = (float *) SDL_realloc(stream->resample_buffer, alloc * framesize);
+        if (ptr == NULL) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        stream->resample_buffer = ptr;
+        stream->resample_buffer_alloc = alloc;
+    }
+    return stream->resample_buffer + stream->resample_buffer_frames * stream->dst_channels;
+}
+
+/* Sinc resample what the buffered input allows onto the output queue,
+   then drop the input frames no later output frame needs. */
+static int
+SDL_ResampleAudioStreamSinc(SDL_AudioStream *stream)
+{
+    const SDL_ResampleFilter *filter = stream->resample_filter;
+    const int chans = (int) stream->dst_channels;
+    const int resampled_frame_size = (int) (chans * sizeof (float));
+    const int available = stream->resample_buffer_frames - stream->resample_pos;
+    SDL_AudioCVT *cvt = &stream->cvt_after_resampling;
+    Sint64 maxframes;
+    float *resampled;
+    int outframes, consumed;
+
+    if (available <= 0) {
+        return 0;
+    }
+    maxframes = (((Sint64) available * stream->dst_rate) / stream->src_rate) + 2;
+    if (maxframes * resampled_frame_size > 0x7FFFFFFF) {
+        return SDL_SetError("Audio stream input too large");
+    }
+    resampled = (float *) SDL_ReserveAudioStreamQueue(stream, (int) maxframes * resampled_frame_size);
+    if (resampled == NULL) {
+        return -1;
+    }
+
+    outframes = SDL_ResampleAudio(filter, chans, stream->resample_buffer, stream->resample_buffer_frames,
+                                  &stream->resample_pos, &stream->resample_phase,
+                                  resampled, (int) maxframes);
+    cvt->buf = (Uint8 *) resampled;
+    cvt->len = outframes * resampled_frame_size;
+    SDL_ConvertAudio(cvt);
+    stream->queue_tail += cvt->len_cvt;
+
+    consumed = stream->resample_pos - (filter->half_taps - 1);
+    if (consumed > 0) {
+        stream->resample_buffer_frames -= consumed;
+        stream->resample_pos -= consumed;
+        SDL_memmove(stream->resample_buffer, stream->resample_buffer + consumed * chans,
+                    stream->resample_buffer_frames * resampled_frame_size);
+    }
+    return 0;
+}
+
+/* Linear interpolation between consecutive input frames, carrying the
+   last frame and the fractional position over to the next call. */
+static int
+SDL_ResampleAudioStream(SDL_AudioStream *stream, const float *inbuf,
+                        int inframes, float *outbuf)
+{
+    const int chans = (int) stream->dst_channels;
+    const int dst_rate = stream->dst_rate;
+    const float scale = 1.0f / (float) dst_rate;
+    int pos = stream->resample_pos;
+    int frac = stream->resample_frac;
+    float *dst = outbuf;
+    int chan;
+
+    while (pos < inframes) {
+        const float *a = (pos == 0) ? stream->resampler_history : inbuf + (pos - 1) * chans;
+        const float *b = inbuf + pos * chans;
+        const float t = (float) frac * scale;
+        for (chan = 0; chan < chans; chan++) {
+            dst[chan] = a[chan] + ((b[chan] - a[chan]) * t);
+        }
+        dst += chans;
+
+        pos += stream->resample_step_int;
+        frac += stream->resample_step_frac;
+        if (frac >= dst_rate) {
+            frac -= dst_rate;
+            pos++;
+        }
+    }
+
+    if (inframes > 0) {
+        SDL_memcpy(stream->resampler_history, inbuf + (inframes - 1) * chans,
+                   chans * sizeof (float));
+        stream->have_history = SDL_TRUE;
+        pos -= inframes;
+    }
+    stream->resample_pos = pos;
+    stream->resample_frac = frac;
+
+    return (int) ((dst - outbuf) / chans);
+}
+
+/* Convert (len) bytes of whole source sample frames onto the output queue */
+static int
+SDL_AudioStreamPutFrames(SDL_AudioStream *stream, const Uint8 *buf, int len)
+{
+    SDL_AudioCVT *cvt = &stream->cvt_before_resampling;
+    const int resampled_frame_size = (int) (stream->dst_channels * sizeof (float));
+    Sint64 maxframes;
+    float *resampled;
+    int inframes, outframes;
+
+    if (len == 0) {
+        return 0;
+    } else if (len > (0x7FFFFFFF / cvt->len_mult)) {
+        return SDL_SetError("Audio stream input too large");
+    }
+
+    if (!stream->resampling) {
+        /* Convert straight into the queue */
+        Uint8 *ptr = SDL_ReserveAudioStreamQueue(stream, len * cvt->len_mult);
+        if (ptr == NULL) {
+            return -1;
+        }
+        SDL_memcpy(ptr, buf, len);
+        cvt->buf = ptr;
+        cvt->len = len;
+        SDL_ConvertAudio(cvt);
+        stream->queue_tail += cvt->len_cvt;
+        return 0;
+    }
+
+    if (stream->resample_filter) {
+        /* Convert straight onto the end of the resampler's input */
+        cvt->buf = (Uint8 *) SDL_ReserveAudioStreamResampleBuffer(stream, len * cvt->len_mult);
+        if (cvt->buf == NULL) {
+            return -1;
+        }
+        SDL_memcpy(cvt->buf, buf, len);
+        cvt->len = len;
+        SDL_ConvertAudio(cvt);
+        stream->resample_buffer_frames += cvt->len_cvt / resampled_frame_size;
+        return SDL_ResampleAudioStreamSinc(stream);
+    }
+
+    cvt->buf = SDL_EnsureAudioStreamWorkBuffer(stream, len * cvt->len_mult);
+    if (cvt->buf == NULL) {
+        return -1;
+    }
+    SDL_memcpy(cvt->buf, buf, len);
+    cvt->len = len;
+    SDL_ConvertAudio(cvt);
+    inframes = cvt->len_cvt / resampled_frame_size;
+
+    /* Resample into the queue, then convert from float in place there;
+       the second conversion never grows the data. */
+    maxframes = (((Sint64) inframes * stream->dst_rate) / stream->src_rate) + 2;
+    if (maxframes * resampled_frame_size > 0x7FFFFFFF) {
+        return SDL_SetError("Audio stream input too large");
+    }
+    resampled = (float *) SDL_ReserveAudioStreamQueue(stream, (int) maxframes * resampled_frame_size);
+    if (resampled == NULL) {
+        return -1;
+    }
+    outframes = SDL_ResampleAudioStream(stream, (const float *) cvt->buf, inframes, resampled);
+    SDL_assert(outframes <= maxframes);
+
+    cvt = &stream->cvt_after_resampling;
+    cvt->buf = (Uint8 *) resampled;
+    cvt->len = outframes * resampled_frame_size;
+    SDL_ConvertAudio(cvt);
+    SDL_assert(cvt->len_cvt <= cvt->len);
+    stream->queue_tail += cvt->len_cvt;
+    return 0;
+}
+
+SDL_AudioStream *
+SDL_NewAudioStream(const SDL_AudioFormat src_format,
+                   const Uint8 src_channels,
+                   const int src_rate,
+                   const SDL_AudioFormat dst_format,
+                   const Uint8 dst_channels,
+                   const int dst_rate)
+{
+    SDL_AudioStream *stream;
+    int quality;
+    int rc;
+
+    if ((src_channels == 0) || (dst_channels == 0) ||
+        (src_channels > 8) || (dst_channels > 8)) {
+        SDL_SetError("Unsupported number of audio channels");
+        return NULL;
+    }
+    if ((src_rate <= 0) || (dst_rate <= 0)) {
+        SDL_SetError("Source or destination rate is zero");
+        return NULL;
+    }
+
+    stream = (SDL_AudioStream *) SDL_calloc(1, sizeof (SDL_AudioStream));
+    if (stream == NULL) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    stream->src_format = src_format;
+    stream->src_channels = src_channels;
+    stream->src_rate = src_rate;
+    stream->dst_format = dst_format;
+    stream->dst_channels = dst_channels;
+    stream->dst_rate = dst_rate;
+    stream->src_sample_frame_size = (SDL_AUDIO_BITSIZE(src_format) / 8) * src_channels;
+    stream->dst_sample_frame_size = (SDL_AUDIO_BITSIZE(dst_format) / 8) * dst_channels;
+    stream->resampling = (src_rate != dst_rate) ? SDL_TRUE : SDL_FALSE;
+
+    if (!stream->resampling) {
+        /* One conversion does it all, exactly like SDL_ConvertAudio(). */
+        rc = SDL_BuildAudioCVT(&stream->cvt_before_resampling,
+                               src_format, src_channels, src_rate,
+                               dst_format, dst_channels, dst_rate);
+    } else {
+        stream->resample_step_int = src_rate / dst_rate;
+        stream->resample_step_frac = src_rate % dst_rate;
+
+        rc = 0;
+        quality = SDL_GetResampleQuality();
+        if (quality != SDL_RESAMPLE_FAST) {
+            stream->resample_filter = SDL_AcquireResampleFilter(src_rate, dst_rate, quality);
+            if (stream->resample_filter == NULL ||
+                SDL_ReserveAudioStreamResampleBuffer(stream, stream->resample_filter->taps * dst_channels * sizeof (float)) == NULL) {
+                rc = -1;
+            }
+        }
+        if (rc == 0) {
+            SDL_ResetAudioStreamResampler(stream);
+            rc = SDL_BuildAudioCVT(&stream->cvt_before_resampling,
+                                   src_format, src_channels, src_rate,
+                                   AUDIO_F32SYS, dst_channels, src_rate);
+        }
+        if (rc >= 0) {
+            rc = SDL_BuildAudioCVT(&stream->cvt_after_resampling,
+                                   AUDIO_F32SYS, dst_channels, dst_rate,
+                                   dst_format, dst_channels, dst_rate);
+        }
+    }
+
+    if (rc < 0) {
+        SDL_FreeAudioStream(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+int
+SDL_AudioStreamPut(SDL_AudioStream *stream, const void *buf, int len)
+{
+    const Uint8 *ptr = (const Uint8 *) buf;
+    const int framesize = stream ? stream->src_sample_frame_size : 0;
+    int wholelen;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    /* Finish off a sample frame left over from last time */
+    if (stream->staging_buffer_filled > 0) {
+        const int cpy = SDL_min(len, framesize - stream->staging_buffer_filled);
+        SDL_memcpy(stream->staging_buffer + stream->staging_buffer_filled, ptr, cpy);
+        stream->staging_buffer_filled += cpy;
+        ptr += cpy;
+        len -= cpy;
+        if (stream->staging_buffer_filled < framesize) {
+            return 0;
+        }
+        stream->staging_buffer_filled = 0;
+        if (SDL_AudioStreamPutFrames(stream, stream->staging_buffer, framesize) < 0) {
+            return -1;
+        }
+    }
+
+    wholelen = len - (len % framesize);
+    if (SDL_AudioStreamPutFrames(stream, ptr, wholelen) < 0) {
+        return -1;
+    }
+
+    /* Keep any partial sample frame for next time */
+    SDL_memcpy(stream->staging_buffer, ptr + wholelen, len - wholelen);
+    stream->staging_buffer_filled = len - wholelen;
+
+    return 0;
+}
+
+int
+SDL_AudioStreamFlush(SDL_AudioStream *stream)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    /* A partial sample frame can't be converted, drop it */
+    stream->staging_buffer_filled = 0;
+
+    if (stream->resample_filter) {
+        /* Follow the input with silence, enough for the window of every
+           output frame before the end of the input. */
+        const int padding = stream->resample_filter->half_taps * stream->dst_channels * sizeof (float);
+        float *ptr = SDL_ReserveAudioStreamResampleBuffer(stream, padding);
+        if (ptr == NULL) {
+            return -1;
+        }
+        SDL_memset(ptr, 0, padding);
+        stream->resample_buffer_frames += stream->resample_filter->half_taps;
+        if (SDL_ResampleAudioStreamSinc(stream) < 0) {
+            return -1;
+        }
+    } else if (stream->resampling && stream->have_history) {
+        /* Repeat the last input frame so the output frames that fall
+           between it and the (missing) next one come out too. */
+        const int chans = (int) stream->dst_channels;
+        const int frame_size = (int) (chans * sizeof (float));
+        float history[8];
+        float *resampled;
+        int outframes;
+        SDL_AudioCVT *cvt = &stream->cvt_after_resampling;
+
+        SDL_memcpy(history, stream->resampler_history, frame_size);
+        resampled = (float *) SDL_ReserveAudioStreamQueue(stream, frame_size * (stream->dst_rate / stream->src_rate + 2));
+        if (resampled == NULL) {
+            return -1;
+        }
+        outframes = SDL_ResampleAudioStream(stream, history, 1, resampled);
+        cvt->buf = (Uint8 *) resampled;
+        cvt->len = outframes * frame_size;
+        SDL_ConvertAudio(cvt);
+        stream->queue_tail += cvt->len_cvt;
+    }
+
+    if (stream->resampling) {
+        SDL_ResetAudioStreamResampler(stream);
+    }
+
+    return 0;
+}
+
+int
+SDL_AudioStreamGet(SDL_AudioStream *stream, void *buf, int len)
+{
+    const int available = stream ? stream->queue_tail - stream->queue_head : 0;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    } else if ((len % stream->dst_sample_frame_size) != 0) {
+        return SDL_SetError("Can't request partial sample frames");
+    }
+
+    if (len > available) {
+        len = available;
+    }
+    SDL_memcpy(buf, stream->queue + stream->queue_head, len);
+    stream->queue_head += len;
+    if (stream->queue_head == stream->queue_tail) {
+        stream->queue_head = stream->queue_tail = 0;
+    }
+    return len;
+}
+
+int
+SDL_AudioStreamAvailable(SDL_AudioStream *stream)
+{
+    return stream ? stream->queue_tail - stream->queue_head : 0;
+}
+
+void
+SDL_AudioStreamClear(SDL_AudioStream *stream)
+{
+    if (!stream) {
+        SDL_InvalidParamError("stream");
+        return;
+    }
+    stream->queue_head = stream->queue_tail = 0;
+    stream->staging_buffer_filled = 0;
+    if (stream->resampling) {
+        SDL_ResetAudioStreamResampler(stream);
+    }
+}
+
+void
+SDL_FreeAudioStream(SDL_AudioStream *stream)
+{
+    if (stream) {
+        SDL_ReleaseResampleFilter(stream->resample_filter);
+        SDL_free(stream->resample_buffer);
+        SDL_free(stream->work_buffer);
+        SDL_free(stream->queue);
+        SDL_free(stream);
+    }
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
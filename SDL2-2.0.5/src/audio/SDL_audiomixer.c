@@ -0,0 +1,539 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* A software mixer that renders any number of voices in one pass.
+
+   The output is made SDL_AUDIOMIXER_BLOCK frames at a time: every voice
+   is converted to float and added into a small accumulator, which is
+   clamped and converted to the output format once. The accumulator and
+   a voice's converted block both stay in the cache while they're used.
+ */
+
+#include "SDL_audio.h"
+#include "SDL_mutex.h"
+#include "SDL_audio_c.h"
+#include "SDL_audio_simd.h"
+
+#define SDL_AUDIOMIXER_BLOCK    256     /* sample frames mixed at a time */
+
+typedef struct
+{
+    int id;
+    int channels;           /* of the float data, 1 or the mixer's */
+    float gain_left;
+    float gain_right;
+
+    /* Voices from SDL_AudioMixerAddBuffer() */
+    const Uint8 *buf;
+    Uint32 len;
+    Uint32 pos;
+    SDL_bool loop;
+    int frame_size;         /* of the buffer's format */
+    SDL_AudioCVT cvt;       /* the buffer's format to float */
+    SDL_bool done;
+
+    /* Voices from SDL_AudioMixerAddStream() */
+    SDL_AudioStream *stream;
+} SDL_AudioMixerVoice;
+
+struct _SDL_AudioMixer
+{
+    SDL_mutex *lock;
+    SDL_AudioFormat format;
+    int channels;
+    int rate;
+    int frame_size;
+    Uint8 silence;
+    SDL_AudioCVT cvt;       /* float to the output format */
+    SDL_AudioMixerVoice *voices;
+    int num_voices;
+    int max_voices;
+    int next_id;
+    float *mix;             /* one block of the sum */
+    Uint8 *scratch;         /* one block of a voice */
+    int scratch_len;
+};
+
+SDL_AudioMixer *
+SDL_NewAudioMixer(SDL_AudioFormat format, Uint8 channels, int rate)
+{
+    SDL_AudioMixer *mixer;
+
+    if (channels != 1 && channels != 2) {
+        SDL_SetError("Audio mixer only supports mono or stereo output");
+        return NULL;
+    }
+    if (rate <= 0) {
+        SDL_InvalidParamError("rate");
+        return NULL;
+    }
+
+    mixer = (SDL_AudioMixer *) SDL_calloc(1, sizeof (SDL_AudioMixer));
+    if (!mixer) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    mixer->format = format;
+    mixer->channels = channels;
+    mixer->rate = rate;
+    mixer->frame_size = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    mixer->silence = (format == AUDIO_U8) ? 0x80 : 0x00;
+    mixer->next_id = 1;
+
+    if (SDL_BuildAudioCVT(&mixer->cvt, AUDIO_F32SYS, channels, rate, format, channels, rate) < 0) {
+        SDL_free(mixer);
+        return NULL;
+    }
+
+    mixer->mix = (float *) SDL_malloc(SDL_AUDIOMIXER_BLOCK * channels * sizeof (float));
+    mixer->lock = SDL_CreateMutex();
+    if (!mixer->mix || !mixer->lock) {
+        SDL_FreeAudioMixer(mixer);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    return mixer;
+}
+
+/* Add a voice with unity gain, with the mixer locked. The scratch buffer
+   is grown to hold scratch_len bytes, so a block of the voice fits. */
+static SDL_AudioMixerVoice *
+SDL_AddAudioMixerVoice(SDL_AudioMixer *mixer, int channels, int scratch_len)
+{
+    SDL_AudioMixerVoice *voice;
+
+    if (mixer->num_voices == mixer->max_voices) {
+        const int max_voices = mixer->max_voices ? (mixer->max_voices * 2) : 8;
+        void *ptr = SDL_realloc(mixer->voices, max_voices * sizeof (SDL_AudioMixerVoice));
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        mixer->voices = (SDL_AudioMixerVoice *) ptr;
+        mixer->max_voices = max_voices;
+    }
+
+    if (scratch_len > mixer->scratch_len) {
+        void *ptr = SDL_realloc(mixer->scratch, scratch_len);
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        mixer->scratch = (Uint8 *) ptr;
+        mixer->scratch_len = scratch_len;
+    }
+
+    voice = &mixer->voices[mixer->num_voices++];
+    SDL_zerop(voice);
+    voice->id = mixer->next_id++;
+    voice->channels = channels;
+    voice->gain_left = 1.0f;
+    voice->gain_right = 1.0f;
+    return voice;
+}
+
+/* Find a voice, with the mixer locked */
+static SDL_AudioMixerVoice *
+SDL_FindAudioMixerVoice(SDL_AudioMixer *mixer, int id)
+{
+    int i;
+
+    for (i = 0; i < mixer->num_voices; ++i) {
+        if (mixer->voices[i].id == id) {
+            return &mixer->voices[i];
+        }
+    }
+    return NULL;
+}
+
+/* Remove a voice, with the mixer locked. Voices keep their order, so the
+   mix is always summed the same way. */
+static void
+SDL_DeleteAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioMixerVoice *voice)
+{
+    const int index = (int) (voice - mixer->voices);
+
+    if (voice->stream) {
+        SDL_FreeAudioStream(voice->stream);
+    }
+    SDL_memmove(voice, voice + 1, (mixer->num_voices - index - 1) * sizeof (*voice));
+    --mixer->num_voices;
+}
+
+int
+SDL_AudioMixerAddBuffer(SDL_AudioMixer *mixer, SDL_AudioFormat format, Uint8 channels,
+                        const void *buf, Uint32 len, SDL_bool loop)
+{
+    SDL_AudioMixerVoice *voice;
+    SDL_AudioCVT cvt;
+    int voice_channels, frame_size, id;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+    if (!buf) {
+        return SDL_InvalidParamError("buf");
+    }
+
+    voice_channels = (channels == 1) ? 1 : mixer->channels;
+    if (SDL_BuildAudioCVT(&cvt, format, channels, mixer->rate,
+                          AUDIO_F32SYS, voice_channels, mixer->rate) < 0) {
+        return -1;
+    }
+    frame_size = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    if (len < (Uint32) frame_size) {
+        return SDL_SetError("Audio buffer is shorter than a sample frame");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    voice = SDL_AddAudioMixerVoice(mixer, voice_channels,
+                                   SDL_max(SDL_AUDIOMIXER_BLOCK * frame_size * cvt.len_mult,
+                                           SDL_AUDIOMIXER_BLOCK * voice_channels * (int) sizeof (float)));
+    if (!voice) {
+        SDL_UnlockMutex(mixer->lock);
+        return -1;
+    }
+    voice->buf = (const Uint8 *) buf;
+    voice->len = len - (len % frame_size);
+    voice->loop = loop;
+    voice->frame_size = frame_size;
+    voice->cvt = cvt;
+    id = voice->id;
+    SDL_UnlockMutex(mixer->lock);
+
+    return id;
+}
+
+int
+SDL_AudioMixerAddStream(SDL_AudioMixer *mixer, SDL_AudioFormat format, Uint8 channels, int rate)
+{
+    SDL_AudioMixerVoice *voice;
+    SDL_AudioStream *stream;
+    int voice_channels, id;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    voice_channels = (channels == 1) ? 1 : mixer->channels;
+    stream = SDL_NewAudioStream(format, channels, rate, AUDIO_F32SYS, voice_channels, mixer->rate);
+    if (!stream) {
+        return -1;
+    }
+
+    SDL_LockMutex(mixer->lock);
+    voice = SDL_AddAudioMixerVoice(mixer, voice_channels,
+                                   SDL_AUDIOMIXER_BLOCK * voice_channels * sizeof (float));
+    if (!voice) {
+        SDL_UnlockMutex(mixer->lock);
+        SDL_FreeAudioStream(stream);
+        return -1;
+    }
+    voice->stream = stream;
+    id = voice->id;
+    SDL_UnlockMutex(mixer->lock);
+
+    return id;
+}
+
+int
+SDL_AudioMixerPutVoice(SDL_AudioMixer *mixer, int id, const void *buf, int len)
+{
+    SDL_AudioMixerVoice *voice;
+    int retval;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    voice = SDL_FindAudioMixerVoice(mixer, id);
+    if (!voice) {
+        retval = SDL_SetError("Invalid audio mixer voice");
+    } else if (!voice->stream) {
+        retval = SDL_SetError("Audio mixer voice doesn't take streamed audio");
+    } else {
+        retval = SDL_AudioStreamPut(voice->stream, buf, len);
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return retval;
+}
+
+int
+SDL_AudioMixerSetVoiceVolume(SDL_AudioMixer *mixer, int id, float gain, float pan)
+{
+    SDL_AudioMixerVoice *voice;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+    if (pan < -1.0f || pan > 1.0f) {
+        return SDL_InvalidParamError("pan");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    voice = SDL_FindAudioMixerVoice(mixer, id);
+    if (!voice) {
+        SDL_UnlockMutex(mixer->lock);
+        return SDL_SetError("Invalid audio mixer voice");
+    }
+    if (mixer->channels == 1) {
+        voice->gain_left = voice->gain_right = gain;
+    } else {
+        /* The side being panned away from fades, the other stays at gain */
+        voice->gain_left = (pan > 0.0f) ? gain * (1.0f - pan) : gain;
+        voice->gain_right = (pan < 0.0f) ? gain * (1.0f + pan) : gain;
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return 0;
+}
+
+SDL_bool
+SDL_AudioMixerVoicePlaying(SDL_AudioMixer *mixer, int id)
+{
+    SDL_AudioMixerVoice *voice;
+    SDL_bool retval;
+
+    if (!mixer) {
+        return SDL_FALSE;
+    }
+
+    SDL_LockMutex(mixer->lock);
+    voice = SDL_FindAudioMixerVoice(mixer, id);
+    retval = (voice && !voice->done) ? SDL_TRUE : SDL_FALSE;
+    SDL_UnlockMutex(mixer->lock);
+
+    return retval;
+}
+
+int
+SDL_AudioMixerRemoveVoice(SDL_AudioMixer *mixer, int id)
+{
+    SDL_AudioMixerVoice *voice;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+
+    SDL_LockMutex(mixer->lock);
+    voice = SDL_FindAudioMixerVoice(mixer, id);
+    if (voice) {
+        SDL_DeleteAudioMixerVoice(mixer, voice);
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return voice ? 0 : SDL_SetError("Invalid audio mixer voice");
+}
+
+/* Put up to frames sample frames of a voice into the scratch buffer as
+   float, and return how many there were. */
+static int
+SDL_ReadAudioMixerVoice(SDL_AudioMixer *mixer, SDL_AudioMixerVoice *voice, int frames)
+{
+    int got = 0;
+
+    if (voice->stream) {
+        const int frame_size = voice->channels * sizeof (float);
+        got = SDL_AudioStreamGet(voice->stream, mixer->scratch, frames * frame_size);
+        return (got > 0) ? (got / frame_size) : 0;
+    }
+
+    while (got < frames && !voice->done) {
+        const Uint32 remaining = (voice->len - voice->pos) / voice->frame_size;
+        if (remaining == 0) {
+            if (voice->loop) {
+                voice->pos = 0;
+            } else {
+                voice->done = SDL_TRUE;
+            }
+        } else {
+            const int count = (int) SDL_min(remaining, (Uint32) (frames - got));
+            SDL_memcpy(mixer->scratch + got * voice->frame_size, voice->buf + voice->pos,
+                       count * voice->frame_size);
+            voice->pos += count * voice->frame_size;
+            got += count;
+        }
+    }
+
+    if (got > 0 && voice->cvt.needed) {
+        voice->cvt.buf = mixer->scratch;
+        voice->cvt.len = got * voice->frame_size;
+        SDL_ConvertAudio(&voice->cvt);
+    }
+    return got;
+}
+
+static void
+SDL_AccumulateAudioMixerVoice(SDL_AudioMixer *mixer, const SDL_AudioMixerVoice *voice,
+                              const float *src, int frames)
+{
+    float *mix = mixer->mix;
+    const float left = voice->gain_left;
+    const float right = voice->gain_right;
+    int i;
+
+    if (mixer->channels == 1) {
+        for (i = 0; i < frames; ++i) {
+            mix[i] += src[i] * left;
+        }
+    } else if (voice->channels == 1) {
+        for (i = 0; i < frames; ++i) {
+            mix[i * 2] += src[i] * left;
+            mix[i * 2 + 1] += src[i] * right;
+        }
+    } else {
+        for (i = 0; i < frames; ++i) {
+            mix[i * 2] += src[i * 2] * left;
+            mix[i * 2 + 1] += src[i * 2 + 1] * right;
+        }
+    }
+}
+
+/* Pin the mix to [-1, 1]. NaN is passed through on every path. */
+static void
+SDL_ClampAudioMixerBlock(float *mix, int count, Uint32 features)
+{
+    int i = 0;
+
+#if SDL_SSE2_AUDIO
+    if (features & SDL_AUDIO_CPU_SSE2) {
+        const __m128 hi = _mm_set1_ps(1.0f);
+        const __m128 lo = _mm_set1_ps(-1.0f);
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(mix + i, _mm_max_ps(lo, _mm_min_ps(hi, _mm_loadu_ps(mix + i))));
+        }
+    }
+#elif SDL_NEON_AUDIO
+    if (features & SDL_AUDIO_CPU_NEON) {
+        const float32x4_t hi = vdupq_n_f32(1.0f);
+        const float32x4_t lo = vdupq_n_f32(-1.0f);
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t x = vld1q_f32(mix + i);
+            /* vminq/vmaxq would turn NaN into a limit, compare instead */
+            vst1q_f32(mix + i, vbslq_f32(vcgtq_f32(x, hi), hi, vbslq_f32(vcltq_f32(x, lo), lo, x)));
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (mix[i] > 1.0f) {
+            mix[i] = 1.0f;
+        } else if (mix[i] < -1.0f) {
+            mix[i] = -1.0f;
+        }
+    }
+}
+
+int
+SDL_AudioMixerRender(SDL_AudioMixer *mixer, void *buf, int len)
+{
+    Uint8 *dst = (Uint8 *) buf;
+    Uint32 features;
+    int frames, i;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    }
+    if (!buf) {
+        return SDL_InvalidParamError("buf");
+    }
+    if (len < 0 || (len % mixer->frame_size) != 0) {
+        return SDL_SetError("Can't render partial sample frames");
+    }
+
+    features = SDL_GetAudioCPUFeatures();
+    frames = len / mixer->frame_size;
+
+    SDL_LockMutex(mixer->lock);
+    while (frames > 0) {
+        const int block = SDL_min(frames, SDL_AUDIOMIXER_BLOCK);
+        const int samples = block * mixer->channels;
+
+        SDL_memset(mixer->mix, 0, samples * sizeof (float));
+        for (i = 0; i < mixer->num_voices; ++i) {
+            SDL_AudioMixerVoice *voice = &mixer->voices[i];
+            const int got = SDL_ReadAudioMixerVoice(mixer, voice, block);
+            SDL_AccumulateAudioMixerVoice(mixer, voice, (const float *) mixer->scratch, got);
+        }
+        SDL_ClampAudioMixerBlock(mixer->mix, samples, features);
+
+        /* The output format is never wider than float, convert in place */
+        if (mixer->cvt.needed) {
+            mixer->cvt.buf = (Uint8 *) mixer->mix;
+            mixer->cvt.len = samples * sizeof (float);
+            SDL_ConvertAudio(&mixer->cvt);
+        }
+        SDL_memcpy(dst, mixer->mix, block * mixer->frame_size);
+
+        dst += block * mixer->frame_size;
+        frames -= block;
+    }
+
+    /* Buffers that played to the end are done with */
+    i = 0;
+    while (i < mixer->num_voices) {
+        if (mixer->voices[i].done) {
+            SDL_DeleteAudioMixerVoice(mixer, &mixer->voices[i]);
+        } else {
+            ++i;
+        }
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    return 0;
+}
+
+void SDLCALL
+SDL_AudioMixerCallback(void *userdata, Uint8 * stream, int len)
+{
+    SDL_AudioMixer *mixer = (SDL_AudioMixer *) userdata;
+
+    if (SDL_AudioMixerRender(mixer, stream, len) < 0) {
+        SDL_memset(stream, mixer ? mixer->silence : 0, len);
+    }
+}
+
+void
+SDL_FreeAudioMixer(SDL_AudioMixer *mixer)
+{
+    int i;
+
+    if (!mixer) {
+        return;
+    }
+    for (i = 0; i < mixer->num_voices; ++i) {
+        if (mixer->voices[i].stream) {
+            SDL_FreeAudioStream(mixer->voices[i].stream);
+        }
+    }
+    if (mixer->lock) {
+        SDL_DestroyMutex(mixer->lock);
+    }
+    SDL_free(mixer->voices);
+    SDL_free(mixer->mix);
+    SDL_free(mixer->scratch);
+    SDL_free(mixer);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
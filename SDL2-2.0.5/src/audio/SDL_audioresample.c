@@ -0,0 +1,445 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Polyphase windowed sinc resampling.
+
+   For a ratio of rates dst_rate/src_rate in lowest terms, output frame n
+   falls at input position n * src_rate / dst_rate, so there are only
+   dst_rate different fractional positions (phases). Each phase gets its
+   own row of Kaiser windowed sinc coefficients, and an output frame is
+   the dot product of a row with the input frames around it. Ratios with
+   more phases than SDL_RESAMPLE_MAX_PHASES interpolate between the rows
+   of a smaller table instead.
+
+   Tables are cached by ratio and quality, so every stream and converter
+   resampling 44.1 to 48 kHz shares one.
+ */
+
+#include "SDL_audio.h"
+#include "SDL_assert.h"
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_audio_c.h"
+#include "SDL_audio_simd.h"
+
+#define SDL_RESAMPLE_MAX_PHASES     1024
+#define SDL_RESAMPLE_MAX_HALF_TAPS  256
+
+static const struct
+{
+    int zero_crossings;     /* on each side of the centre, at the cutoff */
+    double beta;            /* Kaiser window shape */
+    double cutoff;          /* as a fraction of the lower Nyquist frequency */
+} SDL_resample_qualities[] = {
+    { 0, 0.0, 0.0 },        /* SDL_RESAMPLE_FAST doesn't use a filter */
+    { 8, 6.0, 0.90 },       /* SDL_RESAMPLE_MEDIUM */
+    { 32, 10.0, 0.96 }      /* SDL_RESAMPLE_BEST */
+};
+
+static SDL_SpinLock SDL_resample_filters_lock;
+static SDL_ResampleFilter *SDL_resample_filters = NULL;
+
+int
+SDL_GetResampleQuality(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_RESAMPLING_MODE);
+
+    if (hint) {
+        if (*hint == '1' || SDL_strcasecmp(hint, "fast") == 0) {
+            return SDL_RESAMPLE_FAST;
+        } else if (*hint == '3' || SDL_strcasecmp(hint, "best") == 0) {
+            return SDL_RESAMPLE_BEST;
+        }
+    }
+    return SDL_RESAMPLE_MEDIUM;
+}
+
+static int
+SDL_GreatestCommonDivisor(int a, int b)
+{
+    while (b != 0) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/* Modified Bessel function of the first kind, order 0 */
+static double
+SDL_BesselI0(double x)
+{
+    const double q = (x * x) / 4.0;
+    double sum = 1.0;
+    double term = 1.0;
+    int k;
+
+    for (k = 1; k < 100; ++k) {
+        term *= q / ((double) k * (double) k);
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+static SDL_ResampleFilter *
+SDL_BuildResampleFilter(int src_rate, int dst_rate, int quality)
+{
+    const double beta = SDL_resample_qualities[quality].beta;
+    const double stretch = (dst_rate < src_rate) ? ((double) dst_rate / (double) src_rate) : 1.0;
+    const double cutoff = SDL_resample_qualities[quality].cutoff * stretch;
+    const double window_scale = 1.0 / SDL_BesselI0(beta);
+    SDL_ResampleFilter *filter;
+    int half_taps, rows, phase, tap;
+
+    /* Downsampling moves the cutoff down, so the sinc gets wider */
+    half_taps = (int) SDL_ceil(SDL_resample_qualities[quality].zero_crossings / stretch);
+    half_taps = SDL_min((half_taps + 1) & ~1, SDL_RESAMPLE_MAX_HALF_TAPS);
+
+    filter = (SDL_ResampleFilter *) SDL_calloc(1, sizeof (SDL_ResampleFilter));
+    if (!filter) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    filter->src_rate = src_rate;
+    filter->dst_rate = dst_rate;
+    filter->quality = quality;
+    filter->half_taps = half_taps;
+    filter->taps = half_taps * 2;
+    if (dst_rate <= SDL_RESAMPLE_MAX_PHASES) {
+        filter->phases = dst_rate;
+        filter->interpolate = SDL_FALSE;
+        rows = filter->phases;
+    } else {
+        filter->phases = SDL_RESAMPLE_MAX_PHASES;
+        filter->interpolate = SDL_TRUE;
+        rows = filter->phases + 1;
+    }
+
+    filter->coeffs = (float *) SDL_malloc(rows * filter->taps * sizeof (float));
+    if (!filter->coeffs) {
+        SDL_free(filter);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    for (phase = 0; phase < rows; ++phase) {
+        const double offset = (double) phase / (double) filter->phases;
+        float *row = filter->coeffs + phase * filter->taps;
+        double sum = 0.0;
+
+        for (tap = 0; tap < filter->taps; ++tap) {
+            /* Distance from the output position to this tap's input frame */
+            const double d = (double) (tap - half_taps + 1) - offset;
+            const double x = d / (double) half_taps;
+            const double window = (x * x < 1.0) ? SDL_BesselI0(beta * SDL_sqrt(1.0 - x * x)) * window_scale : 0.0;
+            const double arg = M_PI * cutoff * d;
+            const double value = ((d == 0.0) ? cutoff : (cutoff * SDL_sin(arg) / arg)) * window;
+            row[tap] = (float) value;
+            sum += value;
+        }
+
+        /* Pass DC unchanged at every phase */
+        for (tap = 0; tap < filter->taps; ++tap) {
+            row[tap] = (float) (row[tap] / sum);
+        }
+    }
+
+    return filter;
+}
+
+static void
+SDL_DestroyResampleFilter(SDL_ResampleFilter *filter)
+{
+    SDL_free(filter->coeffs);
+    SDL_free(filter);
+}
+
+SDL_ResampleFilter *
+SDL_AcquireResampleFilter(int src_rate, int dst_rate, int quality)
+{
+    SDL_ResampleFilter *filter, *built;
+    int gcd;
+
+    if (src_rate <= 0 || dst_rate <= 0 ||
+        quality <= SDL_RESAMPLE_FAST || quality > SDL_RESAMPLE_BEST) {
+        SDL_InvalidParamError("rate");
+        return NULL;
+    }
+    gcd = SDL_GreatestCommonDivisor(src_rate, dst_rate);
+    src_rate /= gcd;
+    dst_rate /= gcd;
+
+    for (built = NULL; ; ) {
+        SDL_AtomicLock(&SDL_resample_filters_lock);
+        for (filter = SDL_resample_filters; filter; filter = filter->next) {
+            if (filter->src_rate == src_rate && filter->dst_rate == dst_rate &&
+                filter->quality == quality) {
+                break;
+            }
+        }
+        if (!filter && built) {
+            filter = built;
+            filter->next = SDL_resample_filters;
+            SDL_resample_filters = filter;
+            built = NULL;
+        }
+        if (filter) {
+            ++filter->refcount;
+        }
+        SDL_AtomicUnlock(&SDL_resample_filters_lock);
+
+        if (filter) {
+            break;
+        }
+
+        /* Build it without holding the lock; if another thread gets there
+           first, its table is used and this one thrown away. */
+        built = SDL_BuildResampleFilter(src_rate, dst_rate, quality);
+        if (!built) {
+            return NULL;
+        }
+    }
+
+    if (built) {
+        SDL_DestroyResampleFilter(built);
+    }
+    return filter;
+}
+
+void
+SDL_ReleaseResampleFilter(SDL_ResampleFilter *filter)
+{
+    if (filter) {
+        SDL_AtomicLock(&SDL_resample_filters_lock);
+        SDL_assert(filter->refcount > 0);
+        --filter->refcount;
+        SDL_AtomicUnlock(&SDL_resample_filters_lock);
+    }
+}
+
+void
+SDL_FreeResampleFilters(void)
+{
+    SDL_ResampleFilter **prev = &SDL_resample_filters;
+
+    SDL_AtomicLock(&SDL_resample_filters_lock);
+    while (*prev) {
+        SDL_ResampleFilter *filter = *prev;
+        if (filter->refcount == 0) {
+            *prev = filter->next;
+            SDL_DestroyResampleFilter(filter);
+        } else {
+            prev = &filter->next;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_resample_filters_lock);
+}
+
+void
+SDL_StepResampleAudio(const SDL_ResampleFilter *filter, int *pos, Uint32 *phase)
+{
+    *pos += filter->src_rate / filter->dst_rate;
+    *phase += (Uint32) (filter->src_rate % filter->dst_rate);
+    if (*phase >= (Uint32) filter->dst_rate) {
+        *phase -= (Uint32) filter->dst_rate;
+        ++*pos;
+    }
+}
+
+/* The coefficients for a phase: a row of the table, or a blend of the two
+   rows around it, made in (tmp). */
+static const float *
+SDL_GetResampleCoeffs(const SDL_ResampleFilter *filter, Uint32 phase, float *tmp)
+{
+    const int taps = filter->taps;
+    Uint64 scaled;
+    const float *a, *b;
+    float t;
+    int i;
+
+    if (!filter->interpolate) {
+        return filter->coeffs + phase * taps;
+    }
+
+    scaled = (Uint64) phase * filter->phases;
+    a = filter->coeffs + (int) (scaled / filter->dst_rate) * taps;
+    b = a + taps;
+    t = (float) (scaled % filter->dst_rate) / (float) filter->dst_rate;
+    for (i = 0; i < taps; ++i) {
+        tmp[i] = a[i] + (b[i] - a[i]) * t;
+    }
+    return tmp;
+}
+
+/* Dot products of (taps) coefficients with the frames at (src). Taps are
+   always a multiple of 4. */
+typedef void (*SDL_ResampleFrameFunc)(const float *coeffs, int taps, const float *src,
+                                      int channels, float *dst);
+
+static void
+SDL_ResampleFrame_Scalar(const float *coeffs, int taps, const float *src, int channels, float *dst)
+{
+    int chan, tap;
+
+    for (chan = 0; chan < channels; ++chan) {
+        const float *x = src + chan;
+        float sum = 0.0f;
+        for (tap = 0; tap < taps; ++tap) {
+            sum += coeffs[tap] * x[tap * channels];
+        }
+        dst[chan] = sum;
+    }
+}
+
+#if SDL_SSE2_AUDIO
+static void
+SDL_ResampleFrame_Mono_SSE2(const float *coeffs, int taps, const float *src, int channels, float *dst)
+{
+    __m128 sum = _mm_setzero_ps();
+    int tap;
+
+    for (tap = 0; tap < taps; tap += 4) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(coeffs + tap), _mm_loadu_ps(src + tap)));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+    _mm_store_ss(dst, sum);
+}
+
+static void
+SDL_ResampleFrame_Stereo_SSE2(const float *coeffs, int taps, const float *src, int channels, float *dst)
+{
+    __m128 sum = _mm_setzero_ps();
+    int tap;
+
+    /* Each coefficient is used for both samples of a frame */
+    for (tap = 0; tap < taps; tap += 4) {
+        const __m128 c = _mm_loadu_ps(coeffs + tap);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_unpacklo_ps(c, c), _mm_loadu_ps(src + tap * 2)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_unpackhi_ps(c, c), _mm_loadu_ps(src + tap * 2 + 4)));
+    }
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    _mm_storel_pi((__m64 *) dst, sum);
+}
+#endif
+
+#if SDL_NEON_AUDIO
+static void
+SDL_ResampleFrame_Mono_NEON(const float *coeffs, int taps, const float *src, int channels, float *dst)
+{
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    int tap;
+
+    for (tap = 0; tap < taps; tap += 4) {
+        sum = vmlaq_f32(sum, vld1q_f32(coeffs + tap), vld1q_f32(src + tap));
+    }
+    *dst = vaddvq_f32(sum);
+}
+
+static void
+SDL_ResampleFrame_Stereo_NEON(const float *coeffs, int taps, const float *src, int channels, float *dst)
+{
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    int tap;
+
+    for (tap = 0; tap < taps; tap += 4) {
+        const float32x4x2_t c = vzipq_f32(vld1q_f32(coeffs + tap), vld1q_f32(coeffs + tap));
+        sum = vmlaq_f32(sum, c.val[0], vld1q_f32(src + tap * 2));
+        sum = vmlaq_f32(sum, c.val[1], vld1q_f32(src + tap * 2 + 4));
+    }
+    vst1_f32(dst, vadd_f32(vget_low_f32(sum), vget_high_f32(sum)));
+}
+#endif
+
+static SDL_ResampleFrameFunc
+SDL_ChooseResampleFrame(int channels)
+{
+    const Uint32 features = SDL_GetAudioCPUFeatures();
+
+#if SDL_SSE2_AUDIO
+    if (features & SDL_AUDIO_CPU_SSE2) {
+        if (channels == 1) {
+            return SDL_ResampleFrame_Mono_SSE2;
+        } else if (channels == 2) {
+            return SDL_ResampleFrame_Stereo_SSE2;
+        }
+    }
+#elif SDL_NEON_AUDIO
+    if (features & SDL_AUDIO_CPU_NEON) {
+        if (channels == 1) {
+            return SDL_ResampleFrame_Mono_NEON;
+        } else if (channels == 2) {
+            return SDL_ResampleFrame_Stereo_NEON;
+        }
+    }
+#endif
+    (void) features;
+    return SDL_ResampleFrame_Scalar;
+}
+
+int
+SDL_ResampleAudio(const SDL_ResampleFilter *filter, int channels,
+                  const float *inbuf, int inframes, int *pos, Uint32 *phase,
+                  float *outbuf, int maxframes)
+{
+    const SDL_ResampleFrameFunc resample = SDL_ChooseResampleFrame(channels);
+    const int half_taps = filter->half_taps;
+    float tmp[SDL_RESAMPLE_MAX_HALF_TAPS * 2];
+    int frames = 0;
+
+    SDL_assert(*pos >= half_taps - 1);
+
+    while (frames < maxframes && *pos + half_taps < inframes) {
+        const float *coeffs = SDL_GetResampleCoeffs(filter, *phase, tmp);
+        resample(coeffs, filter->taps, inbuf + (*pos - half_taps + 1) * channels, channels, outbuf);
+        outbuf += channels;
+        ++frames;
+        SDL_StepResampleAudio(filter, pos, phase);
+    }
+    return frames;
+}
+
+void
+SDL_ResampleAudioFrameClipped(const SDL_ResampleFilter *filter, int channels,
+                              const float *inbuf, int inframes, int pos, Uint32 phase,
+                              float *outbuf)
+{
+    float tmp[SDL_RESAMPLE_MAX_HALF_TAPS * 2];
+    const float *coeffs = SDL_GetResampleCoeffs(filter, phase, tmp);
+    const int first = pos - filter->half_taps + 1;
+    const int start = SDL_max(0, -first);
+    const int end = SDL_min(filter->taps, inframes - first);
+    int chan, tap;
+
+    for (chan = 0; chan < channels; ++chan) {
+        float sum = 0.0f;
+        for (tap = start; tap < end; ++tap) {
+            sum += coeffs[tap] * inbuf[(first + tap) * channels + chan];
+        }
+        outbuf[chan] = sum;
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -53,6 +53,40 @@
 #define DIVBY32767 3.05185094759972e-05f
 #define DIVBY2147483647 4.6566128752458e-10f
 
+/* Foreign-endian floats are swapped as integers: the swapped bits can look
+   like a signaling NaN, which an x87 load would quietly rewrite. */
+static SDL_INLINE float
+SDL_LoadSwappedFloat(const float *src)
+{
+    Uint32 bits;
+    float f;
+    SDL_memcpy(&bits, src, sizeof (bits));
+    bits = SDL_Swap32(bits);
+    SDL_memcpy(&f, &bits, sizeof (f));
+    return f;
+}
+
+static SDL_INLINE void
+SDL_StoreSwappedFloat(float *dst, const float f)
+{
+    Uint32 bits;
+    SDL_memcpy(&bits, &f, sizeof (bits));
+    bits = SDL_Swap32(bits);
+    SDL_memcpy(dst, &bits, sizeof (bits));
+}
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define SDL_LoadFloatLE(src) (*(src))
+#define SDL_LoadFloatBE(src) SDL_LoadSwappedFloat(src)
+#define SDL_StoreFloatLE(dst, f) (*(dst) = (f))
+#define SDL_StoreFloatBE(dst, f) SDL_StoreSwappedFloat(dst, f)
+#else
+#define SDL_LoadFloatLE(src) SDL_LoadSwappedFloat(src)
+#define SDL_LoadFloatBE(src) (*(src))
+#define SDL_StoreFloatLE(dst, f) SDL_StoreSwappedFloat(dst, f)
+#define SDL_StoreFloatBE(dst, f) (*(dst) = (f))
+#endif
+
 #if !NO_CONVERTERS
 
 static void SDLCALL
@@ -237,7 +271,7 @@ SDL_Convert_U8_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 4)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint8); i; --i, --src, --dst) {
         const float val = ((((float) *src) * DIVBY127) - 1.0f);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     cvt->len_cvt *= 4;
@@ -261,7 +295,7 @@ SDL_Convert_U8_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 4)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint8); i; --i, --src, --dst) {
         const float val = ((((float) *src) * DIVBY127) - 1.0f);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     cvt->len_cvt *= 4;
@@ -452,7 +486,7 @@ SDL_Convert_S8_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 4)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint8); i; --i, --src, --dst) {
         const float val = (((float) ((Sint8) *src)) * DIVBY127);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     cvt->len_cvt *= 4;
@@ -476,7 +510,7 @@ SDL_Convert_S8_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 4)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint8); i; --i, --src, --dst) {
         const float val = (((float) ((Sint8) *src)) * DIVBY127);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     cvt->len_cvt *= 4;
@@ -665,7 +699,7 @@ SDL_Convert_U16LSB_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = ((((float) SDL_SwapLE16(*src)) * DIVBY32767) - 1.0f);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -689,7 +723,7 @@ SDL_Convert_U16LSB_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = ((((float) SDL_SwapLE16(*src)) * DIVBY32767) - 1.0f);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -878,7 +912,7 @@ SDL_Convert_S16LSB_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = (((float) ((Sint16) SDL_SwapLE16(*src))) * DIVBY32767);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -902,7 +936,7 @@ SDL_Convert_S16LSB_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = (((float) ((Sint16) SDL_SwapLE16(*src))) * DIVBY32767);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -1091,7 +1125,7 @@ SDL_Convert_U16MSB_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = ((((float) SDL_SwapBE16(*src)) * DIVBY32767) - 1.0f);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -1115,7 +1149,7 @@ SDL_Convert_U16MSB_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = ((((float) SDL_SwapBE16(*src)) * DIVBY32767) - 1.0f);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -1304,7 +1338,7 @@ SDL_Convert_S16MSB_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = (((float) ((Sint16) SDL_SwapBE16(*src))) * DIVBY32767);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -1328,7 +1362,7 @@ SDL_Convert_S16MSB_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = ((float *) (cvt->buf + cvt->len_cvt * 2)) - 1;
     for (i = cvt->len_cvt / sizeof (Uint16); i; --i, --src, --dst) {
         const float val = (((float) ((Sint16) SDL_SwapBE16(*src))) * DIVBY32767);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     cvt->len_cvt *= 2;
@@ -1519,7 +1553,7 @@ SDL_Convert_S32LSB_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = (float *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (Uint32); i; --i, ++src, ++dst) {
         const float val = (((float) ((Sint32) SDL_SwapLE32(*src))) * DIVBY2147483647);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     if (cvt->filters[++cvt->filter_index]) {
@@ -1542,7 +1576,7 @@ SDL_Convert_S32LSB_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = (float *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (Uint32); i; --i, ++src, ++dst) {
         const float val = (((float) ((Sint32) SDL_SwapLE32(*src))) * DIVBY2147483647);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     if (cvt->filters[++cvt->filter_index]) {
@@ -1732,7 +1766,7 @@ SDL_Convert_S32MSB_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = (float *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (Uint32); i; --i, ++src, ++dst) {
         const float val = (((float) ((Sint32) SDL_SwapBE32(*src))) * DIVBY2147483647);
-        *dst = SDL_SwapFloatLE(val);
+        SDL_StoreFloatLE(dst, val);
     }
 
     if (cvt->filters[++cvt->filter_index]) {
@@ -1755,7 +1789,7 @@ SDL_Convert_S32MSB_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     dst = (float *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (Uint32); i; --i, ++src, ++dst) {
         const float val = (((float) ((Sint32) SDL_SwapBE32(*src))) * DIVBY2147483647);
-        *dst = SDL_SwapFloatBE(val);
+        SDL_StoreFloatBE(dst, val);
     }
 
     if (cvt->filters[++cvt->filter_index]) {
@@ -1777,7 +1811,7 @@ SDL_Convert_F32LSB_to_U8(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Uint8 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Uint8 val = ((Uint8) ((SDL_SwapFloatLE(*src) + 1.0f) * 127.0f));
+        const Uint8 val = ((Uint8) ((SDL_LoadFloatLE(src) + 1.0f) * 127.0f));
         *dst = val;
     }
 
@@ -1801,7 +1835,7 @@ SDL_Convert_F32LSB_to_S8(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint8 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint8 val = ((Sint8) (SDL_SwapFloatLE(*src) * 127.0f));
+        const Sint8 val = ((Sint8) (SDL_LoadFloatLE(src) * 127.0f));
         *dst = ((Sint8) val);
     }
 
@@ -1825,7 +1859,7 @@ SDL_Convert_F32LSB_to_U16LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Uint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Uint16 val = ((Uint16) ((SDL_SwapFloatLE(*src) + 1.0f) * 32767.0f));
+        const Uint16 val = ((Uint16) ((SDL_LoadFloatLE(src) + 1.0f) * 32767.0f));
         *dst = SDL_SwapLE16(val);
     }
 
@@ -1849,7 +1883,7 @@ SDL_Convert_F32LSB_to_S16LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint16 val = ((Sint16) (SDL_SwapFloatLE(*src) * 32767.0f));
+        const Sint16 val = ((Sint16) (SDL_LoadFloatLE(src) * 32767.0f));
         *dst = ((Sint16) SDL_SwapLE16(val));
     }
 
@@ -1873,7 +1907,7 @@ SDL_Convert_F32LSB_to_U16MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Uint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Uint16 val = ((Uint16) ((SDL_SwapFloatLE(*src) + 1.0f) * 32767.0f));
+        const Uint16 val = ((Uint16) ((SDL_LoadFloatLE(src) + 1.0f) * 32767.0f));
         *dst = SDL_SwapBE16(val);
     }
 
@@ -1897,7 +1931,7 @@ SDL_Convert_F32LSB_to_S16MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint16 val = ((Sint16) (SDL_SwapFloatLE(*src) * 32767.0f));
+        const Sint16 val = ((Sint16) (SDL_LoadFloatLE(src) * 32767.0f));
         *dst = ((Sint16) SDL_SwapBE16(val));
     }
 
@@ -1921,7 +1955,7 @@ SDL_Convert_F32LSB_to_S32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint32 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint32 val = ((Sint32) (SDL_SwapFloatLE(*src) * 2147483647.0));
+        const Sint32 val = ((Sint32) (SDL_LoadFloatLE(src) * 2147483647.0));
         *dst = ((Sint32) SDL_SwapLE32(val));
     }
 
@@ -1944,7 +1978,7 @@ SDL_Convert_F32LSB_to_S32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint32 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint32 val = ((Sint32) (SDL_SwapFloatLE(*src) * 2147483647.0));
+        const Sint32 val = ((Sint32) (SDL_LoadFloatLE(src) * 2147483647.0));
         *dst = ((Sint32) SDL_SwapBE32(val));
     }
 
@@ -1967,8 +2001,8 @@ SDL_Convert_F32LSB_to_F32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (float *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const float val = SDL_SwapFloatLE(*src);
-        *dst = SDL_SwapFloatBE(val);
+        const float val = SDL_LoadFloatLE(src);
+        SDL_StoreFloatBE(dst, val);
     }
 
     if (cvt->filters[++cvt->filter_index]) {
@@ -1990,7 +2024,7 @@ SDL_Convert_F32MSB_to_U8(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Uint8 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Uint8 val = ((Uint8) ((SDL_SwapFloatBE(*src) + 1.0f) * 127.0f));
+        const Uint8 val = ((Uint8) ((SDL_LoadFloatBE(src) + 1.0f) * 127.0f));
         *dst = val;
     }
 
@@ -2014,7 +2048,7 @@ SDL_Convert_F32MSB_to_S8(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint8 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint8 val = ((Sint8) (SDL_SwapFloatBE(*src) * 127.0f));
+        const Sint8 val = ((Sint8) (SDL_LoadFloatBE(src) * 127.0f));
         *dst = ((Sint8) val);
     }
 
@@ -2038,7 +2072,7 @@ SDL_Convert_F32MSB_to_U16LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Uint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Uint16 val = ((Uint16) ((SDL_SwapFloatBE(*src) + 1.0f) * 32767.0f));
+        const Uint16 val = ((Uint16) ((SDL_LoadFloatBE(src) + 1.0f) * 32767.0f));
         *dst = SDL_SwapLE16(val);
     }
 
@@ -2062,7 +2096,7 @@ SDL_Convert_F32MSB_to_S16LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint16 val = ((Sint16) (SDL_SwapFloatBE(*src) * 32767.0f));
+        const Sint16 val = ((Sint16) (SDL_LoadFloatBE(src) * 32767.0f));
         *dst = ((Sint16) SDL_SwapLE16(val));
     }
 
@@ -2086,7 +2120,7 @@ SDL_Convert_F32MSB_to_U16MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Uint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Uint16 val = ((Uint16) ((SDL_SwapFloatBE(*src) + 1.0f) * 32767.0f));
+        const Uint16 val = ((Uint16) ((SDL_LoadFloatBE(src) + 1.0f) * 32767.0f));
         *dst = SDL_SwapBE16(val);
     }
 
@@ -2110,7 +2144,7 @@ SDL_Convert_F32MSB_to_S16MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint16 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint16 val = ((Sint16) (SDL_SwapFloatBE(*src) * 32767.0f));
+        const Sint16 val = ((Sint16) (SDL_LoadFloatBE(src) * 32767.0f));
         *dst = ((Sint16) SDL_SwapBE16(val));
     }
 
@@ -2134,7 +2168,7 @@ SDL_Convert_F32MSB_to_S32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint32 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint32 val = ((Sint32) (SDL_SwapFloatBE(*src) * 2147483647.0));
+        const Sint32 val = ((Sint32) (SDL_LoadFloatBE(src) * 2147483647.0));
         *dst = ((Sint32) SDL_SwapLE32(val));
     }
 
@@ -2157,7 +2191,7 @@ SDL_Convert_F32MSB_to_S32MSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (Sint32 *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const Sint32 val = ((Sint32) (SDL_SwapFloatBE(*src) * 2147483647.0));
+        const Sint32 val = ((Sint32) (SDL_LoadFloatBE(src) * 2147483647.0));
         *dst = ((Sint32) SDL_SwapBE32(val));
     }
 
@@ -2180,8 +2214,8 @@ SDL_Convert_F32MSB_to_F32LSB(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     src = (const float *) cvt->buf;
     dst = (float *) cvt->buf;
     for (i = cvt->len_cvt / sizeof (float); i; --i, ++src, ++dst) {
-        const float val = SDL_SwapFloatBE(*src);
-        *dst = SDL_SwapFloatLE(val);
+        const float val = SDL_LoadFloatBE(src);
+        SDL_StoreFloatLE(dst, val);
     }
 
     if (cvt->filters[++cvt->filter_index]) {
@@ -6145,15 +6179,15 @@ SDL_Upsample_F32LSB_1c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 1;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 1;
     const float *target = ((const float *) cvt->buf);
-    float sample0 = SDL_SwapFloatLE(src[0]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[0] = SDL_SwapFloatLE(sample0);
+        SDL_StoreFloatLE(&dst[0], sample0);
         dst--;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src--;
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample0 = sample0;
             eps -= dstsize;
         }
@@ -6177,15 +6211,15 @@ SDL_Downsample_F32LSB_1c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatLE(src[0]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
     float last_sample0 = sample0;
     while (dst < target) {
         src++;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatLE(sample0);
+            SDL_StoreFloatLE(&dst[0], sample0);
             dst++;
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample0 = sample0;
             eps -= srcsize;
         }
@@ -6209,19 +6243,19 @@ SDL_Upsample_F32LSB_2c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 2;
     const float *target = ((const float *) cvt->buf);
-    float sample1 = SDL_SwapFloatLE(src[1]);
-    float sample0 = SDL_SwapFloatLE(src[0]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[1] = SDL_SwapFloatLE(sample1);
-        dst[0] = SDL_SwapFloatLE(sample0);
+        SDL_StoreFloatLE(&dst[1], sample1);
+        SDL_StoreFloatLE(&dst[0], sample0);
         dst -= 2;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 2;
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample1 = sample1;
             last_sample0 = sample0;
             eps -= dstsize;
@@ -6246,19 +6280,19 @@ SDL_Downsample_F32LSB_2c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatLE(src[0]);
-    float sample1 = SDL_SwapFloatLE(src[1]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     while (dst < target) {
         src += 2;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatLE(sample0);
-            dst[1] = SDL_SwapFloatLE(sample1);
+            SDL_StoreFloatLE(&dst[0], sample0);
+            SDL_StoreFloatLE(&dst[1], sample1);
             dst += 2;
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             eps -= srcsize;
@@ -6283,27 +6317,27 @@ SDL_Upsample_F32LSB_4c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 4;
     const float *target = ((const float *) cvt->buf);
-    float sample3 = SDL_SwapFloatLE(src[3]);
-    float sample2 = SDL_SwapFloatLE(src[2]);
-    float sample1 = SDL_SwapFloatLE(src[1]);
-    float sample0 = SDL_SwapFloatLE(src[0]);
+    float sample3 = SDL_LoadFloatLE(&src[3]);
+    float sample2 = SDL_LoadFloatLE(&src[2]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
     float last_sample3 = sample3;
     float last_sample2 = sample2;
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[3] = SDL_SwapFloatLE(sample3);
-        dst[2] = SDL_SwapFloatLE(sample2);
-        dst[1] = SDL_SwapFloatLE(sample1);
-        dst[0] = SDL_SwapFloatLE(sample0);
+        SDL_StoreFloatLE(&dst[3], sample3);
+        SDL_StoreFloatLE(&dst[2], sample2);
+        SDL_StoreFloatLE(&dst[1], sample1);
+        SDL_StoreFloatLE(&dst[0], sample0);
         dst -= 4;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 4;
-            sample3 = (float) ((((double) SDL_SwapFloatLE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatLE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatLE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatLE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample3 = sample3;
             last_sample2 = sample2;
             last_sample1 = sample1;
@@ -6330,10 +6364,10 @@ SDL_Downsample_F32LSB_4c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatLE(src[0]);
-    float sample1 = SDL_SwapFloatLE(src[1]);
-    float sample2 = SDL_SwapFloatLE(src[2]);
-    float sample3 = SDL_SwapFloatLE(src[3]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
+    float sample2 = SDL_LoadFloatLE(&src[2]);
+    float sample3 = SDL_LoadFloatLE(&src[3]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     float last_sample2 = sample2;
@@ -6342,15 +6376,15 @@ SDL_Downsample_F32LSB_4c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
         src += 4;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatLE(sample0);
-            dst[1] = SDL_SwapFloatLE(sample1);
-            dst[2] = SDL_SwapFloatLE(sample2);
-            dst[3] = SDL_SwapFloatLE(sample3);
+            SDL_StoreFloatLE(&dst[0], sample0);
+            SDL_StoreFloatLE(&dst[1], sample1);
+            SDL_StoreFloatLE(&dst[2], sample2);
+            SDL_StoreFloatLE(&dst[3], sample3);
             dst += 4;
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatLE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatLE(src[3])) + ((double) last_sample3)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatLE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatLE(&src[3])) + ((double) last_sample3)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             last_sample2 = sample2;
@@ -6377,12 +6411,12 @@ SDL_Upsample_F32LSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 6;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 6;
     const float *target = ((const float *) cvt->buf);
-    float sample5 = SDL_SwapFloatLE(src[5]);
-    float sample4 = SDL_SwapFloatLE(src[4]);
-    float sample3 = SDL_SwapFloatLE(src[3]);
-    float sample2 = SDL_SwapFloatLE(src[2]);
-    float sample1 = SDL_SwapFloatLE(src[1]);
-    float sample0 = SDL_SwapFloatLE(src[0]);
+    float sample5 = SDL_LoadFloatLE(&src[5]);
+    float sample4 = SDL_LoadFloatLE(&src[4]);
+    float sample3 = SDL_LoadFloatLE(&src[3]);
+    float sample2 = SDL_LoadFloatLE(&src[2]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
     float last_sample5 = sample5;
     float last_sample4 = sample4;
     float last_sample3 = sample3;
@@ -6390,22 +6424,22 @@ SDL_Upsample_F32LSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[5] = SDL_SwapFloatLE(sample5);
-        dst[4] = SDL_SwapFloatLE(sample4);
-        dst[3] = SDL_SwapFloatLE(sample3);
-        dst[2] = SDL_SwapFloatLE(sample2);
-        dst[1] = SDL_SwapFloatLE(sample1);
-        dst[0] = SDL_SwapFloatLE(sample0);
+        SDL_StoreFloatLE(&dst[5], sample5);
+        SDL_StoreFloatLE(&dst[4], sample4);
+        SDL_StoreFloatLE(&dst[3], sample3);
+        SDL_StoreFloatLE(&dst[2], sample2);
+        SDL_StoreFloatLE(&dst[1], sample1);
+        SDL_StoreFloatLE(&dst[0], sample0);
         dst -= 6;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 6;
-            sample5 = (float) ((((double) SDL_SwapFloatLE(src[5])) + ((double) last_sample5)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatLE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatLE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatLE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatLE(&src[5])) + ((double) last_sample5)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatLE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatLE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatLE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample5 = sample5;
             last_sample4 = sample4;
             last_sample3 = sample3;
@@ -6434,12 +6468,12 @@ SDL_Downsample_F32LSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatLE(src[0]);
-    float sample1 = SDL_SwapFloatLE(src[1]);
-    float sample2 = SDL_SwapFloatLE(src[2]);
-    float sample3 = SDL_SwapFloatLE(src[3]);
-    float sample4 = SDL_SwapFloatLE(src[4]);
-    float sample5 = SDL_SwapFloatLE(src[5]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
+    float sample2 = SDL_LoadFloatLE(&src[2]);
+    float sample3 = SDL_LoadFloatLE(&src[3]);
+    float sample4 = SDL_LoadFloatLE(&src[4]);
+    float sample5 = SDL_LoadFloatLE(&src[5]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     float last_sample2 = sample2;
@@ -6450,19 +6484,19 @@ SDL_Downsample_F32LSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
         src += 6;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatLE(sample0);
-            dst[1] = SDL_SwapFloatLE(sample1);
-            dst[2] = SDL_SwapFloatLE(sample2);
-            dst[3] = SDL_SwapFloatLE(sample3);
-            dst[4] = SDL_SwapFloatLE(sample4);
-            dst[5] = SDL_SwapFloatLE(sample5);
+            SDL_StoreFloatLE(&dst[0], sample0);
+            SDL_StoreFloatLE(&dst[1], sample1);
+            SDL_StoreFloatLE(&dst[2], sample2);
+            SDL_StoreFloatLE(&dst[3], sample3);
+            SDL_StoreFloatLE(&dst[4], sample4);
+            SDL_StoreFloatLE(&dst[5], sample5);
             dst += 6;
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatLE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatLE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatLE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample5 = (float) ((((double) SDL_SwapFloatLE(src[5])) + ((double) last_sample5)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatLE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatLE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatLE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatLE(&src[5])) + ((double) last_sample5)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             last_sample2 = sample2;
@@ -6491,14 +6525,14 @@ SDL_Upsample_F32LSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 8;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 8;
     const float *target = ((const float *) cvt->buf);
-    float sample7 = SDL_SwapFloatLE(src[7]);
-    float sample6 = SDL_SwapFloatLE(src[6]);
-    float sample5 = SDL_SwapFloatLE(src[5]);
-    float sample4 = SDL_SwapFloatLE(src[4]);
-    float sample3 = SDL_SwapFloatLE(src[3]);
-    float sample2 = SDL_SwapFloatLE(src[2]);
-    float sample1 = SDL_SwapFloatLE(src[1]);
-    float sample0 = SDL_SwapFloatLE(src[0]);
+    float sample7 = SDL_LoadFloatLE(&src[7]);
+    float sample6 = SDL_LoadFloatLE(&src[6]);
+    float sample5 = SDL_LoadFloatLE(&src[5]);
+    float sample4 = SDL_LoadFloatLE(&src[4]);
+    float sample3 = SDL_LoadFloatLE(&src[3]);
+    float sample2 = SDL_LoadFloatLE(&src[2]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
     float last_sample7 = sample7;
     float last_sample6 = sample6;
     float last_sample5 = sample5;
@@ -6508,26 +6542,26 @@ SDL_Upsample_F32LSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[7] = SDL_SwapFloatLE(sample7);
-        dst[6] = SDL_SwapFloatLE(sample6);
-        dst[5] = SDL_SwapFloatLE(sample5);
-        dst[4] = SDL_SwapFloatLE(sample4);
-        dst[3] = SDL_SwapFloatLE(sample3);
-        dst[2] = SDL_SwapFloatLE(sample2);
-        dst[1] = SDL_SwapFloatLE(sample1);
-        dst[0] = SDL_SwapFloatLE(sample0);
+        SDL_StoreFloatLE(&dst[7], sample7);
+        SDL_StoreFloatLE(&dst[6], sample6);
+        SDL_StoreFloatLE(&dst[5], sample5);
+        SDL_StoreFloatLE(&dst[4], sample4);
+        SDL_StoreFloatLE(&dst[3], sample3);
+        SDL_StoreFloatLE(&dst[2], sample2);
+        SDL_StoreFloatLE(&dst[1], sample1);
+        SDL_StoreFloatLE(&dst[0], sample0);
         dst -= 8;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 8;
-            sample7 = (float) ((((double) SDL_SwapFloatLE(src[7])) + ((double) last_sample7)) * 0.5);
-            sample6 = (float) ((((double) SDL_SwapFloatLE(src[6])) + ((double) last_sample6)) * 0.5);
-            sample5 = (float) ((((double) SDL_SwapFloatLE(src[5])) + ((double) last_sample5)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatLE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatLE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatLE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample7 = (float) ((((double) SDL_LoadFloatLE(&src[7])) + ((double) last_sample7)) * 0.5);
+            sample6 = (float) ((((double) SDL_LoadFloatLE(&src[6])) + ((double) last_sample6)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatLE(&src[5])) + ((double) last_sample5)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatLE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatLE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatLE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample7 = sample7;
             last_sample6 = sample6;
             last_sample5 = sample5;
@@ -6558,14 +6592,14 @@ SDL_Downsample_F32LSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatLE(src[0]);
-    float sample1 = SDL_SwapFloatLE(src[1]);
-    float sample2 = SDL_SwapFloatLE(src[2]);
-    float sample3 = SDL_SwapFloatLE(src[3]);
-    float sample4 = SDL_SwapFloatLE(src[4]);
-    float sample5 = SDL_SwapFloatLE(src[5]);
-    float sample6 = SDL_SwapFloatLE(src[6]);
-    float sample7 = SDL_SwapFloatLE(src[7]);
+    float sample0 = SDL_LoadFloatLE(&src[0]);
+    float sample1 = SDL_LoadFloatLE(&src[1]);
+    float sample2 = SDL_LoadFloatLE(&src[2]);
+    float sample3 = SDL_LoadFloatLE(&src[3]);
+    float sample4 = SDL_LoadFloatLE(&src[4]);
+    float sample5 = SDL_LoadFloatLE(&src[5]);
+    float sample6 = SDL_LoadFloatLE(&src[6]);
+    float sample7 = SDL_LoadFloatLE(&src[7]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     float last_sample2 = sample2;
@@ -6578,23 +6612,23 @@ SDL_Downsample_F32LSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
         src += 8;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatLE(sample0);
-            dst[1] = SDL_SwapFloatLE(sample1);
-            dst[2] = SDL_SwapFloatLE(sample2);
-            dst[3] = SDL_SwapFloatLE(sample3);
-            dst[4] = SDL_SwapFloatLE(sample4);
-            dst[5] = SDL_SwapFloatLE(sample5);
-            dst[6] = SDL_SwapFloatLE(sample6);
-            dst[7] = SDL_SwapFloatLE(sample7);
+            SDL_StoreFloatLE(&dst[0], sample0);
+            SDL_StoreFloatLE(&dst[1], sample1);
+            SDL_StoreFloatLE(&dst[2], sample2);
+            SDL_StoreFloatLE(&dst[3], sample3);
+            SDL_StoreFloatLE(&dst[4], sample4);
+            SDL_StoreFloatLE(&dst[5], sample5);
+            SDL_StoreFloatLE(&dst[6], sample6);
+            SDL_StoreFloatLE(&dst[7], sample7);
             dst += 8;
-            sample0 = (float) ((((double) SDL_SwapFloatLE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatLE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatLE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatLE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatLE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample5 = (float) ((((double) SDL_SwapFloatLE(src[5])) + ((double) last_sample5)) * 0.5);
-            sample6 = (float) ((((double) SDL_SwapFloatLE(src[6])) + ((double) last_sample6)) * 0.5);
-            sample7 = (float) ((((double) SDL_SwapFloatLE(src[7])) + ((double) last_sample7)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatLE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatLE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatLE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatLE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatLE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatLE(&src[5])) + ((double) last_sample5)) * 0.5);
+            sample6 = (float) ((((double) SDL_LoadFloatLE(&src[6])) + ((double) last_sample6)) * 0.5);
+            sample7 = (float) ((((double) SDL_LoadFloatLE(&src[7])) + ((double) last_sample7)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             last_sample2 = sample2;
@@ -6625,15 +6659,15 @@ SDL_Upsample_F32MSB_1c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 1;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 1;
     const float *target = ((const float *) cvt->buf);
-    float sample0 = SDL_SwapFloatBE(src[0]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[0] = SDL_SwapFloatBE(sample0);
+        SDL_StoreFloatBE(&dst[0], sample0);
         dst--;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src--;
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample0 = sample0;
             eps -= dstsize;
         }
@@ -6657,15 +6691,15 @@ SDL_Downsample_F32MSB_1c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatBE(src[0]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
     float last_sample0 = sample0;
     while (dst < target) {
         src++;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatBE(sample0);
+            SDL_StoreFloatBE(&dst[0], sample0);
             dst++;
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample0 = sample0;
             eps -= srcsize;
         }
@@ -6689,19 +6723,19 @@ SDL_Upsample_F32MSB_2c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 2;
     const float *target = ((const float *) cvt->buf);
-    float sample1 = SDL_SwapFloatBE(src[1]);
-    float sample0 = SDL_SwapFloatBE(src[0]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[1] = SDL_SwapFloatBE(sample1);
-        dst[0] = SDL_SwapFloatBE(sample0);
+        SDL_StoreFloatBE(&dst[1], sample1);
+        SDL_StoreFloatBE(&dst[0], sample0);
         dst -= 2;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 2;
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample1 = sample1;
             last_sample0 = sample0;
             eps -= dstsize;
@@ -6726,19 +6760,19 @@ SDL_Downsample_F32MSB_2c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatBE(src[0]);
-    float sample1 = SDL_SwapFloatBE(src[1]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     while (dst < target) {
         src += 2;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatBE(sample0);
-            dst[1] = SDL_SwapFloatBE(sample1);
+            SDL_StoreFloatBE(&dst[0], sample0);
+            SDL_StoreFloatBE(&dst[1], sample1);
             dst += 2;
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             eps -= srcsize;
@@ -6763,27 +6797,27 @@ SDL_Upsample_F32MSB_4c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 4;
     const float *target = ((const float *) cvt->buf);
-    float sample3 = SDL_SwapFloatBE(src[3]);
-    float sample2 = SDL_SwapFloatBE(src[2]);
-    float sample1 = SDL_SwapFloatBE(src[1]);
-    float sample0 = SDL_SwapFloatBE(src[0]);
+    float sample3 = SDL_LoadFloatBE(&src[3]);
+    float sample2 = SDL_LoadFloatBE(&src[2]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
     float last_sample3 = sample3;
     float last_sample2 = sample2;
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[3] = SDL_SwapFloatBE(sample3);
-        dst[2] = SDL_SwapFloatBE(sample2);
-        dst[1] = SDL_SwapFloatBE(sample1);
-        dst[0] = SDL_SwapFloatBE(sample0);
+        SDL_StoreFloatBE(&dst[3], sample3);
+        SDL_StoreFloatBE(&dst[2], sample2);
+        SDL_StoreFloatBE(&dst[1], sample1);
+        SDL_StoreFloatBE(&dst[0], sample0);
         dst -= 4;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 4;
-            sample3 = (float) ((((double) SDL_SwapFloatBE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatBE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatBE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatBE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample3 = sample3;
             last_sample2 = sample2;
             last_sample1 = sample1;
@@ -6810,10 +6844,10 @@ SDL_Downsample_F32MSB_4c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatBE(src[0]);
-    float sample1 = SDL_SwapFloatBE(src[1]);
-    float sample2 = SDL_SwapFloatBE(src[2]);
-    float sample3 = SDL_SwapFloatBE(src[3]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
+    float sample2 = SDL_LoadFloatBE(&src[2]);
+    float sample3 = SDL_LoadFloatBE(&src[3]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     float last_sample2 = sample2;
@@ -6822,15 +6856,15 @@ SDL_Downsample_F32MSB_4c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
         src += 4;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatBE(sample0);
-            dst[1] = SDL_SwapFloatBE(sample1);
-            dst[2] = SDL_SwapFloatBE(sample2);
-            dst[3] = SDL_SwapFloatBE(sample3);
+            SDL_StoreFloatBE(&dst[0], sample0);
+            SDL_StoreFloatBE(&dst[1], sample1);
+            SDL_StoreFloatBE(&dst[2], sample2);
+            SDL_StoreFloatBE(&dst[3], sample3);
             dst += 4;
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatBE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatBE(src[3])) + ((double) last_sample3)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatBE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatBE(&src[3])) + ((double) last_sample3)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             last_sample2 = sample2;
@@ -6857,12 +6891,12 @@ SDL_Upsample_F32MSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 6;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 6;
     const float *target = ((const float *) cvt->buf);
-    float sample5 = SDL_SwapFloatBE(src[5]);
-    float sample4 = SDL_SwapFloatBE(src[4]);
-    float sample3 = SDL_SwapFloatBE(src[3]);
-    float sample2 = SDL_SwapFloatBE(src[2]);
-    float sample1 = SDL_SwapFloatBE(src[1]);
-    float sample0 = SDL_SwapFloatBE(src[0]);
+    float sample5 = SDL_LoadFloatBE(&src[5]);
+    float sample4 = SDL_LoadFloatBE(&src[4]);
+    float sample3 = SDL_LoadFloatBE(&src[3]);
+    float sample2 = SDL_LoadFloatBE(&src[2]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
     float last_sample5 = sample5;
     float last_sample4 = sample4;
     float last_sample3 = sample3;
@@ -6870,22 +6904,22 @@ SDL_Upsample_F32MSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[5] = SDL_SwapFloatBE(sample5);
-        dst[4] = SDL_SwapFloatBE(sample4);
-        dst[3] = SDL_SwapFloatBE(sample3);
-        dst[2] = SDL_SwapFloatBE(sample2);
-        dst[1] = SDL_SwapFloatBE(sample1);
-        dst[0] = SDL_SwapFloatBE(sample0);
+        SDL_StoreFloatBE(&dst[5], sample5);
+        SDL_StoreFloatBE(&dst[4], sample4);
+        SDL_StoreFloatBE(&dst[3], sample3);
+        SDL_StoreFloatBE(&dst[2], sample2);
+        SDL_StoreFloatBE(&dst[1], sample1);
+        SDL_StoreFloatBE(&dst[0], sample0);
         dst -= 6;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 6;
-            sample5 = (float) ((((double) SDL_SwapFloatBE(src[5])) + ((double) last_sample5)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatBE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatBE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatBE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatBE(&src[5])) + ((double) last_sample5)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatBE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatBE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatBE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample5 = sample5;
             last_sample4 = sample4;
             last_sample3 = sample3;
@@ -6914,12 +6948,12 @@ SDL_Downsample_F32MSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatBE(src[0]);
-    float sample1 = SDL_SwapFloatBE(src[1]);
-    float sample2 = SDL_SwapFloatBE(src[2]);
-    float sample3 = SDL_SwapFloatBE(src[3]);
-    float sample4 = SDL_SwapFloatBE(src[4]);
-    float sample5 = SDL_SwapFloatBE(src[5]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
+    float sample2 = SDL_LoadFloatBE(&src[2]);
+    float sample3 = SDL_LoadFloatBE(&src[3]);
+    float sample4 = SDL_LoadFloatBE(&src[4]);
+    float sample5 = SDL_LoadFloatBE(&src[5]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     float last_sample2 = sample2;
@@ -6930,19 +6964,19 @@ SDL_Downsample_F32MSB_6c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
         src += 6;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatBE(sample0);
-            dst[1] = SDL_SwapFloatBE(sample1);
-            dst[2] = SDL_SwapFloatBE(sample2);
-            dst[3] = SDL_SwapFloatBE(sample3);
-            dst[4] = SDL_SwapFloatBE(sample4);
-            dst[5] = SDL_SwapFloatBE(sample5);
+            SDL_StoreFloatBE(&dst[0], sample0);
+            SDL_StoreFloatBE(&dst[1], sample1);
+            SDL_StoreFloatBE(&dst[2], sample2);
+            SDL_StoreFloatBE(&dst[3], sample3);
+            SDL_StoreFloatBE(&dst[4], sample4);
+            SDL_StoreFloatBE(&dst[5], sample5);
             dst += 6;
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatBE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatBE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatBE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample5 = (float) ((((double) SDL_SwapFloatBE(src[5])) + ((double) last_sample5)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatBE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatBE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatBE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatBE(&src[5])) + ((double) last_sample5)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             last_sample2 = sample2;
@@ -6971,14 +7005,14 @@ SDL_Upsample_F32MSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 8;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 8;
     const float *target = ((const float *) cvt->buf);
-    float sample7 = SDL_SwapFloatBE(src[7]);
-    float sample6 = SDL_SwapFloatBE(src[6]);
-    float sample5 = SDL_SwapFloatBE(src[5]);
-    float sample4 = SDL_SwapFloatBE(src[4]);
-    float sample3 = SDL_SwapFloatBE(src[3]);
-    float sample2 = SDL_SwapFloatBE(src[2]);
-    float sample1 = SDL_SwapFloatBE(src[1]);
-    float sample0 = SDL_SwapFloatBE(src[0]);
+    float sample7 = SDL_LoadFloatBE(&src[7]);
+    float sample6 = SDL_LoadFloatBE(&src[6]);
+    float sample5 = SDL_LoadFloatBE(&src[5]);
+    float sample4 = SDL_LoadFloatBE(&src[4]);
+    float sample3 = SDL_LoadFloatBE(&src[3]);
+    float sample2 = SDL_LoadFloatBE(&src[2]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
     float last_sample7 = sample7;
     float last_sample6 = sample6;
     float last_sample5 = sample5;
@@ -6988,26 +7022,26 @@ SDL_Upsample_F32MSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float last_sample1 = sample1;
     float last_sample0 = sample0;
     while (dst >= target) {
-        dst[7] = SDL_SwapFloatBE(sample7);
-        dst[6] = SDL_SwapFloatBE(sample6);
-        dst[5] = SDL_SwapFloatBE(sample5);
-        dst[4] = SDL_SwapFloatBE(sample4);
-        dst[3] = SDL_SwapFloatBE(sample3);
-        dst[2] = SDL_SwapFloatBE(sample2);
-        dst[1] = SDL_SwapFloatBE(sample1);
-        dst[0] = SDL_SwapFloatBE(sample0);
+        SDL_StoreFloatBE(&dst[7], sample7);
+        SDL_StoreFloatBE(&dst[6], sample6);
+        SDL_StoreFloatBE(&dst[5], sample5);
+        SDL_StoreFloatBE(&dst[4], sample4);
+        SDL_StoreFloatBE(&dst[3], sample3);
+        SDL_StoreFloatBE(&dst[2], sample2);
+        SDL_StoreFloatBE(&dst[1], sample1);
+        SDL_StoreFloatBE(&dst[0], sample0);
         dst -= 8;
         eps += srcsize;
         if ((eps << 1) >= dstsize) {
             src -= 8;
-            sample7 = (float) ((((double) SDL_SwapFloatBE(src[7])) + ((double) last_sample7)) * 0.5);
-            sample6 = (float) ((((double) SDL_SwapFloatBE(src[6])) + ((double) last_sample6)) * 0.5);
-            sample5 = (float) ((((double) SDL_SwapFloatBE(src[5])) + ((double) last_sample5)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatBE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatBE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatBE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
+            sample7 = (float) ((((double) SDL_LoadFloatBE(&src[7])) + ((double) last_sample7)) * 0.5);
+            sample6 = (float) ((((double) SDL_LoadFloatBE(&src[6])) + ((double) last_sample6)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatBE(&src[5])) + ((double) last_sample5)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatBE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatBE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatBE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
             last_sample7 = sample7;
             last_sample6 = sample6;
             last_sample5 = sample5;
@@ -7038,14 +7072,14 @@ SDL_Downsample_F32MSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    float sample0 = SDL_SwapFloatBE(src[0]);
-    float sample1 = SDL_SwapFloatBE(src[1]);
-    float sample2 = SDL_SwapFloatBE(src[2]);
-    float sample3 = SDL_SwapFloatBE(src[3]);
-    float sample4 = SDL_SwapFloatBE(src[4]);
-    float sample5 = SDL_SwapFloatBE(src[5]);
-    float sample6 = SDL_SwapFloatBE(src[6]);
-    float sample7 = SDL_SwapFloatBE(src[7]);
+    float sample0 = SDL_LoadFloatBE(&src[0]);
+    float sample1 = SDL_LoadFloatBE(&src[1]);
+    float sample2 = SDL_LoadFloatBE(&src[2]);
+    float sample3 = SDL_LoadFloatBE(&src[3]);
+    float sample4 = SDL_LoadFloatBE(&src[4]);
+    float sample5 = SDL_LoadFloatBE(&src[5]);
+    float sample6 = SDL_LoadFloatBE(&src[6]);
+    float sample7 = SDL_LoadFloatBE(&src[7]);
     float last_sample0 = sample0;
     float last_sample1 = sample1;
     float last_sample2 = sample2;
@@ -7058,23 +7092,23 @@ SDL_Downsample_F32MSB_8c(SDL_AudioCVT * cvt, SDL_AudioFormat format)
         src += 8;
         eps += dstsize;
         if ((eps << 1) >= srcsize) {
-            dst[0] = SDL_SwapFloatBE(sample0);
-            dst[1] = SDL_SwapFloatBE(sample1);
-            dst[2] = SDL_SwapFloatBE(sample2);
-            dst[3] = SDL_SwapFloatBE(sample3);
-            dst[4] = SDL_SwapFloatBE(sample4);
-            dst[5] = SDL_SwapFloatBE(sample5);
-            dst[6] = SDL_SwapFloatBE(sample6);
-            dst[7] = SDL_SwapFloatBE(sample7);
+            SDL_StoreFloatBE(&dst[0], sample0);
+            SDL_StoreFloatBE(&dst[1], sample1);
+            SDL_StoreFloatBE(&dst[2], sample2);
+            SDL_StoreFloatBE(&dst[3], sample3);
+            SDL_StoreFloatBE(&dst[4], sample4);
+            SDL_StoreFloatBE(&dst[5], sample5);
+            SDL_StoreFloatBE(&dst[6], sample6);
+            SDL_StoreFloatBE(&dst[7], sample7);
             dst += 8;
-            sample0 = (float) ((((double) SDL_SwapFloatBE(src[0])) + ((double) last_sample0)) * 0.5);
-            sample1 = (float) ((((double) SDL_SwapFloatBE(src[1])) + ((double) last_sample1)) * 0.5);
-            sample2 = (float) ((((double) SDL_SwapFloatBE(src[2])) + ((double) last_sample2)) * 0.5);
-            sample3 = (float) ((((double) SDL_SwapFloatBE(src[3])) + ((double) last_sample3)) * 0.5);
-            sample4 = (float) ((((double) SDL_SwapFloatBE(src[4])) + ((double) last_sample4)) * 0.5);
-            sample5 = (float) ((((double) SDL_SwapFloatBE(src[5])) + ((double) last_sample5)) * 0.5);
-            sample6 = (float) ((((double) SDL_SwapFloatBE(src[6])) + ((double) last_sample6)) * 0.5);
-            sample7 = (float) ((((double) SDL_SwapFloatBE(src[7])) + ((double) last_sample7)) * 0.5);
+            sample0 = (float) ((((double) SDL_LoadFloatBE(&src[0])) + ((double) last_sample0)) * 0.5);
+            sample1 = (float) ((((double) SDL_LoadFloatBE(&src[1])) + ((double) last_sample1)) * 0.5);
+            sample2 = (float) ((((double) SDL_LoadFloatBE(&src[2])) + ((double) last_sample2)) * 0.5);
+            sample3 = (float) ((((double) SDL_LoadFloatBE(&src[3])) + ((double) last_sample3)) * 0.5);
+            sample4 = (float) ((((double) SDL_LoadFloatBE(&src[4])) + ((double) last_sample4)) * 0.5);
+            sample5 = (float) ((((double) SDL_LoadFloatBE(&src[5])) + ((double) last_sample5)) * 0.5);
+            sample6 = (float) ((((double) SDL_LoadFloatBE(&src[6])) + ((double) last_sample6)) * 0.5);
+            sample7 = (float) ((((double) SDL_LoadFloatBE(&src[7])) + ((double) last_sample7)) * 0.5);
             last_sample0 = sample0;
             last_sample1 = sample1;
             last_sample2 = sample2;
@@ -13986,9 +14020,9 @@ SDL_Upsample_F32LSB_1c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 1 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 1;
     const float *target = ((const float *) cvt->buf);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
     while (dst >= target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src--;
         dst[1] = (float) ((sample0 + last_sample0) * 0.5);
         dst[0] = (float) sample0;
@@ -14013,9 +14047,9 @@ SDL_Downsample_F32LSB_1c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src += 2;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         last_sample0 = sample0;
@@ -14039,9 +14073,9 @@ SDL_Upsample_F32LSB_1c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 1 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 1;
     const float *target = ((const float *) cvt->buf);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
     while (dst >= target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src--;
         dst[3] = (float) ((sample0 + (3.0 * last_sample0)) * 0.25);
         dst[2] = (float) ((sample0 + last_sample0) * 0.5);
@@ -14068,9 +14102,9 @@ SDL_Downsample_F32LSB_1c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src += 4;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         last_sample0 = sample0;
@@ -14094,11 +14128,11 @@ SDL_Upsample_F32LSB_2c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 2 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 2;
     const float *target = ((const float *) cvt->buf);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
     while (dst >= target) {
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 2;
         dst[3] = (float) ((sample1 + last_sample1) * 0.5);
         dst[2] = (float) ((sample0 + last_sample0) * 0.5);
@@ -14126,11 +14160,11 @@ SDL_Downsample_F32LSB_2c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
         src += 4;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14156,11 +14190,11 @@ SDL_Upsample_F32LSB_2c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 2 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 2;
     const float *target = ((const float *) cvt->buf);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
     while (dst >= target) {
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 2;
         dst[7] = (float) ((sample1 + (3.0 * last_sample1)) * 0.25);
         dst[6] = (float) ((sample0 + (3.0 * last_sample0)) * 0.25);
@@ -14192,11 +14226,11 @@ SDL_Downsample_F32LSB_2c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
         src += 8;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14222,15 +14256,15 @@ SDL_Upsample_F32LSB_4c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 4 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 4;
     const float *target = ((const float *) cvt->buf);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    while (dst >= target) {
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    while (dst >= target) {
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 4;
         dst[7] = (float) ((sample3 + last_sample3) * 0.5);
         dst[6] = (float) ((sample2 + last_sample2) * 0.5);
@@ -14264,15 +14298,15 @@ SDL_Downsample_F32LSB_4c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
         src += 8;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14302,15 +14336,15 @@ SDL_Upsample_F32LSB_4c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 4 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 4;
     const float *target = ((const float *) cvt->buf);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    while (dst >= target) {
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    while (dst >= target) {
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 4;
         dst[15] = (float) ((sample3 + (3.0 * last_sample3)) * 0.25);
         dst[14] = (float) ((sample2 + (3.0 * last_sample2)) * 0.25);
@@ -14352,15 +14386,15 @@ SDL_Downsample_F32LSB_4c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
         src += 16;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14390,19 +14424,19 @@ SDL_Upsample_F32LSB_6c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 6 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 6;
     const float *target = ((const float *) cvt->buf);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    while (dst >= target) {
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    while (dst >= target) {
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 6;
         dst[11] = (float) ((sample5 + last_sample5) * 0.5);
         dst[10] = (float) ((sample4 + last_sample4) * 0.5);
@@ -14442,19 +14476,19 @@ SDL_Downsample_F32LSB_6c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
         src += 12;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14488,19 +14522,19 @@ SDL_Upsample_F32LSB_6c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 6 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 6;
     const float *target = ((const float *) cvt->buf);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    while (dst >= target) {
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    while (dst >= target) {
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 6;
         dst[23] = (float) ((sample5 + (3.0 * last_sample5)) * 0.25);
         dst[22] = (float) ((sample4 + (3.0 * last_sample4)) * 0.25);
@@ -14552,19 +14586,19 @@ SDL_Downsample_F32LSB_6c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
         src += 24;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14598,23 +14632,23 @@ SDL_Upsample_F32LSB_8c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 8 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 8;
     const float *target = ((const float *) cvt->buf);
-    double last_sample7 = (double) SDL_SwapFloatLE(src[7]);
-    double last_sample6 = (double) SDL_SwapFloatLE(src[6]);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    while (dst >= target) {
-        const double sample7 = (double) SDL_SwapFloatLE(src[7]);
-        const double sample6 = (double) SDL_SwapFloatLE(src[6]);
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample7 = (double) SDL_LoadFloatLE(&src[7]);
+    double last_sample6 = (double) SDL_LoadFloatLE(&src[6]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    while (dst >= target) {
+        const double sample7 = (double) SDL_LoadFloatLE(&src[7]);
+        const double sample6 = (double) SDL_LoadFloatLE(&src[6]);
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 8;
         dst[15] = (float) ((sample7 + last_sample7) * 0.5);
         dst[14] = (float) ((sample6 + last_sample6) * 0.5);
@@ -14660,23 +14694,23 @@ SDL_Downsample_F32LSB_8c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    double last_sample6 = (double) SDL_SwapFloatLE(src[6]);
-    double last_sample7 = (double) SDL_SwapFloatLE(src[7]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
-        const double sample6 = (double) SDL_SwapFloatLE(src[6]);
-        const double sample7 = (double) SDL_SwapFloatLE(src[7]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    double last_sample6 = (double) SDL_LoadFloatLE(&src[6]);
+    double last_sample7 = (double) SDL_LoadFloatLE(&src[7]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
+        const double sample6 = (double) SDL_LoadFloatLE(&src[6]);
+        const double sample7 = (double) SDL_LoadFloatLE(&src[7]);
         src += 16;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14714,23 +14748,23 @@ SDL_Upsample_F32LSB_8c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 8 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 8;
     const float *target = ((const float *) cvt->buf);
-    double last_sample7 = (double) SDL_SwapFloatLE(src[7]);
-    double last_sample6 = (double) SDL_SwapFloatLE(src[6]);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    while (dst >= target) {
-        const double sample7 = (double) SDL_SwapFloatLE(src[7]);
-        const double sample6 = (double) SDL_SwapFloatLE(src[6]);
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
+    double last_sample7 = (double) SDL_LoadFloatLE(&src[7]);
+    double last_sample6 = (double) SDL_LoadFloatLE(&src[6]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    while (dst >= target) {
+        const double sample7 = (double) SDL_LoadFloatLE(&src[7]);
+        const double sample6 = (double) SDL_LoadFloatLE(&src[6]);
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
         src -= 8;
         dst[31] = (float) ((sample7 + (3.0 * last_sample7)) * 0.25);
         dst[30] = (float) ((sample6 + (3.0 * last_sample6)) * 0.25);
@@ -14792,23 +14826,23 @@ SDL_Downsample_F32LSB_8c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatLE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatLE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatLE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatLE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatLE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatLE(src[5]);
-    double last_sample6 = (double) SDL_SwapFloatLE(src[6]);
-    double last_sample7 = (double) SDL_SwapFloatLE(src[7]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatLE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatLE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatLE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatLE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatLE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatLE(src[5]);
-        const double sample6 = (double) SDL_SwapFloatLE(src[6]);
-        const double sample7 = (double) SDL_SwapFloatLE(src[7]);
+    double last_sample0 = (double) SDL_LoadFloatLE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatLE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatLE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatLE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatLE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatLE(&src[5]);
+    double last_sample6 = (double) SDL_LoadFloatLE(&src[6]);
+    double last_sample7 = (double) SDL_LoadFloatLE(&src[7]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatLE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatLE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatLE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatLE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatLE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatLE(&src[5]);
+        const double sample6 = (double) SDL_LoadFloatLE(&src[6]);
+        const double sample7 = (double) SDL_LoadFloatLE(&src[7]);
         src += 32;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -14846,9 +14880,9 @@ SDL_Upsample_F32MSB_1c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 1 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 1;
     const float *target = ((const float *) cvt->buf);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
     while (dst >= target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src--;
         dst[1] = (float) ((sample0 + last_sample0) * 0.5);
         dst[0] = (float) sample0;
@@ -14873,9 +14907,9 @@ SDL_Downsample_F32MSB_1c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src += 2;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         last_sample0 = sample0;
@@ -14899,9 +14933,9 @@ SDL_Upsample_F32MSB_1c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 1 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 1;
     const float *target = ((const float *) cvt->buf);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
     while (dst >= target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src--;
         dst[3] = (float) ((sample0 + (3.0 * last_sample0)) * 0.25);
         dst[2] = (float) ((sample0 + last_sample0) * 0.5);
@@ -14928,9 +14962,9 @@ SDL_Downsample_F32MSB_1c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src += 4;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         last_sample0 = sample0;
@@ -14954,11 +14988,11 @@ SDL_Upsample_F32MSB_2c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 2 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 2;
     const float *target = ((const float *) cvt->buf);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
     while (dst >= target) {
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 2;
         dst[3] = (float) ((sample1 + last_sample1) * 0.5);
         dst[2] = (float) ((sample0 + last_sample0) * 0.5);
@@ -14986,11 +15020,11 @@ SDL_Downsample_F32MSB_2c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
         src += 4;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -15016,11 +15050,11 @@ SDL_Upsample_F32MSB_2c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 2 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 2;
     const float *target = ((const float *) cvt->buf);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
     while (dst >= target) {
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 2;
         dst[7] = (float) ((sample1 + (3.0 * last_sample1)) * 0.25);
         dst[6] = (float) ((sample0 + (3.0 * last_sample0)) * 0.25);
@@ -15052,11 +15086,11 @@ SDL_Downsample_F32MSB_2c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
     while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
         src += 8;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -15082,15 +15116,15 @@ SDL_Upsample_F32MSB_4c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 4 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 4;
     const float *target = ((const float *) cvt->buf);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    while (dst >= target) {
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    while (dst >= target) {
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 4;
         dst[7] = (float) ((sample3 + last_sample3) * 0.5);
         dst[6] = (float) ((sample2 + last_sample2) * 0.5);
@@ -15124,15 +15158,15 @@ SDL_Downsample_F32MSB_4c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
         src += 8;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -15162,15 +15196,15 @@ SDL_Upsample_F32MSB_4c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 4 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 4;
     const float *target = ((const float *) cvt->buf);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    while (dst >= target) {
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    while (dst >= target) {
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 4;
         dst[15] = (float) ((sample3 + (3.0 * last_sample3)) * 0.25);
         dst[14] = (float) ((sample2 + (3.0 * last_sample2)) * 0.25);
@@ -15212,15 +15246,15 @@ SDL_Downsample_F32MSB_4c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
         src += 16;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -15250,19 +15284,19 @@ SDL_Upsample_F32MSB_6c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 6 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 6;
     const float *target = ((const float *) cvt->buf);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    while (dst >= target) {
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    while (dst >= target) {
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 6;
         dst[11] = (float) ((sample5 + last_sample5) * 0.5);
         dst[10] = (float) ((sample4 + last_sample4) * 0.5);
@@ -15302,19 +15336,19 @@ SDL_Downsample_F32MSB_6c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
         src += 12;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -15348,19 +15382,19 @@ SDL_Upsample_F32MSB_6c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 6 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 6;
     const float *target = ((const float *) cvt->buf);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    while (dst >= target) {
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    while (dst >= target) {
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 6;
         dst[23] = (float) ((sample5 + (3.0 * last_sample5)) * 0.25);
         dst[22] = (float) ((sample4 + (3.0 * last_sample4)) * 0.25);
@@ -15412,19 +15446,19 @@ SDL_Downsample_F32MSB_6c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
         src += 24;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -15458,23 +15492,23 @@ SDL_Upsample_F32MSB_8c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 8 * 2;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 8;
     const float *target = ((const float *) cvt->buf);
-    double last_sample7 = (double) SDL_SwapFloatBE(src[7]);
-    double last_sample6 = (double) SDL_SwapFloatBE(src[6]);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    while (dst >= target) {
-        const double sample7 = (double) SDL_SwapFloatBE(src[7]);
-        const double sample6 = (double) SDL_SwapFloatBE(src[6]);
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample7 = (double) SDL_LoadFloatBE(&src[7]);
+    double last_sample6 = (double) SDL_LoadFloatBE(&src[6]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    while (dst >= target) {
+        const double sample7 = (double) SDL_LoadFloatBE(&src[7]);
+        const double sample6 = (double) SDL_LoadFloatBE(&src[6]);
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 8;
         dst[15] = (float) ((sample7 + last_sample7) * 0.5);
         dst[14] = (float) ((sample6 + last_sample6) * 0.5);
@@ -15520,23 +15554,23 @@ SDL_Downsample_F32MSB_8c_x2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    double last_sample6 = (double) SDL_SwapFloatBE(src[6]);
-    double last_sample7 = (double) SDL_SwapFloatBE(src[7]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
-        const double sample6 = (double) SDL_SwapFloatBE(src[6]);
-        const double sample7 = (double) SDL_SwapFloatBE(src[7]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    double last_sample6 = (double) SDL_LoadFloatBE(&src[6]);
+    double last_sample7 = (double) SDL_LoadFloatBE(&src[7]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
+        const double sample6 = (double) SDL_LoadFloatBE(&src[6]);
+        const double sample7 = (double) SDL_LoadFloatBE(&src[7]);
         src += 16;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
@@ -15574,23 +15608,23 @@ SDL_Upsample_F32MSB_8c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = ((float *) (cvt->buf + dstsize)) - 8 * 4;
     const float *src = ((float *) (cvt->buf + cvt->len_cvt)) - 8;
     const float *target = ((const float *) cvt->buf);
-    double last_sample7 = (double) SDL_SwapFloatBE(src[7]);
-    double last_sample6 = (double) SDL_SwapFloatBE(src[6]);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    while (dst >= target) {
-        const double sample7 = (double) SDL_SwapFloatBE(src[7]);
-        const double sample6 = (double) SDL_SwapFloatBE(src[6]);
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
+    double last_sample7 = (double) SDL_LoadFloatBE(&src[7]);
+    double last_sample6 = (double) SDL_LoadFloatBE(&src[6]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    while (dst >= target) {
+        const double sample7 = (double) SDL_LoadFloatBE(&src[7]);
+        const double sample6 = (double) SDL_LoadFloatBE(&src[6]);
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
         src -= 8;
         dst[31] = (float) ((sample7 + (3.0 * last_sample7)) * 0.25);
         dst[30] = (float) ((sample6 + (3.0 * last_sample6)) * 0.25);
@@ -15652,23 +15686,23 @@ SDL_Downsample_F32MSB_8c_x4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
     float *dst = (float *) cvt->buf;
     const float *src = (float *) cvt->buf;
     const float *target = (const float *) (cvt->buf + dstsize);
-    double last_sample0 = (double) SDL_SwapFloatBE(src[0]);
-    double last_sample1 = (double) SDL_SwapFloatBE(src[1]);
-    double last_sample2 = (double) SDL_SwapFloatBE(src[2]);
-    double last_sample3 = (double) SDL_SwapFloatBE(src[3]);
-    double last_sample4 = (double) SDL_SwapFloatBE(src[4]);
-    double last_sample5 = (double) SDL_SwapFloatBE(src[5]);
-    double last_sample6 = (double) SDL_SwapFloatBE(src[6]);
-    double last_sample7 = (double) SDL_SwapFloatBE(src[7]);
-    while (dst < target) {
-        const double sample0 = (double) SDL_SwapFloatBE(src[0]);
-        const double sample1 = (double) SDL_SwapFloatBE(src[1]);
-        const double sample2 = (double) SDL_SwapFloatBE(src[2]);
-        const double sample3 = (double) SDL_SwapFloatBE(src[3]);
-        const double sample4 = (double) SDL_SwapFloatBE(src[4]);
-        const double sample5 = (double) SDL_SwapFloatBE(src[5]);
-        const double sample6 = (double) SDL_SwapFloatBE(src[6]);
-        const double sample7 = (double) SDL_SwapFloatBE(src[7]);
+    double last_sample0 = (double) SDL_LoadFloatBE(&src[0]);
+    double last_sample1 = (double) SDL_LoadFloatBE(&src[1]);
+    double last_sample2 = (double) SDL_LoadFloatBE(&src[2]);
+    double last_sample3 = (double) SDL_LoadFloatBE(&src[3]);
+    double last_sample4 = (double) SDL_LoadFloatBE(&src[4]);
+    double last_sample5 = (double) SDL_LoadFloatBE(&src[5]);
+    double last_sample6 = (double) SDL_LoadFloatBE(&src[6]);
+    double last_sample7 = (double) SDL_LoadFloatBE(&src[7]);
+    while (dst < target) {
+        const double sample0 = (double) SDL_LoadFloatBE(&src[0]);
+        const double sample1 = (double) SDL_LoadFloatBE(&src[1]);
+        const double sample2 = (double) SDL_LoadFloatBE(&src[2]);
+        const double sample3 = (double) SDL_LoadFloatBE(&src[3]);
+        const double sample4 = (double) SDL_LoadFloatBE(&src[4]);
+        const double sample5 = (double) SDL_LoadFloatBE(&src[5]);
+        const double sample6 = (double) SDL_LoadFloatBE(&src[6]);
+        const double sample7 = (double) SDL_LoadFloatBE(&src[7]);
         src += 32;
         dst[0] = (float) ((sample0 + last_sample0) * 0.5);
         dst[1] = (float) ((sample1 + last_sample1) * 0.5);
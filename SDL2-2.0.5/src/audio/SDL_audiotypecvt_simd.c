@@ -0,0 +1,924 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Vectorized sample type converters for SDL_HandTunedTypeCVT() */
+
+#include "SDL_audio.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_audio_c.h"
+#include "SDL_audio_simd.h"
+
+/* These have to give exactly what the generated converters in
+   SDL_audiotypecvt.c give, including for samples outside [-1.0, 1.0],
+   so each one follows the rounding of the matching C expression:
+   float math where C uses floats, and double math for F32 to S32 and
+   for the U8 <-> F32 pairs, whose "+/- 1.0f" the x87 builds evaluate
+   with extra precision. Out of range results are truncated to 32-bit
+   integers and then wrapped, like the casts do. */
+
+#define SDL_SWAP_SRC    0x1
+#define SDL_SWAP_DST    0x2
+
+#define DIVBY127 0.0078740157480315f
+#define DIVBY32767 3.05185094759972e-05f
+#define DIVBY2147483647 4.6566128752458e-10f
+
+Uint32
+SDL_GetAudioCPUFeatures(void)
+{
+    static Uint32 detected = 0xffffffff;
+    const char *override;
+    Uint32 features;
+
+    if (detected == 0xffffffff) {
+        Uint32 found = 0;
+#if SDL_SSE2_AUDIO
+        if (SDL_HasSSE2()) {
+            found |= SDL_AUDIO_CPU_SSE2;
+        }
+#endif
+#if SDL_AVX2_AUDIO
+        if (SDL_HasAVX2()) {
+            found |= SDL_AUDIO_CPU_AVX2;
+        }
+#endif
+#if SDL_NEON_AUDIO
+        found |= SDL_AUDIO_CPU_NEON;
+#endif
+        detected = found;
+    }
+    features = detected;
+
+    /* Allow an override for testing, but never enable what isn't there.
+       This is checked every time, so tests can compare against the
+       plain C converters. */
+    override = SDL_getenv("SDL_AUDIO_CPU_FEATURES");
+    if (override && *override) {
+        features &= (Uint32) SDL_strtoul(override, NULL, 0);
+    }
+    return features;
+}
+
+#if SDL_SSE2_AUDIO || SDL_NEON_AUDIO
+
+/* Which sides of a conversion aren't in native byte order */
+static int
+SDL_AudioTypeSwaps(SDL_AudioFormat src_fmt, SDL_AudioFormat dst_fmt)
+{
+    int swaps = 0;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    if (SDL_AUDIO_ISBIGENDIAN(src_fmt) && SDL_AUDIO_BITSIZE(src_fmt) > 8) {
+        swaps |= SDL_SWAP_SRC;
+    }
+    if (SDL_AUDIO_ISBIGENDIAN(dst_fmt) && SDL_AUDIO_BITSIZE(dst_fmt) > 8) {
+        swaps |= SDL_SWAP_DST;
+    }
+#else
+    if (SDL_AUDIO_ISLITTLEENDIAN(src_fmt) && SDL_AUDIO_BITSIZE(src_fmt) > 8) {
+        swaps |= SDL_SWAP_SRC;
+    }
+    if (SDL_AUDIO_ISLITTLEENDIAN(dst_fmt) && SDL_AUDIO_BITSIZE(dst_fmt) > 8) {
+        swaps |= SDL_SWAP_DST;
+    }
+#endif
+    return swaps;
+}
+
+/* The converters are shared by both byte orders. They write multi-byte
+   samples in the byte order of the final format of the conversion, or in
+   native order if that is a single byte type; SDL_ChooseAudioTypeCVT()
+   only hands them out for conversions that want exactly that. */
+static SDL_AudioFormat
+SDL_AudioTypeOutputFormat(SDL_AudioFormat dst_type, SDL_AudioFormat final_fmt)
+{
+    if (SDL_AUDIO_BITSIZE(dst_type) > 8 && SDL_AUDIO_BITSIZE(final_fmt) > 8) {
+        return (dst_type & ~SDL_AUDIO_MASK_ENDIAN) | (final_fmt & SDL_AUDIO_MASK_ENDIAN);
+    }
+    return dst_type;
+}
+
+static void
+SDL_RunNextAudioFilter(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index] (cvt, format);
+    }
+}
+
+/* Convert the last partial block through a zero padded copy, so it gets
+   exactly the same arithmetic as the rest of the buffer. */
+#define SDL_CONVERT_AUDIO_TAIL(block, count, srcsize, dstsize) \
+    do { \
+        SDL_memset(tmp_src, 0, sizeof (tmp_src)); \
+        SDL_memcpy(tmp_src, buf + whole * (srcsize), (samples - whole) * (srcsize)); \
+        block(tmp_src, tmp_dst, swaps); \
+        SDL_memcpy(buf + whole * (dstsize), tmp_dst, (samples - whole) * (dstsize)); \
+    } while (0)
+
+/* Run (block) over cvt->buf in place, (count) samples at a time. Growing
+   conversions go from the end of the buffer to the start, so no input is
+   overwritten before it has been read. */
+#define SDL_CONVERT_AUDIO_BLOCKS(cvt, format, dst_type, block, count, srcsize, dstsize) \
+    do { \
+        const SDL_AudioFormat dst_fmt = SDL_AudioTypeOutputFormat(dst_type, cvt->dst_format); \
+        const int swaps = SDL_AudioTypeSwaps(format, dst_fmt); \
+        const int samples = cvt->len_cvt / (srcsize); \
+        const int whole = samples - (samples % (count)); \
+        Uint8 *buf = cvt->buf; \
+        Uint8 tmp_src[(count) * (srcsize)]; \
+        Uint8 tmp_dst[(count) * (dstsize)]; \
+        int i; \
+        if ((dstsize) > (srcsize)) { \
+            if (whole < samples) { \
+                SDL_CONVERT_AUDIO_TAIL(block, count, srcsize, dstsize); \
+            } \
+            for (i = whole - (count); i >= 0; i -= (count)) { \
+                block(buf + i * (srcsize), buf + i * (dstsize), swaps); \
+            } \
+        } else { \
+            for (i = 0; i < whole; i += (count)) { \
+                block(buf + i * (srcsize), buf + i * (dstsize), swaps); \
+            } \
+            if (whole < samples) { \
+                SDL_CONVERT_AUDIO_TAIL(block, count, srcsize, dstsize); \
+            } \
+        } \
+        cvt->len_cvt = samples * (dstsize); \
+        SDL_RunNextAudioFilter(cvt, dst_fmt); \
+    } while (0)
+
+#endif /* SDL_SSE2_AUDIO || SDL_NEON_AUDIO */
+
+#if SDL_SSE2_AUDIO
+
+static SDL_INLINE __m128i
+SDL_Swap16_SSE2(const __m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+static SDL_INLINE __m128i
+SDL_Swap32_SSE2(const __m128i v)
+{
+    const __m128i w = SDL_Swap16_SSE2(v);
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(w, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static SDL_INLINE __m128
+SDL_LoadF32_SSE2(const Uint8 *src, const int swap)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i *) src);
+    return _mm_castsi128_ps(swap ? SDL_Swap32_SSE2(v) : v);
+}
+
+static SDL_INLINE void
+SDL_StoreF32_SSE2(Uint8 *dst, const __m128 f, const int swap)
+{
+    const __m128i v = _mm_castps_si128(f);
+    _mm_storeu_si128((__m128i *) dst, swap ? SDL_Swap32_SSE2(v) : v);
+}
+
+/* Four floats to (int) (f * scale), with the product rounded to double */
+static SDL_INLINE __m128i
+SDL_ScaleF32ToS32Double_SSE2(const __m128 f, const __m128d scale)
+{
+    const __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(f), scale));
+    const __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(f, f)), scale));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+/* 8 samples */
+static SDL_INLINE void
+SDL_S16_to_F32_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128 scale = _mm_set1_ps(DIVBY32767);
+    __m128i v = _mm_loadu_si128((const __m128i *) src);
+    __m128 lo, hi;
+
+    if (swaps & SDL_SWAP_SRC) {
+        v = SDL_Swap16_SSE2(v);
+    }
+    lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+    hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+    SDL_StoreF32_SSE2(dst, _mm_mul_ps(lo, scale), swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 16, _mm_mul_ps(hi, scale), swaps & SDL_SWAP_DST);
+}
+
+/* 8 samples */
+static SDL_INLINE void
+SDL_F32_to_S16_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    const __m128 a = SDL_LoadF32_SSE2(src, swaps & SDL_SWAP_SRC);
+    const __m128 b = SDL_LoadF32_SSE2(src + 16, swaps & SDL_SWAP_SRC);
+    __m128i ia = _mm_cvttps_epi32(_mm_mul_ps(a, scale));
+    __m128i ib = _mm_cvttps_epi32(_mm_mul_ps(b, scale));
+    __m128i v;
+
+    /* Keep the low 16 bits, like the cast does */
+    ia = _mm_srai_epi32(_mm_slli_epi32(ia, 16), 16);
+    ib = _mm_srai_epi32(_mm_slli_epi32(ib, 16), 16);
+    v = _mm_packs_epi32(ia, ib);
+    if (swaps & SDL_SWAP_DST) {
+        v = SDL_Swap16_SSE2(v);
+    }
+    _mm_storeu_si128((__m128i *) dst, v);
+}
+
+/* 4 samples */
+static SDL_INLINE void
+SDL_S32_to_F32_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    __m128i v = _mm_loadu_si128((const __m128i *) src);
+
+    if (swaps & SDL_SWAP_SRC) {
+        v = SDL_Swap32_SSE2(v);
+    }
+    SDL_StoreF32_SSE2(dst, _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(DIVBY2147483647)), swaps & SDL_SWAP_DST);
+}
+
+/* 4 samples */
+static SDL_INLINE void
+SDL_F32_to_S32_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128 f = SDL_LoadF32_SSE2(src, swaps & SDL_SWAP_SRC);
+    __m128i v = SDL_ScaleF32ToS32Double_SSE2(f, _mm_set1_pd(2147483647.0));
+
+    if (swaps & SDL_SWAP_DST) {
+        v = SDL_Swap32_SSE2(v);
+    }
+    _mm_storeu_si128((__m128i *) dst, v);
+}
+
+/* 16 samples */
+static SDL_INLINE void
+SDL_8_to_S16_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps, const __m128i flip)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *) src), flip);
+    __m128i lo = _mm_unpacklo_epi8(zero, v);
+    __m128i hi = _mm_unpackhi_epi8(zero, v);
+
+    if (swaps & SDL_SWAP_DST) {
+        lo = SDL_Swap16_SSE2(lo);
+        hi = SDL_Swap16_SSE2(hi);
+    }
+    _mm_storeu_si128((__m128i *) dst, lo);
+    _mm_storeu_si128((__m128i *) (dst + 16), hi);
+}
+
+static SDL_INLINE void
+SDL_U8_to_S16_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    SDL_8_to_S16_Block_SSE2(src, dst, swaps, _mm_set1_epi8((char) 0x80));
+}
+
+static SDL_INLINE void
+SDL_S8_to_S16_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    SDL_8_to_S16_Block_SSE2(src, dst, swaps, _mm_setzero_si128());
+}
+
+/* 16 samples */
+static SDL_INLINE void
+SDL_S16_to_8_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps, const __m128i flip)
+{
+    __m128i a = _mm_loadu_si128((const __m128i *) src);
+    __m128i b = _mm_loadu_si128((const __m128i *) (src + 16));
+
+    if (swaps & SDL_SWAP_SRC) {
+        a = SDL_Swap16_SSE2(a);
+        b = SDL_Swap16_SSE2(b);
+    }
+    a = _mm_packs_epi16(_mm_srai_epi16(a, 8), _mm_srai_epi16(b, 8));
+    _mm_storeu_si128((__m128i *) dst, _mm_xor_si128(a, flip));
+}
+
+static SDL_INLINE void
+SDL_S16_to_U8_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    SDL_S16_to_8_Block_SSE2(src, dst, swaps, _mm_set1_epi8((char) 0x80));
+}
+
+static SDL_INLINE void
+SDL_S16_to_S8_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    SDL_S16_to_8_Block_SSE2(src, dst, swaps, _mm_setzero_si128());
+}
+
+/* 16 samples */
+static SDL_INLINE void
+SDL_U8_to_F32_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128d scale = _mm_set1_pd((double) DIVBY127);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v = _mm_loadu_si128((const __m128i *) src);
+    const __m128i w[2] = { _mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero) };
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        const __m128i x = (i & 1) ? _mm_unpackhi_epi16(w[i >> 1], zero) : _mm_unpacklo_epi16(w[i >> 1], zero);
+        const __m128d lo = _mm_sub_pd(_mm_mul_pd(_mm_cvtepi32_pd(x), scale), one);
+        const __m128d hi = _mm_sub_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(x, 8)), scale), one);
+        SDL_StoreF32_SSE2(dst + i * 16, _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)), swaps & SDL_SWAP_DST);
+    }
+}
+
+/* 16 samples */
+static SDL_INLINE void
+SDL_S8_to_F32_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128 scale = _mm_set1_ps(DIVBY127);
+    const __m128i v = _mm_loadu_si128((const __m128i *) src);
+    const __m128i w[2] = { _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8), _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8) };
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        const __m128i x = (i & 1) ? _mm_unpackhi_epi16(w[i >> 1], w[i >> 1]) : _mm_unpacklo_epi16(w[i >> 1], w[i >> 1]);
+        const __m128 f = _mm_cvtepi32_ps(_mm_srai_epi32(x, 16));
+        SDL_StoreF32_SSE2(dst + i * 16, _mm_mul_ps(f, scale), swaps & SDL_SWAP_DST);
+    }
+}
+
+/* 16 samples */
+static SDL_INLINE void
+SDL_F32_to_U8_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128d scale = _mm_set1_pd(127.0);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i x[4];
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        const __m128 f = SDL_LoadF32_SSE2(src + i * 16, swaps & SDL_SWAP_SRC);
+        const __m128d lo = _mm_mul_pd(_mm_add_pd(_mm_cvtps_pd(f), one), scale);
+        const __m128d hi = _mm_mul_pd(_mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(f, f)), one), scale);
+        x[i] = _mm_and_si128(_mm_cvttps_epi32(_mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi))), mask);
+    }
+    _mm_storeu_si128((__m128i *) dst, _mm_packus_epi16(_mm_packs_epi32(x[0], x[1]), _mm_packs_epi32(x[2], x[3])));
+}
+
+/* 16 samples */
+static SDL_INLINE void
+SDL_F32_to_S8_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128 scale = _mm_set1_ps(127.0f);
+    __m128i x[4];
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        const __m128 f = SDL_LoadF32_SSE2(src + i * 16, swaps & SDL_SWAP_SRC);
+        const __m128i v = _mm_cvttps_epi32(_mm_mul_ps(f, scale));
+        /* Keep the low 8 bits, like the cast does */
+        x[i] = _mm_srai_epi32(_mm_slli_epi32(v, 24), 24);
+    }
+    _mm_storeu_si128((__m128i *) dst, _mm_packs_epi16(_mm_packs_epi32(x[0], x[1]), _mm_packs_epi32(x[2], x[3])));
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_F32_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S16_to_F32_Block_SSE2, 8, 2, 4);
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S16_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S16SYS, SDL_F32_to_S16_Block_SSE2, 8, 4, 2);
+}
+
+static void SDLCALL
+SDL_Convert_S32_to_F32_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S32_to_F32_Block_SSE2, 4, 4, 4);
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S32_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S32SYS, SDL_F32_to_S32_Block_SSE2, 4, 4, 4);
+}
+
+static void SDLCALL
+SDL_Convert_U8_to_S16_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S16SYS, SDL_U8_to_S16_Block_SSE2, 16, 1, 2);
+}
+
+static void SDLCALL
+SDL_Convert_S8_to_S16_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S16SYS, SDL_S8_to_S16_Block_SSE2, 16, 1, 2);
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_U8_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_U8, SDL_S16_to_U8_Block_SSE2, 16, 2, 1);
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_S8_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S8, SDL_S16_to_S8_Block_SSE2, 16, 2, 1);
+}
+
+static void SDLCALL
+SDL_Convert_U8_to_F32_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_U8_to_F32_Block_SSE2, 16, 1, 4);
+}
+
+static void SDLCALL
+SDL_Convert_S8_to_F32_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S8_to_F32_Block_SSE2, 16, 1, 4);
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_U8_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_U8, SDL_F32_to_U8_Block_SSE2, 16, 4, 1);
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S8_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S8, SDL_F32_to_S8_Block_SSE2, 16, 4, 1);
+}
+
+/* S16 to float and a channel converter in one pass, doing the math of the
+   S16 to F32 converter followed by SDL_ConvertStereo(), SDL_ConvertMono(),
+   SDL_ConvertSurround_4() or SDL_ConvertSurround(). The mixes are rounded
+   once, like the double and x87 math of the C versions: halving is exact,
+   so (l + r) / 2 is the rounded sum halved, and l - (l / 2 + r / 2) is
+   (l - r) / 2. */
+
+/* 8 samples, scaled to floats */
+static SDL_INLINE void
+SDL_LoadS16AsF32_SSE2(const Uint8 *src, const int swap, __m128 *lo, __m128 *hi)
+{
+    const __m128 scale = _mm_set1_ps(DIVBY32767);
+    __m128i v = _mm_loadu_si128((const __m128i *) src);
+
+    if (swap) {
+        v = SDL_Swap16_SSE2(v);
+    }
+    *lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), scale);
+    *hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), scale);
+}
+
+/* 8 frames, mono to stereo */
+static SDL_INLINE void
+SDL_S16_to_F32_1to2_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    __m128 lo, hi;
+
+    SDL_LoadS16AsF32_SSE2(src, swaps & SDL_SWAP_SRC, &lo, &hi);
+    SDL_StoreF32_SSE2(dst, _mm_unpacklo_ps(lo, lo), swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 16, _mm_unpackhi_ps(lo, lo), swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 32, _mm_unpacklo_ps(hi, hi), swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 48, _mm_unpackhi_ps(hi, hi), swaps & SDL_SWAP_DST);
+}
+
+/* 8 frames, stereo to mono */
+static SDL_INLINE void
+SDL_S16_to_F32_2to1_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 a, b, c, d;
+
+    SDL_LoadS16AsF32_SSE2(src, swaps & SDL_SWAP_SRC, &a, &b);
+    SDL_LoadS16AsF32_SSE2(src + 16, swaps & SDL_SWAP_SRC, &c, &d);
+    a = _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    c = _mm_add_ps(_mm_shuffle_ps(c, d, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c, d, _MM_SHUFFLE(3, 1, 3, 1)));
+    SDL_StoreF32_SSE2(dst, _mm_mul_ps(a, half), swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 16, _mm_mul_ps(c, half), swaps & SDL_SWAP_DST);
+}
+
+/* 4 frames of stereo, as left, right, left - center, right - center and center */
+static SDL_INLINE void
+SDL_LoadS16AsF32Surround_SSE2(const Uint8 *src, const int swap,
+                              __m128 *lf, __m128 *rf, __m128 *ls, __m128 *rs, __m128 *ce)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 lo, hi;
+
+    SDL_LoadS16AsF32_SSE2(src, swap, &lo, &hi);
+    *lf = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    *rf = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+    *ce = _mm_mul_ps(_mm_add_ps(*lf, *rf), half);
+    *ls = _mm_mul_ps(_mm_sub_ps(*lf, *rf), half);
+    *rs = _mm_mul_ps(_mm_sub_ps(*rf, *lf), half);
+}
+
+/* 4 frames, stereo to quad */
+static SDL_INLINE void
+SDL_S16_to_F32_2to4_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    __m128 lf, rf, ls, rs, ce;
+
+    SDL_LoadS16AsF32Surround_SSE2(src, swaps & SDL_SWAP_SRC, &lf, &rf, &ls, &rs, &ce);
+    _MM_TRANSPOSE4_PS(lf, rf, ls, rs);
+    SDL_StoreF32_SSE2(dst, lf, swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 16, rf, swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 32, ls, swaps & SDL_SWAP_DST);
+    SDL_StoreF32_SSE2(dst + 48, rs, swaps & SDL_SWAP_DST);
+}
+
+/* 4 frames, stereo to 5.1 */
+static SDL_INLINE void
+SDL_S16_to_F32_2to6_Block_SSE2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    __m128 lf, rf, ls, rs, ce, ce01, ce23;
+
+    SDL_LoadS16AsF32Surround_SSE2(src, swaps & SDL_SWAP_SRC, &lf, &rf, &ls, &rs, &ce);
+    _MM_TRANSPOSE4_PS(lf, rf, ls, rs);
+    ce01 = _mm_unpacklo_ps(ce, ce);
+    ce23 = _mm_unpackhi_ps(ce, ce);
+    if (swaps & SDL_SWAP_DST) {
+        ce01 = _mm_castsi128_ps(SDL_Swap32_SSE2(_mm_castps_si128(ce01)));
+        ce23 = _mm_castsi128_ps(SDL_Swap32_SSE2(_mm_castps_si128(ce23)));
+    }
+    SDL_StoreF32_SSE2(dst, lf, swaps & SDL_SWAP_DST);
+    _mm_storel_pi((__m64 *) (dst + 16), ce01);
+    SDL_StoreF32_SSE2(dst + 24, rf, swaps & SDL_SWAP_DST);
+    _mm_storeh_pi((__m64 *) (dst + 40), ce01);
+    SDL_StoreF32_SSE2(dst + 48, ls, swaps & SDL_SWAP_DST);
+    _mm_storel_pi((__m64 *) (dst + 64), ce23);
+    SDL_StoreF32_SSE2(dst + 72, rs, swaps & SDL_SWAP_DST);
+    _mm_storeh_pi((__m64 *) (dst + 88), ce23);
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_F32_1to2_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S16_to_F32_1to2_Block_SSE2, 8, 2, 8);
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_F32_2to1_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S16_to_F32_2to1_Block_SSE2, 8, 4, 4);
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_F32_2to4_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S16_to_F32_2to4_Block_SSE2, 4, 4, 16);
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_F32_2to6_SSE2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S16_to_F32_2to6_Block_SSE2, 4, 4, 24);
+}
+
+#endif /* SDL_SSE2_AUDIO */
+
+#if SDL_AVX2_AUDIO
+
+static SDL_TARGETING("avx2") SDL_INLINE __m256i
+SDL_Swap_AVX2(const __m256i v, const int size)
+{
+    const __m256i swap16 = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                            1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m256i swap32 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    return _mm256_shuffle_epi8(v, (size == 2) ? swap16 : swap32);
+}
+
+static SDL_TARGETING("avx2") SDL_INLINE __m256
+SDL_LoadF32_AVX2(const Uint8 *src, const int swap)
+{
+    const __m256i v = _mm256_loadu_si256((const __m256i *) src);
+    return _mm256_castsi256_ps(swap ? SDL_Swap_AVX2(v, 4) : v);
+}
+
+static SDL_TARGETING("avx2") SDL_INLINE void
+SDL_StoreF32_AVX2(Uint8 *dst, const __m256 f, const int swap)
+{
+    const __m256i v = _mm256_castps_si256(f);
+    _mm256_storeu_si256((__m256i *) dst, swap ? SDL_Swap_AVX2(v, 4) : v);
+}
+
+/* 16 samples */
+static SDL_TARGETING("avx2") SDL_INLINE void
+SDL_S16_to_F32_Block_AVX2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m256 scale = _mm256_set1_ps(DIVBY32767);
+    __m256i v = _mm256_loadu_si256((const __m256i *) src);
+    __m256 lo, hi;
+
+    if (swaps & SDL_SWAP_SRC) {
+        v = SDL_Swap_AVX2(v, 2);
+    }
+    lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(v)));
+    hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1)));
+    SDL_StoreF32_AVX2(dst, _mm256_mul_ps(lo, scale), swaps & SDL_SWAP_DST);
+    SDL_StoreF32_AVX2(dst + 32, _mm256_mul_ps(hi, scale), swaps & SDL_SWAP_DST);
+}
+
+/* 16 samples */
+static SDL_TARGETING("avx2") SDL_INLINE void
+SDL_F32_to_S16_Block_AVX2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m256 scale = _mm256_set1_ps(32767.0f);
+    const __m256 a = SDL_LoadF32_AVX2(src, swaps & SDL_SWAP_SRC);
+    const __m256 b = SDL_LoadF32_AVX2(src + 32, swaps & SDL_SWAP_SRC);
+    __m256i ia = _mm256_cvttps_epi32(_mm256_mul_ps(a, scale));
+    __m256i ib = _mm256_cvttps_epi32(_mm256_mul_ps(b, scale));
+    __m256i v;
+
+    /* Keep the low 16 bits, like the cast does */
+    ia = _mm256_srai_epi32(_mm256_slli_epi32(ia, 16), 16);
+    ib = _mm256_srai_epi32(_mm256_slli_epi32(ib, 16), 16);
+    /* The pack works per 128-bit lane, put the halves back in order */
+    v = _mm256_permute4x64_epi64(_mm256_packs_epi32(ia, ib), _MM_SHUFFLE(3, 1, 2, 0));
+    if (swaps & SDL_SWAP_DST) {
+        v = SDL_Swap_AVX2(v, 2);
+    }
+    _mm256_storeu_si256((__m256i *) dst, v);
+}
+
+/* 8 samples */
+static SDL_TARGETING("avx2") SDL_INLINE void
+SDL_S32_to_F32_Block_AVX2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    __m256i v = _mm256_loadu_si256((const __m256i *) src);
+
+    if (swaps & SDL_SWAP_SRC) {
+        v = SDL_Swap_AVX2(v, 4);
+    }
+    SDL_StoreF32_AVX2(dst, _mm256_mul_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(DIVBY2147483647)), swaps & SDL_SWAP_DST);
+}
+
+/* 8 samples */
+static SDL_TARGETING("avx2") SDL_INLINE void
+SDL_F32_to_S32_Block_AVX2(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const __m256d scale = _mm256_set1_pd(2147483647.0);
+    const __m256 f = SDL_LoadF32_AVX2(src, swaps & SDL_SWAP_SRC);
+    const __m128i lo = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(f)), scale));
+    const __m128i hi = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(f, 1)), scale));
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+    if (swaps & SDL_SWAP_DST) {
+        v = SDL_Swap_AVX2(v, 4);
+    }
+    _mm256_storeu_si256((__m256i *) dst, v);
+}
+
+static SDL_TARGETING("avx2") void SDLCALL
+SDL_Convert_S16_to_F32_AVX2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S16_to_F32_Block_AVX2, 16, 2, 4);
+}
+
+static SDL_TARGETING("avx2") void SDLCALL
+SDL_Convert_F32_to_S16_AVX2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S16SYS, SDL_F32_to_S16_Block_AVX2, 16, 4, 2);
+}
+
+static SDL_TARGETING("avx2") void SDLCALL
+SDL_Convert_S32_to_F32_AVX2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S32_to_F32_Block_AVX2, 8, 4, 4);
+}
+
+static SDL_TARGETING("avx2") void SDLCALL
+SDL_Convert_F32_to_S32_AVX2(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S32SYS, SDL_F32_to_S32_Block_AVX2, 8, 4, 4);
+}
+
+#endif /* SDL_AVX2_AUDIO */
+
+#if SDL_NEON_AUDIO
+
+static SDL_INLINE float32x4_t
+SDL_LoadF32_NEON(const Uint8 *src, const int swap)
+{
+    const uint8x16_t v = vld1q_u8(src);
+    return vreinterpretq_f32_u8(swap ? vrev32q_u8(v) : v);
+}
+
+static SDL_INLINE void
+SDL_StoreF32_NEON(Uint8 *dst, const float32x4_t f, const int swap)
+{
+    const uint8x16_t v = vreinterpretq_u8_f32(f);
+    vst1q_u8(dst, swap ? vrev32q_u8(v) : v);
+}
+
+/* 8 samples */
+static SDL_INLINE void
+SDL_S16_to_F32_Block_NEON(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const float32x4_t scale = vdupq_n_f32(DIVBY32767);
+    uint8x16_t bytes = vld1q_u8(src);
+    int16x8_t v;
+
+    if (swaps & SDL_SWAP_SRC) {
+        bytes = vrev16q_u8(bytes);
+    }
+    v = vreinterpretq_s16_u8(bytes);
+    SDL_StoreF32_NEON(dst, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale), swaps & SDL_SWAP_DST);
+    SDL_StoreF32_NEON(dst + 16, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale), swaps & SDL_SWAP_DST);
+}
+
+/* 8 samples */
+static SDL_INLINE void
+SDL_F32_to_S16_Block_NEON(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const float32x4_t scale = vdupq_n_f32(32767.0f);
+    const int32x4_t a = vcvtq_s32_f32(vmulq_f32(SDL_LoadF32_NEON(src, swaps & SDL_SWAP_SRC), scale));
+    const int32x4_t b = vcvtq_s32_f32(vmulq_f32(SDL_LoadF32_NEON(src + 16, swaps & SDL_SWAP_SRC), scale));
+    /* Keep the low 16 bits, like the cast does */
+    uint8x16_t v = vreinterpretq_u8_s16(vcombine_s16(vmovn_s32(a), vmovn_s32(b)));
+
+    if (swaps & SDL_SWAP_DST) {
+        v = vrev16q_u8(v);
+    }
+    vst1q_u8(dst, v);
+}
+
+/* 4 samples */
+static SDL_INLINE void
+SDL_S32_to_F32_Block_NEON(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    uint8x16_t bytes = vld1q_u8(src);
+
+    if (swaps & SDL_SWAP_SRC) {
+        bytes = vrev32q_u8(bytes);
+    }
+    SDL_StoreF32_NEON(dst, vmulq_f32(vcvtq_f32_s32(vreinterpretq_s32_u8(bytes)), vdupq_n_f32(DIVBY2147483647)), swaps & SDL_SWAP_DST);
+}
+
+/* 4 samples */
+static SDL_INLINE void
+SDL_F32_to_S32_Block_NEON(const Uint8 *src, Uint8 *dst, const int swaps)
+{
+    const float64x2_t scale = vdupq_n_f64(2147483647.0);
+    const float32x4_t f = SDL_LoadF32_NEON(src, swaps & SDL_SWAP_SRC);
+    const int64x2_t lo = vcvtq_s64_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(f)), scale));
+    const int64x2_t hi = vcvtq_s64_f64(vmulq_f64(vcvt_f64_f32(vget_high_f32(f)), scale));
+    /* The scalar conversion saturates to 32 bits */
+    uint8x16_t v = vreinterpretq_u8_s32(vcombine_s32(vqmovn_s64(lo), vqmovn_s64(hi)));
+
+    if (swaps & SDL_SWAP_DST) {
+        v = vrev32q_u8(v);
+    }
+    vst1q_u8(dst, v);
+}
+
+static void SDLCALL
+SDL_Convert_S16_to_F32_NEON(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S16_to_F32_Block_NEON, 8, 2, 4);
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S16_NEON(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S16SYS, SDL_F32_to_S16_Block_NEON, 8, 4, 2);
+}
+
+static void SDLCALL
+SDL_Convert_S32_to_F32_NEON(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_F32SYS, SDL_S32_to_F32_Block_NEON, 4, 4, 4);
+}
+
+static void SDLCALL
+SDL_Convert_F32_to_S32_NEON(SDL_AudioCVT * cvt, SDL_AudioFormat format)
+{
+    SDL_CONVERT_AUDIO_BLOCKS(cvt, format, AUDIO_S32SYS, SDL_F32_to_S32_Block_NEON, 4, 4, 4);
+}
+
+#endif /* SDL_NEON_AUDIO */
+
+SDL_AudioFilter
+SDL_ChooseAudioTypeCVT(SDL_AudioFormat src_fmt, SDL_AudioFormat dst_fmt, SDL_AudioFormat final_fmt)
+{
+    const Uint32 features = SDL_GetAudioCPUFeatures();
+    /* Byte order is handled inside the converters */
+    const SDL_AudioFormat src = src_fmt & ~SDL_AUDIO_MASK_ENDIAN;
+    const SDL_AudioFormat dst = dst_fmt & ~SDL_AUDIO_MASK_ENDIAN;
+
+#if SDL_SSE2_AUDIO || SDL_NEON_AUDIO
+    if (SDL_AudioTypeOutputFormat(dst_fmt, final_fmt) != dst_fmt) {
+        return NULL;
+    }
+#endif
+
+#if SDL_AVX2_AUDIO
+    if (features & SDL_AUDIO_CPU_AVX2) {
+        if (src == AUDIO_S16LSB && dst == AUDIO_F32LSB) {
+            return SDL_Convert_S16_to_F32_AVX2;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_S16LSB) {
+            return SDL_Convert_F32_to_S16_AVX2;
+        } else if (src == AUDIO_S32LSB && dst == AUDIO_F32LSB) {
+            return SDL_Convert_S32_to_F32_AVX2;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_S32LSB) {
+            return SDL_Convert_F32_to_S32_AVX2;
+        }
+    }
+#endif
+
+#if SDL_SSE2_AUDIO
+    if (features & SDL_AUDIO_CPU_SSE2) {
+        if (src == AUDIO_S16LSB && dst == AUDIO_F32LSB) {
+            return SDL_Convert_S16_to_F32_SSE2;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_S16LSB) {
+            return SDL_Convert_F32_to_S16_SSE2;
+        } else if (src == AUDIO_S32LSB && dst == AUDIO_F32LSB) {
+            return SDL_Convert_S32_to_F32_SSE2;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_S32LSB) {
+            return SDL_Convert_F32_to_S32_SSE2;
+        } else if (src == AUDIO_U8 && dst == AUDIO_S16LSB) {
+            return SDL_Convert_U8_to_S16_SSE2;
+        } else if (src == AUDIO_S8 && dst == AUDIO_S16LSB) {
+            return SDL_Convert_S8_to_S16_SSE2;
+        } else if (src == AUDIO_S16LSB && dst == AUDIO_U8) {
+            return SDL_Convert_S16_to_U8_SSE2;
+        } else if (src == AUDIO_S16LSB && dst == AUDIO_S8) {
+            return SDL_Convert_S16_to_S8_SSE2;
+        } else if (src == AUDIO_U8 && dst == AUDIO_F32LSB) {
+            return SDL_Convert_U8_to_F32_SSE2;
+        } else if (src == AUDIO_S8 && dst == AUDIO_F32LSB) {
+            return SDL_Convert_S8_to_F32_SSE2;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_U8) {
+            return SDL_Convert_F32_to_U8_SSE2;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_S8) {
+            return SDL_Convert_F32_to_S8_SSE2;
+        }
+    }
+#endif
+
+#if SDL_NEON_AUDIO
+    if (features & SDL_AUDIO_CPU_NEON) {
+        if (src == AUDIO_S16LSB && dst == AUDIO_F32LSB) {
+            return SDL_Convert_S16_to_F32_NEON;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_S16LSB) {
+            return SDL_Convert_F32_to_S16_NEON;
+        } else if (src == AUDIO_S32LSB && dst == AUDIO_F32LSB) {
+            return SDL_Convert_S32_to_F32_NEON;
+        } else if (src == AUDIO_F32LSB && dst == AUDIO_S32LSB) {
+            return SDL_Convert_F32_to_S32_NEON;
+        }
+    }
+#endif
+
+    return NULL;
+}
+
+SDL_AudioFilter
+SDL_ChooseAudioRemixCVT(SDL_AudioFormat src_fmt, int src_channels,
+                        SDL_AudioFormat dst_fmt, int dst_channels,
+                        SDL_AudioFormat final_fmt)
+{
+#if SDL_SSE2_AUDIO
+    const Uint32 features = SDL_GetAudioCPUFeatures();
+
+    if ((features & SDL_AUDIO_CPU_SSE2) &&
+        (src_fmt & ~SDL_AUDIO_MASK_ENDIAN) == AUDIO_S16LSB &&
+        (dst_fmt & ~SDL_AUDIO_MASK_ENDIAN) == AUDIO_F32LSB &&
+        SDL_AudioTypeOutputFormat(dst_fmt, final_fmt) == dst_fmt) {
+        if (src_channels == 1 && dst_channels == 2) {
+            return SDL_Convert_S16_to_F32_1to2_SSE2;
+        } else if (src_channels == 2 && dst_channels == 1) {
+            return SDL_Convert_S16_to_F32_2to1_SSE2;
+        } else if (src_channels == 2 && dst_channels == 4) {
+            return SDL_Convert_S16_to_F32_2to4_SSE2;
+        } else if (src_channels == 2 && dst_channels == 6) {
+            return SDL_Convert_S16_to_F32_2to6_SSE2;
+        }
+    }
+#endif
+
+    return NULL;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -25,6 +25,8 @@
 #include "SDL_cpuinfo.h"
 #include "SDL_timer.h"
 #include "SDL_audio.h"
+#include "SDL_audio_c.h"
+#include "SDL_audio_simd.h"
 #include "SDL_sysaudio.h"
 
 /* This table is used to add two sound values together and pin
@@ -85,15 +87,274 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(s, v) (s = (s*v)/SDL_MIX_MAXVOLUME)
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 
+/* Vectorized mixing of the native byte order S16, S32 and F32 formats.
+   Each mixer does as many whole vectors as it can and returns how many
+   samples that was; the loops in SDL_MixAudioFormat() finish the rest.
+
+   The integer mixers give exactly what the loops give. Volumes above
+   SDL_MIX_MAXVOLUME make those loops overflow, so they're left to them.
+
+   For F32 the loops give different results depending on how the compiler
+   evaluates float expressions: x87 builds keep the scaled sample in extended
+   precision, where the product is exact, so the vector code does the math
+   in double precision there. That matches except for a rare last bit when
+   the x87 sum rounds twice, and which NaN survives when both are NaN. */
+#if (SDL_SSE2_AUDIO || SDL_NEON_AUDIO) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+#define SDL_SIMD_MIXING 1
+#endif
+
+#if defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ != 0)
+#define SDL_MIX_F32_EXTENDED 1
+#endif
+
+#if SDL_SIMD_MIXING && SDL_SSE2_AUDIO
+
+static Uint32
+SDL_MixAudio_S16_SSE2(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 8 <= len; i += 8) {
+        __m128i src_sample = _mm_loadu_si128((const __m128i *) (src + i * 2));
+        const __m128i dst_sample = _mm_loadu_si128((const __m128i *) (dst + i * 2));
+
+        if (volume != SDL_MIX_MAXVOLUME) {
+            const __m128i lo = _mm_mullo_epi16(src_sample, vol);
+            const __m128i hi = _mm_mulhi_epi16(src_sample, vol);
+            __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+            __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+
+            /* Divide by SDL_MIX_MAXVOLUME, rounding toward zero */
+            p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_srli_epi32(_mm_srai_epi32(p0, 31), 25)), 7);
+            p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_srli_epi32(_mm_srai_epi32(p1, 31), 25)), 7);
+            src_sample = _mm_packs_epi32(p0, p1);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i * 2), _mm_adds_epi16(dst_sample, src_sample));
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_S32_SSE2(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+    /* The scaled samples and the sums are exact in double precision */
+    const __m128d vol = _mm_set1_pd((double) volume / SDL_MIX_MAXVOLUME);
+    const __m128d max_audioval = _mm_set1_pd(2147483647.0);
+    const __m128d min_audioval = _mm_set1_pd(-2147483648.0);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= len; i += 4) {
+        const __m128i src_sample = _mm_loadu_si128((const __m128i *) (src + i * 4));
+        const __m128i dst_sample = _mm_loadu_si128((const __m128i *) (dst + i * 4));
+        const __m128i src_lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(src_sample), vol));
+        const __m128i src_hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(src_sample, 8)), vol));
+        __m128d lo = _mm_add_pd(_mm_cvtepi32_pd(src_lo), _mm_cvtepi32_pd(dst_sample));
+        __m128d hi = _mm_add_pd(_mm_cvtepi32_pd(src_hi), _mm_cvtepi32_pd(_mm_srli_si128(dst_sample, 8)));
+
+        lo = _mm_max_pd(_mm_min_pd(lo, max_audioval), min_audioval);
+        hi = _mm_max_pd(_mm_min_pd(hi, max_audioval), min_audioval);
+        _mm_storeu_si128((__m128i *) (dst + i * 4), _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi)));
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_F32_SSE2(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+#if SDL_MIX_F32_EXTENDED
+    const __m128d vol = _mm_set1_pd((double) volume / SDL_MIX_MAXVOLUME);
+#else
+    const __m128 fvolume = _mm_set1_ps((float) volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+#endif
+    const __m128d max_audioval = _mm_set1_pd(3.402823466e+38F);
+    const __m128d min_audioval = _mm_set1_pd(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= len; i += 4) {
+        const __m128 src_sample = _mm_loadu_ps((const float *) (src + i * 4));
+        const __m128 dst_sample = _mm_loadu_ps((const float *) (dst + i * 4));
+        __m128d lo, hi;
+
+#if SDL_MIX_F32_EXTENDED
+        lo = _mm_mul_pd(_mm_cvtps_pd(src_sample), vol);
+        hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(src_sample, src_sample)), vol);
+#else
+        {
+            const __m128 scaled = _mm_mul_ps(_mm_mul_ps(src_sample, fvolume), fmaxvolume);
+            lo = _mm_cvtps_pd(scaled);
+            hi = _mm_cvtps_pd(_mm_movehl_ps(scaled, scaled));
+        }
+#endif
+        lo = _mm_add_pd(lo, _mm_cvtps_pd(dst_sample));
+        hi = _mm_add_pd(hi, _mm_cvtps_pd(_mm_movehl_ps(dst_sample, dst_sample)));
+
+        /* The bounds go first, so NaN passes through like in the loop */
+        lo = _mm_max_pd(min_audioval, _mm_min_pd(max_audioval, lo));
+        hi = _mm_max_pd(min_audioval, _mm_min_pd(max_audioval, hi));
+        _mm_storeu_ps((float *) (dst + i * 4), _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+    }
+    return i;
+}
+
+#endif /* SDL_SIMD_MIXING && SDL_SSE2_AUDIO */
+
+#if SDL_SIMD_MIXING && SDL_NEON_AUDIO
+
+static Uint32
+SDL_MixAudio_S16_NEON(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+    const int16x4_t vol = vdup_n_s16((int16_t) volume);
+    Uint32 i;
+
+    for (i = 0; i + 8 <= len; i += 8) {
+        const int16x8_t src_sample = vld1q_s16((const int16_t *) (src + i * 2));
+        const int16x8_t dst_sample = vld1q_s16((const int16_t *) (dst + i * 2));
+        int32x4_t lo = vmull_s16(vget_low_s16(src_sample), vol);
+        int32x4_t hi = vmull_s16(vget_high_s16(src_sample), vol);
+
+        /* Divide by SDL_MIX_MAXVOLUME, rounding toward zero */
+        lo = vshrq_n_s32(vaddq_s32(lo, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(lo, 31)), 25))), 7);
+        hi = vshrq_n_s32(vaddq_s32(hi, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(hi, 31)), 25))), 7);
+        vst1q_s16((int16_t *) (dst + i * 2), vqaddq_s16(dst_sample, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))));
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_S32_NEON(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+    const int32x2_t vol = vdup_n_s32(volume);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= len; i += 4) {
+        const int32x4_t src_sample = vld1q_s32((const int32_t *) (src + i * 4));
+        const int32x4_t dst_sample = vld1q_s32((const int32_t *) (dst + i * 4));
+        int64x2_t lo = vmull_s32(vget_low_s32(src_sample), vol);
+        int64x2_t hi = vmull_s32(vget_high_s32(src_sample), vol);
+
+        /* Divide by SDL_MIX_MAXVOLUME, rounding toward zero */
+        lo = vshrq_n_s64(vaddq_s64(lo, vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_s64(vshrq_n_s64(lo, 63)), 57))), 7);
+        hi = vshrq_n_s64(vaddq_s64(hi, vreinterpretq_s64_u64(vshrq_n_u64(vreinterpretq_u64_s64(vshrq_n_s64(hi, 63)), 57))), 7);
+        lo = vaddw_s32(lo, vget_low_s32(dst_sample));
+        hi = vaddw_s32(hi, vget_high_s32(dst_sample));
+        vst1q_s32((int32_t *) (dst + i * 4), vcombine_s32(vqmovn_s64(lo), vqmovn_s64(hi)));
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixAudio_F32_NEON(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+#if SDL_MIX_F32_EXTENDED
+    const float64x2_t vol = vdupq_n_f64((double) volume / SDL_MIX_MAXVOLUME);
+#else
+    const float32x4_t fvolume = vdupq_n_f32((float) volume);
+    const float32x4_t fmaxvolume = vdupq_n_f32(1.0f / ((float) SDL_MIX_MAXVOLUME));
+#endif
+    const float64x2_t max_audioval = vdupq_n_f64(3.402823466e+38F);
+    const float64x2_t min_audioval = vdupq_n_f64(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 4 <= len; i += 4) {
+        const float32x4_t src_sample = vld1q_f32((const float *) (src + i * 4));
+        const float32x4_t dst_sample = vld1q_f32((const float *) (dst + i * 4));
+        float64x2_t lo, hi;
+
+#if SDL_MIX_F32_EXTENDED
+        lo = vmulq_f64(vcvt_f64_f32(vget_low_f32(src_sample)), vol);
+        hi = vmulq_f64(vcvt_f64_f32(vget_high_f32(src_sample)), vol);
+#else
+        {
+            const float32x4_t scaled = vmulq_f32(vmulq_f32(src_sample, fvolume), fmaxvolume);
+            lo = vcvt_f64_f32(vget_low_f32(scaled));
+            hi = vcvt_f64_f32(vget_high_f32(scaled));
+        }
+#endif
+        lo = vaddq_f64(lo, vcvt_f64_f32(vget_low_f32(dst_sample)));
+        hi = vaddq_f64(hi, vcvt_f64_f32(vget_high_f32(dst_sample)));
+
+        /* These pass NaN through, like the loop */
+        lo = vmaxq_f64(vminq_f64(lo, max_audioval), min_audioval);
+        hi = vmaxq_f64(vminq_f64(hi, max_audioval), min_audioval);
+        vst1q_f32((float *) (dst + i * 4), vcombine_f32(vcvt_f32_f64(lo), vcvt_f32_f64(hi)));
+    }
+    return i;
+}
+
+#endif /* SDL_SIMD_MIXING && SDL_NEON_AUDIO */
+
+#if SDL_SIMD_MIXING
+typedef Uint32 (*SDL_MixAudioSIMDFunc) (Uint8 * dst, const Uint8 * src, Uint32 len, int volume);
+
+/* Pick a vectorized mixer for a native byte order format, or NULL */
+static SDL_MixAudioSIMDFunc
+SDL_ChooseMixAudioSIMD(SDL_AudioFormat format, int volume)
+{
+    const Uint32 features = SDL_GetAudioCPUFeatures();
+
+    if (volume < 0 || volume > SDL_MIX_MAXVOLUME) {
+        return NULL;
+    }
+#if SDL_SSE2_AUDIO
+    if (features & SDL_AUDIO_CPU_SSE2) {
+        switch (format) {
+        case AUDIO_S16SYS:
+            return SDL_MixAudio_S16_SSE2;
+        case AUDIO_S32SYS:
+            return SDL_MixAudio_S32_SSE2;
+        case AUDIO_F32SYS:
+            return SDL_MixAudio_F32_SSE2;
+        default:
+            break;
+        }
+    }
+#endif
+#if SDL_NEON_AUDIO
+    if (features & SDL_AUDIO_CPU_NEON) {
+        switch (format) {
+        case AUDIO_S16SYS:
+            return SDL_MixAudio_S16_NEON;
+        case AUDIO_S32SYS:
+            return SDL_MixAudio_S32_NEON;
+        case AUDIO_F32SYS:
+            return SDL_MixAudio_F32_NEON;
+        default:
+            break;
+        }
+    }
+#endif
+    return NULL;
+}
+#endif /* SDL_SIMD_MIXING */
+
 
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
                    Uint32 len, int volume)
 {
+#if SDL_SIMD_MIXING
+    SDL_MixAudioSIMDFunc mix_simd;
+#endif
+
     if (volume == 0) {
         return;
     }
 
+#if SDL_SIMD_MIXING
+    mix_simd = SDL_ChooseMixAudioSIMD(format, volume);
+    if (mix_simd) {
+        const int size = SDL_AUDIO_BITSIZE(format) / 8;
+        const Uint32 done = mix_simd(dst, src, len / size, volume) * size;
+
+        /* The loops below mix whatever is left over */
+        dst += done;
+        src += done;
+        len -= done;
+    }
+#endif
+
     switch (format) {
 
     case AUDIO_U8:
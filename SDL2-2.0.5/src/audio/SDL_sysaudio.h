@@ -23,6 +23,7 @@
 #ifndef _SDL_sysaudio_h
 #define _SDL_sysaudio_h
 
+#include "SDL_atomic.h"
 #include "SDL_mutex.h"
 #include "SDL_thread.h"
 
@@ -50,25 +51,28 @@ extern void SDL_RemoveAudioDevice(const int iscapture, void *handle);
 extern void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device);
 
 
-/* This is the size of a packet when using SDL_QueueAudio(). We allocate
-   these as necessary and pool them, under the assumption that we'll
-   eventually end up with a handful that keep recycling, meeting whatever
-   the app needs. We keep packing data tightly as more arrives to avoid
-   wasting space, and if we get a giant block of data, we'll split them
-   into multiple packets behind the scenes. My expectation is that most
-   apps will have 2-3 of these in the pool. 8k should cover most needs, but
-   if this is crippling for some embedded system, we can #ifdef this.
-   The system preallocates enough packets for 2 callbacks' worth of data. */
-#define SDL_AUDIOBUFFERQUEUE_PACKETLEN (8 * 1024)
+/* This is the smallest ring used for SDL_QueueAudio(). The first ring
+   holds two callbacks' worth of data if that's more, and the queue moves
+   to rings twice as big whenever the app gets further ahead than that.
+   Most apps settle on one ring and never allocate again. */
+#define SDL_AUDIOQUEUE_MINSIZE (8 * 1024)
 
-/* Used by apps that queue audio instead of using the callback. */
-typedef struct SDL_AudioBufferQueue
+/* Used by apps that queue audio instead of using the callback.
+
+   The audio thread is one side of the queue and the app is the other, so
+   there is one producer and one consumer, and they share nothing but the
+   atomic positions: neither ever waits for the other. When a ring is full
+   the producer moves on to a bigger one and links it from the old one; the
+   consumer follows once it has drained the old one. */
+typedef struct SDL_AudioQueueRing
 {
-    Uint8 data[SDL_AUDIOBUFFERQUEUE_PACKETLEN];  /* packet data. */
-    Uint32 datalen;  /* bytes currently in use in this packet. */
-    Uint32 startpos;  /* bytes currently consumed in this packet. */
-    struct SDL_AudioBufferQueue *next;  /* next item in linked list. */
-} SDL_AudioBufferQueue;
+    Uint8 *data;  /* the ring itself. */
+    Uint32 size;  /* bytes in the ring, a power of two. */
+    SDL_atomic_t head;  /* total bytes written; only the producer moves this. */
+    SDL_atomic_t tail;  /* total bytes read; only the consumer moves this. */
+    void *next;  /* the ring the producer moved on to, or NULL. */
+    struct SDL_AudioQueueRing *retired_next;  /* next drained ring to free. */
+} SDL_AudioQueueRing;
 
 typedef struct SDL_AudioDriverImpl
 {
@@ -136,15 +140,6 @@ typedef struct SDL_AudioDriver
 } SDL_AudioDriver;
 
 
-/* Streamer */
-typedef struct
-{
-    Uint8 *buffer;
-    int max_len;                /* the maximum length in bytes */
-    int read_pos, write_pos;    /* the position of the write and read heads in bytes */
-} SDL_AudioStreamer;
-
-
 /* Define the SDL audio driver structure */
 struct SDL_AudioDevice
 {
@@ -155,12 +150,11 @@ struct SDL_AudioDevice
     /* The current audio specification (shared with audio thread) */
     SDL_AudioSpec spec;
 
-    /* An audio conversion block for audio format emulation */
-    SDL_AudioCVT convert;
+    /* The audio specification the app's callback sees */
+    SDL_AudioSpec callbackspec;
 
-    /* The streamer, if sample rate conversion necessitates it */
-    int use_streamer;
-    SDL_AudioStreamer streamer;
+    /* Converts between the callback and device formats, if they differ */
+    SDL_AudioStream *stream;
 
     /* Current state flags */
     SDL_atomic_t shutdown; /* true if we are signaling the play thread to end. */
@@ -168,8 +162,10 @@ struct SDL_AudioDevice
     SDL_atomic_t paused;
     SDL_bool iscapture;
 
-    /* Fake audio buffer for when the audio hardware is busy */
-    Uint8 *fake_stream;
+    /* Scratch buffer for the callback's data when it doesn't go straight
+       to the device, and for when the audio hardware is busy */
+    Uint8 *work_buffer;
+    Uint32 work_buffer_len;
 
     /* A mutex for locking the mixing buffers */
     SDL_mutex *mixer_lock;
@@ -178,11 +174,19 @@ struct SDL_AudioDevice
     SDL_Thread *thread;
     SDL_threadID threadid;
 
-    /* Queued buffers (if app not using callback). */
-    SDL_AudioBufferQueue *buffer_queue_head; /* device fed from here. */
-    SDL_AudioBufferQueue *buffer_queue_tail; /* queue fills to here. */
-    SDL_AudioBufferQueue *buffer_queue_pool; /* these are unused packets. */
-    Uint32 queued_bytes;  /* number of bytes of audio data in the queue. */
+    /* Queued audio (if app not using callback). */
+    SDL_AudioQueueRing *queue_read;  /* the consumer reads from here. */
+    SDL_AudioQueueRing *queue_write;  /* the producer writes to here. */
+    void *queue_retired;  /* drained rings, freed on the app's side. */
+    SDL_mutex *queue_lock;  /* serializes app threads; the audio thread never takes it. */
+    SDL_atomic_t queued_bytes;  /* number of bytes of audio data in the queue. */
+
+    /* Timing counters, written by the audio thread under stats_lock. */
+    SDL_SpinLock stats_lock;
+    SDL_AudioDeviceStats stats;
+    Uint64 stats_last_play;  /* performance counter at the last PlayDevice, 0 if none. */
+    int stats_stream_bytes;  /* converted audio left in the stream after the last conversion. */
+    Uint64 position;  /* sample frames played or captured, also under stats_lock. */
 
     /* * * */
     /* Data private to this driver */
@@ -25,8 +25,57 @@
 #include "SDL_audio.h"
 #include "SDL_wave.h"
 
+/* The header is parsed once when the reader is made. After that, PCM data
+   is read straight from the file and ADPCM data is decoded a block at a
+   time, so only one encoded and one decoded block are ever in memory. */
+
+#define WAVE_NO_BLOCK           0xFFFFFFFF
+#define WAVE_MAX_FMT_LENGTH     1024
+
+struct _SDL_WAVReader
+{
+    SDL_RWops *src;
+    int freesrc;
+
+    /* The format, from the fmt chunk */
+    Uint16 encoding;
+    Uint16 channels;
+    Uint16 blockalign;
+    Uint16 samples_per_block;   /* ADPCM only */
+    Sint16 coeff[7][2];         /* MS ADPCM only */
+
+    Sint64 data_start;          /* Where the data chunk's payload starts */
+    Sint64 riff_end;            /* Where the RIFF chunk ends */
+    Sint64 src_offset;          /* Where src is now, so reads in order don't seek */
+    Uint32 frame_size;          /* Bytes per sample frame of the output */
+    Uint32 frames;              /* Length of the audio, in sample frames */
+    Uint32 position;            /* The next sample frame to read */
+
+    /* ADPCM only */
+    Uint8 *block;               /* One encoded block */
+    Uint8 *decoded;             /* That block decoded */
+    Uint32 decoded_block;       /* Which block is in decoded, or WAVE_NO_BLOCK */
+};
+
+static Uint16
+WAV_LE16(const Uint8 * p)
+{
+    return (Uint16) (p[0] | (p[1] << 8));
+}
+
+static Uint32
+WAV_LE32(const Uint8 * p)
+{
+    return (Uint32) p[0] | ((Uint32) p[1] << 8) | ((Uint32) p[2] << 16) | ((Uint32) p[3] << 24);
+}
+
+static void
+WAV_StoreSample(Uint8 * decoded, Sint32 sample)
+{
+    decoded[0] = (Uint8) (sample & 0xFF);
+    decoded[1] = (Uint8) ((sample >> 8) & 0xFF);
+}
 
-static int ReadChunk(SDL_RWops * src, Chunk * chunk);
 
 struct MS_ADPCM_decodestate
 {
@@ -35,55 +84,44 @@ struct MS_ADPCM_decodestate
     Sint16 iSamp1;
     Sint16 iSamp2;
 };
-static struct MS_ADPCM_decoder
-{
-    WaveFMT wavefmt;
-    Uint16 wSamplesPerBlock;
-    Uint16 wNumCoef;
-    Sint16 aCoeff[7][2];
-    /* * * */
-    struct MS_ADPCM_decodestate state[2];
-} MS_ADPCM_state;
 
 static int
-InitMS_ADPCM(WaveFMT * format)
+InitMS_ADPCM(SDL_WAVReader * reader, const Uint8 * fmt, Uint32 fmtlen)
 {
-    Uint8 *rogue_feel;
+    const Uint16 channels = reader->channels;
+    Uint16 numcoef;
     int i;
 
-    /* Set the rogue pointer to the MS_ADPCM specific data */
-    MS_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    MS_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    MS_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    MS_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    MS_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    MS_ADPCM_state.wavefmt.bitspersample =
-        SDL_SwapLE16(format->bitspersample);
-    rogue_feel = (Uint8 *) format + sizeof(*format);
-    if (sizeof(*format) == 16) {
-        /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
-        rogue_feel += sizeof(Uint16);
-    }
-    MS_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
-    rogue_feel += sizeof(Uint16);
-    MS_ADPCM_state.wNumCoef = ((rogue_feel[1] << 8) | rogue_feel[0]);
-    rogue_feel += sizeof(Uint16);
-    if (MS_ADPCM_state.wNumCoef != 7) {
-        SDL_SetError("Unknown set of MS_ADPCM coefficients");
-        return (-1);
-    }
-    for (i = 0; i < MS_ADPCM_state.wNumCoef; ++i) {
-        MS_ADPCM_state.aCoeff[i][0] = ((rogue_feel[1] << 8) | rogue_feel[0]);
-        rogue_feel += sizeof(Uint16);
-        MS_ADPCM_state.aCoeff[i][1] = ((rogue_feel[1] << 8) | rogue_feel[0]);
-        rogue_feel += sizeof(Uint16);
-    }
-    return (0);
+    /* The coefficient count and table follow cbSize and wSamplesPerBlock */
+    if (fmtlen < 22) {
+        return SDL_SetError("MS ADPCM format chunk is too short");
+    }
+    numcoef = WAV_LE16(fmt + 20);
+    if (numcoef != 7) {
+        return SDL_SetError("Unknown set of MS_ADPCM coefficients");
+    }
+    if (fmtlen < 22 + 4 * (Uint32) numcoef) {
+        return SDL_SetError("MS ADPCM format chunk is too short");
+    }
+    for (i = 0; i < numcoef; ++i) {
+        reader->coeff[i][0] = (Sint16) WAV_LE16(fmt + 22 + i * 4);
+        reader->coeff[i][1] = (Sint16) WAV_LE16(fmt + 22 + i * 4 + 2);
+    }
+
+    /* A block has a 7 byte header per channel, then a nibble per sample
+       after the two samples the header holds. */
+    reader->samples_per_block = WAV_LE16(fmt + 18);
+    if ((channels < 1) || (channels > 2) || (reader->samples_per_block < 2) ||
+        (reader->blockalign < 7 * channels) ||
+        ((reader->samples_per_block - 2) * channels + 1) / 2 > (Uint32) (reader->blockalign - 7 * channels)) {
+        return SDL_SetError("Invalid MS ADPCM block layout");
+    }
+    return 0;
 }
 
 static Sint32
 MS_ADPCM_nibble(struct MS_ADPCM_decodestate *state,
-                Uint8 nybble, Sint16 * coeff)
+                Uint8 nybble, const Sint16 * coeff)
 {
     const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
     const Sint32 min_audioval = -(1 << (16 - 1));
@@ -116,138 +154,78 @@ MS_ADPCM_nibble(struct MS_ADPCM_decodestate *state,
 }
 
 static int
-MS_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+MS_ADPCM_decode(SDL_WAVReader * reader)
 {
-    struct MS_ADPCM_decodestate *state[2];
-    Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    Sint8 nybble;
-    Uint8 stereo;
-    Sint16 *coeff[2];
-    Sint32 new_sample;
-
-    /* Allocate the proper sized output buffer */
-    encoded_len = *audio_len;
-    encoded = *audio_buf;
-    freeable = *audio_buf;
-    *audio_len = (encoded_len / MS_ADPCM_state.wavefmt.blockalign) *
-        MS_ADPCM_state.wSamplesPerBlock *
-        MS_ADPCM_state.wavefmt.channels * sizeof(Sint16);
-    *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
-    if (*audio_buf == NULL) {
-        return SDL_OutOfMemory();
-    }
-    decoded = *audio_buf;
-
-    /* Get ready... Go! */
-    stereo = (MS_ADPCM_state.wavefmt.channels == 2);
-    state[0] = &MS_ADPCM_state.state[0];
-    state[1] = &MS_ADPCM_state.state[stereo];
-    while (encoded_len >= MS_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
-        state[0]->hPredictor = *encoded++;
-        if (stereo) {
-            state[1]->hPredictor = *encoded++;
-        }
-        state[0]->iDelta = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iDelta = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        state[0]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        state[0]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-        encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
+    struct MS_ADPCM_decodestate state[2];
+    const int channels = reader->channels;
+    const Uint8 *encoded = reader->block;
+    Uint8 *decoded = reader->decoded;
+    Uint32 i, samples;
+    int c;
+
+    /* Grab the initial information for this block */
+    for (c = 0; c < channels; ++c) {
+        state[c].hPredictor = *encoded++;
+        if (state[c].hPredictor >= SDL_arraysize(reader->coeff)) {
+            return SDL_SetError("Invalid MS ADPCM predictor");
         }
-        coeff[0] = MS_ADPCM_state.aCoeff[state[0]->hPredictor];
-        coeff[1] = MS_ADPCM_state.aCoeff[state[1]->hPredictor];
+    }
+    for (c = 0; c < channels; ++c, encoded += 2) {
+        state[c].iDelta = WAV_LE16(encoded);
+    }
+    for (c = 0; c < channels; ++c, encoded += 2) {
+        state[c].iSamp1 = (Sint16) WAV_LE16(encoded);
+    }
+    for (c = 0; c < channels; ++c, encoded += 2) {
+        state[c].iSamp2 = (Sint16) WAV_LE16(encoded);
+    }
 
-        /* Store the two initial samples we start with */
-        decoded[0] = state[0]->iSamp2 & 0xFF;
-        decoded[1] = state[0]->iSamp2 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp2 & 0xFF;
-            decoded[1] = state[1]->iSamp2 >> 8;
-            decoded += 2;
-        }
-        decoded[0] = state[0]->iSamp1 & 0xFF;
-        decoded[1] = state[0]->iSamp1 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp1 & 0xFF;
-            decoded[1] = state[1]->iSamp1 >> 8;
-            decoded += 2;
-        }
+    /* Store the two initial samples we start with */
+    for (c = 0; c < channels; ++c, decoded += 2) {
+        WAV_StoreSample(decoded, state[c].iSamp2);
+    }
+    for (c = 0; c < channels; ++c, decoded += 2) {
+        WAV_StoreSample(decoded, state[c].iSamp1);
+    }
 
-        /* Decode and store the other samples in this block */
-        samplesleft = (MS_ADPCM_state.wSamplesPerBlock - 2) *
-            MS_ADPCM_state.wavefmt.channels;
-        while (samplesleft > 0) {
-            nybble = (*encoded) >> 4;
-            new_sample = MS_ADPCM_nibble(state[0], nybble, coeff[0]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            nybble = (*encoded) & 0x0F;
-            new_sample = MS_ADPCM_nibble(state[1], nybble, coeff[1]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            ++encoded;
-            samplesleft -= 2;
-        }
-        encoded_len -= MS_ADPCM_state.wavefmt.blockalign;
+    /* Decode the other samples, high nibble first, alternating channels */
+    samples = (reader->samples_per_block - 2) * channels;
+    for (i = 0; i < samples; ++i, decoded += 2) {
+        const Uint8 nybble = (i & 1) ? (encoded[i / 2] & 0x0F) : (encoded[i / 2] >> 4);
+        c = i % channels;
+        WAV_StoreSample(decoded, MS_ADPCM_nibble(&state[c], nybble, reader->coeff[state[c].hPredictor]));
     }
-    SDL_free(freeable);
-    return (0);
+    return 0;
 }
 
+
 struct IMA_ADPCM_decodestate
 {
     Sint32 sample;
     Sint8 index;
 };
-static struct IMA_ADPCM_decoder
-{
-    WaveFMT wavefmt;
-    Uint16 wSamplesPerBlock;
-    /* * * */
-    struct IMA_ADPCM_decodestate state[2];
-} IMA_ADPCM_state;
 
 static int
-InitIMA_ADPCM(WaveFMT * format)
+InitIMA_ADPCM(SDL_WAVReader * reader, const Uint8 * fmt, Uint32 fmtlen)
 {
-    Uint8 *rogue_feel;
-
-    /* Set the rogue pointer to the IMA_ADPCM specific data */
-    IMA_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    IMA_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    IMA_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    IMA_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    IMA_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    IMA_ADPCM_state.wavefmt.bitspersample =
-        SDL_SwapLE16(format->bitspersample);
-    rogue_feel = (Uint8 *) format + sizeof(*format);
-    if (sizeof(*format) == 16) {
-        /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
-        rogue_feel += sizeof(Uint16);
-    }
-    IMA_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
-    return (0);
+    const Uint16 channels = reader->channels;
+
+    if (fmtlen < 20) {
+        return SDL_SetError("IMA ADPCM format chunk is too short");
+    }
+    if ((channels < 1) || (channels > 2)) {
+        return SDL_SetError("IMA ADPCM decoder can only handle %u channels", 2);
+    }
+
+    /* A block has a 4 byte header per channel, then runs of 8 samples in
+       4 bytes for each channel in turn. */
+    reader->samples_per_block = WAV_LE16(fmt + 18);
+    if ((reader->samples_per_block < 1) || ((reader->samples_per_block - 1) % 8) != 0 ||
+        (reader->blockalign < 4 * channels) ||
+        (reader->samples_per_block - 1) / 2 * channels > (Uint32) (reader->blockalign - 4 * channels)) {
+        return SDL_SetError("Invalid IMA ADPCM block layout");
+    }
+    return 0;
 }
 
 static Sint32
@@ -306,130 +284,184 @@ IMA_ADPCM_nibble(struct IMA_ADPCM_decodestate *state, Uint8 nybble)
 
 /* Fill the decode buffer with a channel block of data (8 samples) */
 static void
-Fill_IMA_ADPCM_block(Uint8 * decoded, Uint8 * encoded,
+Fill_IMA_ADPCM_block(Uint8 * decoded, const Uint8 * encoded,
                      int channel, int numchannels,
                      struct IMA_ADPCM_decodestate *state)
 {
     int i;
-    Sint8 nybble;
-    Sint32 new_sample;
 
     decoded += (channel * 2);
     for (i = 0; i < 4; ++i) {
-        nybble = (*encoded) & 0x0F;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
+        WAV_StoreSample(decoded, IMA_ADPCM_nibble(state, (*encoded) & 0x0F));
         decoded += 2 * numchannels;
-
-        nybble = (*encoded) >> 4;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
+        WAV_StoreSample(decoded, IMA_ADPCM_nibble(state, (*encoded) >> 4));
         decoded += 2 * numchannels;
-
         ++encoded;
     }
 }
 
 static int
-IMA_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+IMA_ADPCM_decode(SDL_WAVReader * reader)
 {
-    struct IMA_ADPCM_decodestate *state;
-    Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    unsigned int c, channels;
-
-    /* Check to make sure we have enough variables in the state array */
-    channels = IMA_ADPCM_state.wavefmt.channels;
-    if (channels > SDL_arraysize(IMA_ADPCM_state.state)) {
-        SDL_SetError("IMA ADPCM decoder can only handle %u channels",
-                     (unsigned int)SDL_arraysize(IMA_ADPCM_state.state));
-        return (-1);
-    }
-    state = IMA_ADPCM_state.state;
-
-    /* Allocate the proper sized output buffer */
-    encoded_len = *audio_len;
-    encoded = *audio_buf;
-    freeable = *audio_buf;
-    *audio_len = (encoded_len / IMA_ADPCM_state.wavefmt.blockalign) *
-        IMA_ADPCM_state.wSamplesPerBlock *
-        IMA_ADPCM_state.wavefmt.channels * sizeof(Sint16);
-    *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
-    if (*audio_buf == NULL) {
-        return SDL_OutOfMemory();
+    struct IMA_ADPCM_decodestate state[2];
+    const int channels = reader->channels;
+    const Uint8 *encoded = reader->block;
+    Uint8 *decoded = reader->decoded;
+    int c, runs;
+
+    /* Grab the initial information for this block */
+    for (c = 0; c < channels; ++c) {
+        state[c].sample = (Sint16) WAV_LE16(encoded);
+        state[c].index = (Sint8) encoded[2];
+        /* encoded[3] is reserved, and should be 0 */
+        encoded += 4;
+
+        /* Store the initial sample we start with */
+        WAV_StoreSample(decoded, state[c].sample);
+        decoded += 2;
     }
-    decoded = *audio_buf;
 
-    /* Get ready... Go! */
-    while (encoded_len >= IMA_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
+    /* Decode and store the other samples in this block */
+    for (runs = (reader->samples_per_block - 1) / 8; runs > 0; --runs) {
         for (c = 0; c < channels; ++c) {
-            /* Fill the state information for this block */
-            state[c].sample = ((encoded[1] << 8) | encoded[0]);
-            encoded += 2;
-            if (state[c].sample & 0x8000) {
-                state[c].sample -= 0x10000;
-            }
-            state[c].index = *encoded++;
-            /* Reserved byte in buffer header, should be 0 */
-            if (*encoded++ != 0) {
-                /* Uh oh, corrupt data?  Buggy code? */ ;
-            }
+            Fill_IMA_ADPCM_block(decoded, encoded, c, channels, &state[c]);
+            encoded += 4;
+        }
+        decoded += (channels * 8 * 2);
+    }
+    return 0;
+}
+
 
-            /* Store the initial sample we start with */
-            decoded[0] = (Uint8) (state[c].sample & 0xFF);
-            decoded[1] = (Uint8) (state[c].sample >> 8);
-            decoded += 2;
+/* Make src be at offset, if it isn't already */
+static int
+WAV_SeekSource(SDL_WAVReader * reader, Sint64 offset)
+{
+    if (reader->src_offset != offset) {
+        if (SDL_RWseek(reader->src, offset, RW_SEEK_SET) != offset) {
+            reader->src_offset = -1;
+            return SDL_Error(SDL_EFSEEK);
         }
+        reader->src_offset = offset;
+    }
+    return 0;
+}
 
-        /* Decode and store the other samples in this block */
-        samplesleft = (IMA_ADPCM_state.wSamplesPerBlock - 1) * channels;
-        while (samplesleft > 0) {
-            for (c = 0; c < channels; ++c) {
-                Fill_IMA_ADPCM_block(decoded, encoded,
-                                     c, channels, &state[c]);
-                encoded += 4;
-                samplesleft -= 8;
-            }
-            decoded += (channels * 8 * 2);
+static int
+WAV_DecodeBlock(SDL_WAVReader * reader, Uint32 block)
+{
+    if (WAV_SeekSource(reader, reader->data_start + (Sint64) block * reader->blockalign) < 0) {
+        return -1;
+    }
+    reader->decoded_block = WAVE_NO_BLOCK;
+    if (SDL_RWread(reader->src, reader->block, reader->blockalign, 1) != 1) {
+        reader->src_offset = -1;
+        return SDL_Error(SDL_EFREAD);
+    }
+    reader->src_offset += reader->blockalign;
+
+    if (reader->encoding == MS_ADPCM_CODE) {
+        if (MS_ADPCM_decode(reader) < 0) {
+            return -1;
+        }
+    } else {
+        if (IMA_ADPCM_decode(reader) < 0) {
+            return -1;
         }
-        encoded_len -= IMA_ADPCM_state.wavefmt.blockalign;
     }
-    SDL_free(freeable);
-    return (0);
+    reader->decoded_block = block;
+    return 0;
 }
 
-SDL_AudioSpec *
-SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
-               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+static int
+WAV_ParseFormat(SDL_WAVReader * reader, const Uint8 * fmt, Uint32 fmtlen,
+                SDL_AudioSpec * spec)
 {
-    int was_error;
-    Chunk chunk;
-    int lenread;
-    int IEEE_float_encoded, MS_ADPCM_encoded, IMA_ADPCM_encoded;
-    int samplesize;
+    Uint16 bitspersample;
+    Uint32 freq;
 
-    /* WAV magic header */
-    Uint32 RIFFchunk;
-    Uint32 wavelen = 0;
-    Uint32 WAVEmagic;
-    Uint32 headerDiff = 0;
+    if (fmtlen < 16) {
+        return SDL_SetError("WAVE format chunk is too short");
+    }
+    reader->encoding = WAV_LE16(fmt);
+    reader->channels = WAV_LE16(fmt + 2);
+    reader->blockalign = WAV_LE16(fmt + 12);
+    bitspersample = WAV_LE16(fmt + 14);
+    freq = WAV_LE32(fmt + 4);
+
+    if (freq == 0 || freq > 0x7FFFFFFF) {
+        return SDL_SetError("Invalid WAVE sample rate: %u", (unsigned int) freq);
+    }
 
-    /* FMT chunk */
-    WaveFMT *format = NULL;
+    SDL_zerop(spec);
+    spec->freq = (int) freq;
 
-    SDL_zero(chunk);
+    switch (reader->encoding) {
+    case PCM_CODE:
+        switch (bitspersample) {
+        case 8:
+            spec->format = AUDIO_U8;
+            break;
+        case 16:
+            spec->format = AUDIO_S16;
+            break;
+        case 32:
+            spec->format = AUDIO_S32;
+            break;
+        default:
+            return SDL_SetError("Unknown %d-bit PCM data format", bitspersample);
+        }
+        break;
+    case IEEE_FLOAT_CODE:
+        if (bitspersample != 32) {
+            return SDL_SetError("Unknown %d-bit PCM data format", bitspersample);
+        }
+        spec->format = AUDIO_F32;
+        break;
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        if (bitspersample != 4) {
+            return SDL_SetError("Unknown %d-bit PCM data format", bitspersample);
+        }
+        if (reader->encoding == MS_ADPCM_CODE) {
+            if (InitMS_ADPCM(reader, fmt, fmtlen) < 0) {
+                return -1;
+            }
+        } else {
+            if (InitIMA_ADPCM(reader, fmt, fmtlen) < 0) {
+                return -1;
+            }
+        }
+        spec->format = AUDIO_S16;
+        break;
+    case MP3_CODE:
+        return SDL_SetError("MPEG Layer 3 data not supported");
+    default:
+        return SDL_SetError("Unknown WAVE data format: 0x%.4x", reader->encoding);
+    }
 
-    /* Make sure we are passed a valid data source */
-    was_error = 0;
-    if (src == NULL) {
-        was_error = 1;
-        goto done;
+    if (reader->channels == 0) {
+        return SDL_SetError("WAVE file has no channels");
+    }
+    if (reader->channels > 255) {
+        /* SDL_AudioSpec can't describe more */
+        return SDL_SetError("Too many WAVE channels: %u", (unsigned int) reader->channels);
     }
+    spec->channels = (Uint8) reader->channels;
+    spec->samples = 4096;       /* Good default buffer size */
+    reader->frame_size = (SDL_AUDIO_BITSIZE(spec->format) / 8) * reader->channels;
+    return 0;
+}
+
+/* Read the RIFF header and the chunks up to the data chunk's payload */
+static int
+WAV_ReadHeader(SDL_WAVReader * reader, SDL_AudioSpec * spec)
+{
+    SDL_RWops *src = reader->src;
+    SDL_bool have_format = SDL_FALSE;
+    Uint32 RIFFchunk, wavelen, WAVEmagic;
+    Uint32 data_len = 0;
+    Sint64 here, size;
 
     /* Check the magic header */
     RIFFchunk = SDL_ReadLE32(src);
@@ -442,157 +474,275 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         WAVEmagic = SDL_ReadLE32(src);
     }
     if ((RIFFchunk != RIFF) || (WAVEmagic != WAVE)) {
-        SDL_SetError("Unrecognized file type (not WAVE)");
-        was_error = 1;
-        goto done;
-    }
-    headerDiff += sizeof(Uint32);       /* for WAVE */
-
-    /* Read the audio data format chunk */
-    chunk.data = NULL;
-    do {
-        SDL_free(chunk.data);
-        chunk.data = NULL;
-        lenread = ReadChunk(src, &chunk);
-        if (lenread < 0) {
-            was_error = 1;
-            goto done;
-        }
-        /* 2 Uint32's for chunk header+len, plus the lenread */
-        headerDiff += lenread + 2 * sizeof(Uint32);
-    } while ((chunk.magic == FACT) || (chunk.magic == LIST) || (chunk.magic == BEXT) || (chunk.magic == JUNK));
-
-    /* Decode the audio data format */
-    format = (WaveFMT *) chunk.data;
-    if (chunk.magic != FMT) {
-        SDL_SetError("Complex WAVE files not supported");
-        was_error = 1;
-        goto done;
-    }
-    IEEE_float_encoded = MS_ADPCM_encoded = IMA_ADPCM_encoded = 0;
-    switch (SDL_SwapLE16(format->encoding)) {
-    case PCM_CODE:
-        /* We can understand this */
-        break;
-    case IEEE_FLOAT_CODE:
-        IEEE_float_encoded = 1;
-        /* We can understand this */
-        break;
-    case MS_ADPCM_CODE:
-        /* Try to understand this */
-        if (InitMS_ADPCM(format) < 0) {
-            was_error = 1;
-            goto done;
-        }
-        MS_ADPCM_encoded = 1;
-        break;
-    case IMA_ADPCM_CODE:
-        /* Try to understand this */
-        if (InitIMA_ADPCM(format) < 0) {
-            was_error = 1;
-            goto done;
-        }
-        IMA_ADPCM_encoded = 1;
-        break;
-    case MP3_CODE:
-        SDL_SetError("MPEG Layer 3 data not supported");
-        was_error = 1;
-        goto done;
-    default:
-        SDL_SetError("Unknown WAVE data format: 0x%.4x",
-                     SDL_SwapLE16(format->encoding));
-        was_error = 1;
-        goto done;
+        return SDL_SetError("Unrecognized file type (not WAVE)");
     }
-    SDL_zerop(spec);
-    spec->freq = SDL_SwapLE32(format->frequency);
+    here = SDL_RWtell(src);
+    if (here < 0) {
+        return SDL_Error(SDL_EFSEEK);
+    }
+    reader->riff_end = here - 4 + wavelen;
 
-    if (IEEE_float_encoded) {
-        if ((SDL_SwapLE16(format->bitspersample)) != 32) {
-            was_error = 1;
-        } else {
-            spec->format = AUDIO_F32;
+    /* Find the format and then the data, skipping everything else */
+    for (;;) {
+        Uint8 header[8];
+        Uint32 magic, length;
+
+        if (SDL_RWread(src, header, sizeof (header), 1) != 1) {
+            return SDL_SetError("WAVE file has no %s chunk", have_format ? "data" : "format");
         }
-    } else {
-        switch (SDL_SwapLE16(format->bitspersample)) {
-        case 4:
-            if (MS_ADPCM_encoded || IMA_ADPCM_encoded) {
-                spec->format = AUDIO_S16;
-            } else {
-                was_error = 1;
+        magic = WAV_LE32(header);
+        length = WAV_LE32(header + 4);
+
+        if (magic == DATA) {
+            if (!have_format) {
+                return SDL_SetError("Complex WAVE files not supported");
             }
+            data_len = length;
             break;
-        case 8:
-            spec->format = AUDIO_U8;
-            break;
-        case 16:
-            spec->format = AUDIO_S16;
-            break;
-        case 32:
-            spec->format = AUDIO_S32;
-            break;
-        default:
-            was_error = 1;
-            break;
+        } else if (magic == FMT && !have_format) {
+            Uint8 *fmt;
+            int result;
+
+            if (length > WAVE_MAX_FMT_LENGTH) {
+                return SDL_SetError("WAVE format chunk is too long");
+            }
+            fmt = (Uint8 *) SDL_malloc(length + 1);
+            if (fmt == NULL) {
+                return SDL_OutOfMemory();
+            }
+            if (length && SDL_RWread(src, fmt, length, 1) != 1) {
+                SDL_free(fmt);
+                return SDL_Error(SDL_EFREAD);
+            }
+            result = WAV_ParseFormat(reader, fmt, length, spec);
+            SDL_free(fmt);
+            if (result < 0) {
+                return -1;
+            }
+            have_format = SDL_TRUE;
+            if ((length & 1) && SDL_RWseek(src, 1, RW_SEEK_CUR) < 0) {
+                return SDL_Error(SDL_EFSEEK);
+            }
+        } else {
+            /* Chunks are padded to an even length */
+            if (SDL_RWseek(src, (Sint64) length + (length & 1), RW_SEEK_CUR) < 0) {
+                return SDL_Error(SDL_EFSEEK);
+            }
         }
     }
 
-    if (was_error) {
-        SDL_SetError("Unknown %d-bit PCM data format",
-                     SDL_SwapLE16(format->bitspersample));
-        goto done;
+    reader->data_start = SDL_RWtell(src);
+    if (reader->data_start < 0) {
+        return SDL_Error(SDL_EFSEEK);
     }
-    spec->channels = (Uint8) SDL_SwapLE16(format->channels);
-    spec->samples = 4096;       /* Good default buffer size */
+    reader->src_offset = reader->data_start;
 
-    /* Read the audio data chunk */
-    *audio_buf = NULL;
-    do {
-        SDL_free(*audio_buf);
-        *audio_buf = NULL;
-        lenread = ReadChunk(src, &chunk);
-        if (lenread < 0) {
-            was_error = 1;
-            goto done;
-        }
-        *audio_len = lenread;
-        *audio_buf = chunk.data;
-        if (chunk.magic != DATA)
-            headerDiff += lenread + 2 * sizeof(Uint32);
-    } while (chunk.magic != DATA);
-    headerDiff += 2 * sizeof(Uint32);   /* for the data chunk and len */
-
-    if (MS_ADPCM_encoded) {
-        if (MS_ADPCM_decode(audio_buf, audio_len) < 0) {
-            was_error = 1;
-            goto done;
-        }
+    /* Files that were cut short, or written by a recorder that couldn't go
+       back to fix the length, have less data than the chunk claims. */
+    size = SDL_RWsize(src);
+    if ((size >= 0) && (reader->data_start + data_len > size)) {
+        data_len = (Uint32) SDL_max(size - reader->data_start, 0);
     }
-    if (IMA_ADPCM_encoded) {
-        if (IMA_ADPCM_decode(audio_buf, audio_len) < 0) {
-            was_error = 1;
-            goto done;
+
+    /* A partial block at the end is dropped, like a partial sample frame */
+    if ((reader->encoding == MS_ADPCM_CODE) || (reader->encoding == IMA_ADPCM_CODE)) {
+        const Uint32 decoded_size = reader->samples_per_block * reader->frame_size;
+        reader->frames = (data_len / reader->blockalign) * reader->samples_per_block;
+        reader->block = (Uint8 *) SDL_malloc(reader->blockalign);
+        reader->decoded = (Uint8 *) SDL_malloc(decoded_size);
+        if (!reader->block || !reader->decoded) {
+            return SDL_OutOfMemory();
         }
+    } else {
+        reader->frames = data_len / reader->frame_size;
     }
+    return 0;
+}
 
-    /* Don't return a buffer that isn't a multiple of samplesize */
-    samplesize = ((SDL_AUDIO_BITSIZE(spec->format)) / 8) * spec->channels;
-    *audio_len &= ~(samplesize - 1);
+SDL_WAVReader *
+SDL_NewWAVReader(SDL_RWops * src, int freesrc, SDL_AudioSpec * spec)
+{
+    SDL_WAVReader *reader;
 
-  done:
-    SDL_free(format);
-    if (src) {
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (!spec) {
+        SDL_InvalidParamError("spec");
         if (freesrc) {
             SDL_RWclose(src);
-        } else {
-            /* seek to the end of the file (given by the RIFF chunk) */
-            SDL_RWseek(src, wavelen - chunk.length - headerDiff, RW_SEEK_CUR);
         }
+        return NULL;
+    }
+
+    reader = (SDL_WAVReader *) SDL_calloc(1, sizeof (*reader));
+    if (!reader) {
+        SDL_OutOfMemory();
+        if (freesrc) {
+            SDL_RWclose(src);
+        }
+        return NULL;
+    }
+    reader->src = src;
+    reader->freesrc = freesrc;
+    reader->decoded_block = WAVE_NO_BLOCK;
+
+    if (WAV_ReadHeader(reader, spec) < 0) {
+        SDL_FreeWAVReader(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+int
+SDL_WAVReaderRead(SDL_WAVReader * reader, void *buf, int len)
+{
+    Uint8 *dst = (Uint8 *) buf;
+    Uint32 frames, done = 0;
+
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    frames = SDL_min((Uint32) len / reader->frame_size, reader->frames - reader->position);
+    if (frames == 0) {
+        return 0;
+    }
+
+    if (reader->block) {
+        const Uint32 samples_per_block = reader->samples_per_block;
+        while (done < frames) {
+            const Uint32 block = reader->position / samples_per_block;
+            const Uint32 offset = reader->position % samples_per_block;
+            const Uint32 count = SDL_min(frames - done, samples_per_block - offset);
+
+            if ((block != reader->decoded_block) && (WAV_DecodeBlock(reader, block) < 0)) {
+                break;
+            }
+            SDL_memcpy(dst + done * reader->frame_size,
+                       reader->decoded + offset * reader->frame_size,
+                       count * reader->frame_size);
+            done += count;
+            reader->position += count;
+        }
+    } else if (WAV_SeekSource(reader, reader->data_start + (Sint64) reader->position * reader->frame_size) == 0) {
+        done = (Uint32) SDL_RWread(reader->src, dst, reader->frame_size, frames);
+        if (done == 0) {
+            SDL_Error(SDL_EFREAD);
+        }
+        reader->src_offset += (Sint64) done * reader->frame_size;
+        reader->position += done;
+        if (done < frames) {
+            /* Don't trust where a short read left the file */
+            reader->src_offset = -1;
+        }
+    }
+
+    /* Report an error only if nothing could be read */
+    return (done > 0) ? (int) (done * reader->frame_size) : -1;
+}
+
+int
+SDL_WAVReaderSeek(SDL_WAVReader * reader, Uint32 frame)
+{
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    }
+    if (frame > reader->frames) {
+        return SDL_SetError("Can't seek past the end of the WAVE data");
+    }
+    reader->position = frame;
+    return 0;
+}
+
+Uint32
+SDL_WAVReaderTell(SDL_WAVReader * reader)
+{
+    if (!reader) {
+        SDL_InvalidParamError("reader");
+        return 0;
+    }
+    return reader->position;
+}
+
+Uint32
+SDL_WAVReaderLength(SDL_WAVReader * reader)
+{
+    if (!reader) {
+        SDL_InvalidParamError("reader");
+        return 0;
+    }
+    return reader->frames;
+}
+
+void
+SDL_FreeWAVReader(SDL_WAVReader * reader)
+{
+    if (!reader) {
+        return;
+    }
+    if (reader->freesrc) {
+        SDL_RWclose(reader->src);
+    }
+    SDL_free(reader->block);
+    SDL_free(reader->decoded);
+    SDL_free(reader);
+}
+
+SDL_AudioSpec *
+SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
+               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+{
+    SDL_WAVReader *reader;
+    Uint64 len;
+    Uint32 done = 0;
+
+    reader = SDL_NewWAVReader(src, freesrc, spec);
+    if (!reader) {
+        return NULL;
+    }
+
+    len = (Uint64) reader->frames * reader->frame_size;
+    if (len > 0xFFFFFFFF) {
+        SDL_SetError("WAVE data is too big to load at once, use SDL_NewWAVReader()");
+        SDL_FreeWAVReader(reader);
+        return NULL;
+    }
+    *audio_buf = (Uint8 *) SDL_malloc((size_t) SDL_max(len, 1));
+    if (*audio_buf == NULL) {
+        SDL_OutOfMemory();
+        SDL_FreeWAVReader(reader);
+        return NULL;
+    }
+
+    /* Read in pieces that fit in an int, which is just one for most files */
+    while (done < (Uint32) len) {
+        const int piece = (int) SDL_min((Uint32) len - done, 0x40000000 - 0x40000000 % reader->frame_size);
+        const int got = SDL_WAVReaderRead(reader, *audio_buf + done, piece);
+        if (got <= 0) {
+            break;
+        }
+        done += (Uint32) got;
+    }
+    if (done < (Uint32) len) {
+        SDL_free(*audio_buf);
+        *audio_buf = NULL;
+        SDL_FreeWAVReader(reader);
+        return NULL;
     }
-    if (was_error) {
-        spec = NULL;
+    *audio_len = done;
+
+    if (!freesrc) {
+        /* seek to the end of the file (given by the RIFF chunk) */
+        SDL_RWseek(src, reader->riff_end, RW_SEEK_SET);
     }
-    return (spec);
+    SDL_FreeWAVReader(reader);
+    return spec;
 }
 
 /* Since the WAV memory is allocated in the shared library, it must also
@@ -604,21 +754,4 @@ SDL_FreeWAV(Uint8 * audio_buf)
     SDL_free(audio_buf);
 }
 
-static int
-ReadChunk(SDL_RWops * src, Chunk * chunk)
-{
-    chunk->magic = SDL_ReadLE32(src);
-    chunk->length = SDL_ReadLE32(src);
-    chunk->data = (Uint8 *) SDL_malloc(chunk->length);
-    if (chunk->data == NULL) {
-        return SDL_OutOfMemory();
-    }
-    if (SDL_RWread(src, chunk->data, chunk->length, 1) != 1) {
-        SDL_free(chunk->data);
-        chunk->data = NULL;
-        return SDL_Error(SDL_EFREAD);
-    }
-    return (chunk->length);
-}
-
 /* vi: set ts=4 sw=4 expandtab: */
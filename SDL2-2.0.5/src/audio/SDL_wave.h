@@ -41,27 +41,19 @@
 #define WAVE_MONO       1
 #define WAVE_STEREO     2
 
-/* Normally, these three chunks come consecutively in a WAVE file */
-typedef struct WaveFMT
-{
-/* Not saved in the chunk we read:
-    Uint32  FMTchunk;
-    Uint32  fmtlen;
-*/
+/* The fmt chunk is, in little-endian order:
     Uint16 encoding;
-    Uint16 channels;            /* 1 = mono, 2 = stereo */
-    Uint32 frequency;           /* One of 11025, 22050, or 44100 Hz */
-    Uint32 byterate;            /* Average bytes per second */
-    Uint16 blockalign;          /* Bytes per sample block */
-    Uint16 bitspersample;       /* One of 8, 12, 16, or 4 for ADPCM */
-} WaveFMT;
-
-/* The general chunk found in the WAVE file */
-typedef struct Chunk
-{
-    Uint32 magic;
-    Uint32 length;
-    Uint8 *data;
-} Chunk;
+    Uint16 channels;            1 = mono, 2 = stereo
+    Uint32 frequency;
+    Uint32 byterate;            Average bytes per second
+    Uint16 blockalign;          Bytes per sample block
+    Uint16 bitspersample;       One of 8, 16, 32, or 4 for ADPCM
+   followed for ADPCM by:
+    Uint16 cbSize;              Bytes of extra information
+    Uint16 wSamplesPerBlock;
+   and for MS ADPCM by:
+    Uint16 wNumCoef;
+    Sint16 aCoeff[wNumCoef][2];
+*/
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -31,6 +31,7 @@
 #include "SDL_rwops.h"
 #include "SDL_timer.h"
 #include "SDL_audio.h"
+#include "SDL_hints.h"
 #include "../SDL_audio_c.h"
 #include "SDL_diskaudio.h"
 
@@ -42,11 +43,34 @@
 #define DISKDEFAULT_INFILE      "sdlaudio-in.raw"
 #define DISKENVR_IODELAY      "SDL_DISKAUDIODELAY"
 
+/* An offline playback device doesn't run while paused, so the file only
+   gets what the app played plus the buffer that was current when it paused. */
+static void
+DISKAUDIO_WaitWhilePaused(_THIS)
+{
+    while (SDL_AtomicGet(&this->paused) && !SDL_AtomicGet(&this->shutdown)) {
+        SDL_Delay(this->hidden->io_delay);
+    }
+}
+
+static void
+DISKAUDIO_ThreadInit(_THIS)
+{
+    /* Devices open paused; don't start the file with a buffer of silence. */
+    if (this->hidden->offline && !this->iscapture) {
+        DISKAUDIO_WaitWhilePaused(this);
+    }
+}
+
 /* This function waits until it is possible to write a full sound buffer */
 static void
 DISKAUDIO_WaitDevice(_THIS)
 {
-    SDL_Delay(this->hidden->io_delay);
+    if (this->hidden->offline) {
+        DISKAUDIO_WaitWhilePaused(this);
+    } else {
+        SDL_Delay(this->hidden->io_delay);
+    }
 }
 
 static void
@@ -77,7 +101,11 @@ DISKAUDIO_CaptureFromDevice(_THIS, void *buffer, int buflen)
     struct SDL_PrivateAudioData *h = this->hidden;
     const int origbuflen = buflen;
 
-    SDL_Delay(h->io_delay);
+    /* Past the end of the file there's only silence left, which offline
+       devices deliver in real time too rather than spinning on it. */
+    if (!h->offline || !h->io) {
+        SDL_Delay(h->io_delay);
+    }
 
     if (h->io) {
         const size_t br = SDL_RWread(h->io, buffer, 1, buflen);
@@ -144,6 +172,7 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     } else {
         this->hidden->io_delay = ((this->spec.samples * 1000) / this->spec.freq);
     }
+    this->hidden->offline = SDL_GetHintBoolean(SDL_HINT_AUDIO_DISK_OFFLINE, SDL_FALSE);
 
     /* Open the audio device */
     this->hidden->io = SDL_RWFromFile(fname, iscapture ? "rb" : "wb");
@@ -163,8 +192,8 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
 #if HAVE_STDIO_H
     fprintf(stderr,
             "WARNING: You are using the SDL disk i/o audio driver!\n"
-            " %s file [%s].\n", iscapture ? "Reading from" : "Writing to",
-            fname);
+            " %s file [%s]%s.\n", iscapture ? "Reading from" : "Writing to",
+            fname, this->hidden->offline ? " offline" : "");
 #endif
 
     /* We're ready to rock and roll. :-) */
@@ -183,6 +212,7 @@ DISKAUDIO_Init(SDL_AudioDriverImpl * impl)
 {
     /* Set the function pointers */
     impl->OpenDevice = DISKAUDIO_OpenDevice;
+    impl->ThreadInit = DISKAUDIO_ThreadInit;
     impl->WaitDevice = DISKAUDIO_WaitDevice;
     impl->PlayDevice = DISKAUDIO_PlayDevice;
     impl->GetDeviceBuf = DISKAUDIO_GetDeviceBuf;
@@ -29,32 +29,6 @@
 
 #include <emscripten/emscripten.h>
 
-static int
-copyData(_THIS)
-{
-    int byte_len;
-
-    if (this->hidden->write_off + this->convert.len_cvt > this->hidden->mixlen) {
-        if (this->hidden->write_off > this->hidden->read_off) {
-            SDL_memmove(this->hidden->mixbuf,
-                        this->hidden->mixbuf + this->hidden->read_off,
-                        this->hidden->mixlen - this->hidden->read_off);
-            this->hidden->write_off = this->hidden->write_off - this->hidden->read_off;
-        } else {
-            this->hidden->write_off = 0;
-        }
-        this->hidden->read_off = 0;
-    }
-
-    SDL_memcpy(this->hidden->mixbuf + this->hidden->write_off,
-               this->convert.buf,
-               this->convert.len_cvt);
-    this->hidden->write_off += this->convert.len_cvt;
-    byte_len = this->hidden->write_off - this->hidden->read_off;
-
-    return byte_len;
-}
-
 static void
 HandleAudioProcess(_THIS)
 {
@@ -67,44 +41,29 @@ HandleAudioProcess(_THIS)
         return;
     }
 
-    if (this->convert.needed) {
-        const int bytes_in = SDL_AUDIO_BITSIZE(this->convert.src_format) / 8;
-
-        if (this->hidden->conv_in_len != 0) {
-            this->convert.len = this->hidden->conv_in_len * bytes_in * this->spec.channels;
-        }
-
-        (*this->spec.callback) (this->spec.userdata,
-                                 this->convert.buf,
-                                 this->convert.len);
-        SDL_ConvertAudio(&this->convert);
-        buf = this->convert.buf;
-        byte_len = this->convert.len_cvt;
-
-        /* size mismatch*/
-        if (byte_len != this->spec.size) {
-            if (!this->hidden->mixbuf) {
-                this->hidden->mixlen = this->spec.size > byte_len ? this->spec.size * 2 : byte_len * 2;
-                this->hidden->mixbuf = SDL_malloc(this->hidden->mixlen);
-            }
-
-            /* copy existing data */
-            byte_len = copyData(this);
-
-            /* read more data*/
-            while (byte_len < this->spec.size) {
-                (*this->spec.callback) (this->spec.userdata,
-                                         this->convert.buf,
-                                         this->convert.len);
-                SDL_ConvertAudio(&this->convert);
-                byte_len = copyData(this);
+    if (this->stream) {
+        const int stream_len = this->callbackspec.size;
+        int got;
+
+        /* Keep asking the app until there's a whole Web Audio buffer */
+        while (SDL_AudioStreamAvailable(this->stream) < ((int) this->spec.size)) {
+            (*this->spec.callback) (this->spec.userdata,
+                                     this->work_buffer,
+                                     stream_len);
+            if (SDL_AudioStreamPut(this->stream, this->work_buffer, stream_len) == -1) {
+                SDL_AudioStreamClear(this->stream);
+                SDL_AtomicSet(&this->enabled, 0);
+                break;
             }
-
-            byte_len = this->spec.size;
-            buf = this->hidden->mixbuf + this->hidden->read_off;
-            this->hidden->read_off += byte_len;
         }
 
+        got = SDL_AudioStreamGet(this->stream, this->work_buffer, this->spec.size);
+        SDL_assert((got < 0) || (got == this->spec.size));
+        if (got != this->spec.size) {
+            SDL_memset(this->work_buffer, this->spec.silence, this->spec.size);
+        }
+        buf = this->work_buffer;
+        byte_len = this->spec.size;
     } else {
         if (!this->hidden->mixbuf) {
             this->hidden->mixlen = this->spec.size;
@@ -138,16 +97,14 @@ static void
 HandleCaptureProcess(_THIS)
 {
     Uint8 *buf;
-    int buflen;
 
     /* Only do something if audio is enabled */
     if (!SDL_AtomicGet(&this->enabled) || SDL_AtomicGet(&this->paused)) {
         return;
     }
 
-    if (this->convert.needed) {
-        buf = this->convert.buf;
-        buflen = this->convert.len_cvt;
+    if (this->stream) {
+        buf = this->work_buffer;
     } else {
         if (!this->hidden->mixbuf) {
             this->hidden->mixbuf = (Uint8 *) SDL_malloc(this->spec.size);
@@ -156,7 +113,6 @@ HandleCaptureProcess(_THIS)
             }
         }
         buf = this->hidden->mixbuf;
-        buflen = this->spec.size;
     }
 
     EM_ASM_ARGS({
@@ -185,12 +141,24 @@ HandleCaptureProcess(_THIS)
 
     /* okay, we've got an interleaved float32 array in C now. */
 
-    if (this->convert.needed) {
-        SDL_ConvertAudio(&this->convert);
-    }
+    if (this->stream) {
+        const int buflen = this->callbackspec.size;
+
+        if (SDL_AudioStreamPut(this->stream, buf, this->spec.size) == -1) {
+            SDL_AudioStreamClear(this->stream);
+            SDL_AtomicSet(&this->enabled, 0);
+            return;
+        }
 
-    /* Send it to the app. */
-    (*this->spec.callback) (this->spec.userdata, buf, buflen);
+        /* Send the app every whole buffer it asked for. */
+        while (SDL_AudioStreamAvailable(this->stream) >= buflen) {
+            SDL_AudioStreamGet(this->stream, buf, buflen);
+            (*this->spec.callback) (this->spec.userdata, buf, buflen);
+        }
+    } else {
+        /* Send it to the app. */
+        (*this->spec.callback) (this->spec.userdata, buf, this->spec.size);
+    }
 }
 
 
@@ -245,8 +213,6 @@ EMSCRIPTENAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscaptu
 {
     SDL_bool valid_format = SDL_FALSE;
     SDL_AudioFormat test_format;
-    int i;
-    float f;
     int result;
 
     /* based on parts of library_sdl.js */
@@ -305,17 +271,7 @@ EMSCRIPTENAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscaptu
         return SDL2.audioContext.sampleRate;
     });
 
-    if(this->spec.freq != sampleRate) {
-        for (i = this->spec.samples; i > 0; i--) {
-            f = (float)i / (float)sampleRate * (float)this->spec.freq;
-            if (SDL_floor(f) == f) {
-                this->hidden->conv_in_len = SDL_floor(f);
-                break;
-            }
-        }
-
-        this->spec.freq = sampleRate;
-    }
+    this->spec.freq = sampleRate;
 
     SDL_CalculateAudioSpec(&this->spec);
 
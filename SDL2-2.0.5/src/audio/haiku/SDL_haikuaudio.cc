@@ -54,14 +54,27 @@ FillSound(void *device, void *stream, size_t len,
     }
 
     if (!SDL_AtomicGet(&audio->paused)) {
-        if (audio->convert.needed) {
-            SDL_LockMutex(audio->mixer_lock);
-            (*audio->spec.callback) (audio->spec.userdata,
-                                     (Uint8 *) audio->convert.buf,
-                                     audio->convert.len);
-            SDL_UnlockMutex(audio->mixer_lock);
-            SDL_ConvertAudio(&audio->convert);
-            SDL_memcpy(stream, audio->convert.buf, audio->convert.len_cvt);
+        if (audio->stream) {
+            const int stream_len = audio->callbackspec.size;
+            int got;
+
+            /* Keep asking the app until the device buffer can be filled */
+            while (SDL_AudioStreamAvailable(audio->stream) < (int) len) {
+                SDL_LockMutex(audio->mixer_lock);
+                (*audio->spec.callback) (audio->spec.userdata,
+                                         audio->work_buffer, stream_len);
+                SDL_UnlockMutex(audio->mixer_lock);
+                if (SDL_AudioStreamPut(audio->stream, audio->work_buffer, stream_len) == -1) {
+                    SDL_AudioStreamClear(audio->stream);
+                    SDL_AtomicSet(&audio->enabled, 0);
+                    break;
+                }
+            }
+
+            got = SDL_AudioStreamGet(audio->stream, stream, (int) len);
+            if (got != (int) len) {
+                SDL_memset(stream, audio->spec.silence, len);
+            }
         } else {
             SDL_LockMutex(audio->mixer_lock);
             (*audio->spec.callback) (audio->spec.userdata,
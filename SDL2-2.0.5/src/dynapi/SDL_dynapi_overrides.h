@@ -612,3 +612,37 @@
 #define SDL_CreateRGBSurfaceWithFormat SDL_CreateRGBSurfaceWithFormat_REAL
 #define SDL_CreateRGBSurfaceWithFormatFrom SDL_CreateRGBSurfaceWithFormatFrom_REAL
 #define SDL_GetHintBoolean SDL_GetHintBoolean_REAL
+#define SDL_PremultiplyAlpha SDL_PremultiplyAlpha_REAL
+#define SDL_GetSurfacePoolStats SDL_GetSurfacePoolStats_REAL
+#define SDL_UpdateYUVTextureAsync SDL_UpdateYUVTextureAsync_REAL
+#define SDL_SetRenderDrawLineWidth SDL_SetRenderDrawLineWidth_REAL
+#define SDL_GetRenderDrawLineWidth SDL_GetRenderDrawLineWidth_REAL
+#define SDL_IntersectRects SDL_IntersectRects_REAL
+#define SDL_CullRects SDL_CullRects_REAL
+#define SDL_ClipPoints SDL_ClipPoints_REAL
+#define SDL_NewAudioStream SDL_NewAudioStream_REAL
+#define SDL_AudioStreamPut SDL_AudioStreamPut_REAL
+#define SDL_AudioStreamGet SDL_AudioStreamGet_REAL
+#define SDL_AudioStreamAvailable SDL_AudioStreamAvailable_REAL
+#define SDL_AudioStreamFlush SDL_AudioStreamFlush_REAL
+#define SDL_AudioStreamClear SDL_AudioStreamClear_REAL
+#define SDL_FreeAudioStream SDL_FreeAudioStream_REAL
+#define SDL_NewAudioMixer SDL_NewAudioMixer_REAL
+#define SDL_AudioMixerAddBuffer SDL_AudioMixerAddBuffer_REAL
+#define SDL_AudioMixerAddStream SDL_AudioMixerAddStream_REAL
+#define SDL_AudioMixerPutVoice SDL_AudioMixerPutVoice_REAL
+#define SDL_AudioMixerSetVoiceVolume SDL_AudioMixerSetVoiceVolume_REAL
+#define SDL_AudioMixerVoicePlaying SDL_AudioMixerVoicePlaying_REAL
+#define SDL_AudioMixerRemoveVoice SDL_AudioMixerRemoveVoice_REAL
+#define SDL_AudioMixerRender SDL_AudioMixerRender_REAL
+#define SDL_AudioMixerCallback SDL_AudioMixerCallback_REAL
+#define SDL_FreeAudioMixer SDL_FreeAudioMixer_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_ResetAudioDeviceStats SDL_ResetAudioDeviceStats_REAL
+#define SDL_GetAudioDevicePosition SDL_GetAudioDevicePosition_REAL
+#define SDL_NewWAVReader SDL_NewWAVReader_REAL
+#define SDL_WAVReaderRead SDL_WAVReaderRead_REAL
+#define SDL_WAVReaderSeek SDL_WAVReaderSeek_REAL
+#define SDL_WAVReaderTell SDL_WAVReaderTell_REAL
+#define SDL_WAVReaderLength SDL_WAVReaderLength_REAL
+#define SDL_FreeWAVReader SDL_FreeWAVReader_REAL
@@ -644,3 +644,37 @@ SDL_DYNAPI_PROC(void,SDL_SetWindowResizable,(SDL_Window *a, SDL_bool b),(a,b),)
 SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateRGBSurfaceWithFormat,(Uint32 a, int b, int c, int d, Uint32 e),(a,b,c,d,e),return)
 SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateRGBSurfaceWithFormatFrom,(void *a, int b, int c, int d, int e, Uint32 f),(a,b,c,d,e,f),return)
 SDL_DYNAPI_PROC(SDL_bool,SDL_GetHintBoolean,(const char *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_PremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(void,SDL_GetSurfacePoolStats,(Uint64 *a, Uint64 *b, Uint64 *c),(a,b,c),)
+SDL_DYNAPI_PROC(int,SDL_UpdateYUVTextureAsync,(SDL_Texture *a, const Uint8 *b, int c, const Uint8 *d, int e, const Uint8 *f, int g),(a,b,c,d,e,f,g),return)
+SDL_DYNAPI_PROC(int,SDL_SetRenderDrawLineWidth,(SDL_Renderer *a, float b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderDrawLineWidth,(SDL_Renderer *a, float *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_IntersectRects,(const SDL_Rect *a, int b, const SDL_Rect *c, SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_CullRects,(const SDL_Rect *a, int b, const SDL_Rect *c, SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_ClipPoints,(const SDL_Point *a, int b, const SDL_Rect *c, SDL_Point *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_NewAudioStream,(const SDL_AudioFormat a, const Uint8 b, const int c, const SDL_AudioFormat d, const Uint8 e, const int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamPut,(SDL_AudioStream *a, const void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamGet,(SDL_AudioStream *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamAvailable,(SDL_AudioStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamFlush,(SDL_AudioStream *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_AudioStreamClear,(SDL_AudioStream *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_FreeAudioStream,(SDL_AudioStream *a),(a),)
+SDL_DYNAPI_PROC(SDL_AudioMixer*,SDL_NewAudioMixer,(SDL_AudioFormat a, Uint8 b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerAddBuffer,(SDL_AudioMixer *a, SDL_AudioFormat b, Uint8 c, const void *d, Uint32 e, SDL_bool f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerAddStream,(SDL_AudioMixer *a, SDL_AudioFormat b, Uint8 c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerPutVoice,(SDL_AudioMixer *a, int b, const void *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerSetVoiceVolume,(SDL_AudioMixer *a, int b, float c, float d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_AudioMixerVoicePlaying,(SDL_AudioMixer *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerRemoveVoice,(SDL_AudioMixer *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AudioMixerRender,(SDL_AudioMixer *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_AudioMixerCallback,(void *a, Uint8 *b, int c),(a,b,c),)
+SDL_DYNAPI_PROC(void,SDL_FreeAudioMixer,(SDL_AudioMixer *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a, SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetAudioDeviceStats,(SDL_AudioDeviceID a),(a),)
+SDL_DYNAPI_PROC(Uint64,SDL_GetAudioDevicePosition,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(SDL_WAVReader*,SDL_NewWAVReader,(SDL_RWops *a, int b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_WAVReaderRead,(SDL_WAVReader *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_WAVReaderSeek,(SDL_WAVReader *a, Uint32 b),(a,b),return)
+SDL_DYNAPI_PROC(Uint32,SDL_WAVReaderTell,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(Uint32,SDL_WAVReaderLength,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_FreeWAVReader,(SDL_WAVReader *a),(a),)
@@ -32,6 +32,7 @@
 #include "../joystick/SDL_joystick_c.h"
 #endif
 #include "../video/SDL_sysvideo.h"
+#include "../video/SDL_surface_pool.h"
 
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS   65535
@@ -624,6 +625,11 @@ SDL_SendAppEvent(SDL_EventType eventType)
 {
     int posted;
 
+    /* Give back what we can before the application frees its own memory */
+    if (eventType == SDL_APP_LOWMEMORY) {
+        SDL_TrimSurfacePool();
+    }
+
     posted = 0;
     if (SDL_GetEventState(eventType) == SDL_ENABLE) {
         SDL_Event event;
@@ -28,6 +28,8 @@
 #include "SDL_render.h"
 #include "SDL_sysrender.h"
 #include "software/SDL_render_sw_c.h"
+#include "software/SDL_drawwideline.h"
+#include "../video/SDL_surface_pool.h"
 
 
 #define SDL_WINDOWRENDERDATA    "_SDL_WindowRenderData"
@@ -216,6 +218,40 @@ SDL_CreateWindowAndRenderer(int width, int height, Uint32 window_flags,
     return 0;
 }
 
+/* Lower the maximum texture size to the one in the hint, if any */
+static void
+SDL_ApplyMaxTextureSize(SDL_Renderer * renderer)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_MAX_TEXTURE_SIZE);
+    int size;
+
+    if (!hint || !*hint) {
+        return;
+    }
+    size = SDL_atoi(hint);
+    if (size <= 0) {
+        return;
+    }
+    if (!renderer->info.max_texture_width || renderer->info.max_texture_width > size) {
+        renderer->info.max_texture_width = size;
+    }
+    if (!renderer->info.max_texture_height || renderer->info.max_texture_height > size) {
+        renderer->info.max_texture_height = size;
+    }
+}
+
+static void SDLCALL
+SDL_RendererLineAntialiasingChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_Renderer *renderer = (SDL_Renderer *) userdata;
+
+    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "false") == 0) {
+        renderer->line_antialias = SDL_FALSE;
+    } else {
+        renderer->line_antialias = SDL_TRUE;
+    }
+}
+
 SDL_Renderer *
 SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
 {
@@ -289,6 +325,10 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
         renderer->window = window;
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
+        renderer->line_width = 1.0f;
+        SDL_ApplyMaxTextureSize(renderer);
+        SDL_AddHintCallback(SDL_HINT_RENDER_LINE_ANTIALIASING,
+                            SDL_RendererLineAntialiasingChanged, renderer);
 
         if (SDL_GetWindowFlags(window) & (SDL_WINDOW_HIDDEN|SDL_WINDOW_MINIMIZED)) {
             renderer->hidden = SDL_TRUE;
@@ -324,6 +364,10 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         renderer->magic = &renderer_magic;
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
+        renderer->line_width = 1.0f;
+        SDL_ApplyMaxTextureSize(renderer);
+        SDL_AddHintCallback(SDL_HINT_RENDER_LINE_ANTIALIASING,
+                            SDL_RendererLineAntialiasingChanged, renderer);
 
         SDL_RenderSetViewport(renderer, NULL);
     }
@@ -406,10 +450,66 @@ GetClosestSupportedFormat(SDL_Renderer * renderer, Uint32 format)
     return renderer->info.texture_formats[0];
 }
 
+/* Back an oversized texture with a grid of textures the renderer can hold */
+static int
+SDL_CreateTextureTiles(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    const int max_w = renderer->info.max_texture_width;
+    const int max_h = renderer->info.max_texture_height;
+    int tx, ty;
+
+    texture->tile_w = (max_w && texture->w > max_w) ? max_w : texture->w;
+    texture->tile_h = (max_h && texture->h > max_h) ? max_h : texture->h;
+    texture->tiles_x = (texture->w + texture->tile_w - 1) / texture->tile_w;
+    texture->tiles_y = (texture->h + texture->tile_h - 1) / texture->tile_h;
+    texture->tiles = (SDL_Texture **) SDL_calloc(texture->tiles_x * texture->tiles_y,
+                                                 sizeof(*texture->tiles));
+    if (!texture->tiles) {
+        return SDL_OutOfMemory();
+    }
+
+    for (ty = 0; ty < texture->tiles_y; ++ty) {
+        for (tx = 0; tx < texture->tiles_x; ++tx) {
+            const int w = SDL_min(texture->tile_w, texture->w - tx * texture->tile_w);
+            const int h = SDL_min(texture->tile_h, texture->h - ty * texture->tile_h);
+            SDL_Texture *tile;
+
+            tile = SDL_CreateTexture(renderer, texture->format, texture->access, w, h);
+            if (!tile) {
+                return -1;
+            }
+            texture->tiles[ty * texture->tiles_x + tx] = tile;
+        }
+    }
+
+    /* Move the texture ahead of its tiles in the list */
+    if (texture->prev) {
+        texture->prev->next = texture->next;
+        if (texture->next) {
+            texture->next->prev = texture->prev;
+        }
+        texture->prev = NULL;
+        texture->next = renderer->textures;
+        renderer->textures->prev = texture;
+        renderer->textures = texture;
+    }
+
+    if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
+        /* The pitch is 4 byte aligned */
+        texture->pitch = (((texture->w * SDL_BYTESPERPIXEL(texture->format)) + 3) & ~3);
+        texture->pixels = SDL_calloc(1, (size_t) texture->pitch * texture->h);
+        if (!texture->pixels) {
+            return SDL_OutOfMemory();
+        }
+    }
+    return 0;
+}
+
 SDL_Texture *
 SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int h)
 {
     SDL_Texture *texture;
+    SDL_bool tiled = SDL_FALSE;
 
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
@@ -430,8 +530,11 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
     }
     if ((renderer->info.max_texture_width && w > renderer->info.max_texture_width) ||
         (renderer->info.max_texture_height && h > renderer->info.max_texture_height)) {
-        SDL_SetError("Texture dimensions are limited to %dx%d", renderer->info.max_texture_width, renderer->info.max_texture_height);
-        return NULL;
+        if (access == SDL_TEXTUREACCESS_TARGET || SDL_ISPIXELFORMAT_FOURCC(format)) {
+            SDL_SetError("Texture dimensions are limited to %dx%d", renderer->info.max_texture_width, renderer->info.max_texture_height);
+            return NULL;
+        }
+        tiled = SDL_TRUE;
     }
     texture = (SDL_Texture *) SDL_calloc(1, sizeof(*texture));
     if (!texture) {
@@ -454,7 +557,12 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
     }
     renderer->textures = texture;
 
-    if (IsSupportedFormat(renderer, format)) {
+    if (tiled) {
+        if (SDL_CreateTextureTiles(renderer, texture) < 0) {
+            SDL_DestroyTexture(texture);
+            return NULL;
+        }
+    } else if (IsSupportedFormat(renderer, format)) {
         if (renderer->CreateTexture(renderer, texture) < 0) {
             SDL_DestroyTexture(texture);
             return NULL;
@@ -556,7 +664,7 @@ SDL_CreateTextureFromSurface(SDL_Renderer * renderer, SDL_Surface * surface)
            SDL_DestroyTexture(texture);
            return NULL;
         }
-        temp = SDL_ConvertSurface(surface, dst_fmt, 0);
+        temp = SDL_ConvertSurfacePooled(surface, dst_fmt);
         SDL_FreeFormat(dst_fmt);
         if (temp) {
             SDL_UpdateTexture(texture, NULL, temp->pixels, temp->pitch);
@@ -613,6 +721,7 @@ int
 SDL_SetTextureColorMod(SDL_Texture * texture, Uint8 r, Uint8 g, Uint8 b)
 {
     SDL_Renderer *renderer;
+    int i;
 
     CHECK_TEXTURE_MAGIC(texture, -1);
 
@@ -625,7 +734,14 @@ SDL_SetTextureColorMod(SDL_Texture * texture, Uint8 r, Uint8 g, Uint8 b)
     texture->r = r;
     texture->g = g;
     texture->b = b;
-    if (texture->native) {
+    if (texture->tiles) {
+        for (i = 0; i < texture->tiles_x * texture->tiles_y; ++i) {
+            if (SDL_SetTextureColorMod(texture->tiles[i], r, g, b) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+    } else if (texture->native) {
         return SDL_SetTextureColorMod(texture->native, r, g, b);
     } else if (renderer->SetTextureColorMod) {
         return renderer->SetTextureColorMod(renderer, texture);
@@ -656,6 +772,7 @@ int
 SDL_SetTextureAlphaMod(SDL_Texture * texture, Uint8 alpha)
 {
     SDL_Renderer *renderer;
+    int i;
 
     CHECK_TEXTURE_MAGIC(texture, -1);
 
@@ -666,7 +783,14 @@ SDL_SetTextureAlphaMod(SDL_Texture * texture, Uint8 alpha)
         texture->modMode &= ~SDL_TEXTUREMODULATE_ALPHA;
     }
     texture->a = alpha;
-    if (texture->native) {
+    if (texture->tiles) {
+        for (i = 0; i < texture->tiles_x * texture->tiles_y; ++i) {
+            if (SDL_SetTextureAlphaMod(texture->tiles[i], alpha) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+    } else if (texture->native) {
         return SDL_SetTextureAlphaMod(texture->native, alpha);
     } else if (renderer->SetTextureAlphaMod) {
         return renderer->SetTextureAlphaMod(renderer, texture);
@@ -690,12 +814,20 @@ int
 SDL_SetTextureBlendMode(SDL_Texture * texture, SDL_BlendMode blendMode)
 {
     SDL_Renderer *renderer;
+    int i;
 
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
     texture->blendMode = blendMode;
-    if (texture->native) {
+    if (texture->tiles) {
+        for (i = 0; i < texture->tiles_x * texture->tiles_y; ++i) {
+            if (SDL_SetTextureBlendMode(texture->tiles[i], blendMode) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+    } else if (texture->native) {
         return SDL_SetTextureBlendMode(texture->native, blendMode);
     } else if (renderer->SetTextureBlendMode) {
         return renderer->SetTextureBlendMode(renderer, texture);
@@ -749,14 +881,14 @@ SDL_UpdateTextureYUV(SDL_Texture * texture, const SDL_Rect * rect,
         int temp_pitch;
 
         temp_pitch = (((rect->w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
-        temp_pixels = SDL_malloc(rect->h * temp_pitch);
+        temp_pixels = SDL_AllocPooledPixels(rect->h * temp_pitch);
         if (!temp_pixels) {
             return SDL_OutOfMemory();
         }
         SDL_SW_CopyYUVToRGB(texture->yuv, rect, native->format,
                             rect->w, rect->h, temp_pixels, temp_pitch);
         SDL_UpdateTexture(native, rect, temp_pixels, temp_pitch);
-        SDL_free(temp_pixels);
+        SDL_FreePooledPixels(temp_pixels);
     }
     return 0;
 }
@@ -785,7 +917,7 @@ SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
         int temp_pitch;
 
         temp_pitch = (((rect->w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
-        temp_pixels = SDL_malloc(rect->h * temp_pitch);
+        temp_pixels = SDL_AllocPooledPixels(rect->h * temp_pitch);
         if (!temp_pixels) {
             return SDL_OutOfMemory();
         }
@@ -793,7 +925,43 @@ SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
                           texture->format, pixels, pitch,
                           native->format, temp_pixels, temp_pitch);
         SDL_UpdateTexture(native, rect, temp_pixels, temp_pitch);
-        SDL_free(temp_pixels);
+        SDL_FreePooledPixels(temp_pixels);
+    }
+    return 0;
+}
+
+/* Pass the part of an update that falls on each tile to that tile */
+static int
+SDL_UpdateTextureTiles(SDL_Texture * texture, const SDL_Rect * rect,
+                       const void *pixels, int pitch)
+{
+    const int bpp = SDL_BYTESPERPIXEL(texture->format);
+    const int tx0 = SDL_max(rect->x, 0) / texture->tile_w;
+    const int ty0 = SDL_max(rect->y, 0) / texture->tile_h;
+    const int tx1 = SDL_min(texture->tiles_x - 1, (rect->x + rect->w - 1) / texture->tile_w);
+    const int ty1 = SDL_min(texture->tiles_y - 1, (rect->y + rect->h - 1) / texture->tile_h);
+    SDL_Rect tile_rect, part;
+    int tx, ty;
+
+    for (ty = ty0; ty <= ty1; ++ty) {
+        for (tx = tx0; tx <= tx1; ++tx) {
+            SDL_Texture *tile = texture->tiles[ty * texture->tiles_x + tx];
+            const Uint8 *src;
+
+            tile_rect.x = tx * texture->tile_w;
+            tile_rect.y = ty * texture->tile_h;
+            tile_rect.w = tile->w;
+            tile_rect.h = tile->h;
+            if (!SDL_IntersectRect(rect, &tile_rect, &part)) {
+                continue;
+            }
+            src = (const Uint8 *) pixels + (part.y - rect->y) * pitch + (part.x - rect->x) * bpp;
+            part.x -= tile_rect.x;
+            part.y -= tile_rect.y;
+            if (SDL_UpdateTexture(tile, &part, src, pitch) < 0) {
+                return -1;
+            }
+        }
     }
     return 0;
 }
@@ -822,10 +990,16 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         rect = &full_rect;
     }
 
+    if (SDL_ApplyYUVQueue(texture, SDL_TRUE) < 0) {
+        return -1;
+    }
+
     if ((rect->w == 0) || (rect->h == 0)) {
         return 0;  /* nothing to do. */
     } else if (texture->yuv) {
         return SDL_UpdateTextureYUV(texture, rect, pixels, pitch);
+    } else if (texture->tiles) {
+        return SDL_UpdateTextureTiles(texture, rect, pixels, pitch);
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
     } else {
@@ -870,14 +1044,14 @@ SDL_UpdateTextureYUVPlanar(SDL_Texture * texture, const SDL_Rect * rect,
         int temp_pitch;
 
         temp_pitch = (((rect->w * SDL_BYTESPERPIXEL(native->format)) + 3) & ~3);
-        temp_pixels = SDL_malloc(rect->h * temp_pitch);
+        temp_pixels = SDL_AllocPooledPixels(rect->h * temp_pitch);
         if (!temp_pixels) {
             return SDL_OutOfMemory();
         }
         SDL_SW_CopyYUVToRGB(texture->yuv, rect, native->format,
                             rect->w, rect->h, temp_pixels, temp_pitch);
         SDL_UpdateTexture(native, rect, temp_pixels, temp_pitch);
-        SDL_free(temp_pixels);
+        SDL_FreePooledPixels(temp_pixels);
     }
     return 0;
 }
@@ -924,6 +1098,10 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
         rect = &full_rect;
     }
 
+    if (SDL_ApplyYUVQueue(texture, SDL_TRUE) < 0) {
+        return -1;
+    }
+
     if (texture->yuv) {
         return SDL_UpdateTextureYUVPlanar(texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
     } else {
@@ -938,6 +1116,44 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
     }
 }
 
+int
+SDL_UpdateYUVTextureAsync(SDL_Texture * texture,
+                          const Uint8 *Yplane, int Ypitch,
+                          const Uint8 *Uplane, int Upitch,
+                          const Uint8 *Vplane, int Vpitch)
+{
+    CHECK_TEXTURE_MAGIC(texture, -1);
+
+    if (!Yplane) {
+        return SDL_InvalidParamError("Yplane");
+    }
+    if (!Ypitch) {
+        return SDL_InvalidParamError("Ypitch");
+    }
+    if (!Uplane) {
+        return SDL_InvalidParamError("Uplane");
+    }
+    if (!Upitch) {
+        return SDL_InvalidParamError("Upitch");
+    }
+    if (!Vplane) {
+        return SDL_InvalidParamError("Vplane");
+    }
+    if (!Vpitch) {
+        return SDL_InvalidParamError("Vpitch");
+    }
+
+    if (texture->format != SDL_PIXELFORMAT_YV12 &&
+        texture->format != SDL_PIXELFORMAT_IYUV) {
+        return SDL_SetError("Texture format must by YV12 or IYUV");
+    }
+    if (!texture->yuv && !texture->renderer->UpdateTextureYUV) {
+        return SDL_Unsupported();
+    }
+
+    return SDL_QueueYUVFrame(texture, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
+}
+
 static int
 SDL_LockTextureYUV(SDL_Texture * texture, const SDL_Rect * rect,
                    void **pixels, int *pitch)
@@ -978,9 +1194,13 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
         rect = &full_rect;
     }
 
+    if (SDL_ApplyYUVQueue(texture, SDL_TRUE) < 0) {
+        return -1;
+    }
+
     if (texture->yuv) {
         return SDL_LockTextureYUV(texture, rect, pixels, pitch);
-    } else if (texture->native) {
+    } else if (texture->native || texture->tiles) {
         return SDL_LockTextureNative(texture, rect, pixels, pitch);
     } else {
         renderer = texture->renderer;
@@ -1030,6 +1250,17 @@ SDL_UnlockTextureNative(SDL_Texture * texture)
     SDL_UnlockTexture(native);
 }
 
+static void
+SDL_UnlockTextureTiles(SDL_Texture * texture)
+{
+    const SDL_Rect *rect = &texture->locked_rect;
+    const void* pixels = (void *) ((Uint8 *) texture->pixels +
+                        rect->y * texture->pitch +
+                        rect->x * SDL_BYTESPERPIXEL(texture->format));
+
+    SDL_UpdateTextureTiles(texture, rect, pixels, texture->pitch);
+}
+
 void
 SDL_UnlockTexture(SDL_Texture * texture)
 {
@@ -1042,6 +1273,8 @@ SDL_UnlockTexture(SDL_Texture * texture)
     }
     if (texture->yuv) {
         SDL_UnlockTextureYUV(texture);
+    } else if (texture->tiles) {
+        SDL_UnlockTextureTiles(texture);
     } else if (texture->native) {
         SDL_UnlockTextureNative(texture);
     } else {
@@ -1396,6 +1629,27 @@ SDL_GetRenderDrawBlendMode(SDL_Renderer * renderer, SDL_BlendMode *blendMode)
     return 0;
 }
 
+int
+SDL_SetRenderDrawLineWidth(SDL_Renderer * renderer, float width)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!(width > 0.0f)) {
+        return SDL_InvalidParamError("width");
+    }
+    renderer->line_width = width;
+    return 0;
+}
+
+int
+SDL_GetRenderDrawLineWidth(SDL_Renderer * renderer, float *width)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    *width = renderer->line_width;
+    return 0;
+}
+
 int
 SDL_RenderClear(SDL_Renderer * renderer)
 {
@@ -1418,6 +1672,26 @@ SDL_RenderDrawPoint(SDL_Renderer * renderer, int x, int y)
     return SDL_RenderDrawPoints(renderer, &point, 1);
 }
 
+/* The part of the logical coordinate space that lands in the viewport,
+   rounded out so that anything partially visible is kept */
+static SDL_bool
+GetRenderCullRect(SDL_Renderer * renderer, SDL_Rect * rect)
+{
+    double w, h;
+
+    if (renderer->scale.x <= 0.0f || renderer->scale.y <= 0.0f) {
+        return SDL_FALSE;
+    }
+    w = SDL_ceil(renderer->viewport.w / renderer->scale.x);
+    h = SDL_ceil(renderer->viewport.h / renderer->scale.y);
+
+    rect->x = 0;
+    rect->y = 0;
+    rect->w = (w < 0x7FFFFFFF) ? (int) w : 0x7FFFFFFF;
+    rect->h = (h < 0x7FFFFFFF) ? (int) h : 0x7FFFFFFF;
+    return SDL_TRUE;
+}
+
 static int
 RenderDrawPointsWithRects(SDL_Renderer * renderer,
                      const SDL_Point * points, int count)
@@ -1449,6 +1723,8 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
                      const SDL_Point * points, int count)
 {
     SDL_FPoint *fpoints;
+    SDL_Point *visible = NULL;
+    SDL_Rect cull;
     int i;
     int status;
 
@@ -1466,12 +1742,29 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
         return 0;
     }
 
+    /* Drop the points outside the viewport before converting them */
+    if (GetRenderCullRect(renderer, &cull)) {
+        visible = SDL_stack_alloc(SDL_Point, count);
+        if (!visible) {
+            return SDL_OutOfMemory();
+        }
+        count = SDL_ClipPoints(points, count, &cull, visible);
+        points = visible;
+        if (count == 0) {
+            SDL_stack_free(visible);
+            return 0;
+        }
+    }
+
     if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
-        return RenderDrawPointsWithRects(renderer, points, count);
+        status = RenderDrawPointsWithRects(renderer, points, count);
+        SDL_stack_free(visible);
+        return status;
     }
 
     fpoints = SDL_stack_alloc(SDL_FPoint, count);
     if (!fpoints) {
+        SDL_stack_free(visible);
         return SDL_OutOfMemory();
     }
     for (i = 0; i < count; ++i) {
@@ -1482,6 +1775,7 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
     status = renderer->RenderDrawPoints(renderer, fpoints, count);
 
     SDL_stack_free(fpoints);
+    SDL_stack_free(visible);
 
     return status;
 }
@@ -1554,6 +1848,107 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
     return status;
 }
 
+/* Draw wide lines as rows of rects on renderers that can't draw them */
+static int
+RenderDrawWideLinesWithRects(SDL_Renderer * renderer,
+                             const SDL_FPoint * points, int count, float width)
+{
+    SDL_Rect clip;
+    SDL_Rect rectbuf[64];
+    SDL_FRect frectbuf[64];
+    SDL_Rect *rects;
+    SDL_FRect *frects;
+    int i, j, nrects, maxrects;
+    int status = 0;
+
+    clip.x = 0;
+    clip.y = 0;
+    clip.w = renderer->viewport.w;
+    clip.h = renderer->viewport.h;
+    if (clip.h <= 0) {
+        return 0;
+    }
+
+    /* Each row gets one rect, and no segment covers more rows than its
+       length plus its width on both ends */
+    maxrects = 0;
+    for (i = 1; i < count; ++i) {
+        const double rows = SDL_fabs(points[i].x - points[i-1].x) +
+                            SDL_fabs(points[i].y - points[i-1].y) +
+                            2.0 * width + 2.0;
+        if (rows >= (double) clip.h) {
+            maxrects = clip.h;
+            break;
+        }
+        maxrects = SDL_max(maxrects, (int) rows);
+    }
+
+    if (maxrects <= (int) SDL_arraysize(rectbuf)) {
+        rects = rectbuf;
+        frects = frectbuf;
+    } else {
+        rects = (SDL_Rect *) SDL_malloc(maxrects * sizeof(*rects));
+        frects = (SDL_FRect *) SDL_malloc(maxrects * sizeof(*frects));
+        if (!rects || !frects) {
+            SDL_free(rects);
+            SDL_free(frects);
+            return SDL_OutOfMemory();
+        }
+    }
+    for (i = 1; i < count; ++i) {
+        nrects = SDL_GetWideLineRects(&points[i-1], &points[i], width, &clip, rects);
+        for (j = 0; j < nrects; ++j) {
+            frects[j].x = (float) rects[j].x;
+            frects[j].y = (float) rects[j].y;
+            frects[j].w = (float) rects[j].w;
+            frects[j].h = (float) rects[j].h;
+        }
+        if (nrects > 0) {
+            status += renderer->RenderFillRects(renderer, frects, nrects);
+        }
+    }
+    if (rects != rectbuf) {
+        SDL_free(rects);
+        SDL_free(frects);
+    }
+
+    if (status < 0) {
+        status = -1;
+    }
+    return status;
+}
+
+static int
+RenderDrawWideLines(SDL_Renderer * renderer,
+                    const SDL_Point * points, int count, SDL_bool antialias)
+{
+    SDL_FPoint *fpoints;
+    float width;
+    int i;
+    int status;
+
+    fpoints = SDL_stack_alloc(SDL_FPoint, count);
+    if (!fpoints) {
+        return SDL_OutOfMemory();
+    }
+    /* Go through the center of the scaled pixels */
+    for (i = 0; i < count; ++i) {
+        fpoints[i].x = (points[i].x + 0.5f) * renderer->scale.x - 0.5f;
+        fpoints[i].y = (points[i].y + 0.5f) * renderer->scale.y - 0.5f;
+    }
+    width = renderer->line_width * (renderer->scale.x + renderer->scale.y) * 0.5f;
+
+    if (renderer->RenderDrawWideLines) {
+        status = renderer->RenderDrawWideLines(renderer, fpoints, count, width, antialias);
+    } else {
+        status = RenderDrawWideLinesWithRects(renderer, fpoints, count, width);
+    }
+
+    SDL_stack_free(fpoints);
+
+    return status;
+}
+
 int
 SDL_RenderDrawLines(SDL_Renderer * renderer,
                     const SDL_Point * points, int count)
@@ -1576,6 +1971,10 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
         return 0;
     }
 
+    if (renderer->line_width != 1.0f || renderer->line_antialias) {
+        return RenderDrawWideLines(renderer, points, count, renderer->line_antialias);
+    }
+
     if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
         return RenderDrawLinesWithRects(renderer, points, count);
     }
@@ -1675,6 +2074,8 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
                     const SDL_Rect * rects, int count)
 {
     SDL_FRect *frects;
+    SDL_Rect *visible = NULL;
+    SDL_Rect cull;
     int i;
     int status;
 
@@ -1692,8 +2093,23 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
         return 0;
     }
 
+    /* Drop the rects outside the viewport before converting them */
+    if (GetRenderCullRect(renderer, &cull)) {
+        visible = SDL_stack_alloc(SDL_Rect, count);
+        if (!visible) {
+            return SDL_OutOfMemory();
+        }
+        count = SDL_CullRects(rects, count, &cull, visible);
+        rects = visible;
+        if (count == 0) {
+            SDL_stack_free(visible);
+            return 0;
+        }
+    }
+
     frects = SDL_stack_alloc(SDL_FRect, count);
     if (!frects) {
+        SDL_stack_free(visible);
         return SDL_OutOfMemory();
     }
     for (i = 0; i < count; ++i) {
@@ -1706,10 +2122,100 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
     status = renderer->RenderFillRects(renderer, frects, count);
 
     SDL_stack_free(frects);
+    SDL_stack_free(visible);
 
     return status;
 }
 
+/* Where source column or row s of a copy lands, relative to the start of
+   the destination. Edges between tiles are put on whole pixels, so that
+   neighbouring tiles neither overlap nor leave a gap. */
+static float
+GetTileEdge(int s, int src_start, int src_size, float dst_size)
+{
+    if (s <= src_start) {
+        return 0.0f;
+    }
+    if (s >= src_start + src_size) {
+        return dst_size;
+    }
+    return (float) SDL_floor((double) (s - src_start) * dst_size / src_size + 0.5);
+}
+
+/* Copy the part of a tiled texture under srcrect with one copy per tile it
+   touches. A center makes it a RenderCopyEx, every tile then turns around
+   the same point. */
+static int
+SDL_RenderCopyTiles(SDL_Renderer * renderer, SDL_Texture * texture,
+                    const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+                    const double angle, const SDL_FPoint * center,
+                    const SDL_RendererFlip flip)
+{
+    const int tx0 = srcrect->x / texture->tile_w;
+    const int ty0 = srcrect->y / texture->tile_h;
+    const int tx1 = (srcrect->x + srcrect->w - 1) / texture->tile_w;
+    const int ty1 = (srcrect->y + srcrect->h - 1) / texture->tile_h;
+    int tx, ty;
+
+    for (ty = ty0; ty <= ty1; ++ty) {
+        for (tx = tx0; tx <= tx1; ++tx) {
+            SDL_Texture *tile = texture->tiles[ty * texture->tiles_x + tx];
+            SDL_Rect part;
+            SDL_FRect frect;
+            SDL_FPoint fcenter;
+            float x0, y0, x1, y1, swap;
+            int status;
+
+            part.x = SDL_max(srcrect->x, tx * texture->tile_w);
+            part.y = SDL_max(srcrect->y, ty * texture->tile_h);
+            part.w = SDL_min(srcrect->x + srcrect->w, tx * texture->tile_w + tile->w) - part.x;
+            part.h = SDL_min(srcrect->y + srcrect->h, ty * texture->tile_h + tile->h) - part.y;
+
+            x0 = GetTileEdge(part.x, srcrect->x, srcrect->w, dstrect->w);
+            x1 = GetTileEdge(part.x + part.w, srcrect->x, srcrect->w, dstrect->w);
+            y0 = GetTileEdge(part.y, srcrect->y, srcrect->h, dstrect->h);
+            y1 = GetTileEdge(part.y + part.h, srcrect->y, srcrect->h, dstrect->h);
+            if (flip & SDL_FLIP_HORIZONTAL) {
+                swap = x0;
+                x0 = dstrect->w - x1;
+                x1 = dstrect->w - swap;
+            }
+            if (flip & SDL_FLIP_VERTICAL) {
+                swap = y0;
+                y0 = dstrect->h - y1;
+                y1 = dstrect->h - swap;
+            }
+            frect.x = dstrect->x + x0;
+            frect.y = dstrect->y + y0;
+            frect.w = x1 - x0;
+            frect.h = y1 - y0;
+
+            part.x -= tx * texture->tile_w;
+            part.y -= ty * texture->tile_h;
+            if (tile->native) {
+                tile = tile->native;
+            }
+
+            if (center) {
+                fcenter.x = center->x - x0;
+                fcenter.y = center->y - y0;
+                status = renderer->RenderCopyEx(renderer, tile, &part, &frect, angle, &fcenter, flip);
+            } else {
+                /* Skip the tiles that land outside the viewport */
+                if (frect.x >= renderer->viewport.w || frect.x + frect.w <= 0.0f ||
+                    frect.y >= renderer->viewport.h || frect.y + frect.h <= 0.0f) {
+                    continue;
+                }
+                status = renderer->RenderCopy(renderer, tile, &part, &frect);
+            }
+            if (status < 0) {
+                return status;
+            }
+        }
+    }
+    return 0;
+}
+
 int
 SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_Rect * dstrect)
@@ -1750,15 +2256,21 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
         real_dstrect = *dstrect;
     }
 
-    if (texture->native) {
-        texture = texture->native;
-    }
+    /* Swap in the newest frame that finished converting, if any */
+    SDL_ApplyYUVQueue(texture, SDL_FALSE);
 
     frect.x = real_dstrect.x * renderer->scale.x;
     frect.y = real_dstrect.y * renderer->scale.y;
     frect.w = real_dstrect.w * renderer->scale.x;
     frect.h = real_dstrect.h * renderer->scale.y;
 
+    if (texture->tiles) {
+        return SDL_RenderCopyTiles(renderer, texture, &real_srcrect, &frect, 0.0, NULL, SDL_FLIP_NONE);
+    }
+    if (texture->native) {
+        texture = texture->native;
+    }
+
     return renderer->RenderCopy(renderer, texture, &real_srcrect, &frect);
 }
 
@@ -1812,9 +2324,7 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
         real_dstrect.y = 0;
     }
 
-    if (texture->native) {
-        texture = texture->native;
-    }
+    SDL_ApplyYUVQueue(texture, SDL_FALSE);
 
     if (center) {
         real_center = *center;
@@ -1831,6 +2341,13 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     fcenter.x = real_center.x * renderer->scale.x;
     fcenter.y = real_center.y * renderer->scale.y;
 
+    if (texture->tiles) {
+        return SDL_RenderCopyTiles(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
+    }
+    if (texture->native) {
+        texture = texture->native;
+    }
+
     return renderer->RenderCopyEx(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
 }
 
@@ -1887,6 +2404,7 @@ void
 SDL_DestroyTexture(SDL_Texture * texture)
 {
     SDL_Renderer *renderer;
+    int i;
 
     CHECK_TEXTURE_MAGIC(texture, );
 
@@ -1906,9 +2424,18 @@ SDL_DestroyTexture(SDL_Texture * texture)
         renderer->textures = texture->next;
     }
 
+    SDL_DestroyYUVQueue(texture);
     if (texture->native) {
         SDL_DestroyTexture(texture->native);
     }
+    if (texture->tiles) {
+        for (i = 0; i < texture->tiles_x * texture->tiles_y; ++i) {
+            if (texture->tiles[i]) {
+                SDL_DestroyTexture(texture->tiles[i]);
+            }
+        }
+        SDL_free(texture->tiles);
+    }
     if (texture->yuv) {
         SDL_SW_DestroyYUVTexture(texture->yuv);
     }
@@ -1924,6 +2451,8 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
     CHECK_RENDERER_MAGIC(renderer, );
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
+    SDL_DelHintCallback(SDL_HINT_RENDER_LINE_ANTIALIASING,
+                        SDL_RendererLineAntialiasingChanged, renderer);
 
     /* Free existing textures for this renderer */
     while (renderer->textures) {
@@ -1947,7 +2476,9 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
 
     CHECK_TEXTURE_MAGIC(texture, -1);
     renderer = texture->renderer;
-    if (texture->native) {
+    if (texture->tiles) {
+        return SDL_SetError("Texture is split into tiles");
+    } else if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
     } else if (renderer && renderer->GL_BindTexture) {
         return renderer->GL_BindTexture(renderer, texture, texw, texh);
@@ -1962,7 +2493,9 @@ int SDL_GL_UnbindTexture(SDL_Texture *texture)
 
     CHECK_TEXTURE_MAGIC(texture, -1);
     renderer = texture->renderer;
-    if (texture->native) {
+    if (texture->tiles) {
+        return SDL_SetError("Texture is split into tiles");
+    } else if (texture->native) {
         return SDL_GL_UnbindTexture(texture->native);
     } else if (renderer && renderer->GL_UnbindTexture) {
         return renderer->GL_UnbindTexture(renderer, texture);
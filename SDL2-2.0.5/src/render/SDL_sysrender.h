@@ -26,6 +26,7 @@
 #include "SDL_render.h"
 #include "SDL_events.h"
 #include "SDL_yuv_sw_c.h"
+#include "SDL_yuv_queue_c.h"
 
 /* The SDL 2D rendering system */
 
@@ -62,6 +63,13 @@ struct SDL_Texture
     /* Support for formats not supported directly by the renderer */
     SDL_Texture *native;
     SDL_SW_YUVTexture *yuv;
+    SDL_YUVQueue *yuv_queue;    /**< Frames from SDL_UpdateYUVTextureAsync() */
+
+    /* Support for textures larger than the renderer's maximum size */
+    SDL_Texture **tiles;        /**< tiles_x * tiles_y textures, row by row */
+    int tile_w, tile_h;         /**< The size of all but the last column and row */
+    int tiles_x, tiles_y;
+
     void *pixels;
     int pitch;
     SDL_Rect locked_rect;
@@ -105,6 +113,8 @@ struct SDL_Renderer
                              int count);
     int (*RenderDrawLines) (SDL_Renderer * renderer, const SDL_FPoint * points,
                             int count);
+    int (*RenderDrawWideLines) (SDL_Renderer * renderer, const SDL_FPoint * points,
+                                int count, float width, SDL_bool antialias);
     int (*RenderFillRects) (SDL_Renderer * renderer, const SDL_FRect * rects,
                             int count);
     int (*RenderCopy) (SDL_Renderer * renderer, SDL_Texture * texture,
@@ -160,6 +170,8 @@ struct SDL_Renderer
 
     Uint8 r, g, b, a;                   /**< Color for drawing operations values */
     SDL_BlendMode blendMode;            /**< The drawing blend mode */
+    float line_width;                   /**< The width of drawn lines */
+    SDL_bool line_antialias;            /**< SDL_HINT_RENDER_LINE_ANTIALIASING */
 
     void *driverdata;
 };
@@ -0,0 +1,626 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_thread.h"
+#include "SDL_sysrender.h"
+#include "SDL_yuv_queue_c.h"
+
+/* Background conversion of YUV frames for SDL_UpdateYUVTextureAsync().
+
+   Each texture gets one or two back buffers. A queued frame is copied into
+   a free one and converted to the format of the native texture on a pool of
+   worker threads shared by all textures. The next time the texture is drawn
+   the newest finished frame is uploaded and its planes are swapped with the
+   texture's own, so the texture always holds the frame it displays.
+
+   Textures the renderer supports natively have nothing to convert, for
+   those only the upload is deferred.
+ */
+
+#define SDL_MAX_YUV_BUFFERS     3   /* Including the one being displayed */
+#define SDL_MAX_YUV_THREADS     8
+
+/* Frame numbers wrap around */
+#define SDL_YUV_NEWER(a, b)     ((Sint32) ((a) - (b)) > 0)
+
+enum
+{
+    SDL_YUV_SLOT_FREE,
+    SDL_YUV_SLOT_FILLING,       /* The frame is being copied in */
+    SDL_YUV_SLOT_QUEUED,        /* Waiting for a worker */
+    SDL_YUV_SLOT_CONVERTING,
+    SDL_YUV_SLOT_READY,
+    SDL_YUV_SLOT_UPLOADING
+};
+
+/* Slots holding a frame the texture hasn't picked up yet */
+#define SDL_YUV_SLOT_UNSHOWN(state) \
+    ((state) == SDL_YUV_SLOT_QUEUED || (state) == SDL_YUV_SLOT_CONVERTING || \
+     (state) == SDL_YUV_SLOT_READY)
+
+typedef struct SDL_YUVQueueSlot
+{
+    int state;
+    Uint32 frame;
+    SDL_YUVQueue *queue;
+    SDL_SW_YUVTexture *yuv;     /* The planes as they were queued */
+    void *pixels;               /* The converted frame, if the texture has one */
+    int pitch;
+    struct SDL_YUVQueueSlot *next;
+} SDL_YUVQueueSlot;
+
+struct SDL_YUVQueue
+{
+    SDL_Texture *texture;
+    Uint32 format;
+    Uint32 target_format;
+    int w, h;
+    SDL_bool convert;
+    Uint32 queued_frame;
+    Uint32 shown_frame;
+    SDL_atomic_t unshown;       /* Checked by the render thread without the lock */
+    int num_slots;
+    SDL_YUVQueueSlot slots[SDL_MAX_YUV_BUFFERS - 1];
+    struct SDL_YUVQueue *next;
+};
+
+static struct
+{
+    SDL_mutex *lock;
+    SDL_cond *work;             /* Signaled when a job is queued */
+    SDL_cond *done;             /* Broadcast when a slot changes state */
+    SDL_Thread *threads[SDL_MAX_YUV_THREADS];
+    int num_threads;
+    SDL_bool quit;
+    SDL_YUVQueueSlot *first_job;
+    SDL_YUVQueueSlot *last_job;
+    SDL_YUVQueue *queues;       /* Every texture's queue, freed at quit */
+} SDL_yuv_pool;
+
+static SDL_SpinLock SDL_yuv_pool_lock;
+
+/* Must be called with the pool lock held */
+static void
+SDL_SetYUVSlotState(SDL_YUVQueueSlot * slot, int state)
+{
+    if (SDL_YUV_SLOT_UNSHOWN(state) && !SDL_YUV_SLOT_UNSHOWN(slot->state)) {
+        SDL_AtomicAdd(&slot->queue->unshown, 1);
+    } else if (!SDL_YUV_SLOT_UNSHOWN(state) && SDL_YUV_SLOT_UNSHOWN(slot->state)) {
+        SDL_AtomicAdd(&slot->queue->unshown, -1);
+    }
+    slot->state = state;
+}
+
+static void
+SDL_ConvertYUVSlot(SDL_YUVQueueSlot * slot)
+{
+    SDL_YUVQueue *queue = slot->queue;
+    SDL_Rect rect;
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = queue->w;
+    rect.h = queue->h;
+    SDL_SW_CopyYUVToRGB(slot->yuv, &rect, queue->target_format,
+                        rect.w, rect.h, slot->pixels, slot->pitch);
+}
+
+static int SDLCALL
+SDL_YUVWorker(void *data)
+{
+    SDL_YUVQueueSlot *slot;
+
+    SDL_LockMutex(SDL_yuv_pool.lock);
+    for (;;) {
+        while (!SDL_yuv_pool.first_job && !SDL_yuv_pool.quit) {
+            SDL_CondWait(SDL_yuv_pool.work, SDL_yuv_pool.lock);
+        }
+        if (SDL_yuv_pool.quit) {
+            break;
+        }
+
+        slot = SDL_yuv_pool.first_job;
+        SDL_yuv_pool.first_job = slot->next;
+        if (!SDL_yuv_pool.first_job) {
+            SDL_yuv_pool.last_job = NULL;
+        }
+        slot->next = NULL;
+        SDL_SetYUVSlotState(slot, SDL_YUV_SLOT_CONVERTING);
+        SDL_UnlockMutex(SDL_yuv_pool.lock);
+
+        SDL_ConvertYUVSlot(slot);
+
+        SDL_LockMutex(SDL_yuv_pool.lock);
+        SDL_SetYUVSlotState(slot, SDL_YUV_SLOT_READY);
+        SDL_CondBroadcast(SDL_yuv_pool.done);
+    }
+    SDL_UnlockMutex(SDL_yuv_pool.lock);
+    return 0;
+}
+
+/* Create the pool lock and, the first time there's work, the threads */
+static int
+SDL_InitYUVPool(SDL_bool start_threads)
+{
+    const char *hint;
+    int count;
+
+    if (SDL_AtomicGetPtr((void **) &SDL_yuv_pool.lock) &&
+        (SDL_yuv_pool.num_threads || !start_threads)) {
+        return 0;
+    }
+
+    SDL_AtomicLock(&SDL_yuv_pool_lock);
+    if (!SDL_yuv_pool.lock) {
+        SDL_yuv_pool.work = SDL_CreateCond();
+        SDL_yuv_pool.done = SDL_CreateCond();
+        if (SDL_yuv_pool.work && SDL_yuv_pool.done) {
+            /* Published last, the render thread checks it without the spinlock */
+            SDL_AtomicSetPtr((void **) &SDL_yuv_pool.lock, SDL_CreateMutex());
+        }
+        if (!SDL_yuv_pool.lock) {
+            if (SDL_yuv_pool.work) {
+                SDL_DestroyCond(SDL_yuv_pool.work);
+                SDL_yuv_pool.work = NULL;
+            }
+            if (SDL_yuv_pool.done) {
+                SDL_DestroyCond(SDL_yuv_pool.done);
+                SDL_yuv_pool.done = NULL;
+            }
+        }
+    }
+    if (SDL_yuv_pool.lock && start_threads && !SDL_yuv_pool.num_threads) {
+        hint = SDL_GetHint(SDL_HINT_RENDER_YUV_THREADS);
+        if (hint && *hint) {
+            count = SDL_atoi(hint);
+        } else {
+            count = SDL_GetCPUCount() - 1;
+        }
+        count = SDL_max(count, 1);
+        count = SDL_min(count, SDL_MAX_YUV_THREADS);
+        while (SDL_yuv_pool.num_threads < count) {
+            SDL_Thread *thread = SDL_CreateThread(SDL_YUVWorker, "SDLYUVWorker", NULL);
+            if (!thread) {
+                break;
+            }
+            SDL_yuv_pool.threads[SDL_yuv_pool.num_threads++] = thread;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_yuv_pool_lock);
+
+    if (!SDL_yuv_pool.lock) {
+        return SDL_SetError("Couldn't create the YUV conversion lock");
+    }
+    return 0;
+}
+
+/* Frames may be queued from another thread than the one rendering, so
+   texture->yuv_queue is only changed with the pool lock held. On success
+   the lock is left held, if there's no queue it is released again. */
+static SDL_YUVQueue *
+SDL_LockYUVQueue(SDL_Texture * texture)
+{
+    SDL_mutex *lock = (SDL_mutex *) SDL_AtomicGetPtr((void **) &SDL_yuv_pool.lock);
+
+    if (!lock) {
+        return NULL;  /* nothing was ever queued */
+    }
+
+    SDL_LockMutex(lock);
+    if (!texture->yuv_queue) {
+        SDL_UnlockMutex(lock);
+        return NULL;
+    }
+    return texture->yuv_queue;
+}
+
+static void
+SDL_FreeYUVQueue(SDL_YUVQueue * queue)
+{
+    int i;
+
+    for (i = 0; i < queue->num_slots; ++i) {
+        if (queue->slots[i].yuv) {
+            SDL_SW_DestroyYUVTexture(queue->slots[i].yuv);
+        }
+        SDL_free(queue->slots[i].pixels);
+    }
+    SDL_free(queue);
+}
+
+static SDL_YUVQueue *
+SDL_CreateYUVQueue(SDL_Texture * texture)
+{
+    SDL_YUVQueue *queue;
+    const char *hint;
+    int buffers = SDL_MAX_YUV_BUFFERS;
+    int i;
+
+    queue = (SDL_YUVQueue *) SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    hint = SDL_GetHint(SDL_HINT_RENDER_YUV_BUFFERS);
+    if (hint && *hint) {
+        buffers = SDL_atoi(hint);
+        buffers = SDL_max(buffers, 2);
+        buffers = SDL_min(buffers, SDL_MAX_YUV_BUFFERS);
+    }
+
+    queue->texture = texture;
+    queue->format = texture->format;
+    queue->w = texture->w;
+    queue->h = texture->h;
+    queue->convert = texture->yuv ? SDL_TRUE : SDL_FALSE;
+    if (queue->convert) {
+        queue->target_format = texture->native->format;
+    }
+    queue->num_slots = buffers - 1;
+    for (i = 0; i < queue->num_slots; ++i) {
+        SDL_YUVQueueSlot *slot = &queue->slots[i];
+
+        slot->queue = queue;
+        slot->yuv = SDL_SW_CreateYUVTexture(queue->format, queue->w, queue->h);
+        if (!slot->yuv) {
+            SDL_FreeYUVQueue(queue);
+            return NULL;
+        }
+        if (queue->convert) {
+            slot->pitch = ((queue->w * SDL_BYTESPERPIXEL(queue->target_format)) + 3) & ~3;
+            slot->pixels = SDL_malloc(slot->pitch * queue->h);
+            if (!slot->pixels) {
+                SDL_FreeYUVQueue(queue);
+                SDL_OutOfMemory();
+                return NULL;
+            }
+        }
+    }
+    return queue;
+}
+
+/* Must be called with the pool lock held. Frames that were never shown
+   are overwritten rather than waited for, the newer one supersedes them. */
+static SDL_YUVQueueSlot *
+SDL_GetFreeYUVSlot(SDL_YUVQueue * queue)
+{
+    SDL_YUVQueueSlot *oldest;
+    int i;
+
+    for (;;) {
+        oldest = NULL;
+        for (i = 0; i < queue->num_slots; ++i) {
+            SDL_YUVQueueSlot *slot = &queue->slots[i];
+
+            if (slot->state == SDL_YUV_SLOT_FREE) {
+                return slot;
+            }
+            if (slot->state == SDL_YUV_SLOT_READY &&
+                (!oldest || SDL_YUV_NEWER(oldest->frame, slot->frame))) {
+                oldest = slot;
+            }
+        }
+        if (oldest) {
+            return oldest;
+        }
+        SDL_CondWait(SDL_yuv_pool.done, SDL_yuv_pool.lock);
+    }
+}
+
+int
+SDL_QueueYUVFrame(SDL_Texture * texture,
+                  const Uint8 *Yplane, int Ypitch,
+                  const Uint8 *Uplane, int Upitch,
+                  const Uint8 *Vplane, int Vpitch)
+{
+    SDL_YUVQueue *queue;
+    SDL_YUVQueueSlot *slot;
+    SDL_bool threaded;
+    SDL_Rect rect;
+
+    if (SDL_InitYUVPool(texture->yuv ? SDL_TRUE : SDL_FALSE) < 0) {
+        return -1;
+    }
+    threaded = (SDL_yuv_pool.num_threads > 0) ? SDL_TRUE : SDL_FALSE;
+
+    SDL_LockMutex(SDL_yuv_pool.lock);
+    queue = texture->yuv_queue;
+    if (!queue) {
+        /* Allocate without the lock, then publish unless someone beat us to it */
+        SDL_UnlockMutex(SDL_yuv_pool.lock);
+        queue = SDL_CreateYUVQueue(texture);
+        if (!queue) {
+            return -1;
+        }
+        SDL_LockMutex(SDL_yuv_pool.lock);
+        if (texture->yuv_queue) {
+            SDL_FreeYUVQueue(queue);
+            queue = texture->yuv_queue;
+        } else {
+            queue->next = SDL_yuv_pool.queues;
+            SDL_yuv_pool.queues = queue;
+            SDL_AtomicSetPtr((void **) &texture->yuv_queue, queue);
+        }
+    }
+    slot = SDL_GetFreeYUVSlot(queue);
+    SDL_SetYUVSlotState(slot, SDL_YUV_SLOT_FILLING);
+    SDL_UnlockMutex(SDL_yuv_pool.lock);
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = queue->w;
+    rect.h = queue->h;
+    SDL_SW_UpdateYUVTexturePlanar(slot->yuv, &rect, Yplane, Ypitch,
+                                  Uplane, Upitch, Vplane, Vpitch);
+    if (queue->convert && !threaded) {
+        SDL_ConvertYUVSlot(slot);
+    }
+
+    SDL_LockMutex(SDL_yuv_pool.lock);
+    slot->frame = ++queue->queued_frame;
+    if (queue->convert && threaded) {
+        SDL_SetYUVSlotState(slot, SDL_YUV_SLOT_QUEUED);
+        if (SDL_yuv_pool.last_job) {
+            SDL_yuv_pool.last_job->next = slot;
+        } else {
+            SDL_yuv_pool.first_job = slot;
+        }
+        SDL_yuv_pool.last_job = slot;
+        SDL_CondSignal(SDL_yuv_pool.work);
+    } else {
+        SDL_SetYUVSlotState(slot, SDL_YUV_SLOT_READY);
+        SDL_CondBroadcast(SDL_yuv_pool.done);
+    }
+    SDL_UnlockMutex(SDL_yuv_pool.lock);
+    return 0;
+}
+
+static int
+SDL_UploadYUVSlot(SDL_Texture * texture, SDL_YUVQueueSlot * slot)
+{
+    SDL_YUVQueue *queue = slot->queue;
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_SW_YUVTexture *yuv = slot->yuv;
+    SDL_Texture *native = texture->native;
+    SDL_Rect rect;
+    int retval = 0;
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = queue->w;
+    rect.h = queue->h;
+
+    if (!queue->convert) {
+        const int u = (queue->format == SDL_PIXELFORMAT_YV12) ? 2 : 1;
+        const int v = (queue->format == SDL_PIXELFORMAT_YV12) ? 1 : 2;
+
+        return renderer->UpdateTextureYUV(renderer, texture, &rect,
+                                          yuv->planes[0], yuv->pitches[0],
+                                          yuv->planes[u], yuv->pitches[u],
+                                          yuv->planes[v], yuv->pitches[v]);
+    }
+
+    if (native->access == SDL_TEXTUREACCESS_STREAMING) {
+        const Uint8 *src = (const Uint8 *) slot->pixels;
+        const size_t length = rect.w * SDL_BYTESPERPIXEL(native->format);
+        void *native_pixels;
+        int native_pitch;
+        int row;
+
+        retval = SDL_LockTexture(native, &rect, &native_pixels, &native_pitch);
+        if (retval == 0) {
+            Uint8 *dst = (Uint8 *) native_pixels;
+
+            for (row = 0; row < rect.h; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += slot->pitch;
+                dst += native_pitch;
+            }
+            SDL_UnlockTexture(native);
+        }
+    } else {
+        retval = SDL_UpdateTexture(native, &rect, slot->pixels, slot->pitch);
+    }
+
+    /* The texture keeps the planes of the frame it shows */
+    slot->yuv = texture->yuv;
+    texture->yuv = yuv;
+    return retval;
+}
+
+int
+SDL_ApplyYUVQueue(SDL_Texture * texture, SDL_bool wait)
+{
+    SDL_YUVQueue *queue;
+    SDL_YUVQueueSlot *newest;
+    SDL_bool pending;
+    int i, retval;
+
+    /* Most draws have no new frame, don't contend with the workers for those */
+    queue = (SDL_YUVQueue *) SDL_AtomicGetPtr((void **) &texture->yuv_queue);
+    if (!queue || !SDL_AtomicGet(&queue->unshown)) {
+        return 0;
+    }
+
+    queue = SDL_LockYUVQueue(texture);
+    if (!queue) {
+        return 0;
+    }
+
+    for (;;) {
+        newest = NULL;
+        pending = SDL_FALSE;
+        for (i = 0; i < queue->num_slots; ++i) {
+            SDL_YUVQueueSlot *slot = &queue->slots[i];
+
+            if (slot->state == SDL_YUV_SLOT_READY) {
+                if (!SDL_YUV_NEWER(slot->frame, queue->shown_frame)) {
+                    /* Finished after a newer frame was shown */
+                    SDL_SetYUVSlotState(slot, SDL_YUV_SLOT_FREE);
+                } else if (!newest || SDL_YUV_NEWER(slot->frame, newest->frame)) {
+                    newest = slot;
+                }
+            } else if (slot->state == SDL_YUV_SLOT_QUEUED ||
+                       slot->state == SDL_YUV_SLOT_CONVERTING) {
+                pending = SDL_TRUE;
+            }
+        }
+        if (!wait || !pending) {
+            break;
+        }
+        SDL_CondWait(SDL_yuv_pool.done, SDL_yuv_pool.lock);
+    }
+
+    if (!newest) {
+        SDL_UnlockMutex(SDL_yuv_pool.lock);
+        return 0;
+    }
+
+    /* Anything older than this frame won't be shown anymore */
+    for (i = 0; i < queue->num_slots; ++i) {
+        SDL_YUVQueueSlot *slot = &queue->slots[i];
+
+        if (slot != newest && slot->state == SDL_YUV_SLOT_READY) {
+            SDL_SetYUVSlotState(slot, SDL_YUV_SLOT_FREE);
+        }
+    }
+    SDL_SetYUVSlotState(newest, SDL_YUV_SLOT_UPLOADING);
+    queue->shown_frame = newest->frame;
+    SDL_UnlockMutex(SDL_yuv_pool.lock);
+
+    retval = SDL_UploadYUVSlot(texture, newest);
+
+    SDL_LockMutex(SDL_yuv_pool.lock);
+    SDL_SetYUVSlotState(newest, SDL_YUV_SLOT_FREE);
+    SDL_CondBroadcast(SDL_yuv_pool.done);
+    SDL_UnlockMutex(SDL_yuv_pool.lock);
+    return retval;
+}
+
+void
+SDL_DestroyYUVQueue(SDL_Texture * texture)
+{
+    SDL_YUVQueue *queue, *prev_queue;
+    SDL_YUVQueueSlot *job, *prev, *next;
+    SDL_bool converting;
+    int i;
+
+    queue = SDL_LockYUVQueue(texture);
+    if (!queue) {
+        return;
+    }
+    SDL_AtomicSetPtr((void **) &texture->yuv_queue, NULL);
+
+    if (SDL_yuv_pool.queues == queue) {
+        SDL_yuv_pool.queues = queue->next;
+    } else {
+        prev_queue = SDL_yuv_pool.queues;
+        while (prev_queue->next != queue) {
+            prev_queue = prev_queue->next;
+        }
+        prev_queue->next = queue->next;
+    }
+
+    /* Drop the jobs nobody started on yet */
+    prev = NULL;
+    job = SDL_yuv_pool.first_job;
+    while (job) {
+        next = job->next;
+        if (job->queue == queue) {
+            if (prev) {
+                prev->next = job->next;
+            } else {
+                SDL_yuv_pool.first_job = job->next;
+            }
+            if (SDL_yuv_pool.last_job == job) {
+                SDL_yuv_pool.last_job = prev;
+            }
+            SDL_SetYUVSlotState(job, SDL_YUV_SLOT_FREE);
+            job->next = NULL;
+        } else {
+            prev = job;
+        }
+        job = next;
+    }
+
+    /* ... and wait for the ones that are running */
+    do {
+        converting = SDL_FALSE;
+        for (i = 0; i < queue->num_slots; ++i) {
+            if (queue->slots[i].state == SDL_YUV_SLOT_CONVERTING) {
+                converting = SDL_TRUE;
+            }
+        }
+        if (converting) {
+            SDL_CondWait(SDL_yuv_pool.done, SDL_yuv_pool.lock);
+        }
+    } while (converting);
+
+    SDL_UnlockMutex(SDL_yuv_pool.lock);
+
+    SDL_FreeYUVQueue(queue);
+}
+
+void
+SDL_YUVQueueQuit(void)
+{
+    int i;
+
+    if (!SDL_yuv_pool.lock) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_yuv_pool.lock);
+    SDL_yuv_pool.quit = SDL_TRUE;
+    SDL_CondBroadcast(SDL_yuv_pool.work);
+    SDL_UnlockMutex(SDL_yuv_pool.lock);
+    for (i = 0; i < SDL_yuv_pool.num_threads; ++i) {
+        SDL_WaitThread(SDL_yuv_pool.threads[i], NULL);
+        SDL_yuv_pool.threads[i] = NULL;
+    }
+    SDL_yuv_pool.num_threads = 0;
+    SDL_yuv_pool.quit = SDL_FALSE;
+
+    /* Textures that outlive the pool lose their queued frames, they keep
+       showing the last one uploaded and can queue again after reinit. */
+    SDL_yuv_pool.first_job = NULL;
+    SDL_yuv_pool.last_job = NULL;
+    while (SDL_yuv_pool.queues) {
+        SDL_YUVQueue *queue = SDL_yuv_pool.queues;
+
+        SDL_yuv_pool.queues = queue->next;
+        SDL_AtomicSetPtr((void **) &queue->texture->yuv_queue, NULL);
+        SDL_FreeYUVQueue(queue);
+    }
+
+    SDL_DestroyMutex(SDL_yuv_pool.lock);
+    SDL_DestroyCond(SDL_yuv_pool.work);
+    SDL_DestroyCond(SDL_yuv_pool.done);
+    SDL_AtomicSetPtr((void **) &SDL_yuv_pool.lock, NULL);
+    SDL_yuv_pool.work = NULL;
+    SDL_yuv_pool.done = NULL;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,44 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_render.h"
+
+/* Background conversion of YUV frames for SDL_UpdateYUVTextureAsync() */
+
+typedef struct SDL_YUVQueue SDL_YUVQueue;
+
+/* Copy a frame and start converting it, may be called from any thread */
+extern int SDL_QueueYUVFrame(SDL_Texture * texture,
+                             const Uint8 *Yplane, int Ypitch,
+                             const Uint8 *Uplane, int Upitch,
+                             const Uint8 *Vplane, int Vpitch);
+
+/* Upload the newest converted frame, optionally waiting for queued ones first */
+extern int SDL_ApplyYUVQueue(SDL_Texture * texture, SDL_bool wait);
+
+extern void SDL_DestroyYUVQueue(SDL_Texture * texture);
+
+/* Stop the conversion threads and free the queues of textures still alive,
+   called from SDL_Quit() */
+extern void SDL_YUVQueueQuit(void);
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,415 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_video.h"
+#include "SDL_yuv_sw_c.h"
+#include "../video/SDL_blit.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+#define SDL_NEON_YUV    1
+#include <arm_neon.h>
+#endif
+
+/* Row converters from YUV to 32-bit RGB for SDL_SW_CopyYUVToRGB().
+
+   Each pair of pixels shares one chroma sample pair. The vector versions
+   compute the same integer expression as YUVPixel(), which also converts
+   the pixels left over at the end of a row, so all of them produce
+   identical output. The vectorized targets need 8-bit channels on byte
+   boundaries, which SDL_SW_SetupYUVDisplay() checks before using them.
+ */
+
+#define YUV_SHIFT   13
+#define YUV_ROUND   (1 << (YUV_SHIFT - 1))
+
+#if SDL_AVX2_BLITTERS || SDL_NEON_YUV
+
+static SDL_INLINE Uint32
+YUVClamp(int value)
+{
+    value >>= YUV_SHIFT;
+    if (value < 0) {
+        return 0;
+    } else if (value > 255) {
+        return 255;
+    }
+    return (Uint32) value;
+}
+
+static SDL_INLINE Uint32
+YUVPixel(const SDL_SW_YUVConversion * conv, int y, int c0, int c1)
+{
+    const int luma = (y - conv->y_offset) * conv->y_scale + YUV_ROUND;
+
+    c0 -= 128;
+    c1 -= 128;
+    return (YUVClamp(luma + conv->r[0] * c0 + conv->r[1] * c1) << conv->r_shift) |
+           (YUVClamp(luma + conv->g[0] * c0 + conv->g[1] * c1) << conv->g_shift) |
+           (YUVClamp(luma + conv->b[0] * c0 + conv->b[1] * c1) << conv->b_shift) |
+           conv->a_mask;
+}
+
+static void
+YUVRowScalar(const SDL_SW_YUVConversion * conv, const Uint8 * lum,
+             const Uint8 * c0, const Uint8 * c1, Uint32 * dst, int width)
+{
+    const int pairs = width / 2;
+    int x;
+
+    switch (conv->layout) {
+    case SDL_YUV_LAYOUT_PLANAR:
+        for (x = 0; x < pairs; ++x) {
+            dst[0] = YUVPixel(conv, lum[0], c0[x], c1[x]);
+            dst[1] = YUVPixel(conv, lum[1], c0[x], c1[x]);
+            lum += 2;
+            dst += 2;
+        }
+        break;
+    case SDL_YUV_LAYOUT_SEMIPLANAR:
+        for (x = 0; x < pairs; ++x) {
+            dst[0] = YUVPixel(conv, lum[0], c0[0], c0[1]);
+            dst[1] = YUVPixel(conv, lum[1], c0[0], c0[1]);
+            lum += 2;
+            c0 += 2;
+            dst += 2;
+        }
+        break;
+    case SDL_YUV_LAYOUT_PACKED_Y:
+        for (x = 0; x < pairs; ++x) {
+            dst[0] = YUVPixel(conv, lum[0], lum[1], lum[3]);
+            dst[1] = YUVPixel(conv, lum[2], lum[1], lum[3]);
+            lum += 4;
+            dst += 2;
+        }
+        break;
+    case SDL_YUV_LAYOUT_PACKED_C:
+        for (x = 0; x < pairs; ++x) {
+            dst[0] = YUVPixel(conv, lum[1], lum[0], lum[2]);
+            dst[1] = YUVPixel(conv, lum[3], lum[0], lum[2]);
+            lum += 4;
+            dst += 2;
+        }
+        break;
+    }
+
+    /* An odd last pixel has no chroma of its own, it uses the pair's before it */
+    if (width & 1) {
+        if (width == 1) {
+            const int y = (conv->layout == SDL_YUV_LAYOUT_PACKED_C) ? lum[1] : lum[0];
+            dst[0] = YUVPixel(conv, y, 128, 128);
+            return;
+        }
+        switch (conv->layout) {
+        case SDL_YUV_LAYOUT_PLANAR:
+            dst[0] = YUVPixel(conv, lum[0], c0[pairs - 1], c1[pairs - 1]);
+            break;
+        case SDL_YUV_LAYOUT_SEMIPLANAR:
+            dst[0] = YUVPixel(conv, lum[0], c0[-2], c0[-1]);
+            break;
+        case SDL_YUV_LAYOUT_PACKED_Y:
+            dst[0] = YUVPixel(conv, lum[0], lum[-3], lum[-1]);
+            break;
+        case SDL_YUV_LAYOUT_PACKED_C:
+            dst[0] = YUVPixel(conv, lum[1], lum[-4], lum[-2]);
+            break;
+        }
+    }
+}
+
+/* Convert the pixels left over by a vector loop that did the first n */
+static SDL_INLINE void
+YUVRowTail(const SDL_SW_YUVConversion * conv, const Uint8 * lum,
+           const Uint8 * c0, const Uint8 * c1, Uint32 * dst, int width, int n)
+{
+    /* A lone odd pixel needs the chroma pair before it, so redo that pair */
+    if (width - n == 1 && n >= 2) {
+        n -= 2;
+    }
+
+    switch (conv->layout) {
+    case SDL_YUV_LAYOUT_PLANAR:
+        YUVRowScalar(conv, lum + n, c0 + n / 2, c1 + n / 2, dst + n, width - n);
+        break;
+    case SDL_YUV_LAYOUT_SEMIPLANAR:
+        YUVRowScalar(conv, lum + n, c0 + n, NULL, dst + n, width - n);
+        break;
+    default:
+        YUVRowScalar(conv, lum + 2 * n, NULL, NULL, dst + n, width - n);
+        break;
+    }
+}
+
+#endif /* SDL_AVX2_BLITTERS || SDL_NEON_YUV */
+
+/* Two 16-bit coefficients as the pair _mm_madd_epi16() multiplies with */
+#define YUV_PAIR(first, second) \
+    ((int) (((Uint32) (second) << 16) | ((Uint32) (first) & 0xFFFF)))
+
+#if SDL_AVX2_BLITTERS
+/* Eight pixels from eight 16-bit luma values and four chroma pairs */
+static SDL_INLINE void SDL_TARGETING("sse2")
+YUVPixelsSSE2(const SDL_SW_YUVConversion * conv, __m128i y, __m128i c, Uint32 * dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    const __m128i ykoef = _mm_set1_epi32(YUV_PAIR(conv->y_scale, YUV_ROUND));
+    __m128i ylo, yhi, t, rgb[3], lo, hi;
+    int i;
+
+    y = _mm_sub_epi16(y, _mm_set1_epi16((short) conv->y_offset));
+    c = _mm_sub_epi16(c, _mm_set1_epi16(128));
+    ylo = _mm_madd_epi16(_mm_unpacklo_epi16(y, _mm_set1_epi16(1)), ykoef);
+    yhi = _mm_madd_epi16(_mm_unpackhi_epi16(y, _mm_set1_epi16(1)), ykoef);
+
+    for (i = 0; i < 3; ++i) {
+        const int *k = (i == 0) ? conv->r : (i == 1) ? conv->g : conv->b;
+
+        /* One term per chroma pair, each used by two neighbouring pixels */
+        t = _mm_madd_epi16(c, _mm_set1_epi32(YUV_PAIR(k[0], k[1])));
+        lo = _mm_srai_epi32(_mm_add_epi32(ylo, _mm_unpacklo_epi32(t, t)), YUV_SHIFT);
+        hi = _mm_srai_epi32(_mm_add_epi32(yhi, _mm_unpackhi_epi32(t, t)), YUV_SHIFT);
+        rgb[i] = _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(lo, hi), zero), max);
+    }
+
+    lo = _mm_set1_epi32((int) conv->a_mask);
+    hi = lo;
+    lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(rgb[0], zero), _mm_cvtsi32_si128(conv->r_shift)));
+    hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(rgb[0], zero), _mm_cvtsi32_si128(conv->r_shift)));
+    lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(rgb[1], zero), _mm_cvtsi32_si128(conv->g_shift)));
+    hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(rgb[1], zero), _mm_cvtsi32_si128(conv->g_shift)));
+    lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(rgb[2], zero), _mm_cvtsi32_si128(conv->b_shift)));
+    hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(rgb[2], zero), _mm_cvtsi32_si128(conv->b_shift)));
+    _mm_storeu_si128((__m128i *) dst, lo);
+    _mm_storeu_si128((__m128i *) (dst + 4), hi);
+}
+
+static void SDL_TARGETING("sse2")
+YUVRowSSE2(const SDL_SW_YUVConversion * conv, const Uint8 * lum,
+           const Uint8 * c0, const Uint8 * c1, Uint32 * dst, int width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = _mm_set1_epi16(0xFF);
+    const int n = width & ~7;
+    __m128i y, c, p;
+    Uint32 u, v;
+    int x;
+
+    for (x = 0; x < n; x += 8) {
+        switch (conv->layout) {
+        case SDL_YUV_LAYOUT_PLANAR:
+            SDL_memcpy(&u, c0 + x / 2, 4);
+            SDL_memcpy(&v, c1 + x / 2, 4);
+            y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (lum + x)), zero);
+            c = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int) u), _mm_cvtsi32_si128((int) v)), zero);
+            break;
+        case SDL_YUV_LAYOUT_SEMIPLANAR:
+            y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (lum + x)), zero);
+            c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (c0 + x)), zero);
+            break;
+        case SDL_YUV_LAYOUT_PACKED_Y:
+            p = _mm_loadu_si128((const __m128i *) (lum + 2 * x));
+            y = _mm_and_si128(p, low);
+            c = _mm_srli_epi16(p, 8);
+            break;
+        default:
+            p = _mm_loadu_si128((const __m128i *) (lum + 2 * x));
+            y = _mm_srli_epi16(p, 8);
+            c = _mm_and_si128(p, low);
+            break;
+        }
+        YUVPixelsSSE2(conv, y, c, dst + x);
+    }
+    YUVRowTail(conv, lum, c0, c1, dst, width, n);
+}
+
+/* Sixteen pixels, the 128-bit lanes hold pixels 0-7 and 8-15 */
+static SDL_INLINE void SDL_TARGETING("avx2")
+YUVPixelsAVX2(const SDL_SW_YUVConversion * conv, __m256i y, __m256i c, Uint32 * dst)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi16(255);
+    const __m256i ykoef = _mm256_set1_epi32(YUV_PAIR(conv->y_scale, YUV_ROUND));
+    __m256i ylo, yhi, t, rgb[3], lo, hi;
+    int i;
+
+    y = _mm256_sub_epi16(y, _mm256_set1_epi16((short) conv->y_offset));
+    c = _mm256_sub_epi16(c, _mm256_set1_epi16(128));
+
+    /* In-lane unpacks: lo holds pixels 0-3 and 8-11, hi holds 4-7 and 12-15 */
+    ylo = _mm256_madd_epi16(_mm256_unpacklo_epi16(y, _mm256_set1_epi16(1)), ykoef);
+    yhi = _mm256_madd_epi16(_mm256_unpackhi_epi16(y, _mm256_set1_epi16(1)), ykoef);
+
+    for (i = 0; i < 3; ++i) {
+        const int *k = (i == 0) ? conv->r : (i == 1) ? conv->g : conv->b;
+
+        t = _mm256_madd_epi16(c, _mm256_set1_epi32(YUV_PAIR(k[0], k[1])));
+        lo = _mm256_srai_epi32(_mm256_add_epi32(ylo, _mm256_unpacklo_epi32(t, t)), YUV_SHIFT);
+        hi = _mm256_srai_epi32(_mm256_add_epi32(yhi, _mm256_unpackhi_epi32(t, t)), YUV_SHIFT);
+        rgb[i] = _mm256_min_epi16(_mm256_max_epi16(_mm256_packs_epi32(lo, hi), zero), max);
+    }
+
+    lo = _mm256_set1_epi32((int) conv->a_mask);
+    hi = lo;
+    lo = _mm256_or_si256(lo, _mm256_sll_epi32(_mm256_unpacklo_epi16(rgb[0], zero), _mm_cvtsi32_si128(conv->r_shift)));
+    hi = _mm256_or_si256(hi, _mm256_sll_epi32(_mm256_unpackhi_epi16(rgb[0], zero), _mm_cvtsi32_si128(conv->r_shift)));
+    lo = _mm256_or_si256(lo, _mm256_sll_epi32(_mm256_unpacklo_epi16(rgb[1], zero), _mm_cvtsi32_si128(conv->g_shift)));
+    hi = _mm256_or_si256(hi, _mm256_sll_epi32(_mm256_unpackhi_epi16(rgb[1], zero), _mm_cvtsi32_si128(conv->g_shift)));
+    lo = _mm256_or_si256(lo, _mm256_sll_epi32(_mm256_unpacklo_epi16(rgb[2], zero), _mm_cvtsi32_si128(conv->b_shift)));
+    hi = _mm256_or_si256(hi, _mm256_sll_epi32(_mm256_unpackhi_epi16(rgb[2], zero), _mm_cvtsi32_si128(conv->b_shift)));
+    _mm256_storeu_si256((__m256i *) dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256((__m256i *) (dst + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+static void SDL_TARGETING("avx2")
+YUVRowAVX2(const SDL_SW_YUVConversion * conv, const Uint8 * lum,
+           const Uint8 * c0, const Uint8 * c1, Uint32 * dst, int width)
+{
+    const __m256i low = _mm256_set1_epi16(0xFF);
+    const int n = width & ~15;
+    __m256i y, c, p;
+    int x;
+
+    for (x = 0; x < n; x += 16) {
+        switch (conv->layout) {
+        case SDL_YUV_LAYOUT_PLANAR:
+            y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (lum + x)));
+            c = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (c0 + x / 2)),
+                                                       _mm_loadl_epi64((const __m128i *) (c1 + x / 2))));
+            break;
+        case SDL_YUV_LAYOUT_SEMIPLANAR:
+            y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (lum + x)));
+            c = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (c0 + x)));
+            break;
+        case SDL_YUV_LAYOUT_PACKED_Y:
+            p = _mm256_loadu_si256((const __m256i *) (lum + 2 * x));
+            y = _mm256_and_si256(p, low);
+            c = _mm256_srli_epi16(p, 8);
+            break;
+        default:
+            p = _mm256_loadu_si256((const __m256i *) (lum + 2 * x));
+            y = _mm256_srli_epi16(p, 8);
+            c = _mm256_and_si256(p, low);
+            break;
+        }
+        YUVPixelsAVX2(conv, y, c, dst + x);
+    }
+    YUVRowTail(conv, lum, c0, c1, dst, width, n);
+}
+#endif /* SDL_AVX2_BLITTERS */
+
+#if SDL_NEON_YUV
+/* One channel of eight pixels, each chroma value covers two of them */
+static SDL_INLINE uint8x8_t
+YUVChannelNEON(const int *k, int32x4_t ylo, int32x4_t yhi, int16x8_t c0, int16x8_t c1)
+{
+    int32x4_t lo = vmlal_n_s16(vmlal_n_s16(ylo, vget_low_s16(c0), (int16_t) k[0]), vget_low_s16(c1), (int16_t) k[1]);
+    int32x4_t hi = vmlal_n_s16(vmlal_n_s16(yhi, vget_high_s16(c0), (int16_t) k[0]), vget_high_s16(c1), (int16_t) k[1]);
+
+    return vqmovun_s16(vcombine_s16(vqmovn_s32(vshrq_n_s32(lo, YUV_SHIFT)),
+                                    vqmovn_s32(vshrq_n_s32(hi, YUV_SHIFT))));
+}
+
+static void
+YUVRowNEON(const SDL_SW_YUVConversion * conv, const Uint8 * lum,
+           const Uint8 * c0, const Uint8 * c1, Uint32 * dst, int width)
+{
+    const int16x8_t yoff = vdupq_n_s16((int16_t) conv->y_offset);
+    const int16x8_t coff = vdupq_n_s16(128);
+    const int32x4_t round = vdupq_n_s32(YUV_ROUND);
+    const int n = width & ~7;
+    const int rb = conv->r_shift / 8, gb = conv->g_shift / 8, bb = conv->b_shift / 8;
+    const uint8x8_t alpha = vdup_n_u8(conv->a_mask ? 0xFF : 0x00);
+    uint8x8_t y, c, first, second;
+    uint8x8x2_t packed;
+    uint8x8x4_t out;
+    int16x8_t yi, ci0, ci1;
+    int32x4_t ylo, yhi;
+    Uint32 u, v;
+    int x;
+
+    for (x = 0; x < n; x += 8) {
+        switch (conv->layout) {
+        case SDL_YUV_LAYOUT_PLANAR:
+            SDL_memcpy(&u, c0 + x / 2, 4);
+            SDL_memcpy(&v, c1 + x / 2, 4);
+            y = vld1_u8(lum + x);
+            c = vzip1_u8(vcreate_u8(u), vcreate_u8(v));
+            break;
+        case SDL_YUV_LAYOUT_SEMIPLANAR:
+            y = vld1_u8(lum + x);
+            c = vld1_u8(c0 + x);
+            break;
+        case SDL_YUV_LAYOUT_PACKED_Y:
+            packed = vld2_u8(lum + 2 * x);
+            y = packed.val[0];
+            c = packed.val[1];
+            break;
+        default:
+            packed = vld2_u8(lum + 2 * x);
+            y = packed.val[1];
+            c = packed.val[0];
+            break;
+        }
+
+        /* Split the chroma pairs and give each value to two pixels */
+        first = vuzp1_u8(c, c);
+        second = vuzp2_u8(c, c);
+        first = vzip1_u8(first, first);
+        second = vzip1_u8(second, second);
+
+        yi = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), yoff);
+        ci0 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(first)), coff);
+        ci1 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(second)), coff);
+        ylo = vmlal_n_s16(round, vget_low_s16(yi), (int16_t) conv->y_scale);
+        yhi = vmlal_n_s16(round, vget_high_s16(yi), (int16_t) conv->y_scale);
+
+        out.val[6 - rb - gb - bb] = alpha;
+        out.val[rb] = YUVChannelNEON(conv->r, ylo, yhi, ci0, ci1);
+        out.val[gb] = YUVChannelNEON(conv->g, ylo, yhi, ci0, ci1);
+        out.val[bb] = YUVChannelNEON(conv->b, ylo, yhi, ci0, ci1);
+        vst4_u8((Uint8 *) (dst + x), out);
+    }
+    YUVRowTail(conv, lum, c0, c1, dst, width, n);
+}
+#endif /* SDL_NEON_YUV */
+
+SDL_SW_YUVRowFunc
+SDL_SW_GetYUVRowFunc(void)
+{
+#if SDL_AVX2_BLITTERS
+    const Uint32 features = SDL_GetBlitCPUFeatures();
+
+    if (features & SDL_CPU_AVX2) {
+        return YUVRowAVX2;
+    }
+    if (features & SDL_CPU_SSE2) {
+        return YUVRowSSE2;
+    }
+#endif
+#if SDL_NEON_YUV
+    return YUVRowNEON;
+#endif
+    /* The lookup tables beat converting every pixel in plain C */
+    return NULL;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -85,6 +85,7 @@
 #include "SDL_assert.h"
 #include "SDL_video.h"
 #include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
 #include "SDL_yuv_sw_c.h"
 
 
@@ -885,6 +886,107 @@ free_bits_at_bottom(Uint32 a)
     return 1 + free_bits_at_bottom(a >> 1);
 }
 
+/* Is this an 8-bit channel that starts on a byte boundary? */
+static SDL_bool
+is_byte_channel(Uint32 mask)
+{
+    const int shift = free_bits_at_bottom(mask);
+
+    return (shift % 8 == 0 && shift < 32 && mask == (0xFFu << shift)) ? SDL_TRUE : SDL_FALSE;
+}
+
+#define YUV_KG(kr, kb)  (1.0 - (kr) - (kb))
+#define YUV_COEFFICIENTS(kr, kb) \
+    2.0 * (1.0 - (kr)), 2.0 * (kr) * (1.0 - (kr)) / YUV_KG(kr, kb), \
+    2.0 * (kb) * (1.0 - (kb)) / YUV_KG(kr, kb), 2.0 * (1.0 - (kb))
+
+/* The supported YUV to RGB conversions. The chroma coefficients are for
+   full range chroma and relative to a luma scale of 1.0. */
+static const struct
+{
+    const char *name;
+    SDL_bool limited;   /* Luma in 16-235 and chroma in 16-240 */
+    double cr_r, cr_g, cb_g, cb_b;
+} SDL_SW_YUVModes[] = {
+    /* The ratios SDL has always used, close to full range BT.601 */
+    { "JPEG", SDL_FALSE, 0.419 / 0.299, 0.299 / 0.419, 0.114 / 0.331, 0.587 / 0.331 },
+    { "BT601", SDL_TRUE, YUV_COEFFICIENTS(0.299, 0.114) },
+    { "BT709", SDL_TRUE, YUV_COEFFICIENTS(0.2126, 0.0722) },
+    { "BT709_FULL", SDL_FALSE, YUV_COEFFICIENTS(0.2126, 0.0722) }
+};
+
+static int
+SDL_SW_GetYUVMode(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_YUV_CONVERSION_MODE);
+    int i;
+
+    if (hint) {
+        for (i = 0; i < SDL_arraysize(SDL_SW_YUVModes); ++i) {
+            if (SDL_strcasecmp(hint, SDL_SW_YUVModes[i].name) == 0) {
+                return i;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Set up the fixed point conversion used by SDL_SW_YUVRowFunc */
+static void
+SDL_SW_SetupYUVConversion(SDL_SW_YUVTexture * swdata, Uint32 Rmask,
+                          Uint32 Gmask, Uint32 Bmask, Uint32 Amask)
+{
+    SDL_SW_YUVConversion *conv = &swdata->conversion;
+    const SDL_bool limited = SDL_SW_YUVModes[swdata->mode].limited;
+    const double luma = (limited ? 255.0 / 219.0 : 1.0) * (1 << 13);
+    const double chroma = luma * (limited ? 219.0 / 224.0 : 1.0);
+    const int cr_r = (int) (SDL_SW_YUVModes[swdata->mode].cr_r * chroma + 0.5);
+    const int cr_g = (int) (SDL_SW_YUVModes[swdata->mode].cr_g * chroma + 0.5);
+    const int cb_g = (int) (SDL_SW_YUVModes[swdata->mode].cb_g * chroma + 0.5);
+    const int cb_b = (int) (SDL_SW_YUVModes[swdata->mode].cb_b * chroma + 0.5);
+
+    switch (swdata->format) {
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        conv->layout = SDL_YUV_LAYOUT_SEMIPLANAR;
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_YVYU:
+        conv->layout = SDL_YUV_LAYOUT_PACKED_Y;
+        break;
+    case SDL_PIXELFORMAT_UYVY:
+        conv->layout = SDL_YUV_LAYOUT_PACKED_C;
+        break;
+    default:
+        conv->layout = SDL_YUV_LAYOUT_PLANAR;
+        break;
+    }
+
+    /* Planar rows are always passed as U then V */
+    if (swdata->format == SDL_PIXELFORMAT_NV21 ||
+        swdata->format == SDL_PIXELFORMAT_YVYU) {
+        conv->r[0] = cr_r;
+        conv->r[1] = 0;
+        conv->g[0] = -cr_g;
+        conv->g[1] = -cb_g;
+        conv->b[0] = 0;
+        conv->b[1] = cb_b;
+    } else {
+        conv->r[0] = 0;
+        conv->r[1] = cr_r;
+        conv->g[0] = -cb_g;
+        conv->g[1] = -cr_g;
+        conv->b[0] = cb_b;
+        conv->b[1] = 0;
+    }
+    conv->y_offset = limited ? 16 : 0;
+    conv->y_scale = (int) (luma + 0.5);
+    conv->r_shift = free_bits_at_bottom(Rmask);
+    conv->g_shift = free_bits_at_bottom(Gmask);
+    conv->b_shift = free_bits_at_bottom(Bmask);
+    conv->a_mask = Amask;
+}
+
 static int
 SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
 {
@@ -894,6 +996,7 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
     int i;
     int bpp;
     Uint32 Rmask, Gmask, Bmask, Amask;
+    const SDL_bool limited = SDL_SW_YUVModes[swdata->mode].limited;
 
     if (!SDL_PixelFormatEnumToMasks
         (target_format, &bpp, &Rmask, &Gmask, &Bmask, &Amask) || bpp < 15) {
@@ -906,18 +1009,31 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
     b_2_pix_alloc = &swdata->rgb_2_pix[2 * 768];
 
     /*
-     * Set up entries 0-255 in rgb-to-pixel value tables.
+     * Set up the rgb-to-pixel value tables. Entries 256-511 are the
+     * channel values, the rest saturate so that we do not need to
+     * check for overflow. With limited range luma the index is
+     * Y - 16 plus the chroma terms, and is expanded to 0-255 here.
      */
-    for (i = 0; i < 256; ++i) {
-        r_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Rmask));
-        r_2_pix_alloc[i + 256] <<= free_bits_at_bottom(Rmask);
-        r_2_pix_alloc[i + 256] |= Amask;
-        g_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Gmask));
-        g_2_pix_alloc[i + 256] <<= free_bits_at_bottom(Gmask);
-        g_2_pix_alloc[i + 256] |= Amask;
-        b_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Bmask));
-        b_2_pix_alloc[i + 256] <<= free_bits_at_bottom(Bmask);
-        b_2_pix_alloc[i + 256] |= Amask;
+    for (i = 0; i < 768; ++i) {
+        int value = i - 256;
+
+        if (limited && value > 0) {
+            value = (value * 510 + 219) / 438;
+        }
+        if (value < 0) {
+            value = 0;
+        } else if (value > 255) {
+            value = 255;
+        }
+        r_2_pix_alloc[i] = value >> (8 - number_of_bits_set(Rmask));
+        r_2_pix_alloc[i] <<= free_bits_at_bottom(Rmask);
+        r_2_pix_alloc[i] |= Amask;
+        g_2_pix_alloc[i] = value >> (8 - number_of_bits_set(Gmask));
+        g_2_pix_alloc[i] <<= free_bits_at_bottom(Gmask);
+        g_2_pix_alloc[i] |= Amask;
+        b_2_pix_alloc[i] = value >> (8 - number_of_bits_set(Bmask));
+        b_2_pix_alloc[i] <<= free_bits_at_bottom(Bmask);
+        b_2_pix_alloc[i] |= Amask;
     }
 
     /*
@@ -928,34 +1044,32 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
      * through a short pointer will lose the top bits anyway.
      */
     if (SDL_BYTESPERPIXEL(target_format) == 2) {
-        for (i = 0; i < 256; ++i) {
-            r_2_pix_alloc[i + 256] |= (r_2_pix_alloc[i + 256]) << 16;
-            g_2_pix_alloc[i + 256] |= (g_2_pix_alloc[i + 256]) << 16;
-            b_2_pix_alloc[i + 256] |= (b_2_pix_alloc[i + 256]) << 16;
+        for (i = 0; i < 768; ++i) {
+            r_2_pix_alloc[i] |= (r_2_pix_alloc[i]) << 16;
+            g_2_pix_alloc[i] |= (g_2_pix_alloc[i]) << 16;
+            b_2_pix_alloc[i] |= (b_2_pix_alloc[i]) << 16;
         }
     }
 
-    /*
-     * Spread out the values we have to the rest of the array so that
-     * we do not need to check for overflow.
-     */
-    for (i = 0; i < 256; ++i) {
-        r_2_pix_alloc[i] = r_2_pix_alloc[256];
-        r_2_pix_alloc[i + 512] = r_2_pix_alloc[511];
-        g_2_pix_alloc[i] = g_2_pix_alloc[256];
-        g_2_pix_alloc[i + 512] = g_2_pix_alloc[511];
-        b_2_pix_alloc[i] = b_2_pix_alloc[256];
-        b_2_pix_alloc[i + 512] = b_2_pix_alloc[511];
+    /* 32-bit targets with byte sized channels are converted row by row
+       when the CPU has a vectorized converter */
+    swdata->ConvertRow = NULL;
+    if (bpp == 32 && is_byte_channel(Rmask) && is_byte_channel(Gmask) &&
+        is_byte_channel(Bmask) && (!Amask || Amask == ~(Rmask | Gmask | Bmask))) {
+        SDL_SW_SetupYUVConversion(swdata, Rmask, Gmask, Bmask, Amask);
+        swdata->ConvertRow = SDL_SW_GetYUVRowFunc();
     }
 
     /* You have chosen wisely... */
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         if (SDL_BYTESPERPIXEL(target_format) == 2) {
 #if (__GNUC__ > 2) && defined(__i386__) && __OPTIMIZE__ && SDL_ASSEMBLY_ROUTINES
-            /* inline assembly functions */
-            if (SDL_HasMMX() && (Rmask == 0xF800) &&
+            /* inline assembly functions, these only know the JPEG matrix */
+            if (swdata->mode == 0 && SDL_HasMMX() && (Rmask == 0xF800) &&
                 (Gmask == 0x07E0) && (Bmask == 0x001F)
                 && (swdata->w & 15) == 0) {
 /* printf("Using MMX 16-bit 565 dither\n"); */
@@ -976,7 +1090,7 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
         if (SDL_BYTESPERPIXEL(target_format) == 4) {
 #if (__GNUC__ > 2) && defined(__i386__) && __OPTIMIZE__ && SDL_ASSEMBLY_ROUTINES
             /* inline assembly functions */
-            if (SDL_HasMMX() && (Rmask == 0x00FF0000) &&
+            if (swdata->mode == 0 && SDL_HasMMX() && (Rmask == 0x00FF0000) &&
                 (Gmask == 0x0000FF00) &&
                 (Bmask == 0x000000FF) && (swdata->w & 15) == 0) {
 /* printf("Using MMX 32-bit dither\n"); */
@@ -1027,10 +1141,14 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
     int *Cb_b_tab;
     int i;
     int CR, CB;
+    double scale;
+    int offset;
 
     switch (format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
@@ -1048,6 +1166,7 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
 
     swdata->format = format;
     swdata->target_format = SDL_PIXELFORMAT_UNKNOWN;
+    swdata->mode = SDL_SW_GetYUVMode();
     swdata->w = w;
     swdata->h = h;
     swdata->pixels = (Uint8 *) SDL_malloc(w * h * 2);
@@ -1059,7 +1178,16 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
         return NULL;
     }
 
-    /* Generate the tables for the display surface */
+    /* Generate the tables for the display surface. For limited range
+       the luma offset is folded in once per channel, and the tables of
+       SDL_SW_SetupYUVDisplay() scale the result back up to full range. */
+    if (SDL_SW_YUVModes[swdata->mode].limited) {
+        scale = 219.0 / 224.0;
+        offset = 16;
+    } else {
+        scale = 1.0;
+        offset = 0;
+    }
     Cr_r_tab = &swdata->colortab[0 * 256];
     Cr_g_tab = &swdata->colortab[1 * 256];
     Cb_g_tab = &swdata->colortab[2 * 256];
@@ -1069,10 +1197,10 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
            would be done here.  See the Berkeley mpeg_play sources.
          */
         CB = CR = (i - 128);
-        Cr_r_tab[i] = (int) ((0.419 / 0.299) * CR);
-        Cr_g_tab[i] = (int) (-(0.299 / 0.419) * CR);
-        Cb_g_tab[i] = (int) (-(0.114 / 0.331) * CB);
-        Cb_b_tab[i] = (int) ((0.587 / 0.331) * CB);
+        Cr_r_tab[i] = (int) ((SDL_SW_YUVModes[swdata->mode].cr_r * scale) * CR) - offset;
+        Cr_g_tab[i] = (int) (-(SDL_SW_YUVModes[swdata->mode].cr_g * scale) * CR) - offset;
+        Cb_g_tab[i] = (int) (-(SDL_SW_YUVModes[swdata->mode].cb_g * scale) * CB);
+        Cb_b_tab[i] = (int) ((SDL_SW_YUVModes[swdata->mode].cb_b * scale) * CB) - offset;
     }
 
     /* Find the pitch and offset values for the overlay */
@@ -1084,7 +1212,14 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
         swdata->pitches[2] = swdata->pitches[0] / 2;
         swdata->planes[0] = swdata->pixels;
         swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
-        swdata->planes[2] = swdata->planes[1] + swdata->pitches[1] * h / 2;
+        swdata->planes[2] = swdata->planes[1] + swdata->pitches[1] * (h / 2);
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        swdata->pitches[0] = w;
+        swdata->pitches[1] = w;
+        swdata->planes[0] = swdata->pixels;
+        swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
         break;
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
@@ -1120,7 +1255,8 @@ SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
         if (rect->x == 0 && rect->y == 0 &&
             rect->w == swdata->w && rect->h == swdata->h) {
                 SDL_memcpy(swdata->pixels, pixels,
-                           (swdata->h * swdata->w) + (swdata->h * swdata->w) / 2);
+                           (swdata->planes[2] - swdata->pixels) +
+                           swdata->pitches[2] * (swdata->h / 2));
         } else {
             Uint8 *src, *dst;
             int row;
@@ -1138,7 +1274,7 @@ SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
 
             /* Copy the next plane */
             src = (Uint8 *) pixels + rect->h * pitch;
-            dst = swdata->pixels + swdata->h * swdata->w;
+            dst = swdata->planes[1];
             dst += rect->y/2 * swdata->w/2 + rect->x/2;
             length = rect->w / 2;
             for (row = 0; row < rect->h/2; ++row) {
@@ -1149,8 +1285,7 @@ SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
 
             /* Copy the next plane */
             src = (Uint8 *) pixels + rect->h * pitch + (rect->h * pitch) / 4;
-            dst = swdata->pixels + swdata->h * swdata->w +
-                  (swdata->h * swdata->w) / 4;
+            dst = swdata->planes[2];
             dst += rect->y/2 * swdata->w/2 + rect->x/2;
             length = rect->w / 2;
             for (row = 0; row < rect->h/2; ++row) {
@@ -1160,6 +1295,39 @@ SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
             }
         }
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        if (rect->x == 0 && rect->y == 0 && pitch == swdata->w &&
+            rect->w == swdata->w && rect->h == swdata->h) {
+                SDL_memcpy(swdata->pixels, pixels,
+                           swdata->pitches[0] * swdata->h +
+                           swdata->pitches[1] * (swdata->h / 2));
+        } else {
+            Uint8 *src, *dst;
+            int row;
+            size_t length;
+
+            /* Copy the Y plane */
+            src = (Uint8 *) pixels;
+            dst = swdata->pixels + rect->y * swdata->w + rect->x;
+            length = rect->w;
+            for (row = 0; row < rect->h; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += swdata->w;
+            }
+
+            /* Copy the interleaved chroma plane */
+            src = (Uint8 *) pixels + rect->h * pitch;
+            dst = swdata->planes[1] + rect->y/2 * swdata->pitches[1] + (rect->x/2) * 2;
+            length = (rect->w / 2) * 2;
+            for (row = 0; row < rect->h/2; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += swdata->pitches[1];
+            }
+        }
+        break;
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
@@ -1208,10 +1376,9 @@ SDL_SW_UpdateYUVTexturePlanar(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
     /* Copy the U plane */
     src = Uplane;
     if (swdata->format == SDL_PIXELFORMAT_IYUV) {
-        dst = swdata->pixels + swdata->h * swdata->w;
+        dst = swdata->planes[1];
     } else {
-        dst = swdata->pixels + swdata->h * swdata->w +
-              (swdata->h * swdata->w) / 4;
+        dst = swdata->planes[2];
     }
     dst += rect->y/2 * swdata->w/2 + rect->x/2;
     length = rect->w / 2;
@@ -1224,10 +1391,9 @@ SDL_SW_UpdateYUVTexturePlanar(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
     /* Copy the V plane */
     src = Vplane;
     if (swdata->format == SDL_PIXELFORMAT_YV12) {
-        dst = swdata->pixels + swdata->h * swdata->w;
+        dst = swdata->planes[1];
     } else {
-        dst = swdata->pixels + swdata->h * swdata->w +
-              (swdata->h * swdata->w) / 4;
+        dst = swdata->planes[2];
     }
     dst += rect->y/2 * swdata->w/2 + rect->x/2;
     length = rect->w / 2;
@@ -1246,11 +1412,13 @@ SDL_SW_LockYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         if (rect
             && (rect->x != 0 || rect->y != 0 || rect->w != swdata->w
                 || rect->h != swdata->h)) {
             return SDL_SetError
-                ("YV12 and IYUV textures only support full surface locks");
+                ("YV12, IYUV, NV12 and NV21 textures only support full surface locks");
         }
         break;
     }
@@ -1269,6 +1437,79 @@ SDL_SW_UnlockYUVTexture(SDL_SW_YUVTexture * swdata)
 {
 }
 
+/* Convert the whole texture with the row converter */
+static void
+SDL_SW_ConvertYUVRows(SDL_SW_YUVTexture * swdata, Uint8 * dst, int pitch)
+{
+    const Uint8 *lum, *c0, *c1;
+    int y, cy;
+
+    for (y = 0; y < swdata->h; ++y) {
+        /* An odd last row shares the chroma of the row pair before it */
+        cy = SDL_min(y / 2, SDL_max(swdata->h / 2 - 1, 0));
+        lum = swdata->planes[0] + y * swdata->pitches[0];
+        switch (swdata->format) {
+        case SDL_PIXELFORMAT_YV12:
+            c0 = swdata->planes[2] + cy * swdata->pitches[2];
+            c1 = swdata->planes[1] + cy * swdata->pitches[1];
+            break;
+        case SDL_PIXELFORMAT_IYUV:
+            c0 = swdata->planes[1] + cy * swdata->pitches[1];
+            c1 = swdata->planes[2] + cy * swdata->pitches[2];
+            break;
+        case SDL_PIXELFORMAT_NV12:
+        case SDL_PIXELFORMAT_NV21:
+            c0 = swdata->planes[1] + cy * swdata->pitches[1];
+            c1 = NULL;
+            break;
+        default:
+            c0 = c1 = NULL;
+            break;
+        }
+        swdata->ConvertRow(&swdata->conversion, lum, c0, c1, (Uint32 *) dst, swdata->w);
+        dst += pitch;
+    }
+}
+
+/* Split the interleaved chroma of NV12 and NV21 into the U and V planes
+   the table converters expect */
+static int
+SDL_SW_SplitYUVChroma(SDL_SW_YUVTexture * swdata, Uint8 ** u, Uint8 ** v)
+{
+    const int size = (swdata->w / 2) * (swdata->h / 2);
+    const Uint8 *src;
+    int x, y;
+
+    *u = *v = NULL;
+    if (!swdata->chroma) {
+        swdata->chroma = (Uint8 *) SDL_malloc(2 * size);
+        if (!swdata->chroma) {
+            return SDL_OutOfMemory();
+        }
+    }
+    if (swdata->format == SDL_PIXELFORMAT_NV12) {
+        *u = swdata->chroma;
+        *v = swdata->chroma + size;
+    } else {
+        *v = swdata->chroma;
+        *u = swdata->chroma + size;
+    }
+
+    /* The first plane gets the first sample of every pair */
+    for (y = 0; y < swdata->h / 2; ++y) {
+        Uint8 *first = swdata->chroma + y * (swdata->w / 2);
+        Uint8 *second = first + size;
+
+        src = swdata->planes[1] + y * swdata->pitches[1];
+        for (x = 0; x < swdata->w / 2; ++x) {
+            first[x] = src[0];
+            second[x] = src[1];
+            src += 2;
+        }
+    }
+    return 0;
+}
+
 int
 SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
                     Uint32 target_format, int w, int h, void *pixels,
@@ -1342,6 +1583,14 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
         pixels = swdata->stretch->pixels;
         pitch = swdata->stretch->pitch;
     }
+    if (swdata->ConvertRow && !scale_2x) {
+        SDL_SW_ConvertYUVRows(swdata, (Uint8 *) pixels, pitch);
+        if (stretch) {
+            SDL_Rect rect = *srcrect;
+            SDL_SoftStretch(swdata->stretch, &rect, swdata->display, NULL);
+        }
+        return 0;
+    }
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
         lum = swdata->planes[0];
@@ -1353,6 +1602,13 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
         Cr = swdata->planes[2];
         Cb = swdata->planes[1];
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        lum = swdata->planes[0];
+        if (SDL_SW_SplitYUVChroma(swdata, &Cb, &Cr) < 0) {
+            return -1;
+        }
+        break;
     case SDL_PIXELFORMAT_YUY2:
         lum = swdata->planes[0];
         Cr = lum + 3;
@@ -1396,6 +1652,7 @@ SDL_SW_DestroyYUVTexture(SDL_SW_YUVTexture * swdata)
         SDL_free(swdata->pixels);
         SDL_free(swdata->colortab);
         SDL_free(swdata->rgb_2_pix);
+        SDL_free(swdata->chroma);
         SDL_FreeSurface(swdata->stretch);
         SDL_FreeSurface(swdata->display);
         SDL_free(swdata);
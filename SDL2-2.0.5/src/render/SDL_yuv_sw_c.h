@@ -24,10 +24,42 @@
 
 /* This is the software implementation of the YUV texture support */
 
+/* How the samples of one row are laid out for SDL_SW_YUVRowFunc */
+enum
+{
+    SDL_YUV_LAYOUT_PLANAR,      /* Y, U and V in separate planes */
+    SDL_YUV_LAYOUT_SEMIPLANAR,  /* Y plane, then a plane of chroma pairs */
+    SDL_YUV_LAYOUT_PACKED_Y,    /* Y0 C0 Y1 C1 */
+    SDL_YUV_LAYOUT_PACKED_C     /* C0 Y0 C1 Y1 */
+};
+
+/* Fixed point YUV to RGB conversion into 32-bit pixels with 8-bit channels.
+   Coefficients have 13 fractional bits; index 0 applies to the chroma
+   sample that comes first in memory and index 1 to the second. */
+typedef struct
+{
+    int layout;
+    int y_offset;
+    int y_scale;
+    int r[2], g[2], b[2];
+    int r_shift, g_shift, b_shift;
+    Uint32 a_mask;
+} SDL_SW_YUVConversion;
+
+/* Convert one row. For planar layouts c0 and c1 are the U and V rows, for
+   semi-planar c0 is the chroma row, and packed rows only use lum. */
+typedef void (*SDL_SW_YUVRowFunc) (const SDL_SW_YUVConversion * conv,
+                                   const Uint8 * lum, const Uint8 * c0,
+                                   const Uint8 * c1, Uint32 * dst, int width);
+
+/* Returns the vectorized row converter for this CPU, or NULL if there is none */
+extern SDL_SW_YUVRowFunc SDL_SW_GetYUVRowFunc(void);
+
 struct SDL_SW_YUVTexture
 {
     Uint32 format;
     Uint32 target_format;
+    int mode;
     int w, h;
     Uint8 *pixels;
     int *colortab;
@@ -41,6 +73,13 @@ struct SDL_SW_YUVTexture
                        unsigned char *cb, unsigned char *out,
                        int rows, int cols, int mod);
 
+    /* Direct conversion to 32-bit targets, NULL if the target needs the tables */
+    SDL_SW_YUVRowFunc ConvertRow;
+    SDL_SW_YUVConversion conversion;
+
+    /* NV12 and NV21 chroma split into planes for the table converters */
+    Uint8 *chroma;
+
     /* These are just so we don't have to allocate them separately */
     Uint16 pitches[3];
     Uint8 *planes[3];
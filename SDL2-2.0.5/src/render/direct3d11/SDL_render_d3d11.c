@@ -115,6 +115,7 @@ typedef struct
     ID3D11BlendState *blendModeBlend;
     ID3D11BlendState *blendModeAdd;
     ID3D11BlendState *blendModeMod;
+    ID3D11BlendState *blendModePremultiplied;
     ID3D11SamplerState *nearestPixelSampler;
     ID3D11SamplerState *linearSampler;
     D3D_FEATURE_LEVEL featureLevel;
@@ -914,6 +915,7 @@ D3D11_ReleaseAll(SDL_Renderer * renderer)
         SAFE_RELEASE(data->blendModeBlend);
         SAFE_RELEASE(data->blendModeAdd);
         SAFE_RELEASE(data->blendModeMod);
+        SAFE_RELEASE(data->blendModePremultiplied);
         SAFE_RELEASE(data->nearestPixelSampler);
         SAFE_RELEASE(data->linearSampler);
         SAFE_RELEASE(data->mainRasterizer);
@@ -1325,6 +1327,19 @@ D3D11_CreateDeviceResources(SDL_Renderer * renderer)
         goto done;
     }
 
+    result = D3D11_CreateBlendMode(
+        renderer,
+        TRUE,
+        D3D11_BLEND_ONE,                /* srcBlend */
+        D3D11_BLEND_INV_SRC_ALPHA,      /* destBlend */
+        D3D11_BLEND_ONE,                /* srcBlendAlpha */
+        D3D11_BLEND_INV_SRC_ALPHA,      /* destBlendAlpha */
+        &data->blendModePremultiplied);
+    if (FAILED(result)) {
+        /* D3D11_CreateBlendMode will set the SDL error, if it fails */
+        goto done;
+    }
+
     /* Setup render state that doesn't change */
     ID3D11DeviceContext_IASetInputLayout(data->d3dContext, data->inputLayout);
     ID3D11DeviceContext_VSSetShader(data->d3dContext, data->vertexShader, NULL, 0);
@@ -2453,6 +2468,9 @@ D3D11_RenderSetBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
     case SDL_BLENDMODE_MOD:
         blendState = rendererData->blendModeMod;
         break;
+    case SDL_BLENDMODE_PREMULTIPLIED:
+        blendState = rendererData->blendModePremultiplied;
+        break;
     case SDL_BLENDMODE_NONE:
         blendState = NULL;
         break;
@@ -27,6 +27,7 @@
 #include "SDL_assert.h"
 #include "SDL_opengl.h"
 #include "../SDL_sysrender.h"
+#include "../../video/SDL_surface_pool.h"
 #include "SDL_shaders_gl.h"
 
 #ifdef __MACOSX__
@@ -1109,6 +1110,10 @@ GL_SetBlendMode(GL_RenderData * data, int blendMode)
             data->glEnable(GL_BLEND);
             data->glBlendFuncSeparate(GL_ZERO, GL_SRC_COLOR, GL_ZERO, GL_ONE);
             break;
+        case SDL_BLENDMODE_PREMULTIPLIED:
+            data->glEnable(GL_BLEND);
+            data->glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
         }
         data->current.blendMode = blendMode;
     }
@@ -1431,13 +1436,13 @@ GL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     GL_ActivateRenderer(renderer);
 
     temp_pitch = rect->w * SDL_BYTESPERPIXEL(temp_format);
-    temp_pixels = SDL_malloc(rect->h * temp_pitch);
+    temp_pixels = SDL_AllocPooledPixels(rect->h * temp_pitch);
     if (!temp_pixels) {
         return SDL_OutOfMemory();
     }
 
     if (!convert_format(data, temp_format, &internalFormat, &format, &type)) {
-        SDL_free(temp_pixels);
+        SDL_FreePooledPixels(temp_pixels);
         return SDL_SetError("Texture format %s not supported by OpenGL",
                             SDL_GetPixelFormatName(temp_format));
     }
@@ -1452,7 +1457,7 @@ GL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                        rect->w, rect->h, format, type, temp_pixels);
 
     if (GL_CheckError("glReadPixels()", renderer) < 0) {
-        SDL_free(temp_pixels);
+        SDL_FreePooledPixels(temp_pixels);
         return -1;
     }
 
@@ -1476,7 +1481,7 @@ GL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     status = SDL_ConvertPixels(rect->w, rect->h,
                                temp_format, temp_pixels, temp_pitch,
                                pixel_format, pixels, pitch);
-    SDL_free(temp_pixels);
+    SDL_FreePooledPixels(temp_pixels);
 
     return status;
 }
@@ -25,6 +25,7 @@
 #include "SDL_hints.h"
 #include "SDL_opengles.h"
 #include "../SDL_sysrender.h"
+#include "../../video/SDL_surface_pool.h"
 
 /* To prevent unnecessary window recreation, 
  * these should match the defaults selected in SDL_GL_ResetAttributes 
@@ -770,6 +771,10 @@ GLES_SetBlendMode(GLES_RenderData * data, int blendMode)
                 data->glBlendFunc(GL_ZERO, GL_SRC_COLOR);
             }
             break;
+        case SDL_BLENDMODE_PREMULTIPLIED:
+            data->glEnable(GL_BLEND);
+            data->glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
         }
         data->current.blendMode = blendMode;
     }
@@ -1097,7 +1102,7 @@ GLES_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     GLES_ActivateRenderer(renderer);
 
     temp_pitch = rect->w * SDL_BYTESPERPIXEL(temp_format);
-    temp_pixels = SDL_malloc(rect->h * temp_pitch);
+    temp_pixels = SDL_AllocPooledPixels(rect->h * temp_pitch);
     if (!temp_pixels) {
         return SDL_OutOfMemory();
     }
@@ -1129,7 +1134,7 @@ GLES_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     status = SDL_ConvertPixels(rect->w, rect->h,
                                temp_format, temp_pixels, temp_pitch,
                                pixel_format, pixels, pitch);
-    SDL_free(temp_pixels);
+    SDL_FreePooledPixels(temp_pixels);
 
     return status;
 }
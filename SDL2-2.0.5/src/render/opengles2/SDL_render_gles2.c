@@ -26,6 +26,7 @@
 #include "SDL_opengles2.h"
 #include "../SDL_sysrender.h"
 #include "../../video/SDL_blit.h"
+#include "../../video/SDL_surface_pool.h"
 #include "SDL_shaders_gles2.h"
 
 /* !!! FIXME: Emscripten makes these into WebGL calls, and WebGL doesn't offer
@@ -1313,6 +1314,8 @@ static const float inv255f = 1.0f / 255.0f;
 static int GLES2_RenderClear(SDL_Renderer *renderer);
 static int GLES2_RenderDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int count);
 static int GLES2_RenderDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count);
+static int GLES2_RenderDrawWideLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count,
+                                     float width, SDL_bool antialias);
 static int GLES2_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count);
 static int GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect,
                             const SDL_FRect *dstrect);
@@ -1403,6 +1406,10 @@ GLES2_SetBlendMode(GLES2_DriverContext *data, int blendMode)
             data->glEnable(GL_BLEND);
             data->glBlendFuncSeparate(GL_ZERO, GL_SRC_COLOR, GL_ZERO, GL_ONE);
             break;
+        case SDL_BLENDMODE_PREMULTIPLIED:
+            data->glEnable(GL_BLEND);
+            data->glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
         }
         data->current.blendMode = blendMode;
     }
@@ -1438,26 +1445,57 @@ GLES2_SetDrawingState(SDL_Renderer * renderer, SDL_BlendMode blendMode)
     return 0;
 }
 
+/* Alpha and additive blending of a solid color are both premultiplied
+   blending, once the color is multiplied by its alpha and, for additive,
+   alpha is dropped. Drawing them that way lets them share a batch. */
+static SDL_BlendMode
+GLES2_GetDrawColor(SDL_Renderer *renderer, GLfloat color[4])
+{
+    GLfloat a = renderer->a * inv255f;
+
+    color[0] = renderer->r * inv255f;
+    color[1] = renderer->g * inv255f;
+    color[2] = renderer->b * inv255f;
+    color[3] = a;
+
+    switch (renderer->blendMode) {
+    case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_ADD:
+        color[0] *= a;
+        color[1] *= a;
+        color[2] *= a;
+        if (renderer->blendMode == SDL_BLENDMODE_ADD) {
+            color[3] = 0.0f;
+        }
+        return SDL_BLENDMODE_PREMULTIPLIED;
+    default:
+        return renderer->blendMode;
+    }
+}
+
 static int
 GLES2_RenderDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     Vertex *vertices = data->vertices;
     int idx;
-    GLfloat r = renderer->r * inv255f;
-    GLfloat g = renderer->g * inv255f;
-    GLfloat b = renderer->b * inv255f;
-    GLfloat a = renderer->a * inv255f;
+    GLfloat color[4];
+    SDL_BlendMode blendMode = GLES2_GetDrawColor(renderer, color);
+    GLfloat r = color[0];
+    GLfloat g = color[1];
+    GLfloat b = color[2];
+    GLfloat a = color[3];
     const int VERTICES_FOR_POINT = 1;
+    GLfloat x, y;
 
     for (idx = 0; idx < count; ++idx) {
         if (data->vertices_current_offset + VERTICES_FOR_POINT > GLES2_MAX_VERTICES) {
             GLES2_FlushVertices(renderer);                        
         }
-        GLES2_CheckAndAddNewCommand(renderer, NULL, renderer->blendMode, GL_POINTS, VERTICES_FOR_POINT);
+        GLES2_CheckAndAddNewCommand(renderer, NULL, blendMode, GL_POINTS, VERTICES_FOR_POINT);
 
-        GLfloat x = points[idx].x + 0.5f;
-        GLfloat y = points[idx].y + 0.5f;
+        x = points[idx].x + 0.5f;
+        y = points[idx].y + 0.5f;
 
         vertices[data->vertices_current_offset].pos[0] = x;
         vertices[data->vertices_current_offset].pos[1] = y;
@@ -1478,22 +1516,25 @@ GLES2_RenderDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, int coun
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     Vertex *vertices = data->vertices;
     int idx;
-    GLfloat r = renderer->r * inv255f;
-    GLfloat g = renderer->g * inv255f;
-    GLfloat b = renderer->b * inv255f;
-    GLfloat a = renderer->a * inv255f;
+    GLfloat color[4];
+    SDL_BlendMode blendMode = GLES2_GetDrawColor(renderer, color);
+    GLfloat r = color[0];
+    GLfloat g = color[1];
+    GLfloat b = color[2];
+    GLfloat a = color[3];
     const int VERTICES_FOR_LINE = 2;
+    GLfloat x1, y1, x2, y2;
 
     for (idx = 0; idx < count - 1; ++idx) {
         if (data->vertices_current_offset + VERTICES_FOR_LINE > GLES2_MAX_VERTICES) {
             GLES2_FlushVertices(renderer);
         }
-        GLES2_CheckAndAddNewCommand(renderer, NULL, renderer->blendMode, GL_LINES, VERTICES_FOR_LINE);
+        GLES2_CheckAndAddNewCommand(renderer, NULL, blendMode, GL_LINES, VERTICES_FOR_LINE);
 
-        const GLfloat x1 = points[idx].x + 0.5f;
-        const GLfloat y1 = points[idx].y + 0.5f;
-        const GLfloat x2 = points[idx + 1].x + 0.5f;
-        const GLfloat y2 = points[idx + 1].y + 0.5f;
+        x1 = points[idx].x + 0.5f;
+        y1 = points[idx].y + 0.5f;
+        x2 = points[idx + 1].x + 0.5f;
+        y2 = points[idx + 1].y + 0.5f;
 
         vertices[data->vertices_current_offset].pos[0] = x1;
         vertices[data->vertices_current_offset].pos[1] = y1;
@@ -1517,30 +1558,151 @@ GLES2_RenderDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, int coun
     return GL_CheckError("", renderer);
 }
 
+/* Add two triangles for the quad p0 p1 p2 p3, each corner with its own color */
+static void
+GLES2_AddColorQuad(GLES2_DriverContext *data, const GLfloat *p0, const GLfloat *p1,
+                   const GLfloat *p2, const GLfloat *p3, const GLfloat *c0,
+                   const GLfloat *c1, const GLfloat *c2, const GLfloat *c3)
+{
+    const GLfloat *pos[6];
+    const GLfloat *color[6];
+    Vertex *vertex;
+    int i;
+
+    pos[0] = p0; pos[1] = p1; pos[2] = p2;
+    pos[3] = p2; pos[4] = p3; pos[5] = p0;
+    color[0] = c0; color[1] = c1; color[2] = c2;
+    color[3] = c2; color[4] = c3; color[5] = c0;
+
+    for (i = 0; i < 6; ++i) {
+        vertex = &data->vertices[data->vertices_current_offset++];
+        vertex->pos[0] = pos[i][0];
+        vertex->pos[1] = pos[i][1];
+        vertex->angle = 0.0f;
+        vertex->color[0] = color[i][0];
+        vertex->color[1] = color[i][1];
+        vertex->color[2] = color[i][2];
+        vertex->color[3] = color[i][3];
+    }
+}
+
+/* Corners of the rectangle around a line, hl along it and hw across it */
+static void
+GLES2_GetLineCorners(const GLfloat center[2], const GLfloat dir[2], GLfloat hl, GLfloat hw,
+                     GLfloat corners[4][2])
+{
+    corners[0][0] = center[0] - hl * dir[0] + hw * dir[1];
+    corners[0][1] = center[1] - hl * dir[1] - hw * dir[0];
+    corners[1][0] = center[0] + hl * dir[0] + hw * dir[1];
+    corners[1][1] = center[1] + hl * dir[1] - hw * dir[0];
+    corners[2][0] = center[0] + hl * dir[0] - hw * dir[1];
+    corners[2][1] = center[1] + hl * dir[1] + hw * dir[0];
+    corners[3][0] = center[0] - hl * dir[0] - hw * dir[1];
+    corners[3][1] = center[1] - hl * dir[1] + hw * dir[0];
+}
+
+static int
+GLES2_RenderDrawWideLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count,
+                          float width, SDL_bool antialias)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat color[4], inner[4], outer[4];
+    GLfloat center[2], dir[2];
+    GLfloat in[4][2], out[4][2];
+    GLfloat dx, dy, len, hl, hw, coverage;
+    SDL_BlendMode blendMode = GLES2_GetDrawColor(renderer, color);
+    const int vertices_per_line = antialias ? 30 : 6;
+    int idx, i;
+
+    /* Anti-aliased edges fade out, which needs blending even in BLENDMODE_NONE */
+    if (antialias && blendMode == SDL_BLENDMODE_NONE) {
+        color[0] *= color[3];
+        color[1] *= color[3];
+        color[2] *= color[3];
+        blendMode = SDL_BLENDMODE_PREMULTIPLIED;
+    }
+
+    /* The edges fade towards the color that leaves the destination alone */
+    if (blendMode == SDL_BLENDMODE_MOD) {
+        outer[0] = outer[1] = outer[2] = 1.0f;
+        outer[3] = color[3];
+    } else {
+        outer[0] = outer[1] = outer[2] = outer[3] = 0.0f;
+    }
+
+    for (idx = 0; idx < count - 1; ++idx) {
+        if (data->vertices_current_offset + vertices_per_line > GLES2_MAX_VERTICES) {
+            GLES2_FlushVertices(renderer);
+        }
+        GLES2_CheckAndAddNewCommand(renderer, NULL, blendMode, GL_TRIANGLES, vertices_per_line);
+
+        dx = points[idx + 1].x - points[idx].x;
+        dy = points[idx + 1].y - points[idx].y;
+        len = (GLfloat) SDL_sqrt(dx * dx + dy * dy);
+        center[0] = (points[idx].x + points[idx + 1].x) * 0.5f + 0.5f;
+        center[1] = (points[idx].y + points[idx + 1].y) * 0.5f + 0.5f;
+        if (len > 0.0f) {
+            dir[0] = dx / len;
+            dir[1] = dy / len;
+        } else {
+            dir[0] = 1.0f;
+            dir[1] = 0.0f;
+        }
+        hw = width * 0.5f;
+        hl = len * 0.5f + hw;
+
+        if (!antialias) {
+            GLES2_GetLineCorners(center, dir, hl, hw, out);
+            GLES2_AddColorQuad(data, out[0], out[1], out[2], out[3], color, color, color, color);
+            continue;
+        }
+
+        /* Full color half a pixel inside the edges, fading out to half a
+           pixel outside. Lines narrower than a pixel never get full color. */
+        coverage = SDL_min(hl * 2.0f, 1.0f) * SDL_min(hw * 2.0f, 1.0f);
+        for (i = 0; i < 4; ++i) {
+            inner[i] = outer[i] + (color[i] - outer[i]) * coverage;
+        }
+        GLES2_GetLineCorners(center, dir, SDL_max(hl - 0.5f, 0.0f), SDL_max(hw - 0.5f, 0.0f), in);
+        GLES2_GetLineCorners(center, dir, hl + 0.5f, hw + 0.5f, out);
+        GLES2_AddColorQuad(data, in[0], in[1], in[2], in[3], inner, inner, inner, inner);
+        for (i = 0; i < 4; ++i) {
+            const int j = (i + 1) % 4;
+            GLES2_AddColorQuad(data, out[i], out[j], in[j], in[i], outer, outer, inner, inner);
+        }
+    }
+
+    return GL_CheckError("", renderer);
+}
+
 static int
 GLES2_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     Vertex *vertices = data->vertices;
     int idx;
-    GLfloat r = renderer->r * inv255f;
-    GLfloat g = renderer->g * inv255f;
-    GLfloat b = renderer->b * inv255f;
-    GLfloat a = renderer->a * inv255f;
+    GLfloat color[4];
+    SDL_BlendMode blendMode = GLES2_GetDrawColor(renderer, color);
+    GLfloat r = color[0];
+    GLfloat g = color[1];
+    GLfloat b = color[2];
+    GLfloat a = color[3];
     const int VERTICES_FOR_RECT = 6;
+    const SDL_FRect *rect;
+    GLfloat xMin, xMax, yMin, yMax;
         
     for (idx = 0; idx < count; ++idx) {
         if (data->vertices_current_offset + VERTICES_FOR_RECT > GLES2_MAX_VERTICES) {
             GLES2_FlushVertices(renderer);
         }
-        GLES2_CheckAndAddNewCommand(renderer, NULL, renderer->blendMode, GL_TRIANGLES, VERTICES_FOR_RECT);
+        GLES2_CheckAndAddNewCommand(renderer, NULL, blendMode, GL_TRIANGLES, VERTICES_FOR_RECT);
 
-        const SDL_FRect *rect = &rects[idx];
+        rect = &rects[idx];
          
-        GLfloat xMin = rect->x;
-        GLfloat xMax = (rect->x + rect->w);
-        GLfloat yMin = rect->y;
-        GLfloat yMax = (rect->y + rect->h);
+        xMin = rect->x;
+        xMax = (rect->x + rect->w);
+        yMin = rect->y;
+        yMax = (rect->y + rect->h);
          
         // 0 == 5, 1, 2 == 3, 4; 0, 1, 2; 3, 4, 5;
          
@@ -1902,7 +2064,7 @@ GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     GLES2_ActivateRenderer(renderer);
 
     temp_pitch = rect->w * SDL_BYTESPERPIXEL(temp_format);
-    temp_pixels = SDL_malloc(rect->h * temp_pitch);
+    temp_pixels = SDL_AllocPooledPixels(rect->h * temp_pitch);
     if (!temp_pixels) {
         return SDL_OutOfMemory();
     }
@@ -1935,7 +2097,7 @@ GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     status = SDL_ConvertPixels(rect->w, rect->h,
                                temp_format, temp_pixels, temp_pitch,
                                pixel_format, pixels, pitch);
-    SDL_free(temp_pixels);
+    SDL_FreePooledPixels(temp_pixels);
 
     return status;
 }
@@ -2198,6 +2360,7 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     renderer->RenderClear         = &GLES2_RenderClear;
     renderer->RenderDrawPoints    = &GLES2_RenderDrawPoints;
     renderer->RenderDrawLines     = &GLES2_RenderDrawLines;
+    renderer->RenderDrawWideLines = &GLES2_RenderDrawWideLines;
     renderer->RenderFillRects     = &GLES2_RenderFillRects;
     renderer->RenderCopy          = &GLES2_RenderCopy;
     renderer->RenderCopyEx        = &GLES2_RenderCopyEx;
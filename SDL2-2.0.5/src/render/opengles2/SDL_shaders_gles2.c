@@ -821,6 +821,7 @@ const GLES2_Shader *GLES2_GetShader(GLES2_ShaderType type, SDL_BlendMode blendMo
     case SDL_BLENDMODE_NONE:
         return &GLES2_FragmentShader_None_SolidSrc;
     case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_PREMULTIPLIED:
         return &GLES2_FragmentShader_Alpha_SolidSrc;
     case SDL_BLENDMODE_ADD:
         return &GLES2_FragmentShader_Additive_SolidSrc;
@@ -834,6 +835,7 @@ const GLES2_Shader *GLES2_GetShader(GLES2_ShaderType type, SDL_BlendMode blendMo
         case SDL_BLENDMODE_NONE:
             return &GLES2_FragmentShader_None_TextureABGRSrc;
         case SDL_BLENDMODE_BLEND:
+        case SDL_BLENDMODE_PREMULTIPLIED:
             return &GLES2_FragmentShader_Alpha_TextureABGRSrc;
         case SDL_BLENDMODE_ADD:
             return &GLES2_FragmentShader_Additive_TextureABGRSrc;
@@ -847,6 +849,7 @@ const GLES2_Shader *GLES2_GetShader(GLES2_ShaderType type, SDL_BlendMode blendMo
         case SDL_BLENDMODE_NONE:
             return &GLES2_FragmentShader_None_TextureARGBSrc;
         case SDL_BLENDMODE_BLEND:
+        case SDL_BLENDMODE_PREMULTIPLIED:
             return &GLES2_FragmentShader_Alpha_TextureARGBSrc;
         case SDL_BLENDMODE_ADD:
             return &GLES2_FragmentShader_Additive_TextureARGBSrc;
@@ -861,6 +864,7 @@ const GLES2_Shader *GLES2_GetShader(GLES2_ShaderType type, SDL_BlendMode blendMo
         case SDL_BLENDMODE_NONE:
             return &GLES2_FragmentShader_None_TextureRGBSrc;
         case SDL_BLENDMODE_BLEND:
+        case SDL_BLENDMODE_PREMULTIPLIED:
             return &GLES2_FragmentShader_Alpha_TextureRGBSrc;
         case SDL_BLENDMODE_ADD:
             return &GLES2_FragmentShader_Additive_TextureRGBSrc;
@@ -875,6 +879,7 @@ const GLES2_Shader *GLES2_GetShader(GLES2_ShaderType type, SDL_BlendMode blendMo
         case SDL_BLENDMODE_NONE:
             return &GLES2_FragmentShader_None_TextureBGRSrc;
         case SDL_BLENDMODE_BLEND:
+        case SDL_BLENDMODE_PREMULTIPLIED:
             return &GLES2_FragmentShader_Alpha_TextureBGRSrc;
         case SDL_BLENDMODE_ADD:
             return &GLES2_FragmentShader_Additive_TextureBGRSrc;
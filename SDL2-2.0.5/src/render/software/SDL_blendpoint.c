@@ -34,6 +34,7 @@ SDL_BlendPoint_RGB555(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode,
 
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_PREMULTIPLIED:
         DRAW_SETPIXELXY_BLEND_RGB555(x, y);
         break;
     case SDL_BLENDMODE_ADD:
@@ -57,6 +58,7 @@ SDL_BlendPoint_RGB565(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode,
 
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_PREMULTIPLIED:
         DRAW_SETPIXELXY_BLEND_RGB565(x, y);
         break;
     case SDL_BLENDMODE_ADD:
@@ -80,6 +82,7 @@ SDL_BlendPoint_RGB888(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode,
 
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_PREMULTIPLIED:
         DRAW_SETPIXELXY_BLEND_RGB888(x, y);
         break;
     case SDL_BLENDMODE_ADD:
@@ -103,6 +106,7 @@ SDL_BlendPoint_ARGB8888(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode
 
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_PREMULTIPLIED:
         DRAW_SETPIXELXY_BLEND_ARGB8888(x, y);
         break;
     case SDL_BLENDMODE_ADD:
@@ -129,6 +133,7 @@ SDL_BlendPoint_RGB(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode, Uin
     case 2:
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
+        case SDL_BLENDMODE_PREMULTIPLIED:
             DRAW_SETPIXELXY2_BLEND_RGB(x, y);
             break;
         case SDL_BLENDMODE_ADD:
@@ -145,6 +150,7 @@ SDL_BlendPoint_RGB(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode, Uin
     case 4:
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
+        case SDL_BLENDMODE_PREMULTIPLIED:
             DRAW_SETPIXELXY4_BLEND_RGB(x, y);
             break;
         case SDL_BLENDMODE_ADD:
@@ -174,6 +180,7 @@ SDL_BlendPoint_RGBA(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode, Ui
     case 4:
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
+        case SDL_BLENDMODE_PREMULTIPLIED:
             DRAW_SETPIXELXY4_BLEND_RGBA(x, y);
             break;
         case SDL_BLENDMODE_ADD:
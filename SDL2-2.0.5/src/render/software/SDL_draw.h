@@ -24,6 +24,8 @@
 
 /* This code assumes that r, g, b, a are the source color,
  * and in the blend and add case, the RGB values are premultiplied by a.
+ * Premultiplied blending uses the blend operators as is, and since its
+ * RGB values may exceed a (which adds light), those saturate.
  */
 
 #define DRAW_MUL(_a, _b) (((unsigned)(_a)*(_b))/255)
@@ -53,9 +55,9 @@ do { \
 do { \
     unsigned sr, sg, sb, sa = 0xFF; \
     getpixel; \
-    sr = DRAW_MUL(inva, sr) + r; \
-    sg = DRAW_MUL(inva, sg) + g; \
-    sb = DRAW_MUL(inva, sb) + b; \
+    sr = DRAW_MUL(inva, sr) + r; if (sr > 0xff) sr = 0xff; \
+    sg = DRAW_MUL(inva, sg) + g; if (sg > 0xff) sg = 0xff; \
+    sb = DRAW_MUL(inva, sb) + b; if (sb > 0xff) sb = 0xff; \
     sa = DRAW_MUL(inva, sa) + a; \
     setpixel; \
 } while (0)
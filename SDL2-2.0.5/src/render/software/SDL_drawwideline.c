@@ -0,0 +1,463 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if !SDL_RENDER_DISABLED
+
+#include "SDL_video.h"
+#include "SDL_blendfillrect.h"
+#include "SDL_blendpoint.h"
+#include "SDL_drawwideline.h"
+
+/* A line segment is drawn as the rectangle around it, with the ends
+   squared off half the width past the end points. Pixel (x, y) is covered
+   when its center, in the same coordinates as the end points, is inside
+   the rectangle, so every row of the rectangle is a single span of pixels.
+
+   Each segment is drawn by itself, so the joints of a blended polyline
+   are blended twice, the same as thin lines drawn one at a time.
+
+   Floating point is only used to set up each segment, the rows and the
+   pixels are walked in fixed point.
+ */
+
+#define WIDELINE_FIX16(_v)  ((Sint64) ((_v) * 65536.0))
+#define WIDELINE_FIX32(_v)  ((Sint64) ((_v) * 4294967296.0))
+#define WIDELINE_ONE16      ((Sint64) 1 << 16)
+#define WIDELINE_HALF32     ((Sint64) 1 << 31)
+
+/* Slabs steeper than this many pixels per row only limit the rows */
+#define WIDELINE_MAX_STEP   65536.0
+
+typedef struct
+{
+    double cx, cy;      /* Center of the segment */
+    double ux, uy;      /* Unit direction of the segment */
+    double hl, hw;      /* Half length including the end caps, half width */
+} SDL_WideLineSegment;
+
+static void
+SDL_SetupWideLineSegment(SDL_WideLineSegment * seg, const SDL_FPoint * p1,
+                         const SDL_FPoint * p2, float width)
+{
+    double dx, dy, len;
+
+    /* Draw the same pixels whichever way round the end points are */
+    if (p2->x < p1->x || (p2->x == p1->x && p2->y < p1->y)) {
+        const SDL_FPoint *tmp = p1;
+        p1 = p2;
+        p2 = tmp;
+    }
+    dx = (double) p2->x - p1->x;
+    dy = (double) p2->y - p1->y;
+    len = SDL_sqrt(dx * dx + dy * dy);
+
+    seg->cx = ((double) p1->x + p2->x) * 0.5;
+    seg->cy = ((double) p1->y + p2->y) * 0.5;
+    if (len > 0.0) {
+        seg->ux = dx / len;
+        seg->uy = dy / len;
+    } else {
+        seg->ux = 1.0;
+        seg->uy = 0.0;
+    }
+    seg->hw = width * 0.5;
+    seg->hl = len * 0.5 + seg->hw;
+}
+
+/* The span of a row is where both the distance along the segment and the
+   distance across it are within bounds. Each limits x to an interval
+   that moves linearly from row to row, unless the segment is (nearly)
+   axis aligned and the distance hardly depends on x, then it only limits
+   the rows. The spans are walked one row at a time, from the first row. */
+typedef struct
+{
+    Sint64 x1[2], x2[2];    /* Intervals of the current row, 16.16 */
+    Sint64 step[2];         /* Interval movement per row, 16.16 */
+    Sint64 left, right;     /* Clipped columns, right is exclusive */
+    int y1, y2;             /* First and last row */
+} SDL_WideLineSpans;
+
+/* A slab is the limit -h <= q * (y - cy) + k * (x - cx) < h */
+static SDL_bool
+SDL_IsWideLineSlabFlat(double q, double k)
+{
+    return (SDL_fabs(q) >= SDL_fabs(k) * WIDELINE_MAX_STEP) ? SDL_TRUE : SDL_FALSE;
+}
+
+static void
+SDL_LimitWideLineRows(SDL_WideLineSpans * spans, const SDL_WideLineSegment * seg,
+                      double q, double k, double h)
+{
+    if (SDL_IsWideLineSlabFlat(q, k)) {
+        const double a = SDL_fabs(h / q);
+        spans->y1 = SDL_max(spans->y1, (int) SDL_ceil(seg->cy - a));
+        spans->y2 = SDL_min(spans->y2, (int) SDL_ceil(seg->cy + a) - 1);
+    }
+}
+
+/* Start the slab's interval at the first row */
+static void
+SDL_SetWideLineSlab(SDL_WideLineSpans * spans, int slab,
+                    const SDL_WideLineSegment * seg, double q, double k,
+                    double h)
+{
+    double a, step, x;
+
+    if (SDL_IsWideLineSlabFlat(q, k)) {
+        spans->x1[slab] = spans->left;
+        spans->x2[slab] = spans->right;
+        spans->step[slab] = 0;
+        return;
+    }
+    a = SDL_fabs(h / k);
+    step = -q / k;
+    x = seg->cx + step * (spans->y1 - seg->cy);
+    spans->x1[slab] = WIDELINE_FIX16(x - a);
+    spans->x2[slab] = WIDELINE_FIX16(x + a);
+    spans->step[slab] = WIDELINE_FIX16(step);
+}
+
+/* Set up the spans of the segment rectangle grown by 'grow' */
+static SDL_bool
+SDL_SetupWideLineSpans(const SDL_WideLineSegment * seg, double grow,
+                       const SDL_Rect * clip, SDL_WideLineSpans * spans)
+{
+    const double hl = seg->hl + grow;
+    const double hw = seg->hw + grow;
+    const double ey = hl * SDL_fabs(seg->uy) + hw * SDL_fabs(seg->ux);
+    const double top = SDL_max(seg->cy - ey, (double) clip->y);
+    const double bottom = SDL_min(seg->cy + ey, (double) (clip->y + clip->h - 1));
+
+    if (hl <= 0.0 || hw <= 0.0 || top > bottom) {
+        return SDL_FALSE;
+    }
+    spans->y1 = (int) SDL_ceil(top);
+    spans->y2 = (int) bottom;
+    SDL_LimitWideLineRows(spans, seg, seg->uy, seg->ux, hl);
+    SDL_LimitWideLineRows(spans, seg, seg->ux, -seg->uy, hw);
+    if (spans->y1 > spans->y2) {
+        return SDL_FALSE;
+    }
+
+    spans->left = (Sint64) clip->x << 16;
+    spans->right = (Sint64) (clip->x + clip->w) << 16;
+    SDL_SetWideLineSlab(spans, 0, seg, seg->uy, seg->ux, hl);
+    SDL_SetWideLineSlab(spans, 1, seg, seg->ux, -seg->uy, hw);
+    return SDL_TRUE;
+}
+
+/* Find the first and last column of the next row */
+static SDL_INLINE SDL_bool
+SDL_NextWideLineSpan(SDL_WideLineSpans * spans, int *first, int *last)
+{
+    const Sint64 x1 = SDL_max(SDL_max(spans->x1[0], spans->x1[1]), spans->left);
+    const Sint64 x2 = SDL_min(SDL_min(spans->x2[0], spans->x2[1]), spans->right);
+
+    spans->x1[0] += spans->step[0];
+    spans->x2[0] += spans->step[0];
+    spans->x1[1] += spans->step[1];
+    spans->x2[1] += spans->step[1];
+
+    /* Both are at least 'left', which isn't negative */
+    if (x1 >= x2) {
+        return SDL_FALSE;
+    }
+    *first = (int) ((x1 + WIDELINE_ONE16 - 1) >> 16);
+    *last = (int) ((x2 + WIDELINE_ONE16 - 1) >> 16) - 1;
+    return (*first <= *last) ? SDL_TRUE : SDL_FALSE;
+}
+
+typedef struct
+{
+    SDL_BlendMode blendMode;
+    Uint32 pixel;           /* The color with the draw alpha */
+    Uint32 opaque;          /* The color with full alpha */
+    Uint32 mask;            /* The bits of the pixel format in use */
+    SDL_bool blend32;       /* Blended inline as four 8-bit channels */
+    Uint8 r, g, b, a;
+} SDL_WideLineColor;
+
+/* The same as DRAW_MUL() */
+#define WIDELINE_MUL(_a, _b) (((unsigned)(_a)*(_b))/255)
+
+/* WIDELINE_MUL() of two channels at once, each product in a 16-bit lane */
+#define WIDELINE_MUL2(_x, _a) \
+    (((((_x) * (_a)) + 0x00010001 + ((((_x) * (_a)) >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF)
+
+/* The same as DRAW_SETPIXEL_BLEND, for any order of 8-bit channels */
+static SDL_INLINE void
+SDL_BlendWideLinePixel32(Uint32 * pixel, const SDL_WideLineColor * color,
+                         Uint32 alpha)
+{
+    const Uint32 inva = 255 - alpha;
+    const Uint32 src = color->opaque;
+    const Uint32 dst = *pixel;
+    const Uint32 even = WIDELINE_MUL2(dst & 0x00FF00FF, inva) +
+                        WIDELINE_MUL2(src & 0x00FF00FF, alpha);
+    const Uint32 odd = WIDELINE_MUL2((dst >> 8) & 0x00FF00FF, inva) +
+                       WIDELINE_MUL2((src >> 8) & 0x00FF00FF, alpha);
+
+    *pixel = (even | (odd << 8)) & color->mask;
+}
+
+static SDL_INLINE void
+SDL_FillWideLineSpan(SDL_Surface * dst, int x1, int x2, int y,
+                     const SDL_WideLineColor * color)
+{
+    const int w = x2 - x1 + 1;
+    SDL_Rect rect;
+
+    if (dst->format->BytesPerPixel == 4) {
+        Uint32 *pixel = (Uint32 *) ((Uint8 *) dst->pixels + y * dst->pitch) + x1;
+
+        /* Short runs are too short for the SIMD fill to pay off */
+        if (color->blendMode == SDL_BLENDMODE_NONE && w < 64) {
+            const Uint32 value = color->pixel;
+            Uint32 *end = pixel + w;
+            while (pixel < end) {
+                *pixel++ = value;
+            }
+            return;
+        }
+        if (color->blendMode == SDL_BLENDMODE_BLEND && color->blend32) {
+            int i;
+            for (i = 0; i < w; ++i) {
+                SDL_BlendWideLinePixel32(&pixel[i], color, color->a);
+            }
+            return;
+        }
+    }
+
+    rect.x = x1;
+    rect.y = y;
+    rect.w = w;
+    rect.h = 1;
+    if (color->blendMode == SDL_BLENDMODE_NONE) {
+        SDL_FillRect(dst, &rect, color->pixel);
+    } else {
+        SDL_BlendFillRect(dst, &rect, color->blendMode,
+                          color->r, color->g, color->b, color->a);
+    }
+}
+
+/* Distances to the center lines of a segment in 32.32 fixed point,
+   s = s0 + sx * x + sy * y along it and t = t0 + tx * x + ty * y across */
+typedef struct
+{
+    Sint64 s0, sx, sy, hl;
+    Sint64 t0, tx, ty, hw;
+} SDL_WideLineCoverage;
+
+static void
+SDL_SetupWideLineCoverage(const SDL_WideLineSegment * seg,
+                          SDL_WideLineCoverage * coverage)
+{
+    coverage->sx = WIDELINE_FIX32(seg->ux);
+    coverage->sy = WIDELINE_FIX32(seg->uy);
+    coverage->s0 = WIDELINE_FIX32(-(seg->cx * seg->ux + seg->cy * seg->uy));
+    coverage->hl = WIDELINE_FIX32(seg->hl) + WIDELINE_HALF32;
+    coverage->tx = WIDELINE_FIX32(-seg->uy);
+    coverage->ty = WIDELINE_FIX32(seg->ux);
+    coverage->t0 = WIDELINE_FIX32(seg->cx * seg->uy - seg->cy * seg->ux);
+    coverage->hw = WIDELINE_FIX32(seg->hw) + WIDELINE_HALF32;
+}
+
+/* Coverage in 1/256ths, (h + 1/2 - |d|) clamped to [0, 1] */
+static SDL_INLINE Uint32
+SDL_WideLineEdgeCoverage(Sint64 d, Sint64 h)
+{
+    const Sint64 coverage = h - SDL_max(d, -d);
+
+    return (Uint32) (SDL_min(SDL_max(coverage, 0), (Sint64) 1 << 32) >> 24);
+}
+
+/* Blend the pixels of row y from x1 to x2 by how much of them is covered */
+static void
+SDL_BlendWideLineEdge(SDL_Surface * dst, const SDL_WideLineCoverage * coverage,
+                      int x1, int x2, int y, const SDL_WideLineColor * color)
+{
+    Sint64 s = coverage->s0 + coverage->sx * x1 + coverage->sy * y;
+    Sint64 t = coverage->t0 + coverage->tx * x1 + coverage->ty * y;
+    SDL_BlendMode blendMode = color->blendMode;
+    Uint32 *row = (Uint32 *) ((Uint8 *) dst->pixels + y * dst->pitch);
+    int x;
+
+    if (blendMode == SDL_BLENDMODE_NONE) {
+        blendMode = SDL_BLENDMODE_BLEND;
+    }
+    if (blendMode == SDL_BLENDMODE_BLEND && color->blend32) {
+        for (x = x1; x <= x2; ++x, s += coverage->sx, t += coverage->tx) {
+            const Uint32 cov = SDL_WideLineEdgeCoverage(s, coverage->hl) *
+                               SDL_WideLineEdgeCoverage(t, coverage->hw);
+            SDL_BlendWideLinePixel32(&row[x], color, (cov * color->a + 32768) >> 16);
+        }
+        return;
+    }
+    for (x = x1; x <= x2; ++x, s += coverage->sx, t += coverage->tx) {
+        const Uint32 cov256 = SDL_WideLineEdgeCoverage(s, coverage->hl) *
+                              SDL_WideLineEdgeCoverage(t, coverage->hw);
+        const unsigned cov = (cov256 * 255 + 32768) >> 16;
+
+        if (cov == 0) {
+            continue;
+        }
+        switch (blendMode) {
+        case SDL_BLENDMODE_PREMULTIPLIED:
+            SDL_BlendPoint(dst, x, y, blendMode,
+                           WIDELINE_MUL(color->r, cov),
+                           WIDELINE_MUL(color->g, cov),
+                           WIDELINE_MUL(color->b, cov),
+                           WIDELINE_MUL(color->a, cov));
+            break;
+        case SDL_BLENDMODE_MOD:
+            /* Fade towards white, which leaves the destination alone */
+            SDL_BlendPoint(dst, x, y, blendMode,
+                           255 - WIDELINE_MUL(255 - color->r, cov),
+                           255 - WIDELINE_MUL(255 - color->g, cov),
+                           255 - WIDELINE_MUL(255 - color->b, cov), color->a);
+            break;
+        default:
+            SDL_BlendPoint(dst, x, y, blendMode, color->r, color->g,
+                           color->b, WIDELINE_MUL(color->a, cov));
+            break;
+        }
+    }
+}
+
+static void
+SDL_DrawWideLineSegment(SDL_Surface * dst, const SDL_WideLineSegment * seg,
+                        SDL_bool antialias, const SDL_WideLineColor * color)
+{
+    const SDL_Rect *clip = &dst->clip_rect;
+    SDL_WideLineSpans outer, inner;
+    SDL_WideLineCoverage coverage;
+    SDL_bool has_inner;
+    int y, x1, x2;
+    int inner1 = 0, inner2 = -1;
+
+    if (!antialias) {
+        if (!SDL_SetupWideLineSpans(seg, 0.0, clip, &outer)) {
+            return;
+        }
+        for (y = outer.y1; y <= outer.y2; ++y) {
+            if (SDL_NextWideLineSpan(&outer, &x1, &x2)) {
+                SDL_FillWideLineSpan(dst, x1, x2, y, color);
+            }
+        }
+        return;
+    }
+
+    /* Pixels within half a pixel of the edges are partially covered,
+       the span between them is filled as usual. */
+    if (!SDL_SetupWideLineSpans(seg, 0.5, clip, &outer)) {
+        return;
+    }
+    has_inner = SDL_SetupWideLineSpans(seg, -0.5 + 1e-4, clip, &inner);
+    SDL_SetupWideLineCoverage(seg, &coverage);
+    for (y = outer.y1; y <= outer.y2; ++y) {
+        const SDL_bool filled = (has_inner && y >= inner.y1 && y <= inner.y2 &&
+                                 SDL_NextWideLineSpan(&inner, &inner1, &inner2));
+
+        if (!SDL_NextWideLineSpan(&outer, &x1, &x2)) {
+            continue;
+        }
+        if (filled) {
+            if (x1 < inner1) {
+                SDL_BlendWideLineEdge(dst, &coverage, x1, inner1 - 1, y, color);
+            }
+            SDL_FillWideLineSpan(dst, inner1, inner2, y, color);
+            if (inner2 < x2) {
+                SDL_BlendWideLineEdge(dst, &coverage, inner2 + 1, x2, y, color);
+            }
+        } else {
+            SDL_BlendWideLineEdge(dst, &coverage, x1, x2, y, color);
+        }
+    }
+}
+
+int
+SDL_DrawWideLines(SDL_Surface * dst, const SDL_FPoint * points, int count,
+                  float width, SDL_bool antialias, SDL_BlendMode blendMode,
+                  Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    SDL_WideLineColor color;
+    SDL_WideLineSegment seg;
+    int i;
+
+    if (!dst) {
+        return SDL_SetError("Passed NULL destination surface");
+    }
+
+    /* This function doesn't work on surfaces < 8 bpp */
+    if (dst->format->BitsPerPixel < 8) {
+        return SDL_SetError("SDL_DrawWideLines(): Unsupported surface format");
+    }
+
+    color.blendMode = blendMode;
+    color.pixel = SDL_MapRGBA(dst->format, r, g, b, a);
+    color.opaque = SDL_MapRGBA(dst->format, r, g, b, 0xFF);
+    color.mask = dst->format->Rmask | dst->format->Gmask |
+                 dst->format->Bmask | dst->format->Amask;
+    color.blend32 = (dst->format->BytesPerPixel == 4 &&
+                     !dst->format->Rloss && !dst->format->Gloss &&
+                     !dst->format->Bloss &&
+                     (!dst->format->Amask || !dst->format->Aloss)) ? SDL_TRUE : SDL_FALSE;
+    color.r = r;
+    color.g = g;
+    color.b = b;
+    color.a = a;
+
+    for (i = 1; i < count; ++i) {
+        SDL_SetupWideLineSegment(&seg, &points[i-1], &points[i], width);
+        SDL_DrawWideLineSegment(dst, &seg, antialias, &color);
+    }
+    return 0;
+}
+
+int
+SDL_GetWideLineRects(const SDL_FPoint * p1, const SDL_FPoint * p2,
+                     float width, const SDL_Rect * clip, SDL_Rect * rects)
+{
+    SDL_WideLineSegment seg;
+    SDL_WideLineSpans spans;
+    int y, x1, x2;
+    int count = 0;
+
+    SDL_SetupWideLineSegment(&seg, p1, p2, width);
+    if (!SDL_SetupWideLineSpans(&seg, 0.0, clip, &spans)) {
+        return 0;
+    }
+    for (y = spans.y1; y <= spans.y2; ++y) {
+        if (SDL_NextWideLineSpan(&spans, &x1, &x2)) {
+            rects[count].x = x1;
+            rects[count].y = y;
+            rects[count].w = x2 - x1 + 1;
+            rects[count].h = 1;
+            ++count;
+        }
+    }
+    return count;
+}
+
+#endif /* !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
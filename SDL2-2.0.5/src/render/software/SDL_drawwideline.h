@@ -0,0 +1,34 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+#include "../SDL_sysrender.h"
+
+
+/* Draws lines of any width as rows of pixel spans, optionally with the
+   edge pixels blended by how much of them the line covers. */
+extern int SDL_DrawWideLines(SDL_Surface * dst, const SDL_FPoint * points, int count, float width, SDL_bool antialias, SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+/* Fills 'rects' with the rows of pixels covered by a wide line segment,
+   limited to 'clip'. One rect is written per row, so 'rects' needs room
+   for the rows the segment spans, and never more than clip->h. */
+extern int SDL_GetWideLineRects(const SDL_FPoint * p1, const SDL_FPoint * p2, float width, const SDL_Rect * clip, SDL_Rect * rects);
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -32,7 +32,9 @@
 #include "SDL_blendpoint.h"
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
+#include "SDL_drawwideline.h"
 #include "SDL_rotate.h"
+#include "../../video/SDL_surface_pool.h"
 
 /* SDL surface based renderer implementation */
 
@@ -61,6 +63,9 @@ static int SW_RenderDrawPoints(SDL_Renderer * renderer,
                                const SDL_FPoint * points, int count);
 static int SW_RenderDrawLines(SDL_Renderer * renderer,
                               const SDL_FPoint * points, int count);
+static int SW_RenderDrawWideLines(SDL_Renderer * renderer,
+                                  const SDL_FPoint * points, int count,
+                                  float width, SDL_bool antialias);
 static int SW_RenderFillRects(SDL_Renderer * renderer,
                               const SDL_FRect * rects, int count);
 static int SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
@@ -95,13 +100,114 @@ SDL_RenderDriver SW_RenderDriver = {
      0}
 };
 
+/* The most rectangles presented separately, more are merged together */
+#define SW_MAX_DIRTY_RECTS  8
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* Areas of the window surface drawn since the last present, these
+       never overlap. If all_dirty is set the whole window is presented. */
+    SDL_Rect dirty[SW_MAX_DIRTY_RECTS + 1];
+    int num_dirty;
+    SDL_bool all_dirty;
 } SW_RenderData;
 
 
+/* Add a dirty rectangle, absorbing any others it overlaps */
+static void
+SW_InsertDirtyRect(SW_RenderData * data, SDL_Rect rect)
+{
+    int i = 0;
+
+    while (i < data->num_dirty) {
+        if (SDL_HasIntersection(&rect, &data->dirty[i])) {
+            SDL_UnionRect(&rect, &data->dirty[i], &rect);
+            data->dirty[i] = data->dirty[--data->num_dirty];
+            /* the union may overlap rectangles we already checked */
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+    data->dirty[data->num_dirty++] = rect;
+}
+
+/* Record that an area of the render target changed */
+static void
+SW_AddDirtyRect(SW_RenderData * data, const SDL_Rect * rect)
+{
+    SDL_Rect clipped;
+
+    /* Only drawing to the window needs to be presented */
+    if (data->all_dirty || !data->window || data->surface != data->window) {
+        return;
+    }
+
+    /* Drawing never leaves the clip rectangle */
+    if (!SDL_IntersectRect(rect, &data->window->clip_rect, &clipped)) {
+        return;
+    }
+    SW_InsertDirtyRect(data, clipped);
+
+    /* Out of room, merge the two rectangles whose union adds the least */
+    while (data->num_dirty > SW_MAX_DIRTY_RECTS) {
+        int i, j, best_i = 0, best_j = 1;
+        Sint64 best = -1;
+        SDL_Rect merged;
+
+        for (i = 0; i < data->num_dirty; ++i) {
+            for (j = i + 1; j < data->num_dirty; ++j) {
+                const SDL_Rect *a = &data->dirty[i];
+                const SDL_Rect *b = &data->dirty[j];
+                Sint64 waste;
+
+                SDL_UnionRect(a, b, &merged);
+                waste = (Sint64) merged.w * merged.h -
+                        (Sint64) a->w * a->h - (Sint64) b->w * b->h;
+                if (best < 0 || waste < best) {
+                    best = waste;
+                    best_i = i;
+                    best_j = j;
+                }
+            }
+        }
+        SDL_UnionRect(&data->dirty[best_i], &data->dirty[best_j], &merged);
+        data->dirty[best_j] = data->dirty[--data->num_dirty];
+        data->dirty[best_i] = data->dirty[--data->num_dirty];
+        SW_InsertDirtyRect(data, merged);
+    }
+}
+
+/* Record the bounding box of a set of points, or of lines joining them */
+static void
+SW_AddDirtyPoints(SW_RenderData * data, const SDL_Point * points, int count)
+{
+    SDL_Rect bounds;
+    int minx, miny, maxx, maxy;
+    int i;
+
+    if (count <= 0) {
+        return;
+    }
+    minx = maxx = points[0].x;
+    miny = maxy = points[0].y;
+    for (i = 1; i < count; ++i) {
+        minx = SDL_min(minx, points[i].x);
+        maxx = SDL_max(maxx, points[i].x);
+        miny = SDL_min(miny, points[i].y);
+        maxy = SDL_max(maxy, points[i].y);
+    }
+    bounds.x = minx;
+    bounds.y = miny;
+    bounds.w = maxx - minx + 1;
+    bounds.h = maxy - miny + 1;
+    SW_AddDirtyRect(data, &bounds);
+}
+
+
 static SDL_Surface *
 SW_ActivateRenderer(SDL_Renderer * renderer)
 {
@@ -114,6 +220,7 @@ SW_ActivateRenderer(SDL_Renderer * renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->all_dirty = SDL_TRUE;
 
             SW_UpdateViewport(renderer);
             SW_UpdateClipRect(renderer);
@@ -147,6 +254,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->all_dirty = SDL_TRUE;
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -163,6 +271,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->RenderClear = SW_RenderClear;
     renderer->RenderDrawPoints = SW_RenderDrawPoints;
     renderer->RenderDrawLines = SW_RenderDrawLines;
+    renderer->RenderDrawWideLines = SW_RenderDrawWideLines;
     renderer->RenderFillRects = SW_RenderFillRects;
     renderer->RenderCopy = SW_RenderCopy;
     renderer->RenderCopyEx = SW_RenderCopyEx;
@@ -199,6 +308,14 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
         data->surface = NULL;
         data->window = NULL;
     }
+
+    /* The window contents may have been lost, present everything */
+    if (event->event == SDL_WINDOWEVENT_SHOWN ||
+        event->event == SDL_WINDOWEVENT_EXPOSED ||
+        event->event == SDL_WINDOWEVENT_RESTORED ||
+        event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+        data->all_dirty = SDL_TRUE;
+    }
 }
 
 static int
@@ -280,10 +397,11 @@ static int
 SW_SetTextureBlendMode(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
-    /* If add or mod blending are ever enabled, permanently disable RLE (which doesn't support
-     * them) to avoid potentially frequent RLE encoding/decoding.
+    /* If add, mod or premultiplied blending are ever enabled, permanently disable RLE (which
+     * doesn't support them) to avoid potentially frequent RLE encoding/decoding.
      */
-    if ((texture->blendMode == SDL_BLENDMODE_ADD || texture->blendMode == SDL_BLENDMODE_MOD)) {
+    if ((texture->blendMode == SDL_BLENDMODE_ADD || texture->blendMode == SDL_BLENDMODE_MOD ||
+         texture->blendMode == SDL_BLENDMODE_PREMULTIPLIED)) {
         SDL_SetSurfaceRLE(surface, 0);
     }
     return SDL_SetSurfaceBlendMode(surface, texture->blendMode);
@@ -379,6 +497,7 @@ SW_UpdateClipRect(SDL_Renderer * renderer)
 static int
 SW_RenderClear(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     Uint32 color;
     SDL_Rect clip_rect;
@@ -395,6 +514,10 @@ SW_RenderClear(SDL_Renderer * renderer)
     SDL_SetClipRect(surface, NULL);
     SDL_FillRect(surface, NULL, color);
     SDL_SetClipRect(surface, &clip_rect);
+
+    if (surface == data->window) {
+        data->all_dirty = SDL_TRUE;
+    }
     return 0;
 }
 
@@ -402,6 +525,7 @@ static int
 SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
                     int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Point *final_points;
     int i, status;
@@ -442,6 +566,7 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
                                 renderer->r, renderer->g, renderer->b,
                                 renderer->a);
     }
+    SW_AddDirtyPoints(data, final_points, count);
     SDL_stack_free(final_points);
 
     return status;
@@ -451,6 +576,7 @@ static int
 SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
                    int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Point *final_points;
     int i, status;
@@ -491,6 +617,56 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
                                 renderer->r, renderer->g, renderer->b,
                                 renderer->a);
     }
+    SW_AddDirtyPoints(data, final_points, count);
+    SDL_stack_free(final_points);
+
+    return status;
+}
+
+static int
+SW_RenderDrawWideLines(SDL_Renderer * renderer, const SDL_FPoint * points,
+                       int count, float width, SDL_bool antialias)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SDL_FPoint *final_points;
+    SDL_Rect bounds;
+    float minx, miny, maxx, maxy;
+    int i, grow, status;
+
+    if (!surface) {
+        return -1;
+    }
+
+    final_points = SDL_stack_alloc(SDL_FPoint, count);
+    if (!final_points) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < count; ++i) {
+        final_points[i].x = renderer->viewport.x + points[i].x;
+        final_points[i].y = renderer->viewport.y + points[i].y;
+    }
+
+    status = SDL_DrawWideLines(surface, final_points, count, width, antialias,
+                               renderer->blendMode,
+                               renderer->r, renderer->g, renderer->b,
+                               renderer->a);
+
+    minx = maxx = final_points[0].x;
+    miny = maxy = final_points[0].y;
+    for (i = 1; i < count; ++i) {
+        minx = SDL_min(minx, final_points[i].x);
+        maxx = SDL_max(maxx, final_points[i].x);
+        miny = SDL_min(miny, final_points[i].y);
+        maxy = SDL_max(maxy, final_points[i].y);
+    }
+    /* The caps and the anti-aliased edges reach past the end points */
+    grow = (int) SDL_ceil(width * 0.5f) + 1;
+    bounds.x = (int) SDL_floor(minx) - grow;
+    bounds.y = (int) SDL_floor(miny) - grow;
+    bounds.w = (int) SDL_ceil(maxx) + grow - bounds.x + 1;
+    bounds.h = (int) SDL_ceil(maxy) + grow - bounds.y + 1;
+    SW_AddDirtyRect(data, &bounds);
     SDL_stack_free(final_points);
 
     return status;
@@ -499,6 +675,7 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
 static int
 SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Rect *final_rects;
     int i, status;
@@ -541,6 +718,9 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
                                     renderer->r, renderer->g, renderer->b,
                                     renderer->a);
     }
+    for (i = 0; i < count; ++i) {
+        SW_AddDirtyRect(data, &final_rects[i]);
+    }
     SDL_stack_free(final_rects);
 
     return status;
@@ -550,9 +730,11 @@ static int
 SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
               const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect final_rect;
+    int status;
 
     if (!surface) {
         return -1;
@@ -568,15 +750,14 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     final_rect.w = (int)dstrect->w;
     final_rect.h = (int)dstrect->h;
 
+    /* The blits clip final_rect to the area they touch */
     if ( srcrect->w == final_rect.w && srcrect->h == final_rect.h ) {
-        return SDL_BlitSurface(src, srcrect, surface, &final_rect);
+        status = SDL_BlitSurface(src, srcrect, surface, &final_rect);
     } else {
-        /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-         * to avoid potentially frequent RLE encoding/decoding.
-         */
-        SDL_SetSurfaceRLE(surface, 0);
-        return SDL_BlitScaled(src, srcrect, surface, &final_rect);
+        status = SDL_BlitScaled(src, srcrect, surface, &final_rect);
     }
+    SW_AddDirtyRect(data, &final_rect);
+    return status;
 }
 
 static int
@@ -596,6 +777,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                 const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                 const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect final_rect, tmp_rect;
@@ -621,7 +803,8 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     tmp_rect = final_rect;
     tmp_rect.x = 0;
     tmp_rect.y = 0;
-    if (srcrect->w == final_rect.w && srcrect->h == final_rect.h && srcrect->x == 0 && srcrect->y == 0) {
+    if (srcrect->w == final_rect.w && srcrect->h == final_rect.h && srcrect->x == 0 && srcrect->y == 0 &&
+        srcrect->w == src->w && srcrect->h == src->h) {
         surface_scaled = src; /* but if we don't need to, just use the original */
         retval = 0;
     } else {
@@ -631,9 +814,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
         Uint8 alphaMod, r, g, b;
         SDL_bool cloneSource = SDL_FALSE;
 
-        surface_scaled = SDL_CreateRGBSurface(SDL_SWSURFACE, final_rect.w, final_rect.h, src->format->BitsPerPixel,
-                                              src->format->Rmask, src->format->Gmask,
-                                              src->format->Bmask, src->format->Amask );
+        surface_scaled = SDL_CreatePooledSurface(final_rect.w, final_rect.h, src->format->format);
         if (!surface_scaled) {
             return -1;
         }
@@ -654,7 +835,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
          */
         cloneSource |= blendMode != SDL_BLENDMODE_NONE || (alphaMod & r & g & b) != 255;
         if (cloneSource) {
-            blit_src = SDL_ConvertSurface(src, src->format, src->flags); /* clone src */
+            blit_src = SDL_ConvertSurfacePooled(src, src->format); /* clone src */
             if (!blit_src) {
                 SDL_FreeSurface(surface_scaled);
                 return -1;
@@ -717,6 +898,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 
             retval = SDL_BlitSurface(surface_rotated, NULL, surface, &tmp_rect);
             SDL_FreeSurface(surface_rotated);
+            SW_AddDirtyRect(data, &tmp_rect);
         }
     }
 
@@ -765,11 +947,19 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
 
     if (window) {
-        SDL_UpdateWindowSurface(window);
+        /* Only push the parts of the window that were drawn to */
+        if (data->all_dirty) {
+            SDL_UpdateWindowSurface(window);
+        } else if (data->num_dirty > 0) {
+            SDL_UpdateWindowSurfaceRects(window, data->dirty, data->num_dirty);
+        }
     }
+    data->all_dirty = SDL_FALSE;
+    data->num_dirty = 0;
 }
 
 static void
@@ -39,6 +39,7 @@ Andreas Schiffler -- aschiffler at ferzkopp dot net
 
 #include "SDL.h"
 #include "SDL_rotate.h"
+#include "../../video/SDL_surface_pool.h"
 
 /* ---- Internally used structures */
 
@@ -444,7 +445,12 @@ SDLgfx_rotateSurface(SDL_Surface * src, double angle, int centerx, int centery,
         */
         rz_src = src;
     } else {
-        rz_src = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB32, src->flags);
+        SDL_PixelFormat *rz_fmt = SDL_AllocFormat(SDL_PIXELFORMAT_ARGB32);
+        if (rz_fmt == NULL) {
+            return NULL;
+        }
+        rz_src = SDL_ConvertSurfacePooled(src, rz_fmt);
+        SDL_FreeFormat(rz_fmt);
         if (rz_src == NULL) {
             return NULL;
         }
@@ -467,15 +473,12 @@ SDLgfx_rotateSurface(SDL_Surface * src, double angle, int centerx, int centery,
         /*
         * Target surface is 32bit with source RGBA/ABGR ordering
         */
-        rz_dst =
-            SDL_CreateRGBSurface(SDL_SWSURFACE, dstwidth, dstheight + GUARD_ROWS, 32,
-            rz_src->format->Rmask, rz_src->format->Gmask,
-            rz_src->format->Bmask, rz_src->format->Amask);
+        rz_dst = SDL_CreatePooledSurface(dstwidth, dstheight + GUARD_ROWS, rz_src->format->format);
     } else {
         /*
         * Target surface is 8bit
         */
-        rz_dst = SDL_CreateRGBSurface(SDL_SWSURFACE, dstwidth, dstheight + GUARD_ROWS, 8, 0, 0, 0, 0);
+        rz_dst = SDL_CreatePooledSurface(dstwidth, dstheight + GUARD_ROWS, SDL_PIXELFORMAT_INDEX8);
     }
 
     /* Check target */
@@ -83,12 +83,21 @@
  *
  *   The end of the sequence is marked by a zero <skip>,<run> pair at the
  *   beginning of an opaque line.
+ *
+ * Both encodings can also be blitted with nearest-neighbour scaling, which
+ * walks the runs of each sampled source line so that transparent spans are
+ * skipped just like in the unscaled case.
+ *
+ * The encoding is kept when the surface is remapped, as long as it still
+ * suits the new blit (see RLEEncodingIsCurrent()), so toggling unrelated
+ * blit parameters doesn't decode and encode the surface again.
  */
 
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
+#include "SDL_pixels_c.h"
 
 #ifndef MAX
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
@@ -446,6 +455,108 @@ RLEClipBlit(int w, Uint8 * srcbuf, SDL_Surface * surf_dst,
 
 }
 
+/*
+ * Find the destination columns of a nearest-neighbour scaled blit that sample
+ * the source pixels [ofs, ofs + run), clipped to [left, right). Returns the
+ * end column and stores the first one in *col.
+ */
+static SDL_INLINE int
+RLEScaledSpan(int ofs, int run, int left, int right, int incx, int dst_w,
+              int *col)
+{
+    int start = MAX(ofs, left) - left;
+    int end = MIN(ofs + run, right) - left;
+
+    if (start >= end) {
+        *col = 0;
+        return 0;
+    }
+    /* first column whose sample position reaches each source column */
+    *col = (int) ((((Sint64) start << 16) + incx - 1) / incx);
+    return (int) MIN((((Sint64) end << 16) + incx - 1) / incx, dst_w);
+}
+
+/*
+ * This takes care of nearest-neighbour scaling. Top clipping has already been
+ * taken care of, each destination row walks the runs of the source line it
+ * samples and only touches the columns covered by opaque runs.
+ */
+static void
+RLEScaledBlit(int w, Uint8 * srcbuf, SDL_Surface * surf_dst,
+              Uint8 * dstbuf, SDL_Rect * srcrect, SDL_Rect * dstrect,
+              unsigned alpha)
+{
+    SDL_PixelFormat *fmt = surf_dst->format;
+    int left = srcrect->x;
+    int right = left + srcrect->w;
+    int incx = (srcrect->w << 16) / dstrect->w;
+    int incy = (srcrect->h << 16) / dstrect->h;
+
+#define RLESCALEDBLIT(bpp, Type, do_blit)                       \
+    do {                                                        \
+        Uint8 *line = srcbuf;                                   \
+        int linecount = dstrect->h;                             \
+        int posy = 0;                                           \
+        for (;;) {                                              \
+            Uint8 *buf = line;                                  \
+            int ofs = 0;                                        \
+            /* blit the sampled source line */                  \
+            for (;;) {                                          \
+                int run;                                        \
+                ofs += *(Type *)buf;                            \
+                run = ((Type *)buf)[1];                         \
+                buf += 2 * sizeof(Type);                        \
+                if (run) {                                      \
+                    int x, posx;                                \
+                    int xend = RLEScaledSpan(ofs, run, left, right, \
+                                             incx, dstrect->w, &x); \
+                    for (posx = x * incx; x < xend; ++x) {      \
+                        do_blit(dstbuf + x * bpp,               \
+                            buf + (left + (posx >> 16) - ofs) * bpp, \
+                            1, bpp, alpha);                     \
+                        posx += incx;                           \
+                    }                                           \
+                    buf += run * bpp;                           \
+                    ofs += run;                                 \
+                } else if (!ofs)                                \
+                    return;                                     \
+                if (ofs == w)                                   \
+                    break;                                      \
+            }                                                   \
+            if (!--linecount)                                   \
+                break;                                          \
+            dstbuf += surf_dst->pitch;                          \
+                                                                \
+            /* move on to the line the next row samples */      \
+            posy += incy;                                       \
+            if (posy >= 0x10000) {                              \
+                line = buf;                                     \
+                posy -= 0x10000;                                \
+            }                                                   \
+            while (posy >= 0x10000) {                           \
+                ofs = 0;                                        \
+                for (;;) {                                      \
+                    int run;                                    \
+                    ofs += *(Type *)line;                       \
+                    run = ((Type *)line)[1];                    \
+                    line += 2 * sizeof(Type) + run * bpp;       \
+                    ofs += run;                                 \
+                    if (!ofs)                                   \
+                        return;                                 \
+                    if (ofs == w)                               \
+                        break;                                  \
+                }                                               \
+                posy -= 0x10000;                                \
+            }                                                   \
+        }                                                       \
+    } while(0)
+
+    CHOOSE_BLIT(RLESCALEDBLIT, alpha, fmt);
+
+#undef RLESCALEDBLIT
+
+}
+
 
 /* blit a colorkeyed RLE surface */
 int
@@ -517,8 +628,10 @@ SDL_RLEBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
     }
 
     alpha = surf_src->map->info.a;
-    /* if left or right edge clipping needed, call clip blit */
-    if (srcrect->x || srcrect->w != surf_src->w) {
+    /* if scaling or left or right edge clipping needed, call those blits */
+    if (srcrect->w != dstrect->w || srcrect->h != dstrect->h) {
+        RLEScaledBlit(w, srcbuf, surf_dst, dstbuf, srcrect, dstrect, alpha);
+    } else if (srcrect->x || srcrect->w != surf_src->w) {
         RLEClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect, alpha);
     } else {
         SDL_PixelFormat *fmt = surf_src->format;
@@ -725,6 +838,124 @@ RLEAlphaClipBlit(int w, Uint8 * srcbuf, SDL_Surface * surf_dst,
     }
 }
 
+/* blit a pixel-alpha RLE surface with nearest-neighbour scaling */
+static void
+RLEAlphaScaledBlit(int w, Uint8 * srcbuf, SDL_Surface * surf_dst,
+                   Uint8 * dstbuf, SDL_Rect * srcrect, SDL_Rect * dstrect)
+{
+    SDL_PixelFormat *df = surf_dst->format;
+    int left = srcrect->x;
+    int right = left + srcrect->w;
+    int incx = (srcrect->w << 16) / dstrect->w;
+    int incy = (srcrect->h << 16) / dstrect->h;
+
+    /*
+     * scaled blitter: Ptype is the destination pixel type,
+     * Ctype the opaque count type, and do_blend the macro
+     * to blend one pixel.
+     */
+#define RLEALPHASCALEDBLIT(Ptype, Ctype, do_blend)              \
+    do {                                                        \
+    Uint8 *line = srcbuf;                                       \
+    int linecount = dstrect->h;                                 \
+    int posy = 0;                                               \
+    for (;;) {                                                  \
+        Ptype *dst = (Ptype *)dstbuf;                           \
+        Uint8 *src = line;                                      \
+        int ofs = 0;                                            \
+        /* blit opaque pixels of the sampled line */            \
+        do {                                                    \
+        int run, x, posx, xend;                                 \
+        ofs += ((Ctype *)src)[0];                               \
+        run = ((Ctype *)src)[1];                                \
+        src += 2 * sizeof(Ctype);                               \
+        if(run) {                                               \
+            xend = RLEScaledSpan(ofs, run, left, right,         \
+                                 incx, dstrect->w, &x);         \
+            for(posx = x * incx; x < xend; ++x) {               \
+            dst[x] = ((Ptype *)src)[left + (posx >> 16) - ofs]; \
+            posx += incx;                                       \
+            }                                                   \
+            src += run * sizeof(Ptype);                         \
+            ofs += run;                                         \
+        } else if(!ofs)                                         \
+            return;                                             \
+        } while(ofs < w);                                       \
+        /* skip padding if necessary */                         \
+        if(sizeof(Ptype) == 2)                                  \
+        src += (uintptr_t)src & 2;                              \
+        /* blit translucent pixels of the same line */          \
+        ofs = 0;                                                \
+        do {                                                    \
+        int run, x, posx, xend;                                 \
+        ofs += ((Uint16 *)src)[0];                              \
+        run = ((Uint16 *)src)[1];                               \
+        src += 4;                                               \
+        if(run) {                                               \
+            xend = RLEScaledSpan(ofs, run, left, right,         \
+                                 incx, dstrect->w, &x);         \
+            for(posx = x * incx; x < xend; ++x) {               \
+            do_blend(((Uint32 *)src)[left + (posx >> 16) - ofs], \
+                     dst[x]);                                   \
+            posx += incx;                                       \
+            }                                                   \
+            src += run * 4;                                     \
+            ofs += run;                                         \
+        }                                                       \
+        } while(ofs < w);                                       \
+        if(!--linecount)                                        \
+        break;                                                  \
+        dstbuf += surf_dst->pitch;                              \
+                                                                \
+        /* move on to the line the next row samples */          \
+        posy += incy;                                           \
+        if(posy >= 0x10000) {                                   \
+        line = src;                                             \
+        posy -= 0x10000;                                        \
+        }                                                       \
+        while(posy >= 0x10000) {                                \
+        /* skip opaque line */                                  \
+        ofs = 0;                                                \
+        do {                                                    \
+            int run;                                            \
+            ofs += ((Ctype *)line)[0];                          \
+            run = ((Ctype *)line)[1];                           \
+            line += 2 * sizeof(Ctype) + run * sizeof(Ptype);    \
+            ofs += run;                                         \
+            if(!ofs)                                            \
+            return;                                             \
+        } while(ofs < w);                                       \
+        if(sizeof(Ptype) == 2)                                  \
+            line += (uintptr_t)line & 2;                        \
+        /* skip translucent line */                             \
+        ofs = 0;                                                \
+        do {                                                    \
+            int run;                                            \
+            ofs += ((Uint16 *)line)[0];                         \
+            run = ((Uint16 *)line)[1];                          \
+            line += 4 * (run + 1);                              \
+            ofs += run;                                         \
+        } while(ofs < w);                                       \
+        posy -= 0x10000;                                        \
+        }                                                       \
+    }                                                           \
+    } while(0)
+
+    switch (df->BytesPerPixel) {
+    case 2:
+        if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0)
+            RLEALPHASCALEDBLIT(Uint16, Uint8, BLIT_TRANSL_565);
+        else
+            RLEALPHASCALEDBLIT(Uint16, Uint8, BLIT_TRANSL_555);
+        break;
+    case 4:
+        RLEALPHASCALEDBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        break;
+    }
+
+#undef RLEALPHASCALEDBLIT
+}
+
 /* blit a pixel-alpha RLE surface */
 int
 SDL_RLEAlphaBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
@@ -803,8 +1034,10 @@ SDL_RLEAlphaBlit(SDL_Surface * surf_src, SDL_Rect * srcrect,
         }
     }
 
-    /* if left or right edge clipping needed, call clip blit */
-    if (srcrect->x || srcrect->w != surf_src->w) {
+    /* if scaling or left or right edge clipping needed, call those blits */
+    if (srcrect->w != dstrect->w || srcrect->h != dstrect->h) {
+        RLEAlphaScaledBlit(w, srcbuf, surf_dst, dstbuf, srcrect, dstrect);
+    } else if (srcrect->x || srcrect->w != surf_src->w) {
         RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect);
     } else {
 
@@ -1222,7 +1455,12 @@ RLEAlphaSurface(SDL_Surface * surface)
 #undef ADD_TRANSL_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_PREALLOC)) {
+    if (surface->flags & SDL_PREALLOC) {
+        /* Don't free */
+    } else if (surface->flags & SDL_SIMD_ALIGNED) {
+        SDL_FreeSurfacePixels(surface->pixels);
+        surface->pixels = NULL;
+    } else {
         SDL_free(surface->pixels);
         surface->pixels = NULL;
     }
@@ -1316,6 +1554,7 @@ RLEColorkeySurface(SDL_Surface * surface)
     dst = rlebuf;
     rgbmask = ~surface->format->Amask;
     ckey = surface->map->info.colorkey & rgbmask;
+    surface->map->rle_colorkey = ckey;
     lastline = dst;
     getpix = getpixes[bpp - 1];
     w = surface->w;
@@ -1382,7 +1621,12 @@ RLEColorkeySurface(SDL_Surface * surface)
 #undef ADD_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
-    if (!(surface->flags & SDL_PREALLOC)) {
+    if (surface->flags & SDL_PREALLOC) {
+        /* Don't free */
+    } else if (surface->flags & SDL_SIMD_ALIGNED) {
+        SDL_FreeSurfacePixels(surface->pixels);
+        surface->pixels = NULL;
+    } else {
         SDL_free(surface->pixels);
         surface->pixels = NULL;
     }
@@ -1399,57 +1643,111 @@ RLEColorkeySurface(SDL_Surface * surface)
     return (0);
 }
 
-int
-SDL_RLESurface(SDL_Surface * surface)
+/* Work out which kind of RLE encoding suits the blit set up in the map */
+static int
+RLEEncodingType(SDL_Surface * surface)
 {
     int flags;
 
-    /* Clear any previous RLE conversion */
-    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
-        SDL_UnRLESurface(surface, 1);
-    }
-
     /* We don't support RLE encoding of bitmaps */
     if (surface->format->BitsPerPixel < 8) {
-        return -1;
-    }
-
-    /* Make sure the pixels are available */
-    if (!surface->pixels) {
-        return -1;
+        return 0;
     }
 
     /* If we don't have colorkey or blending, nothing to do... */
     flags = surface->map->info.flags;
     if (!(flags & (SDL_COPY_COLORKEY | SDL_COPY_BLEND))) {
-        return -1;
+        return 0;
     }
 
     /* Pass on combinations not supported */
     if ((flags & SDL_COPY_MODULATE_COLOR) ||
         ((flags & SDL_COPY_MODULATE_ALPHA) && surface->format->Amask) ||
-        (flags & (SDL_COPY_ADD | SDL_COPY_MOD)) ||
-        (flags & SDL_COPY_NEAREST)) {
-        return -1;
+        (flags & (SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_PREMULTIPLIED))) {
+        return 0;
     }
 
-    /* Encode and set up the blit */
     if (!surface->format->Amask || !(flags & SDL_COPY_BLEND)) {
         if (!surface->map->identity) {
-            return -1;
+            return 0;
+        }
+        return SDL_COPY_RLE_COLORKEY;
+    }
+    return SDL_COPY_RLE_ALPHAKEY;
+}
+
+/* See whether the current encoding would come out the same if the surface
+   was decoded and encoded again for the blit set up in the map */
+static SDL_bool
+RLEEncodingIsCurrent(SDL_Surface * surface)
+{
+    SDL_BlitMap *map = surface->map;
+    int type;
+
+    /* A locked surface keeps the flag but has been decoded */
+    if (!map->data || !map->dst) {
+        return SDL_FALSE;
+    }
+
+    type = RLEEncodingType(surface);
+    if (!type || !(map->info.flags & type)) {
+        return SDL_FALSE;
+    }
+
+    if (type == SDL_COPY_RLE_COLORKEY) {
+        /* encoded in the source format, which identity says is the target's */
+        return (map->rle_colorkey ==
+                (map->info.colorkey & ~surface->format->Amask));
+    } else {
+        /* encoded in the target format */
+        RLEDestFormat *r = (RLEDestFormat *) map->data;
+        SDL_PixelFormat *df = map->dst->format;
+
+        return (r->BytesPerPixel == df->BytesPerPixel &&
+                r->Rmask == df->Rmask && r->Gmask == df->Gmask &&
+                r->Bmask == df->Bmask && r->Amask == df->Amask);
+    }
+}
+
+int
+SDL_RLESurface(SDL_Surface * surface)
+{
+    int type;
+
+    /* Keep the current encoding if it still fits, otherwise clear it */
+    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
+        if (RLEEncodingIsCurrent(surface)) {
+            if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
+                surface->map->blit = SDL_RLEBlit;
+            } else {
+                surface->map->blit = SDL_RLEAlphaBlit;
+            }
+            return 0;
         }
+        SDL_UnRLESurface(surface, 1);
+    }
+
+    /* Make sure the pixels are available */
+    if (!surface->pixels) {
+        return -1;
+    }
+
+    /* Encode and set up the blit */
+    type = RLEEncodingType(surface);
+    if (type == SDL_COPY_RLE_COLORKEY) {
         if (RLEColorkeySurface(surface) < 0) {
             return -1;
         }
         surface->map->blit = SDL_RLEBlit;
-        surface->map->info.flags |= SDL_COPY_RLE_COLORKEY;
-    } else {
+    } else if (type == SDL_COPY_RLE_ALPHAKEY) {
         if (RLEAlphaSurface(surface) < 0) {
             return -1;
         }
         surface->map->blit = SDL_RLEAlphaBlit;
-        surface->map->info.flags |= SDL_COPY_RLE_ALPHAKEY;
+    } else {
+        return -1;
     }
+    surface->map->info.flags |= type;
 
     /* The surface is now accelerated */
     surface->flags |= SDL_RLEACCEL;
@@ -1484,10 +1782,11 @@ UnRLEAlpha(SDL_Surface * surface)
         uncopy_opaque = uncopy_transl = uncopy_32;
     }
 
-    surface->pixels = SDL_malloc(surface->h * surface->pitch);
+    surface->pixels = SDL_AllocSurfacePixels(surface->h * surface->pitch);
     if (!surface->pixels) {
         return (SDL_FALSE);
     }
+    surface->flags |= SDL_SIMD_ALIGNED;
     /* fill background with transparent pixels */
     SDL_memset(surface->pixels, 0, surface->h * surface->pitch);
 
@@ -1547,12 +1846,13 @@ SDL_UnRLESurface(SDL_Surface * surface, int recode)
                 SDL_Rect full;
 
                 /* re-create the original surface */
-                surface->pixels = SDL_malloc(surface->h * surface->pitch);
+                surface->pixels = SDL_AllocSurfacePixels(surface->h * surface->pitch);
                 if (!surface->pixels) {
                     /* Oh crap... */
                     surface->flags |= SDL_RLEACCEL;
                     return;
                 }
+                surface->flags |= SDL_SIMD_ALIGNED;
 
                 /* fill it with the background color */
                 SDL_FillRect(surface, NULL, surface->map->info.colorkey);
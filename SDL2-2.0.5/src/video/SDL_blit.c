@@ -20,12 +20,14 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_hints.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
 #include "SDL_blit_copy.h"
 #include "SDL_blit_slow.h"
+#include "SDL_blit_threads.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
@@ -84,8 +86,10 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
             info->dst_pitch - info->dst_w * info->dst_fmt->BytesPerPixel;
         RunBlit = (SDL_BlitFunc) src->map->data;
 
-        /* Run the actual software blit */
-        RunBlit(info);
+        /* Run the actual software blit, split across threads if it's big */
+        if (!SDL_ParallelBlit(RunBlit, info)) {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -124,44 +128,86 @@ SDL_UseAltivecPrefetch()
 }
 #endif /* __MACOSX__ */
 
-static SDL_BlitFunc
-SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
-                   SDL_BlitFuncEntry * entries)
+/* The CPU features the blitters may use, as SDL_CPU_* flags.
+   SDL_HINT_BLIT_CPU_FEATURES can restrict them for testing lower tiers. */
+static Uint32 SDL_blit_cpu_features = 0xffffffff;
+static SDL_atomic_t SDL_blit_cpu_features_watched;
+
+static Uint32
+SDL_CalculateBlitCPUFeatures(const char *hint)
 {
-    int i, flagcheck;
-    static Uint32 features = 0xffffffff;
+    Uint32 features = SDL_CPU_ANY;
 
-    /* Get the available CPU features */
-    if (features == 0xffffffff) {
-        const char *override = SDL_getenv("SDL_BLIT_CPU_FEATURES");
+    if (SDL_HasMMX()) {
+        features |= SDL_CPU_MMX;
+    }
+    if (SDL_Has3DNow()) {
+        features |= SDL_CPU_3DNOW;
+    }
+    if (SDL_HasSSE()) {
+        features |= SDL_CPU_SSE;
+    }
+    if (SDL_HasSSE2()) {
+        features |= SDL_CPU_SSE2;
+    }
+    if (SDL_HasSSE41()) {
+        features |= SDL_CPU_SSE41;
+    }
+    if (SDL_HasAVX2()) {
+        features |= SDL_CPU_AVX2;
+    }
+    if (SDL_HasAltiVec()) {
+        if (SDL_UseAltivecPrefetch()) {
+            features |= SDL_CPU_ALTIVEC_PREFETCH;
+        } else {
+            features |= SDL_CPU_ALTIVEC_NOPREFETCH;
+        }
+    }
 
-        features = SDL_CPU_ANY;
+    /* Allow an override for testing, but never enable what isn't there. */
+    if (hint && *hint) {
+        Uint32 requested = SDL_CPU_ANY;
+        SDL_sscanf(hint, "%u", &requested);
+        features &= requested;
+    }
+    return features;
+}
 
-        /* Allow an override for testing .. */
-        if (override) {
-            SDL_sscanf(override, "%u", &features);
-        } else {
-            if (SDL_HasMMX()) {
-                features |= SDL_CPU_MMX;
-            }
-            if (SDL_Has3DNow()) {
-                features |= SDL_CPU_3DNOW;
-            }
-            if (SDL_HasSSE()) {
-                features |= SDL_CPU_SSE;
-            }
-            if (SDL_HasSSE2()) {
-                features |= SDL_CPU_SSE2;
-            }
-            if (SDL_HasAltiVec()) {
-                if (SDL_UseAltivecPrefetch()) {
-                    features |= SDL_CPU_ALTIVEC_PREFETCH;
-                } else {
-                    features |= SDL_CPU_ALTIVEC_NOPREFETCH;
-                }
-            }
+static void SDLCALL
+SDL_BlitCPUFeaturesChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_blit_cpu_features = SDL_CalculateBlitCPUFeatures(hint);
+}
+
+Uint32
+SDL_GetBlitCPUFeatures(void)
+{
+    if (SDL_blit_cpu_features == 0xffffffff) {
+        if (!SDL_AtomicCAS(&SDL_blit_cpu_features_watched, 0, 1)) {
+            /* Another thread is registering the callback right now */
+            return SDL_CalculateBlitCPUFeatures(SDL_GetHint(SDL_HINT_BLIT_CPU_FEATURES));
         }
+        /* This calls SDL_BlitCPUFeaturesChanged() with the current value */
+        SDL_AddHintCallback(SDL_HINT_BLIT_CPU_FEATURES, SDL_BlitCPUFeaturesChanged, NULL);
+    }
+    return SDL_blit_cpu_features;
+}
+
+void
+SDL_BlitCPUFeaturesQuit(void)
+{
+    if (SDL_AtomicCAS(&SDL_blit_cpu_features_watched, 1, 0)) {
+        SDL_DelHintCallback(SDL_HINT_BLIT_CPU_FEATURES, SDL_BlitCPUFeaturesChanged, NULL);
     }
+    SDL_blit_cpu_features = 0xffffffff;
+}
+
+static SDL_BlitFunc
+SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
+                   SDL_BlitFuncEntry * entries)
+{
+    int i, flagcheck;
+    Uint32 features = SDL_GetBlitCPUFeatures();
 
     for (i = 0; entries[i].func; ++i) {
         /* Check for matching pixel formats */
@@ -182,7 +228,8 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
         /* Check blend flags */
         flagcheck =
             (flags &
-             (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD));
+             (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD |
+              SDL_COPY_PREMULTIPLIED));
         if ((flagcheck & entries[i].flags) != flagcheck) {
             continue;
         }
@@ -219,23 +266,25 @@ SDL_CalculateBlit(SDL_Surface * surface)
     SDL_BlitMap *map = surface->map;
     SDL_Surface *dst = map->dst;
 
-    /* Clean everything out to start */
-    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
-        SDL_UnRLESurface(surface, 1);
-    }
     map->blit = SDL_SoftBlit;
     map->info.src_fmt = surface->format;
     map->info.src_pitch = surface->pitch;
     map->info.dst_fmt = dst->format;
     map->info.dst_pitch = dst->pitch;
 
-    /* See if we can do RLE acceleration */
+    /* See if we can do RLE acceleration, this keeps an existing encoding
+       that still suits the new mapping */
     if (map->info.flags & SDL_COPY_RLE_DESIRED) {
         if (SDL_RLESurface(surface) == 0) {
             return 0;
         }
     }
 
+    /* Clean out any encoding left over from the previous mapping */
+    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
+        SDL_UnRLESurface(surface, 1);
+    }
+
     /* Choose a standard blit function */
     if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
         blit = SDL_BlitCopy;
@@ -245,7 +294,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
     } else if (surface->format->BytesPerPixel == 1 &&
                SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
         blit = SDL_CalculateBlit1(surface);
-    } else if (map->info.flags & SDL_COPY_BLEND) {
+    } else if (map->info.flags & (SDL_COPY_BLEND | SDL_COPY_PREMULTIPLIED)) {
         blit = SDL_CalculateBlitA(surface);
     } else {
         blit = SDL_CalculateBlitN(surface);
@@ -36,6 +36,7 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_BLEND              0x00000010
 #define SDL_COPY_ADD                0x00000020
 #define SDL_COPY_MOD                0x00000040
+#define SDL_COPY_PREMULTIPLIED      0x00000080
 #define SDL_COPY_COLORKEY           0x00000100
 #define SDL_COPY_NEAREST            0x00000200
 #define SDL_COPY_RLE_DESIRED        0x00001000
@@ -51,6 +52,23 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_CPU_SSE2                0x00000008
 #define SDL_CPU_ALTIVEC_PREFETCH    0x00000010
 #define SDL_CPU_ALTIVEC_NOPREFETCH  0x00000020
+#define SDL_CPU_SSE41               0x00000040
+#define SDL_CPU_AVX2                0x00000080
+
+/* SSE4.1 and AVX2 blitters are compiled per function, so the rest of SDL
+   keeps the baseline instruction set and the choice is made at runtime. */
+#if (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define SDL_AVX2_BLITTERS   1
+#define SDL_TARGETING(x)    __attribute__((target(x)))
+#elif defined(_MSC_VER) && (_MSC_VER >= 1700) && (defined(_M_IX86) || defined(_M_X64))
+#define SDL_AVX2_BLITTERS   1
+#define SDL_TARGETING(x)
+#endif
+
+#if SDL_AVX2_BLITTERS
+#include <immintrin.h>
+#endif
 
 typedef struct
 {
@@ -90,6 +108,9 @@ typedef struct SDL_BlitMap
     void *data;
     SDL_BlitInfo info;
 
+    /* the colorkey a colorkey RLE encoding in 'data' was made with */
+    Uint32 rle_colorkey;
+
     /* the version count matches the destination; mismatch indicates
        an invalid mapping */
     Uint32 dst_palette_version;
@@ -98,6 +119,8 @@ typedef struct SDL_BlitMap
 
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
+extern Uint32 SDL_GetBlitCPUFeatures(void);
+extern void SDL_BlitCPUFeaturesQuit(void);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
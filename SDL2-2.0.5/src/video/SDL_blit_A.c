@@ -509,6 +509,53 @@ BlitRGBtoRGBPixelAlpha(SDL_BlitInfo * info)
     }
 }
 
+/* Exact x/255 for x <= 255*255, the same rounding as SDL_Blit_Slow() */
+#define DIV255(x)   (((x) + 1 + ((x) >> 8)) >> 8)
+
+/* Blend one premultiplied ARGB8888 pixel. Color above alpha adds light,
+   so the color channels saturate. */
+static SDL_INLINE Uint32
+BlendPremultiplied8888(Uint32 s, Uint32 d)
+{
+    Uint32 ialpha = (s >> 24) ^ 0xFF;
+    Uint32 r = ((s >> 16) & 0xFF) + DIV255(((d >> 16) & 0xFF) * ialpha);
+    Uint32 g = ((s >> 8) & 0xFF) + DIV255(((d >> 8) & 0xFF) * ialpha);
+    Uint32 b = (s & 0xFF) + DIV255((d & 0xFF) * ialpha);
+    Uint32 a = (s >> 24) + DIV255((d >> 24) * ialpha);
+
+    return (a << 24) | (SDL_min(r, 0xFF) << 16) |
+           (SDL_min(g, 0xFF) << 8) | SDL_min(b, 0xFF);
+}
+
+/* fast premultiplied ARGB8888->(A)RGB888 blending with pixel alpha */
+static void
+BlitRGBtoRGBPremultipliedPixelAlpha(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+
+    while (height--) {
+        int n = width;
+
+        while (n--) {
+            Uint32 s = *srcp;
+            if ((s >> 24) == SDL_ALPHA_OPAQUE) {
+                *dstp = s;
+            } else if (s) {
+                *dstp = BlendPremultiplied8888(s, *dstp);
+            }
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
 #ifdef __3dNOW__
 /* fast (as in MMX with prefetch) ARGB888->(A)RGB888 blending with pixel alpha */
 static void
@@ -582,6 +629,258 @@ BlitRGBtoRGBPixelAlphaMMX3DNOW(SDL_BlitInfo * info)
 
 #endif /* __3dNOW__ */
 
+#if SDL_AVX2_BLITTERS
+
+/* Blend one ARGB8888 pixel the same way the MMX blitter does, so every
+   tier produces identical output. Alpha must be in the top byte. */
+static SDL_INLINE Uint32
+BlendPixelAlpha8888(Uint32 s, Uint32 d)
+{
+    Uint32 alpha = s >> 24;
+    Uint32 ialpha = alpha ^ 0xFF;
+
+    if (alpha == 0) {
+        return d;
+    } else if (alpha == SDL_ALPHA_OPAQUE) {
+        return s;
+    }
+    return ((((s >> 24) * 0xFF) >> 8) + (((d >> 24) * ialpha) >> 8)) << 24 |
+           ((((s >> 16) & 0xFF) * alpha >> 8) + (((d >> 16) & 0xFF) * ialpha >> 8)) << 16 |
+           ((((s >> 8) & 0xFF) * alpha >> 8) + (((d >> 8) & 0xFF) * ialpha >> 8)) << 8 |
+           (((s & 0xFF) * alpha >> 8) + ((d & 0xFF) * ialpha >> 8));
+}
+
+/* fast ARGB8888->(A)RGB888 blending with pixel alpha, 4 pixels at a time */
+static void SDL_TARGETING("sse4.1")
+BlitRGBtoRGBPixelAlphaSSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amask = _mm_set1_epi32(0xFF000000);
+    const __m128i alpha_lane = _mm_set_epi16(0xFF, 0, 0, 0, 0xFF, 0, 0, 0);
+    const __m128i inv = _mm_set1_epi16(0xFF);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+            __m128i sa = _mm_and_si128(s, amask);
+            __m128i transparent = _mm_cmpeq_epi32(sa, zero);
+            __m128i opaque = _mm_cmpeq_epi32(sa, amask);
+
+            if (_mm_movemask_epi8(opaque) == 0xFFFF) {
+                /* Fully opaque run, nothing to blend */
+                _mm_storeu_si128((__m128i *) dstp, s);
+            } else if (_mm_movemask_epi8(transparent) != 0xFFFF) {
+                __m128i d = _mm_loadu_si128((const __m128i *) dstp);
+                __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+                __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+                __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+                __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+                __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xFF), 0xFF);
+                __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xFF), 0xFF);
+                __m128i r;
+
+                s_lo = _mm_srli_epi16(_mm_mullo_epi16(s_lo, _mm_or_si128(a_lo, alpha_lane)), 8);
+                s_hi = _mm_srli_epi16(_mm_mullo_epi16(s_hi, _mm_or_si128(a_hi, alpha_lane)), 8);
+                d_lo = _mm_srli_epi16(_mm_mullo_epi16(d_lo, _mm_xor_si128(a_lo, inv)), 8);
+                d_hi = _mm_srli_epi16(_mm_mullo_epi16(d_hi, _mm_xor_si128(a_hi, inv)), 8);
+                r = _mm_packus_epi16(_mm_add_epi16(s_lo, d_lo), _mm_add_epi16(s_hi, d_hi));
+
+                r = _mm_blendv_epi8(r, s, opaque);
+                r = _mm_blendv_epi8(r, d, transparent);
+                _mm_storeu_si128((__m128i *) dstp, r);
+            }
+            srcp += 4;
+            dstp += 4;
+            n -= 4;
+        }
+        while (n--) {
+            *dstp = BlendPixelAlpha8888(*srcp, *dstp);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast ARGB8888->(A)RGB888 blending with pixel alpha, 8 pixels at a time */
+static void SDL_TARGETING("avx2")
+BlitRGBtoRGBPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i amask = _mm256_set1_epi32(0xFF000000);
+    const __m256i alpha_lane = _mm256_set_epi16(0xFF, 0, 0, 0, 0xFF, 0, 0, 0,
+                                                0xFF, 0, 0, 0, 0xFF, 0, 0, 0);
+    const __m256i inv = _mm256_set1_epi16(0xFF);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 8) {
+            __m256i s = _mm256_loadu_si256((const __m256i *) srcp);
+            __m256i sa = _mm256_and_si256(s, amask);
+            __m256i transparent = _mm256_cmpeq_epi32(sa, zero);
+            __m256i opaque = _mm256_cmpeq_epi32(sa, amask);
+
+            if (_mm256_movemask_epi8(opaque) == -1) {
+                /* Fully opaque run, nothing to blend */
+                _mm256_storeu_si256((__m256i *) dstp, s);
+            } else if (_mm256_movemask_epi8(transparent) != -1) {
+                __m256i d = _mm256_loadu_si256((const __m256i *) dstp);
+                __m256i s_lo = _mm256_unpacklo_epi8(s, zero);
+                __m256i s_hi = _mm256_unpackhi_epi8(s, zero);
+                __m256i d_lo = _mm256_unpacklo_epi8(d, zero);
+                __m256i d_hi = _mm256_unpackhi_epi8(d, zero);
+                __m256i a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, 0xFF), 0xFF);
+                __m256i a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, 0xFF), 0xFF);
+                __m256i r;
+
+                s_lo = _mm256_srli_epi16(_mm256_mullo_epi16(s_lo, _mm256_or_si256(a_lo, alpha_lane)), 8);
+                s_hi = _mm256_srli_epi16(_mm256_mullo_epi16(s_hi, _mm256_or_si256(a_hi, alpha_lane)), 8);
+                d_lo = _mm256_srli_epi16(_mm256_mullo_epi16(d_lo, _mm256_xor_si256(a_lo, inv)), 8);
+                d_hi = _mm256_srli_epi16(_mm256_mullo_epi16(d_hi, _mm256_xor_si256(a_hi, inv)), 8);
+                r = _mm256_packus_epi16(_mm256_add_epi16(s_lo, d_lo), _mm256_add_epi16(s_hi, d_hi));
+
+                r = _mm256_blendv_epi8(r, s, opaque);
+                r = _mm256_blendv_epi8(r, d, transparent);
+                _mm256_storeu_si256((__m256i *) dstp, r);
+            }
+            srcp += 8;
+            dstp += 8;
+            n -= 8;
+        }
+        while (n--) {
+            *dstp = BlendPixelAlpha8888(*srcp, *dstp);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast premultiplied ARGB8888->(A)RGB888 blending, 4 pixels at a time */
+static void SDL_TARGETING("sse4.1")
+BlitRGBtoRGBPremultipliedPixelAlphaSSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i amask = _mm_set1_epi32(0xFF000000);
+    const __m128i inv = _mm_set1_epi16(0xFF);
+    const __m128i one = _mm_set1_epi16(1);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+            __m128i opaque = _mm_cmpeq_epi32(_mm_and_si128(s, amask), amask);
+
+            if (_mm_movemask_epi8(opaque) == 0xFFFF) {
+                /* Fully opaque run, nothing to blend */
+                _mm_storeu_si128((__m128i *) dstp, s);
+            } else if (!_mm_testz_si128(s, s)) {
+                __m128i d = _mm_loadu_si128((const __m128i *) dstp);
+                __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+                __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+                __m128i ia_lo = _mm_xor_si128(_mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xFF), 0xFF), inv);
+                __m128i ia_hi = _mm_xor_si128(_mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xFF), 0xFF), inv);
+                __m128i d_lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), ia_lo);
+                __m128i d_hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), ia_hi);
+
+                /* Same exact division by 255 as DIV255() */
+                d_lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(d_lo, one), _mm_srli_epi16(d_lo, 8)), 8);
+                d_hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(d_hi, one), _mm_srli_epi16(d_hi, 8)), 8);
+                _mm_storeu_si128((__m128i *) dstp, _mm_adds_epu8(s, _mm_packus_epi16(d_lo, d_hi)));
+            }
+            srcp += 4;
+            dstp += 4;
+            n -= 4;
+        }
+        while (n--) {
+            *dstp = BlendPremultiplied8888(*srcp, *dstp);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast premultiplied ARGB8888->(A)RGB888 blending, 8 pixels at a time */
+static void SDL_TARGETING("avx2")
+BlitRGBtoRGBPremultipliedPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i amask = _mm256_set1_epi32(0xFF000000);
+    const __m256i inv = _mm256_set1_epi16(0xFF);
+    const __m256i one = _mm256_set1_epi16(1);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 8) {
+            __m256i s = _mm256_loadu_si256((const __m256i *) srcp);
+            __m256i opaque = _mm256_cmpeq_epi32(_mm256_and_si256(s, amask), amask);
+
+            if (_mm256_movemask_epi8(opaque) == -1) {
+                /* Fully opaque run, nothing to blend */
+                _mm256_storeu_si256((__m256i *) dstp, s);
+            } else if (!_mm256_testz_si256(s, s)) {
+                __m256i d = _mm256_loadu_si256((const __m256i *) dstp);
+                __m256i s_lo = _mm256_unpacklo_epi8(s, zero);
+                __m256i s_hi = _mm256_unpackhi_epi8(s, zero);
+                __m256i ia_lo = _mm256_xor_si256(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, 0xFF), 0xFF), inv);
+                __m256i ia_hi = _mm256_xor_si256(_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, 0xFF), 0xFF), inv);
+                __m256i d_lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), ia_lo);
+                __m256i d_hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), ia_hi);
+
+                /* Same exact division by 255 as DIV255() */
+                d_lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(d_lo, one), _mm256_srli_epi16(d_lo, 8)), 8);
+                d_hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(d_hi, one), _mm256_srli_epi16(d_hi, 8)), 8);
+                _mm256_storeu_si256((__m256i *) dstp, _mm256_adds_epu8(s, _mm256_packus_epi16(d_lo, d_hi)));
+            }
+            srcp += 8;
+            dstp += 8;
+            n -= 8;
+        }
+        while (n--) {
+            *dstp = BlendPremultiplied8888(*srcp, *dstp);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+#endif /* SDL_AVX2_BLITTERS */
+
 /* 16bpp special case for per-surface alpha=50%: blend 2 pixels in parallel */
 
 /* blend a single 16 bit pixel at 50% */
@@ -1270,6 +1569,7 @@ SDL_CalculateBlitA(SDL_Surface * surface)
 {
     SDL_PixelFormat *sf = surface->format;
     SDL_PixelFormat *df = surface->map->dst->format;
+    Uint32 features = SDL_GetBlitCPUFeatures();
 
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case SDL_COPY_BLEND:
@@ -1294,17 +1594,28 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             if (sf->Rmask == df->Rmask
                 && sf->Gmask == df->Gmask
                 && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+#if SDL_AVX2_BLITTERS
+                if (sf->Rshift % 8 == 0
+                    && sf->Gshift % 8 == 0
+                    && sf->Bshift % 8 == 0
+                    && sf->Amask == 0xff000000) {
+                    if (features & SDL_CPU_AVX2)
+                        return BlitRGBtoRGBPixelAlphaAVX2;
+                    if (features & SDL_CPU_SSE41)
+                        return BlitRGBtoRGBPixelAlphaSSE41;
+                }
+#endif /* SDL_AVX2_BLITTERS */
 #if defined(__MMX__) || defined(__3dNOW__)
                 if (sf->Rshift % 8 == 0
                     && sf->Gshift % 8 == 0
                     && sf->Bshift % 8 == 0
                     && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
 #ifdef __3dNOW__
-                    if (SDL_Has3DNow())
+                    if (features & SDL_CPU_3DNOW)
                         return BlitRGBtoRGBPixelAlphaMMX3DNOW;
 #endif
 #ifdef __MMX__
-                    if (SDL_HasMMX())
+                    if (features & SDL_CPU_MMX)
                         return BlitRGBtoRGBPixelAlphaMMX;
 #endif
                 }
@@ -1332,14 +1643,14 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                 if (surface->map->identity) {
                     if (df->Gmask == 0x7e0) {
 #ifdef __MMX__
-                        if (SDL_HasMMX())
+                        if (features & SDL_CPU_MMX)
                             return Blit565to565SurfaceAlphaMMX;
                         else
 #endif
                             return Blit565to565SurfaceAlpha;
                     } else if (df->Gmask == 0x3e0) {
 #ifdef __MMX__
-                        if (SDL_HasMMX())
+                        if (features & SDL_CPU_MMX)
                             return Blit555to555SurfaceAlphaMMX;
                         else
 #endif
@@ -1355,7 +1666,7 @@ SDL_CalculateBlitA(SDL_Surface * surface)
 #ifdef __MMX__
                     if (sf->Rshift % 8 == 0
                         && sf->Gshift % 8 == 0
-                        && sf->Bshift % 8 == 0 && SDL_HasMMX())
+                        && sf->Bshift % 8 == 0 && (features & SDL_CPU_MMX))
                         return BlitRGBtoRGBSurfaceAlphaMMX;
 #endif
                     if ((sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
@@ -1380,6 +1691,24 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             }
         }
         break;
+
+    case SDL_COPY_PREMULTIPLIED:
+        /* Premultiplied per-pixel alpha, everything else uses SDL_Blit_Slow() */
+        if (sf->BytesPerPixel == 4 && df->BytesPerPixel == 4
+            && sf->Amask == 0xff000000
+            && sf->Rmask == df->Rmask
+            && sf->Gmask == df->Gmask
+            && sf->Bmask == df->Bmask
+            && (sf->Rmask | sf->Gmask | sf->Bmask) == 0xffffff) {
+#if SDL_AVX2_BLITTERS
+            if (features & SDL_CPU_AVX2)
+                return BlitRGBtoRGBPremultipliedPixelAlphaAVX2;
+            if (features & SDL_CPU_SSE41)
+                return BlitRGBtoRGBPremultipliedPixelAlphaSSE41;
+#endif /* SDL_AVX2_BLITTERS */
+            return BlitRGBtoRGBPremultipliedPixelAlpha;
+        }
+        break;
     }
 
     return NULL;
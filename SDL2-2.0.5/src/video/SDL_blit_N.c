@@ -871,7 +871,7 @@ GetBlitFeatures(void)
 #endif
 #else
 /* Feature 1 is has-MMX */
-#define GetBlitFeatures() ((Uint32)(SDL_HasMMX() ? 1 : 0))
+#define GetBlitFeatures() ((Uint32)((SDL_GetBlitCPUFeatures() & SDL_CPU_MMX) ? 1 : 0))
 #endif
 
 /* This is now endian dependent */
@@ -2454,6 +2454,146 @@ BlitNto2101010(SDL_BlitInfo * info)
     }
 }
 
+#if SDL_AVX2_BLITTERS
+/* Work out the byte shuffle that converts one byte-aligned 32-bit format
+   into another: each destination byte names its source byte, or 0x80 to
+   clear it. Bits that can't come from the source end up in *fill. */
+static SDL_bool
+Get8888Swizzle(const SDL_PixelFormat * srcfmt, const SDL_PixelFormat * dstfmt,
+               Uint8 alpha, Uint8 shuffle[4], Uint32 * fill)
+{
+    if (srcfmt->BytesPerPixel != 4 || dstfmt->BytesPerPixel != 4) {
+        return SDL_FALSE;
+    }
+    if (srcfmt->Rloss || srcfmt->Gloss || srcfmt->Bloss ||
+        dstfmt->Rloss || dstfmt->Gloss || dstfmt->Bloss ||
+        (srcfmt->Rshift | srcfmt->Gshift | srcfmt->Bshift |
+         dstfmt->Rshift | dstfmt->Gshift | dstfmt->Bshift) % 8) {
+        return SDL_FALSE;
+    }
+    if ((srcfmt->Amask && (srcfmt->Aloss || srcfmt->Ashift % 8)) ||
+        (dstfmt->Amask && (dstfmt->Aloss || dstfmt->Ashift % 8))) {
+        return SDL_FALSE;
+    }
+
+    shuffle[0] = shuffle[1] = shuffle[2] = shuffle[3] = 0x80;
+    shuffle[dstfmt->Rshift / 8] = srcfmt->Rshift / 8;
+    shuffle[dstfmt->Gshift / 8] = srcfmt->Gshift / 8;
+    shuffle[dstfmt->Bshift / 8] = srcfmt->Bshift / 8;
+    *fill = 0;
+    if (dstfmt->Amask) {
+        if (srcfmt->Amask) {
+            shuffle[dstfmt->Ashift / 8] = srcfmt->Ashift / 8;
+        } else {
+            *fill = (Uint32) alpha << dstfmt->Ashift;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_INLINE Uint32
+Swizzle8888(Uint32 pixel, const Uint8 shuffle[4], Uint32 fill)
+{
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        if (!(shuffle[i] & 0x80)) {
+            fill |= ((pixel >> (shuffle[i] * 8)) & 0xFF) << (i * 8);
+        }
+    }
+    return fill;
+}
+
+/* 32-bit RGBA<->RGBA channel reorder with pshufb, 4 pixels at a time */
+static void SDL_TARGETING("sse4.1")
+Blit_8888_8888_SwizzleSSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 shuffle[4];
+    Uint32 fill;
+    __m128i mask, vfill;
+    int i;
+
+    Get8888Swizzle(info->src_fmt, info->dst_fmt, info->a, shuffle, &fill);
+    mask = _mm_setr_epi8(
+        shuffle[0], shuffle[1], shuffle[2], shuffle[3],
+        shuffle[0] | 4, shuffle[1] | 4, shuffle[2] | 4, shuffle[3] | 4,
+        shuffle[0] | 8, shuffle[1] | 8, shuffle[2] | 8, shuffle[3] | 8,
+        shuffle[0] | 12, shuffle[1] | 12, shuffle[2] | 12, shuffle[3] | 12);
+    vfill = _mm_set1_epi32(fill);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *) src);
+            s = _mm_or_si128(_mm_shuffle_epi8(s, mask), vfill);
+            _mm_storeu_si128((__m128i *) dst, s);
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        for (i = 0; i < n; ++i) {
+            *dst++ = Swizzle8888(*src++, shuffle, fill);
+        }
+        src = (Uint32 *) ((Uint8 *) src + srcskip);
+        dst = (Uint32 *) ((Uint8 *) dst + dstskip);
+    }
+}
+
+/* 32-bit RGBA<->RGBA channel reorder with vpshufb, 8 pixels at a time */
+static void SDL_TARGETING("avx2")
+Blit_8888_8888_SwizzleAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 shuffle[4];
+    Uint32 fill;
+    __m256i mask, vfill;
+    int i;
+
+    Get8888Swizzle(info->src_fmt, info->dst_fmt, info->a, shuffle, &fill);
+    /* vpshufb works within each 128-bit lane, so the pattern repeats */
+    mask = _mm256_setr_epi8(
+        shuffle[0], shuffle[1], shuffle[2], shuffle[3],
+        shuffle[0] | 4, shuffle[1] | 4, shuffle[2] | 4, shuffle[3] | 4,
+        shuffle[0] | 8, shuffle[1] | 8, shuffle[2] | 8, shuffle[3] | 8,
+        shuffle[0] | 12, shuffle[1] | 12, shuffle[2] | 12, shuffle[3] | 12,
+        shuffle[0], shuffle[1], shuffle[2], shuffle[3],
+        shuffle[0] | 4, shuffle[1] | 4, shuffle[2] | 4, shuffle[3] | 4,
+        shuffle[0] | 8, shuffle[1] | 8, shuffle[2] | 8, shuffle[3] | 8,
+        shuffle[0] | 12, shuffle[1] | 12, shuffle[2] | 12, shuffle[3] | 12);
+    vfill = _mm256_set1_epi32(fill);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 8) {
+            __m256i s = _mm256_loadu_si256((const __m256i *) src);
+            s = _mm256_or_si256(_mm256_shuffle_epi8(s, mask), vfill);
+            _mm256_storeu_si256((__m256i *) dst, s);
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        for (i = 0; i < n; ++i) {
+            *dst++ = Swizzle8888(*src++, shuffle, fill);
+        }
+        src = (Uint32 *) ((Uint8 *) src + srcskip);
+        dst = (Uint32 *) ((Uint8 *) dst + dstskip);
+    }
+}
+#endif /* SDL_AVX2_BLITTERS */
+
 /* Normal N to N optimized blitters */
 struct blit_table
 {
@@ -2604,6 +2744,23 @@ SDL_CalculateBlitN(SDL_Surface * surface)
                     blitfun = BlitNtoNCopyAlpha;
                 }
             }
+#if SDL_AVX2_BLITTERS
+            if (blitfun == BlitNtoN || blitfun == BlitNtoNCopyAlpha ||
+                blitfun == Blit4to4MaskAlpha) {
+                Uint32 features = SDL_GetBlitCPUFeatures();
+                Uint8 shuffle[4];
+                Uint32 fill;
+
+                if ((features & (SDL_CPU_AVX2 | SDL_CPU_SSE41)) &&
+                    Get8888Swizzle(srcfmt, dstfmt, 0xFF, shuffle, &fill)) {
+                    if (features & SDL_CPU_AVX2) {
+                        blitfun = Blit_8888_8888_SwizzleAVX2;
+                    } else {
+                        blitfun = Blit_8888_8888_SwizzleSSE41;
+                    }
+                }
+            }
+#endif /* SDL_AVX2_BLITTERS */
         }
         return (blitfun);
 
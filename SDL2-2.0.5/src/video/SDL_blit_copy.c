@@ -26,25 +26,41 @@
 
 
 #ifdef __SSE__
-/* This assumes 16-byte aligned src and dst */
+/* This assumes 16-byte aligned dst, src may be unaligned */
 static SDL_INLINE void
 SDL_memcpySSE(Uint8 * dst, const Uint8 * src, int len)
 {
     int i;
 
     __m128 values[4];
-    for (i = len / 64; i--;) {
-        _mm_prefetch(src, _MM_HINT_NTA);
-        values[0] = *(__m128 *) (src + 0);
-        values[1] = *(__m128 *) (src + 16);
-        values[2] = *(__m128 *) (src + 32);
-        values[3] = *(__m128 *) (src + 48);
-        _mm_stream_ps((float *) (dst + 0), values[0]);
-        _mm_stream_ps((float *) (dst + 16), values[1]);
-        _mm_stream_ps((float *) (dst + 32), values[2]);
-        _mm_stream_ps((float *) (dst + 48), values[3]);
-        src += 64;
-        dst += 64;
+    if (!((uintptr_t) src & 15)) {
+        for (i = len / 64; i--;) {
+            _mm_prefetch(src, _MM_HINT_NTA);
+            values[0] = *(__m128 *) (src + 0);
+            values[1] = *(__m128 *) (src + 16);
+            values[2] = *(__m128 *) (src + 32);
+            values[3] = *(__m128 *) (src + 48);
+            _mm_stream_ps((float *) (dst + 0), values[0]);
+            _mm_stream_ps((float *) (dst + 16), values[1]);
+            _mm_stream_ps((float *) (dst + 32), values[2]);
+            _mm_stream_ps((float *) (dst + 48), values[3]);
+            src += 64;
+            dst += 64;
+        }
+    } else {
+        for (i = len / 64; i--;) {
+            _mm_prefetch(src, _MM_HINT_NTA);
+            values[0] = _mm_loadu_ps((const float *) (src + 0));
+            values[1] = _mm_loadu_ps((const float *) (src + 16));
+            values[2] = _mm_loadu_ps((const float *) (src + 32));
+            values[3] = _mm_loadu_ps((const float *) (src + 48));
+            _mm_stream_ps((float *) (dst + 0), values[0]);
+            _mm_stream_ps((float *) (dst + 16), values[1]);
+            _mm_stream_ps((float *) (dst + 32), values[2]);
+            _mm_stream_ps((float *) (dst + 48), values[3]);
+            src += 64;
+            dst += 64;
+        }
     }
 
     if (len & 63)
@@ -128,14 +144,22 @@ SDL_BlitCopy(SDL_BlitInfo * info)
     }
 
 #ifdef __SSE__
-    if (SDL_HasSSE() &&
-        !((uintptr_t) src & 15) && !(srcskip & 15) &&
-        !((uintptr_t) dst & 15) && !(dstskip & 15)) {
+    /* Surfaces allocated by SDL start 64-byte aligned, so with a 16-byte
+       multiple pitch every row starts at the same alignment and the
+       leading bytes up to the first aligned dst address are the same
+       for each row. The src side may be misaligned relative to dst. */
+    if (SDL_HasSSE() && w >= 64 && !(dstskip & 15)) {
+        const int head = (int) ((16 - ((uintptr_t) dst & 15)) & 15);
+
         while (h--) {
-            SDL_memcpySSE(dst, src, w);
+            if (head) {
+                SDL_memcpy(dst, src, head);
+            }
+            SDL_memcpySSE(dst + head, src + head, w - head);
             src += srcskip;
             dst += dstskip;
         }
+        _mm_sfence();
         return;
     }
 #endif
@@ -0,0 +1,178 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_video.h"
+#include "SDL_endian.h"
+#include "SDL_blit.h"
+#include "SDL_blit_premultiply.h"
+
+/* Premultiplying rounds down like the straight alpha blitters in
+   SDL_Blit_Slow() do, so blitting premultiplied pixels with
+   SDL_BLENDMODE_PREMULTIPLIED matches blitting the originals with
+   SDL_BLENDMODE_BLEND there. */
+
+/* Exact x/255 for x <= 255*255 */
+#define DIV255(x)   (((x) + 1 + ((x) >> 8)) >> 8)
+
+typedef void (*SDL_PremultiplyFunc) (int width, int height, int alpha,
+                                     const Uint8 * src, int src_pitch,
+                                     Uint8 * dst, int dst_pitch);
+
+static void
+PremultiplyBytes(int width, int height, int alpha,
+                 const Uint8 * src, int src_pitch,
+                 Uint8 * dst, int dst_pitch)
+{
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n--) {
+            const unsigned a = s[alpha];
+            d[0] = (Uint8) DIV255(s[0] * a);
+            d[1] = (Uint8) DIV255(s[1] * a);
+            d[2] = (Uint8) DIV255(s[2] * a);
+            d[3] = (Uint8) DIV255(s[3] * a);
+            d[alpha] = (Uint8) a;
+            s += 4;
+            d += 4;
+        }
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+#if SDL_AVX2_BLITTERS
+/* pshufb, four pixels at a time. The alpha byte is multiplied like the
+   others and then put back from the source. */
+static void SDL_TARGETING("sse4.1")
+PremultiplySSE41(int width, int height, int alpha,
+                 const Uint8 * src, int src_pitch,
+                 Uint8 * dst, int dst_pitch)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i shuffle = _mm_add_epi8(_mm_set1_epi8((char) alpha),
+                                         _mm_set_epi8(12, 12, 12, 12, 8, 8, 8, 8,
+                                                      4, 4, 4, 4, 0, 0, 0, 0));
+    const __m128i amask = _mm_slli_epi32(_mm_set1_epi32(0xFF), alpha * 8);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n >= 4) {
+            __m128i p = _mm_loadu_si128((const __m128i *) s);
+            __m128i a = _mm_shuffle_epi8(p, shuffle);
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), _mm_unpacklo_epi8(a, zero));
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), _mm_unpackhi_epi8(a, zero));
+
+            lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one), _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one), _mm_srli_epi16(hi, 8)), 8);
+            _mm_storeu_si128((__m128i *) d, _mm_blendv_epi8(_mm_packus_epi16(lo, hi), p, amask));
+            s += 16;
+            d += 16;
+            n -= 4;
+        }
+        if (n) {
+            PremultiplyBytes(n, 1, alpha, s, 0, d, 0);
+        }
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+/* Same as PremultiplySSE41(), eight pixels at a time */
+static void SDL_TARGETING("avx2")
+PremultiplyAVX2(int width, int height, int alpha,
+                const Uint8 * src, int src_pitch,
+                Uint8 * dst, int dst_pitch)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i shuffle = _mm256_add_epi8(_mm256_set1_epi8((char) alpha),
+                                            _mm256_set_epi8(12, 12, 12, 12, 8, 8, 8, 8,
+                                                            4, 4, 4, 4, 0, 0, 0, 0,
+                                                            12, 12, 12, 12, 8, 8, 8, 8,
+                                                            4, 4, 4, 4, 0, 0, 0, 0));
+    const __m256i amask = _mm256_slli_epi32(_mm256_set1_epi32(0xFF), alpha * 8);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n >= 8) {
+            __m256i p = _mm256_loadu_si256((const __m256i *) s);
+            __m256i a = _mm256_shuffle_epi8(p, shuffle);
+            __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(p, zero), _mm256_unpacklo_epi8(a, zero));
+            __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(p, zero), _mm256_unpackhi_epi8(a, zero));
+
+            lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, one), _mm256_srli_epi16(lo, 8)), 8);
+            hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, one), _mm256_srli_epi16(hi, 8)), 8);
+            _mm256_storeu_si256((__m256i *) d, _mm256_blendv_epi8(_mm256_packus_epi16(lo, hi), p, amask));
+            s += 32;
+            d += 32;
+            n -= 8;
+        }
+        if (n) {
+            PremultiplyBytes(n, 1, alpha, s, 0, d, 0);
+        }
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+#endif /* SDL_AVX2_BLITTERS */
+
+void
+SDL_PremultiplyPixels8888(int width, int height, Uint32 format,
+                          const void * src, int src_pitch,
+                          void * dst, int dst_pitch)
+{
+    SDL_PremultiplyFunc func = PremultiplyBytes;
+    Uint32 features = SDL_GetBlitCPUFeatures();
+    Uint32 Rmask, Gmask, Bmask, Amask;
+    int bpp, alpha;
+
+    SDL_PixelFormatEnumToMasks(format, &bpp, &Rmask, &Gmask, &Bmask, &Amask);
+    alpha = (Amask == 0xFF000000) ? 3 : (Amask == 0x00FF0000) ? 2 :
+            (Amask == 0x0000FF00) ? 1 : 0;
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    alpha = 3 - alpha;
+#endif
+
+#if SDL_AVX2_BLITTERS
+    if (features & SDL_CPU_AVX2) {
+        func = PremultiplyAVX2;
+    } else if (features & SDL_CPU_SSE41) {
+        func = PremultiplySSE41;
+    }
+#endif
+    (void) features;
+
+    func(width, height, alpha, (const Uint8 *) src, src_pitch,
+         (Uint8 *) dst, dst_pitch);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -118,7 +118,8 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                     srcB = (srcB * srcA) / 255;
                 }
             }
-            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD)) {
+            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD |
+                             SDL_COPY_PREMULTIPLIED)) {
             case 0:
                 dstR = srcR;
                 dstG = srcG;
@@ -147,6 +148,19 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                 dstG = (srcG * dstG) / 255;
                 dstB = (srcB * dstB) / 255;
                 break;
+            case SDL_COPY_PREMULTIPLIED:
+                /* Color above alpha adds light, so it can overflow */
+                dstR = srcR + ((255 - srcA) * dstR) / 255;
+                if (dstR > 255)
+                    dstR = 255;
+                dstG = srcG + ((255 - srcA) * dstG) / 255;
+                if (dstG > 255)
+                    dstG = 255;
+                dstB = srcB + ((255 - srcA) * dstB) / 255;
+                if (dstB > 255)
+                    dstB = 255;
+                dstA = srcA + ((255 - srcA) * dstA) / 255;
+                break;
             }
             if (dst_fmt->Amask) {
                 ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, dstR, dstG, dstB, dstA);
@@ -0,0 +1,575 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_video.h"
+#include "SDL_endian.h"
+#include "SDL_blit.h"
+#include "SDL_blit_swizzle.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define SDL_NEON_SWIZZLE    1
+#include <arm_neon.h>
+#endif
+
+/* Direct kernels for the conversions SDL_ConvertPixels() sees most often:
+   32-bit channel reorders, 24 <-> 32 bit and 16-bit 565 <-> 32 bit. The output
+   matches what the blitter SDL_LowerBlit() picks for the pair would write:
+   a missing source alpha becomes opaque, unused destination bytes are zero
+   and 5/6 bit channels are expanded like SDL_expand_byte does. */
+
+enum
+{
+    SWIZZLE_8888_8888,
+    SWIZZLE_888_8888,
+    SWIZZLE_8888_888,
+    SWIZZLE_565_8888,
+    SWIZZLE_8888_565
+};
+
+typedef struct
+{
+    int kind;
+    int src_bytes;
+    int dst_bytes;
+    /* Destination byte i is source byte shuffle[i], or fill[i] if that is
+       0x80. A 16-bit 565 source counts as the three bytes R, G, B. */
+    Uint8 shuffle[4];
+    Uint8 fill[4];
+    /* Byte offsets of R, G and B on the 32-bit side of 565 conversions */
+    int src_rgb[3];
+    int dst_rgb[3];
+    /* Bit positions of red and blue on the 565 side */
+    int red_shift;
+    int blue_shift;
+} SDL_SwizzleInfo;
+
+typedef void (*SDL_SwizzleFunc) (const SDL_SwizzleInfo * info,
+                                 int width, int height,
+                                 const Uint8 * src, int src_pitch,
+                                 Uint8 * dst, int dst_pitch);
+
+/* Find the memory offset of each of R, G, B and A in a byte-aligned format,
+   or -1 for a channel the format doesn't have */
+static SDL_bool
+GetByteLayout(Uint32 format, int *bytes, int offset[4])
+{
+    Uint32 masks[4];
+    int bpp, i;
+
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format)) {
+        return SDL_FALSE;
+    }
+    *bytes = SDL_BYTESPERPIXEL(format);
+    if (*bytes != 3 && *bytes != 4) {
+        return SDL_FALSE;
+    }
+    if (!SDL_PixelFormatEnumToMasks(format, &bpp, &masks[0], &masks[1],
+                                    &masks[2], &masks[3])) {
+        return SDL_FALSE;
+    }
+    for (i = 0; i < 4; ++i) {
+        int shift = 0;
+
+        if (!masks[i]) {
+            offset[i] = -1;
+            continue;
+        }
+        while (!(masks[i] & (1u << shift))) {
+            ++shift;
+        }
+        if (masks[i] != (0xFFu << shift) || (shift % 8) != 0) {
+            return SDL_FALSE;
+        }
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        offset[i] = *bytes - 1 - shift / 8;
+#else
+        offset[i] = shift / 8;
+#endif
+    }
+    if (offset[0] < 0 || offset[1] < 0 || offset[2] < 0) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+Get565Layout(Uint32 format, int *red_shift, int *blue_shift)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_RGB565:
+        *red_shift = 11;
+        *blue_shift = 0;
+        return SDL_TRUE;
+    case SDL_PIXELFORMAT_BGR565:
+        *red_shift = 0;
+        *blue_shift = 11;
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+static void
+SetupShuffle(SDL_SwizzleInfo * info, const int src_offset[4], const int dst_offset[4])
+{
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        info->shuffle[i] = 0x80;
+        info->fill[i] = 0;
+    }
+    for (i = 0; i < 3; ++i) {
+        info->shuffle[dst_offset[i]] = (Uint8) src_offset[i];
+        info->src_rgb[i] = src_offset[i];
+        info->dst_rgb[i] = dst_offset[i];
+    }
+    if (dst_offset[3] >= 0) {
+        if (src_offset[3] >= 0) {
+            info->shuffle[dst_offset[3]] = (Uint8) src_offset[3];
+        } else {
+            info->fill[dst_offset[3]] = 0xFF;
+        }
+    }
+}
+
+static SDL_bool
+GetSwizzleInfo(Uint32 src_format, Uint32 dst_format, SDL_SwizzleInfo * info)
+{
+    static const int rgb565_offset[4] = { 0, 1, 2, -1 };
+    int src_offset[4], dst_offset[4];
+
+    if (GetByteLayout(src_format, &info->src_bytes, src_offset)) {
+        if (GetByteLayout(dst_format, &info->dst_bytes, dst_offset)) {
+            if (info->src_bytes == 4 && info->dst_bytes == 4) {
+                info->kind = SWIZZLE_8888_8888;
+            } else if (info->src_bytes == 3 && info->dst_bytes == 4) {
+                info->kind = SWIZZLE_888_8888;
+            } else if (info->src_bytes == 4 && info->dst_bytes == 3) {
+                info->kind = SWIZZLE_8888_888;
+            } else {
+                return SDL_FALSE;
+            }
+            SetupShuffle(info, src_offset, dst_offset);
+            return SDL_TRUE;
+        }
+        if (info->src_bytes == 4 &&
+            Get565Layout(dst_format, &info->red_shift, &info->blue_shift)) {
+            info->kind = SWIZZLE_8888_565;
+            info->dst_bytes = 2;
+            SetupShuffle(info, src_offset, rgb565_offset);
+            return SDL_TRUE;
+        }
+        return SDL_FALSE;
+    }
+
+    /* RGB565 sources already have the Blit_RGB565_32() lookup tables,
+       which beat expanding the channels arithmetically */
+    if (src_format != SDL_PIXELFORMAT_RGB565 &&
+        Get565Layout(src_format, &info->red_shift, &info->blue_shift) &&
+        GetByteLayout(dst_format, &info->dst_bytes, dst_offset) &&
+        info->dst_bytes == 4) {
+        info->kind = SWIZZLE_565_8888;
+        info->src_bytes = 2;
+        SetupShuffle(info, rgb565_offset, dst_offset);
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+/* Scalar rows, also used for the tails of the SIMD kernels */
+
+static void
+SwizzleBytesRow(const SDL_SwizzleInfo * info, const Uint8 * src, Uint8 * dst, int n)
+{
+    const int src_bytes = info->src_bytes;
+    const int dst_bytes = info->dst_bytes;
+
+    while (n--) {
+        Uint8 pixel[4];
+        int i;
+
+        /* Read the whole pixel first, the conversion may be in place */
+        pixel[0] = src[0];
+        pixel[1] = src[1];
+        pixel[2] = src[2];
+        pixel[3] = (src_bytes == 4) ? src[3] : 0;
+        for (i = 0; i < dst_bytes; ++i) {
+            dst[i] = (info->shuffle[i] & 0x80) ? info->fill[i] : pixel[info->shuffle[i]];
+        }
+        src += src_bytes;
+        dst += dst_bytes;
+    }
+}
+
+static void
+Swizzle565to8888Row(const SDL_SwizzleInfo * info, const Uint8 * src, Uint8 * dst, int n)
+{
+    const Uint16 *pixels = (const Uint16 *) src;
+
+    while (n--) {
+        Uint32 pixel = *pixels++;
+        Uint32 r = (pixel >> info->red_shift) & 0x1F;
+        Uint32 g = (pixel >> 5) & 0x3F;
+        Uint32 b = (pixel >> info->blue_shift) & 0x1F;
+        Uint8 rgb[3];
+        int i;
+
+        rgb[0] = SDL_expand_byte[3][r];
+        rgb[1] = SDL_expand_byte[2][g];
+        rgb[2] = SDL_expand_byte[3][b];
+        for (i = 0; i < 4; ++i) {
+            dst[i] = (info->shuffle[i] & 0x80) ? info->fill[i] : rgb[info->shuffle[i]];
+        }
+        dst += 4;
+    }
+}
+
+static void
+Swizzle8888to565Row(const SDL_SwizzleInfo * info, const Uint8 * src, Uint8 * dst, int n)
+{
+    Uint16 *pixels = (Uint16 *) dst;
+
+    while (n--) {
+        *pixels++ = (Uint16) (((src[info->src_rgb[0]] >> 3) << info->red_shift) |
+                              ((src[info->src_rgb[1]] >> 2) << 5) |
+                              ((src[info->src_rgb[2]] >> 3) << info->blue_shift));
+        src += 4;
+    }
+}
+
+static void
+SwizzleBytes(const SDL_SwizzleInfo * info, int width, int height,
+             const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    while (height--) {
+        SwizzleBytesRow(info, src, dst, width);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+static void
+Swizzle565to8888(const SDL_SwizzleInfo * info, int width, int height,
+                 const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    while (height--) {
+        Swizzle565to8888Row(info, src, dst, width);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+static void
+Swizzle8888to565(const SDL_SwizzleInfo * info, int width, int height,
+                 const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    while (height--) {
+        Swizzle8888to565Row(info, src, dst, width);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+#if SDL_AVX2_BLITTERS || SDL_NEON_SWIZZLE
+/* Build the table lookup for four pixels of a byte shuffle. Indices of
+   0x80 select zero for both pshufb and tbl. */
+static void
+GetShuffleMask(const SDL_SwizzleInfo * info, Uint8 mask[16], Uint8 fill[16])
+{
+    int p, i;
+
+    for (i = 0; i < 16; ++i) {
+        mask[i] = 0x80;
+        fill[i] = 0;
+    }
+    for (p = 0; p < 4; ++p) {
+        for (i = 0; i < info->dst_bytes; ++i) {
+            const int index = p * info->dst_bytes + i;
+            if (info->shuffle[i] & 0x80) {
+                fill[index] = info->fill[i];
+            } else {
+                mask[index] = (Uint8) (p * info->src_bytes + info->shuffle[i]);
+            }
+        }
+    }
+}
+
+/* Pixels that must remain in a row for a 16 byte load and store to stay
+   inside it, while only converting four of them */
+#define SWIZZLE_SAFE_PIXELS(info) \
+    ((info->src_bytes == 3 || info->dst_bytes == 3) ? 6 : 4)
+#endif /* SDL_AVX2_BLITTERS || SDL_NEON_SWIZZLE */
+
+#if SDL_AVX2_BLITTERS
+/* Byte shuffles with pshufb, four pixels at a time */
+static void SDL_TARGETING("sse4.1")
+SwizzleBytesSSE41(const SDL_SwizzleInfo * info, int width, int height,
+                  const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    const int safe = SWIZZLE_SAFE_PIXELS(info);
+    const int src_step = 4 * info->src_bytes;
+    const int dst_step = 4 * info->dst_bytes;
+    Uint8 mask_bytes[16], fill_bytes[16];
+    __m128i mask, fill;
+
+    GetShuffleMask(info, mask_bytes, fill_bytes);
+    mask = _mm_loadu_si128((const __m128i *) mask_bytes);
+    fill = _mm_loadu_si128((const __m128i *) fill_bytes);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n >= safe) {
+            __m128i pixels = _mm_loadu_si128((const __m128i *) s);
+            pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, mask), fill);
+            _mm_storeu_si128((__m128i *) d, pixels);
+            s += src_step;
+            d += dst_step;
+            n -= 4;
+        }
+        SwizzleBytesRow(info, s, d, n);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+/* 32-bit channel reorder with vpshufb, eight pixels at a time */
+static void SDL_TARGETING("avx2")
+Swizzle8888AVX2(const SDL_SwizzleInfo * info, int width, int height,
+                const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    Uint8 mask_bytes[16], fill_bytes[16];
+    __m256i mask, fill;
+
+    /* vpshufb works within each 128-bit lane, so the pattern repeats */
+    GetShuffleMask(info, mask_bytes, fill_bytes);
+    mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) mask_bytes));
+    fill = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) fill_bytes));
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n >= 8) {
+            __m256i pixels = _mm256_loadu_si256((const __m256i *) s);
+            pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), fill);
+            _mm256_storeu_si256((__m256i *) d, pixels);
+            s += 32;
+            d += 32;
+            n -= 8;
+        }
+        SwizzleBytesRow(info, s, d, n);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+static __m128i SDL_TARGETING("sse4.1")
+Expand565SSE41(__m128i pixels, const SDL_SwizzleInfo * info, __m128i fill)
+{
+    const __m128i mask5 = _mm_set1_epi32(0x1F);
+    const __m128i mask6 = _mm_set1_epi32(0x3F);
+    /* x * 255 / 31 and x * 255 / 63 rounded down, as in SDL_expand_byte */
+    const __m128i scale5 = _mm_set1_epi32(1053);
+    const __m128i scale6 = _mm_set1_epi32(4145);
+    __m128i r = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(info->red_shift)), mask5);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 5), mask6);
+    __m128i b = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(info->blue_shift)), mask5);
+
+    r = _mm_srli_epi32(_mm_madd_epi16(r, scale5), 7);
+    g = _mm_srli_epi32(_mm_madd_epi16(g, scale6), 10);
+    b = _mm_srli_epi32(_mm_madd_epi16(b, scale5), 7);
+    r = _mm_sll_epi32(r, _mm_cvtsi32_si128(info->dst_rgb[0] * 8));
+    g = _mm_sll_epi32(g, _mm_cvtsi32_si128(info->dst_rgb[1] * 8));
+    b = _mm_sll_epi32(b, _mm_cvtsi32_si128(info->dst_rgb[2] * 8));
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, fill));
+}
+
+/* 16-bit 565 to 32-bit, eight pixels at a time */
+static void SDL_TARGETING("sse4.1")
+Swizzle565to8888SSE41(const SDL_SwizzleInfo * info, int width, int height,
+                      const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    const __m128i zero = _mm_setzero_si128();
+    Uint8 mask_bytes[16], fill_bytes[16];
+    __m128i fill;
+
+    GetShuffleMask(info, mask_bytes, fill_bytes);
+    fill = _mm_loadu_si128((const __m128i *) fill_bytes);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n >= 8) {
+            __m128i pixels = _mm_loadu_si128((const __m128i *) s);
+            _mm_storeu_si128((__m128i *) d,
+                             Expand565SSE41(_mm_unpacklo_epi16(pixels, zero), info, fill));
+            _mm_storeu_si128((__m128i *) (d + 16),
+                             Expand565SSE41(_mm_unpackhi_epi16(pixels, zero), info, fill));
+            s += 16;
+            d += 32;
+            n -= 8;
+        }
+        Swizzle565to8888Row(info, s, d, n);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+
+static __m128i SDL_TARGETING("sse4.1")
+Pack565SSE41(__m128i pixels, const SDL_SwizzleInfo * info)
+{
+    const __m128i mask5 = _mm_set1_epi32(0xF8);
+    const __m128i mask6 = _mm_set1_epi32(0xFC);
+    __m128i r = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(info->src_rgb[0] * 8)), mask5);
+    __m128i g = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(info->src_rgb[1] * 8)), mask6);
+    __m128i b = _mm_and_si128(_mm_srl_epi32(pixels, _mm_cvtsi32_si128(info->src_rgb[2] * 8)), mask5);
+
+    r = _mm_srli_epi32(_mm_sll_epi32(r, _mm_cvtsi32_si128(info->red_shift)), 3);
+    g = _mm_slli_epi32(g, 3);
+    b = _mm_srli_epi32(_mm_sll_epi32(b, _mm_cvtsi32_si128(info->blue_shift)), 3);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+/* 32-bit to 16-bit 565, eight pixels at a time */
+static void SDL_TARGETING("sse4.1")
+Swizzle8888to565SSE41(const SDL_SwizzleInfo * info, int width, int height,
+                      const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n >= 8) {
+            __m128i lo = Pack565SSE41(_mm_loadu_si128((const __m128i *) s), info);
+            __m128i hi = Pack565SSE41(_mm_loadu_si128((const __m128i *) (s + 16)), info);
+            _mm_storeu_si128((__m128i *) d, _mm_packus_epi32(lo, hi));
+            s += 32;
+            d += 16;
+            n -= 8;
+        }
+        Swizzle8888to565Row(info, s, d, n);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+#endif /* SDL_AVX2_BLITTERS */
+
+#if SDL_NEON_SWIZZLE
+/* Byte shuffles with tbl, four pixels at a time */
+static void
+SwizzleBytesNEON(const SDL_SwizzleInfo * info, int width, int height,
+                 const Uint8 * src, int src_pitch, Uint8 * dst, int dst_pitch)
+{
+    const int safe = SWIZZLE_SAFE_PIXELS(info);
+    const int src_step = 4 * info->src_bytes;
+    const int dst_step = 4 * info->dst_bytes;
+    Uint8 mask_bytes[16], fill_bytes[16];
+    uint8x16_t mask, fill;
+
+    GetShuffleMask(info, mask_bytes, fill_bytes);
+    mask = vld1q_u8(mask_bytes);
+    fill = vld1q_u8(fill_bytes);
+
+    while (height--) {
+        const Uint8 *s = src;
+        Uint8 *d = dst;
+        int n = width;
+
+        while (n >= safe) {
+            uint8x16_t pixels = vld1q_u8(s);
+            vst1q_u8(d, vorrq_u8(vqtbl1q_u8(pixels, mask), fill));
+            s += src_step;
+            d += dst_step;
+            n -= 4;
+        }
+        SwizzleBytesRow(info, s, d, n);
+        src += src_pitch;
+        dst += dst_pitch;
+    }
+}
+#endif /* SDL_NEON_SWIZZLE */
+
+/* The first entry for a conversion that the CPU supports is used */
+static const struct
+{
+    int kind;
+    Uint32 cpu;
+    SDL_SwizzleFunc func;
+} SDL_swizzle_funcs[] = {
+#if SDL_AVX2_BLITTERS
+    /* pshufb is SSSE3, which every SSE4.1 processor has */
+    { SWIZZLE_8888_8888, SDL_CPU_AVX2, Swizzle8888AVX2 },
+    { SWIZZLE_8888_8888, SDL_CPU_SSE41, SwizzleBytesSSE41 },
+    { SWIZZLE_888_8888, SDL_CPU_SSE41, SwizzleBytesSSE41 },
+    { SWIZZLE_8888_888, SDL_CPU_SSE41, SwizzleBytesSSE41 },
+    { SWIZZLE_565_8888, SDL_CPU_SSE41, Swizzle565to8888SSE41 },
+    { SWIZZLE_8888_565, SDL_CPU_SSE41, Swizzle8888to565SSE41 },
+#endif
+#if SDL_NEON_SWIZZLE
+    { SWIZZLE_8888_8888, SDL_CPU_ANY, SwizzleBytesNEON },
+    { SWIZZLE_888_8888, SDL_CPU_ANY, SwizzleBytesNEON },
+    { SWIZZLE_8888_888, SDL_CPU_ANY, SwizzleBytesNEON },
+#endif
+    { SWIZZLE_8888_8888, SDL_CPU_ANY, SwizzleBytes },
+    { SWIZZLE_888_8888, SDL_CPU_ANY, SwizzleBytes },
+    { SWIZZLE_8888_888, SDL_CPU_ANY, SwizzleBytes },
+    { SWIZZLE_565_8888, SDL_CPU_ANY, Swizzle565to8888 },
+    { SWIZZLE_8888_565, SDL_CPU_ANY, Swizzle8888to565 }
+};
+
+SDL_bool
+SDL_SwizzlePixels(int width, int height,
+                  Uint32 src_format, const void * src, int src_pitch,
+                  Uint32 dst_format, void * dst, int dst_pitch)
+{
+    SDL_SwizzleInfo info;
+    Uint32 features;
+    int i;
+
+    if (width <= 0 || height <= 0) {
+        return SDL_FALSE;
+    }
+    if (!GetSwizzleInfo(src_format, dst_format, &info)) {
+        return SDL_FALSE;
+    }
+
+    features = SDL_GetBlitCPUFeatures();
+    for (i = 0; i < SDL_arraysize(SDL_swizzle_funcs); ++i) {
+        if (SDL_swizzle_funcs[i].kind == info.kind &&
+            (SDL_swizzle_funcs[i].cpu & features) == SDL_swizzle_funcs[i].cpu) {
+            SDL_swizzle_funcs[i].func(&info, width, height,
+                                      (const Uint8 *) src, src_pitch,
+                                      (Uint8 *) dst, dst_pitch);
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,281 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_thread.h"
+#include "SDL_blit_threads.h"
+
+/* Worker pool for splitting large software blits into row bands.
+
+   Every SDL_BlitInfo based blitter walks rows independently, so an
+   unscaled blit can be cut into horizontal bands that run concurrently.
+   The calling thread always works on bands too, and a blit that finds
+   the pool busy simply runs on the calling thread.
+ */
+
+#define SDL_MAX_BLIT_THREADS            64
+#define SDL_DEFAULT_BLIT_MIN_PIXELS     (256 * 256)
+#define SDL_MIN_BLIT_BAND_ROWS          8
+
+typedef struct
+{
+    SDL_BlitFunc func;
+    SDL_BlitInfo info;
+} SDL_BlitBand;
+
+static struct
+{
+    SDL_mutex *lock;
+    SDL_sem *work;
+    SDL_sem *done;
+    SDL_Thread *threads[SDL_MAX_BLIT_THREADS];
+    int num_threads;
+    int started_for;    /* The hint value the workers were started for */
+    SDL_bool quit;
+    SDL_BlitBand bands[SDL_MAX_BLIT_THREADS];
+    int num_bands;
+    SDL_atomic_t next_band;
+} SDL_blit_pool;
+
+static SDL_SpinLock SDL_blit_pool_lock;
+static SDL_bool SDL_blit_hints_watched = SDL_FALSE;
+static int SDL_blit_requested_threads = 0;
+static int SDL_blit_min_pixels = SDL_DEFAULT_BLIT_MIN_PIXELS;
+
+static void SDLCALL
+SDL_BlitThreadsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    int count = hint ? SDL_atoi(hint) : 0;
+
+    if (count > SDL_MAX_BLIT_THREADS) {
+        count = SDL_MAX_BLIT_THREADS;
+    }
+    SDL_blit_requested_threads = (count > 1) ? count : 0;
+}
+
+static void SDLCALL
+SDL_BlitThreadsMinPixelsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    int pixels = hint ? SDL_atoi(hint) : 0;
+
+    SDL_blit_min_pixels = (pixels > 0) ? pixels : SDL_DEFAULT_BLIT_MIN_PIXELS;
+}
+
+/* Claim and run bands until there are none left */
+static void
+SDL_RunBlitBands(void)
+{
+    for (;;) {
+        int band = SDL_AtomicAdd(&SDL_blit_pool.next_band, 1);
+        if (band >= SDL_blit_pool.num_bands) {
+            break;
+        }
+        SDL_blit_pool.bands[band].func(&SDL_blit_pool.bands[band].info);
+    }
+}
+
+static int SDLCALL
+SDL_BlitWorker(void *data)
+{
+    for (;;) {
+        SDL_SemWait(SDL_blit_pool.work);
+        if (SDL_blit_pool.quit) {
+            break;
+        }
+        SDL_RunBlitBands();
+        SDL_SemPost(SDL_blit_pool.done);
+    }
+    return 0;
+}
+
+/* Must be called with the pool lock held */
+static void
+SDL_StopBlitWorkers(void)
+{
+    int i;
+
+    SDL_blit_pool.quit = SDL_TRUE;
+    for (i = 0; i < SDL_blit_pool.num_threads; ++i) {
+        SDL_SemPost(SDL_blit_pool.work);
+    }
+    for (i = 0; i < SDL_blit_pool.num_threads; ++i) {
+        SDL_WaitThread(SDL_blit_pool.threads[i], NULL);
+        SDL_blit_pool.threads[i] = NULL;
+    }
+    SDL_blit_pool.num_threads = 0;
+    SDL_blit_pool.quit = SDL_FALSE;
+
+    /* Drain any wakeups that were never consumed */
+    while (SDL_SemTryWait(SDL_blit_pool.work) == 0) {
+        continue;
+    }
+}
+
+/* Must be called with the pool lock held */
+static void
+SDL_StartBlitWorkers(int count)
+{
+    while (SDL_blit_pool.num_threads < count) {
+        SDL_Thread *thread = SDL_CreateThread(SDL_BlitWorker, "SDLBlitWorker", NULL);
+        if (!thread) {
+            break;
+        }
+        SDL_blit_pool.threads[SDL_blit_pool.num_threads++] = thread;
+    }
+}
+
+static SDL_bool
+SDL_InitBlitPool(void)
+{
+    if (SDL_blit_hints_watched && (SDL_blit_pool.lock || !SDL_blit_requested_threads)) {
+        return SDL_blit_pool.lock ? SDL_TRUE : SDL_FALSE;
+    }
+
+    SDL_AtomicLock(&SDL_blit_pool_lock);
+    if (!SDL_blit_hints_watched) {
+        SDL_AddHintCallback(SDL_HINT_BLIT_THREADS, SDL_BlitThreadsChanged, NULL);
+        SDL_AddHintCallback(SDL_HINT_BLIT_THREADS_MIN_PIXELS, SDL_BlitThreadsMinPixelsChanged, NULL);
+        SDL_blit_hints_watched = SDL_TRUE;
+    }
+    if (SDL_blit_requested_threads && !SDL_blit_pool.lock) {
+        SDL_blit_pool.work = SDL_CreateSemaphore(0);
+        SDL_blit_pool.done = SDL_CreateSemaphore(0);
+        if (SDL_blit_pool.work && SDL_blit_pool.done) {
+            SDL_blit_pool.lock = SDL_CreateMutex();
+        }
+        if (!SDL_blit_pool.lock) {
+            if (SDL_blit_pool.work) {
+                SDL_DestroySemaphore(SDL_blit_pool.work);
+                SDL_blit_pool.work = NULL;
+            }
+            if (SDL_blit_pool.done) {
+                SDL_DestroySemaphore(SDL_blit_pool.done);
+                SDL_blit_pool.done = NULL;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&SDL_blit_pool_lock);
+
+    return SDL_blit_pool.lock ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_bool
+SDL_ParallelBlit(SDL_BlitFunc blit, const SDL_BlitInfo * info)
+{
+    const Uint8 *src_end, *dst_end;
+    int bands, rows, extra, y, i, workers;
+
+    /* Cheap rejections first, most blits are small */
+    if (info->dst_w != info->src_w || info->dst_h != info->src_h ||
+        info->dst_h < 2 * SDL_MIN_BLIT_BAND_ROWS) {
+        return SDL_FALSE;
+    }
+    if (!SDL_InitBlitPool() || !SDL_blit_requested_threads) {
+        return SDL_FALSE;
+    }
+    if ((Sint64) info->dst_w * info->dst_h < SDL_blit_min_pixels) {
+        return SDL_FALSE;
+    }
+
+    /* Bands of an in-place blit could read rows another band already wrote */
+    src_end = info->src + (size_t) info->src_h * info->src_pitch;
+    dst_end = info->dst + (size_t) info->dst_h * info->dst_pitch;
+    if (info->src < dst_end && info->dst < src_end) {
+        return SDL_FALSE;
+    }
+
+    /* Somebody else is using the pool, don't wait for them */
+    if (SDL_TryLockMutex(SDL_blit_pool.lock) != 0) {
+        return SDL_FALSE;
+    }
+
+    /* Only restart the workers when the hint changes; if fewer threads
+       could be made than asked for, go on with the ones we have. */
+    if (SDL_blit_pool.started_for != SDL_blit_requested_threads) {
+        SDL_StopBlitWorkers();
+        SDL_StartBlitWorkers(SDL_blit_requested_threads - 1);
+        SDL_blit_pool.started_for = SDL_blit_requested_threads;
+    }
+
+    bands = SDL_min(SDL_blit_pool.num_threads + 1, info->dst_h / SDL_MIN_BLIT_BAND_ROWS);
+    if (bands < 2) {
+        SDL_UnlockMutex(SDL_blit_pool.lock);
+        return SDL_FALSE;
+    }
+
+    rows = info->dst_h / bands;
+    extra = info->dst_h % bands;
+    y = 0;
+    for (i = 0; i < bands; ++i) {
+        SDL_BlitInfo band = *info;
+        int h = rows + (i < extra ? 1 : 0);
+
+        band.src = info->src + (size_t) y * info->src_pitch;
+        band.dst = info->dst + (size_t) y * info->dst_pitch;
+        band.src_h = h;
+        band.dst_h = h;
+        SDL_blit_pool.bands[i].func = blit;
+        SDL_blit_pool.bands[i].info = band;
+        y += h;
+    }
+    SDL_blit_pool.num_bands = bands;
+    SDL_AtomicSet(&SDL_blit_pool.next_band, 0);
+
+    workers = bands - 1;
+    for (i = 0; i < workers; ++i) {
+        SDL_SemPost(SDL_blit_pool.work);
+    }
+    SDL_RunBlitBands();
+    for (i = 0; i < workers; ++i) {
+        SDL_SemWait(SDL_blit_pool.done);
+    }
+
+    SDL_UnlockMutex(SDL_blit_pool.lock);
+    return SDL_TRUE;
+}
+
+void
+SDL_BlitThreadsQuit(void)
+{
+    if (SDL_blit_hints_watched) {
+        SDL_DelHintCallback(SDL_HINT_BLIT_THREADS, SDL_BlitThreadsChanged, NULL);
+        SDL_DelHintCallback(SDL_HINT_BLIT_THREADS_MIN_PIXELS, SDL_BlitThreadsMinPixelsChanged, NULL);
+        SDL_blit_hints_watched = SDL_FALSE;
+    }
+    if (SDL_blit_pool.lock) {
+        SDL_LockMutex(SDL_blit_pool.lock);
+        SDL_StopBlitWorkers();
+        SDL_blit_pool.started_for = 0;
+        SDL_UnlockMutex(SDL_blit_pool.lock);
+        SDL_DestroyMutex(SDL_blit_pool.lock);
+        SDL_DestroySemaphore(SDL_blit_pool.work);
+        SDL_DestroySemaphore(SDL_blit_pool.done);
+        SDL_blit_pool.lock = NULL;
+        SDL_blit_pool.work = NULL;
+        SDL_blit_pool.done = NULL;
+    }
+    SDL_blit_requested_threads = 0;
+    SDL_blit_min_pixels = SDL_DEFAULT_BLIT_MIN_PIXELS;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,37 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef _SDL_blit_threads_h
+#define _SDL_blit_threads_h
+
+#include "SDL_blit.h"
+
+/* Run an unscaled blit as row bands on the blit worker pool.
+   Returns SDL_FALSE if the blit should be run on the calling thread. */
+extern SDL_bool SDL_ParallelBlit(SDL_BlitFunc blit, const SDL_BlitInfo * info);
+
+/* Stop the worker threads, called from SDL_Quit() */
+extern void SDL_BlitThreadsQuit(void);
+
+#endif /* _SDL_blit_threads_h */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -22,7 +22,9 @@
 
 /* General (mostly internal) pixel/color manipulation routines for SDL */
 
+#include "SDL_atomic.h"
 #include "SDL_endian.h"
+#include "SDL_hints.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
@@ -482,17 +484,56 @@ SDL_MasksToPixelFormatEnum(int bpp, Uint32 Rmask, Uint32 Gmask, Uint32 Bmask,
     return SDL_PIXELFORMAT_UNKNOWN;
 }
 
-static SDL_PixelFormat *formats;
+/*
+ * RGB formats are shared by everyone asking for the same pixel format.
+ * The shared ones live in a small hash table with a few slots per bucket,
+ * so a lookup costs at most FORMAT_CACHE_SLOTS compares; a format whose
+ * bucket is full just isn't shared. Indexed formats are never shared, each
+ * of them owns the palette attached to it. The lock also covers the
+ * reference counts, surfaces get created and freed on any thread.
+ */
+#define FORMAT_CACHE_BITS       5
+#define FORMAT_CACHE_BUCKETS    (1 << FORMAT_CACHE_BITS)
+#define FORMAT_CACHE_SLOTS      4
+
+static SDL_PixelFormat *SDL_format_cache[FORMAT_CACHE_BUCKETS][FORMAT_CACHE_SLOTS];
+static SDL_SpinLock SDL_format_cache_lock;
+
+static SDL_PixelFormat **
+SDL_GetFormatCacheBucket(Uint32 pixel_format)
+{
+    return SDL_format_cache[(Uint32) (pixel_format * 0x9E3779B1u) >> (32 - FORMAT_CACHE_BITS)];
+}
+
+/* Must be called with the cache lock held */
+static SDL_PixelFormat *
+SDL_FindCachedFormat(SDL_PixelFormat ** bucket, Uint32 pixel_format)
+{
+    int i;
+
+    for (i = 0; i < FORMAT_CACHE_SLOTS; ++i) {
+        if (bucket[i] && bucket[i]->format == pixel_format) {
+            ++bucket[i]->refcount;
+            return bucket[i];
+        }
+    }
+    return NULL;
+}
 
 SDL_PixelFormat *
 SDL_AllocFormat(Uint32 pixel_format)
 {
-    SDL_PixelFormat *format;
+    SDL_PixelFormat **bucket = SDL_GetFormatCacheBucket(pixel_format);
+    SDL_PixelFormat *format, *cached;
+    const SDL_bool shared = SDL_ISPIXELFORMAT_INDEXED(pixel_format) ? SDL_FALSE : SDL_TRUE;
+    int i;
 
-    /* Look it up in our list of previously allocated formats */
-    for (format = formats; format; format = format->next) {
-        if (pixel_format == format->format) {
-            ++format->refcount;
+    /* Look it up in our table of previously allocated formats */
+    if (shared) {
+        SDL_AtomicLock(&SDL_format_cache_lock);
+        format = SDL_FindCachedFormat(bucket, pixel_format);
+        SDL_AtomicUnlock(&SDL_format_cache_lock);
+        if (format) {
             return format;
         }
     }
@@ -509,10 +550,23 @@ SDL_AllocFormat(Uint32 pixel_format)
         return NULL;
     }
 
-    if (!SDL_ISPIXELFORMAT_INDEXED(pixel_format)) {
-        /* Cache the RGB formats */
-        format->next = formats;
-        formats = format;
+    if (shared) {
+        /* Cache the RGB formats, unless another thread got there first */
+        SDL_AtomicLock(&SDL_format_cache_lock);
+        cached = SDL_FindCachedFormat(bucket, pixel_format);
+        if (!cached) {
+            for (i = 0; i < FORMAT_CACHE_SLOTS; ++i) {
+                if (!bucket[i]) {
+                    bucket[i] = format;
+                    break;
+                }
+            }
+        }
+        SDL_AtomicUnlock(&SDL_format_cache_lock);
+        if (cached) {
+            SDL_free(format);
+            return cached;
+        }
     }
     return format;
 }
@@ -585,27 +639,29 @@ SDL_InitFormat(SDL_PixelFormat * format, Uint32 pixel_format)
 void
 SDL_FreeFormat(SDL_PixelFormat *format)
 {
-    SDL_PixelFormat *prev;
+    SDL_PixelFormat **bucket;
+    int i;
 
     if (!format) {
         SDL_InvalidParamError("format");
         return;
     }
+
+    SDL_AtomicLock(&SDL_format_cache_lock);
     if (--format->refcount > 0) {
+        SDL_AtomicUnlock(&SDL_format_cache_lock);
         return;
     }
 
-    /* Remove this format from our list */
-    if (format == formats) {
-        formats = format->next;
-    } else if (formats) {
-        for (prev = formats; prev->next; prev = prev->next) {
-            if (prev->next == format) {
-                prev->next = format->next;
-                break;
-            }
+    /* Remove this format from our table */
+    bucket = SDL_GetFormatCacheBucket(format->format);
+    for (i = 0; i < FORMAT_CACHE_SLOTS; ++i) {
+        if (bucket[i] == format) {
+            bucket[i] = NULL;
+            break;
         }
     }
+    SDL_AtomicUnlock(&SDL_format_cache_lock);
 
     if (format->palette) {
         SDL_FreePalette(format->palette);
@@ -613,6 +669,312 @@ SDL_FreeFormat(SDL_PixelFormat *format)
     SDL_free(format);
 }
 
+/*
+ * Inverse colormaps, used by SDL_FindColor() for palettes that are searched
+ * a lot, like when mapping every pixel of an image with SDL_MapRGB().
+ *
+ * The RGB cube is split into cells, and each cell lists the palette entries
+ * that can be closest to some color in it, so a search only has to look at
+ * a handful of entries and still finds exactly the entry a full search would.
+ * SDL_Palette is part of the ABI, so the maps are kept here, keyed on the
+ * palette and its version; changing the colors without SDL_SetPaletteColors()
+ * or a version bump makes SDL_FindColor() results stale, like blit maps.
+ */
+#define INVERSE_MAP_BITS        4
+#define INVERSE_MAP_SIDE        (1 << INVERSE_MAP_BITS)
+#define INVERSE_MAP_SHIFT       (8 - INVERSE_MAP_BITS)
+#define INVERSE_MAP_CELLS       (INVERSE_MAP_SIDE * INVERSE_MAP_SIDE * INVERSE_MAP_SIDE)
+#define INVERSE_MAP_SLOTS       4
+
+/* Building a map costs about as much as this many full searches */
+#define INVERSE_MAP_THRESHOLD   4096
+
+/* The cells of a built map. The slot holds one reference and every search
+   holds another while it reads them, so searches run without the lock. */
+typedef struct
+{
+    SDL_atomic_t refcount;
+    Uint32 *cells;      /* INVERSE_MAP_CELLS + 1 offsets into candidates */
+    Uint8 *candidates;  /* palette indices, in increasing order per cell */
+} SDL_InverseTable;
+
+/* Everything but palette, searches and built is only touched with the
+   lock held. Those three are atomic, so that palettes that haven't been
+   searched often enough to get a map can be counted without the lock. */
+typedef struct
+{
+    void *palette;          /* SDL_Palette * */
+    SDL_Color *colors;
+    Uint32 version;
+    int ncolors;
+    SDL_atomic_t searches;
+    SDL_atomic_t built;
+    SDL_bool building;
+    Uint32 last_used;
+    SDL_InverseTable *table;
+} SDL_InverseMap;
+
+static SDL_InverseMap SDL_inverse_maps[INVERSE_MAP_SLOTS];
+static Uint32 SDL_inverse_map_clock;
+static int SDL_inverse_map_misses;
+static SDL_SpinLock SDL_inverse_map_lock;
+
+static void
+SDL_ReleaseInverseTable(SDL_InverseTable * table)
+{
+    if (table && SDL_AtomicDecRef(&table->refcount)) {
+        SDL_free(table->cells);
+        SDL_free(table->candidates);
+        SDL_free(table);
+    }
+}
+
+static void
+SDL_ResetInverseMap(SDL_InverseMap * map, SDL_Palette * pal)
+{
+    SDL_ReleaseInverseTable(map->table);
+    SDL_AtomicSetPtr(&map->palette, pal);
+    map->colors = pal ? pal->colors : NULL;
+    map->version = pal ? pal->version : 0;
+    map->ncolors = pal ? pal->ncolors : 0;
+    SDL_AtomicSet(&map->searches, 0);
+    SDL_AtomicSet(&map->built, 0);
+    map->building = SDL_FALSE;
+    map->last_used = SDL_inverse_map_clock;
+    map->table = NULL;
+}
+
+/* This walks every cell for every entry, so it runs without the lock */
+static int
+SDL_BuildInverseMap(SDL_Palette * pal, SDL_InverseTable ** table_out)
+{
+    /* squared distances along each axis between every span of cells and
+       every entry, the nearest and farthest point of the span */
+    Uint16 (*nearest)[INVERSE_MAP_SIDE][256];
+    Uint16 (*farthest)[INVERSE_MAP_SIDE][256];
+    Uint32 alpha[256], closest[256];
+    SDL_InverseTable *table;
+    Uint32 *cells;
+    Uint8 *candidates;
+    size_t count = 0, size = INVERSE_MAP_CELLS * 8;
+    int ncolors = SDL_min(pal->ncolors, 256);
+    int c, i, cell, r, g, b;
+
+    nearest = SDL_malloc(2 * 3 * sizeof(*nearest));
+    table = (SDL_InverseTable *) SDL_malloc(sizeof(*table));
+    cells = (Uint32 *) SDL_malloc((INVERSE_MAP_CELLS + 1) * sizeof(*cells));
+    candidates = (Uint8 *) SDL_malloc(size);
+    if (!nearest || !table || !cells || !candidates) {
+        SDL_free(nearest);
+        SDL_free(table);
+        SDL_free(cells);
+        SDL_free(candidates);
+        return SDL_OutOfMemory();
+    }
+    farthest = nearest + 3;
+
+    for (i = 0; i < ncolors; ++i) {
+        const int ad = pal->colors[i].a - SDL_ALPHA_OPAQUE;
+
+        alpha[i] = ad * ad;
+        for (c = 0; c < 3; ++c) {
+            const int v = (c == 0) ? pal->colors[i].r :
+                          (c == 1) ? pal->colors[i].g : pal->colors[i].b;
+
+            for (cell = 0; cell < INVERSE_MAP_SIDE; ++cell) {
+                const int lo = cell << INVERSE_MAP_SHIFT;
+                const int hi = lo + (1 << INVERSE_MAP_SHIFT) - 1;
+                const int d = (v < lo) ? (lo - v) : (v > hi) ? (v - hi) : 0;
+                const int f = SDL_max(v - lo, hi - v);
+                nearest[c][cell][i] = (Uint16) (d * d);
+                farthest[c][cell][i] = (Uint16) (f * f);
+            }
+        }
+    }
+
+    cell = 0;
+    for (r = 0; r < INVERSE_MAP_SIDE; ++r) {
+        for (g = 0; g < INVERSE_MAP_SIDE; ++g) {
+            for (b = 0; b < INVERSE_MAP_SIDE; ++b) {
+                /* Every color in the cell is at most this far from some entry,
+                   so entries that can't get closer than that never win */
+                Uint32 bound = ~0u;
+
+                for (i = 0; i < ncolors; ++i) {
+                    const Uint32 worst = farthest[0][r][i] + farthest[1][g][i] +
+                                         farthest[2][b][i] + alpha[i];
+                    closest[i] = nearest[0][r][i] + nearest[1][g][i] +
+                                 nearest[2][b][i] + alpha[i];
+                    bound = SDL_min(bound, worst);
+                }
+
+                if (count + ncolors > size) {
+                    Uint8 *bigger;
+
+                    size *= 2;
+                    bigger = (Uint8 *) SDL_realloc(candidates, size);
+                    if (!bigger) {
+                        SDL_free(nearest);
+                        SDL_free(table);
+                        SDL_free(cells);
+                        SDL_free(candidates);
+                        return SDL_OutOfMemory();
+                    }
+                    candidates = bigger;
+                }
+                cells[cell++] = (Uint32) count;
+                for (i = 0; i < ncolors; ++i) {
+                    if (closest[i] <= bound) {
+                        candidates[count++] = (Uint8) i;
+                    }
+                }
+            }
+        }
+    }
+    cells[cell] = (Uint32) count;
+    SDL_free(nearest);
+
+    SDL_AtomicSet(&table->refcount, 1);
+    table->cells = cells;
+    table->candidates = candidates;
+    *table_out = table;
+    return 0;
+}
+
+/* Count a full search of a palette that doesn't have a map yet. Returns
+   SDL_TRUE while that stays below the threshold, without taking the lock. */
+static SDL_bool
+SDL_CountPaletteSearch(SDL_Palette * pal)
+{
+    int i;
+
+    for (i = 0; i < INVERSE_MAP_SLOTS; ++i) {
+        SDL_InverseMap *map = &SDL_inverse_maps[i];
+
+        if (SDL_AtomicGetPtr(&map->palette) == pal) {
+            return (!SDL_AtomicGet(&map->built) &&
+                    SDL_AtomicIncRef(&map->searches) + 1 < INVERSE_MAP_THRESHOLD);
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Must be called with the inverse map lock held. A palette without a slot
+   only takes one over after about as many searches as went into the slot
+   it replaces, the one with the fewest searches and no map yet if there is
+   one. That way more palettes than slots in turn still get maps, and don't
+   keep throwing built ones away. */
+static SDL_InverseMap *
+SDL_FindInverseMapSlot(SDL_Palette * pal)
+{
+    SDL_InverseMap *victim = NULL;
+    int cost = INVERSE_MAP_THRESHOLD;
+    int i;
+
+    for (i = 0; i < INVERSE_MAP_SLOTS; ++i) {
+        SDL_InverseMap *map = &SDL_inverse_maps[i];
+
+        if (map->palette == pal) {
+            return map;
+        }
+        if (!map->table) {
+            const int searches = SDL_AtomicGet(&map->searches);
+
+            if (searches < cost) {
+                victim = map;
+                cost = searches;
+            }
+        } else if (cost == INVERSE_MAP_THRESHOLD &&
+                   (!victim || map->last_used - victim->last_used > 0x80000000u)) {
+            /* The least recently used of the built maps */
+            victim = map;
+        }
+    }
+
+    if (!victim || SDL_inverse_map_misses < cost) {
+        ++SDL_inverse_map_misses;
+        return NULL;
+    }
+    SDL_inverse_map_misses = 0;
+    SDL_ResetInverseMap(victim, pal);
+    return victim;
+}
+
+/* Must be called with the inverse map lock held. Returns the map with a
+   reference for the caller, or NULL if the palette should be searched in
+   full instead; *build is set if the caller should build the map and
+   publish it with SDL_PublishInverseMap(). */
+static SDL_InverseTable *
+SDL_GetInverseMap(SDL_Palette * pal, SDL_bool * build)
+{
+    SDL_InverseMap *map = SDL_FindInverseMapSlot(pal);
+
+    if (!map) {
+        return NULL;
+    }
+    if (map->version != pal->version || map->colors != pal->colors ||
+        map->ncolors != pal->ncolors) {
+        SDL_ResetInverseMap(map, pal);
+    }
+    map->last_used = ++SDL_inverse_map_clock;
+
+    if (!map->table) {
+        if (SDL_AtomicIncRef(&map->searches) + 1 >= INVERSE_MAP_THRESHOLD &&
+            !map->building) {
+            map->building = SDL_TRUE;
+            *build = SDL_TRUE;
+        }
+        return NULL;
+    }
+    SDL_AtomicIncRef(&map->table->refcount);
+    return map->table;
+}
+
+/* Must be called with the inverse map lock held. The map is dropped if the
+   palette was changed or evicted while it was being built. Returns it with
+   a reference for the caller, like SDL_GetInverseMap(). */
+static SDL_InverseTable *
+SDL_PublishInverseMap(SDL_Palette * pal, SDL_Color * colors, Uint32 version,
+                      int ncolors, SDL_InverseTable * table)
+{
+    int i;
+
+    for (i = 0; i < INVERSE_MAP_SLOTS; ++i) {
+        SDL_InverseMap *map = &SDL_inverse_maps[i];
+
+        if (map->palette == pal && map->building && !map->table &&
+            map->colors == colors && map->version == version &&
+            map->ncolors == ncolors) {
+            map->building = SDL_FALSE;
+            if (!table) {
+                SDL_AtomicSet(&map->searches, 0);  /* out of memory, try again later */
+                return NULL;
+            }
+            map->table = table;
+            SDL_AtomicSet(&map->built, 1);
+            SDL_AtomicIncRef(&table->refcount);
+            return table;
+        }
+    }
+    SDL_ReleaseInverseTable(table);
+    return NULL;
+}
+
+/* Forget any inverse map of a palette that is going away */
+static void
+SDL_FreeInverseMap(SDL_Palette * pal)
+{
+    int i;
+
+    SDL_AtomicLock(&SDL_inverse_map_lock);
+    for (i = 0; i < INVERSE_MAP_SLOTS; ++i) {
+        if (SDL_inverse_maps[i].palette == pal) {
+            SDL_ResetInverseMap(&SDL_inverse_maps[i], NULL);
+        }
+    }
+    SDL_AtomicUnlock(&SDL_inverse_map_lock);
+}
+
 SDL_Palette *
 SDL_AllocPalette(int ncolors)
 {
@@ -709,6 +1071,7 @@ SDL_FreePalette(SDL_Palette * palette)
     if (--palette->refcount > 0) {
         return;
     }
+    SDL_FreeInverseMap(palette);
     SDL_free(palette->colors);
     SDL_free(palette);
 }
@@ -741,6 +1104,9 @@ SDL_DitherColors(SDL_Color * colors, int bpp)
     }
 }
 
+/* Pixels allocated by SDL start on a cache line, which is also enough for AVX */
+#define SDL_SURFACE_ALIGNMENT   64
+
 /*
  * Calculate the pad-aligned scanline width of a surface
  */
@@ -761,25 +1127,56 @@ SDL_CalculatePitch(SDL_Surface * surface)
     default:
         break;
     }
-    pitch = (pitch + 3) & ~3;   /* 4-byte aligning */
+    if (SDL_GetHintBoolean(SDL_HINT_SURFACE_ALIGNED_PITCH, SDL_FALSE)) {
+        pitch = (pitch + SDL_SURFACE_ALIGNMENT - 1) & ~(SDL_SURFACE_ALIGNMENT - 1);
+    } else {
+        pitch = (pitch + 3) & ~3;   /* 4-byte aligning */
+    }
     return (pitch);
 }
 
 /*
- * Match an RGB value to a particular palette index
+ * Allocate surface pixels on an SDL_SURFACE_ALIGNMENT boundary, the
+ * original pointer is kept just in front of the returned block.
  */
-Uint8
-SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+void *
+SDL_AllocSurfacePixels(size_t size)
+{
+    Uint8 *memory, *pixels;
+
+    memory = (Uint8 *) SDL_malloc(size + SDL_SURFACE_ALIGNMENT + sizeof(void *));
+    if (!memory) {
+        return NULL;
+    }
+    pixels = memory + sizeof(void *);
+    pixels += (SDL_SURFACE_ALIGNMENT - ((uintptr_t) pixels & (SDL_SURFACE_ALIGNMENT - 1))) & (SDL_SURFACE_ALIGNMENT - 1);
+    ((void **) pixels)[-1] = memory;
+    return pixels;
+}
+
+void
+SDL_FreeSurfacePixels(void *pixels)
+{
+    if (pixels) {
+        SDL_free(((void **) pixels)[-1]);
+    }
+}
+
+/* Search some palette entries, or all of them if indices is NULL */
+static Uint8
+SDL_FindColorIn(SDL_Palette * pal, const Uint8 * indices, int count,
+                Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     /* Do colorspace distance matching */
     unsigned int smallest;
     unsigned int distance;
     int rd, gd, bd, ad;
-    int i;
+    int i, k;
     Uint8 pixel = 0;
 
     smallest = ~0;
-    for (i = 0; i < pal->ncolors; ++i) {
+    for (k = 0; k < count; ++k) {
+        i = indices ? indices[k] : k;
         rd = pal->colors[i].r - r;
         gd = pal->colors[i].g - g;
         bd = pal->colors[i].b - b;
@@ -796,6 +1193,49 @@ SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     return (pixel);
 }
 
+/*
+ * Match an RGB value to a particular palette index
+ */
+Uint8
+SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    /* The inverse maps only cover opaque colors, which is what SDL_MapRGB() asks for */
+    if (a == SDL_ALPHA_OPAQUE && pal->ncolors > 0 && pal->ncolors <= 256 &&
+        !SDL_CountPaletteSearch(pal)) {
+        SDL_InverseTable *table;
+        SDL_bool build = SDL_FALSE;
+
+        /* The lock is only held to find the map and take a reference */
+        SDL_AtomicLock(&SDL_inverse_map_lock);
+        table = SDL_GetInverseMap(pal, &build);
+        if (build) {
+            SDL_Color *colors = pal->colors;
+            const Uint32 version = pal->version;
+            const int ncolors = pal->ncolors;
+
+            SDL_AtomicUnlock(&SDL_inverse_map_lock);
+            SDL_BuildInverseMap(pal, &table);
+            SDL_AtomicLock(&SDL_inverse_map_lock);
+            table = SDL_PublishInverseMap(pal, colors, version, ncolors, table);
+        }
+        SDL_AtomicUnlock(&SDL_inverse_map_lock);
+
+        if (table) {
+            const int cell = ((r >> INVERSE_MAP_SHIFT) << (2 * INVERSE_MAP_BITS)) |
+                             ((g >> INVERSE_MAP_SHIFT) << INVERSE_MAP_BITS) |
+                             (b >> INVERSE_MAP_SHIFT);
+            const Uint32 first = table->cells[cell];
+            const Uint8 pixel = SDL_FindColorIn(pal, table->candidates + first,
+                                                (int) (table->cells[cell + 1] - first),
+                                                r, g, b, a);
+
+            SDL_ReleaseInverseTable(table);
+            return pixel;
+        }
+    }
+    return SDL_FindColorIn(pal, NULL, pal->ncolors, r, g, b, a);
+}
+
 /* Find the opaque pixel value corresponding to an RGB triple */
 Uint32
 SDL_MapRGB(const SDL_PixelFormat * format, Uint8 r, Uint8 g, Uint8 b)
@@ -996,11 +1436,9 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     SDL_PixelFormat *dstfmt;
     SDL_BlitMap *map;
 
-    /* Clear out any previous mapping */
+    /* Clear out any previous mapping, SDL_CalculateBlit() decides whether
+       an RLE encoding can be kept */
     map = src->map;
-    if ((src->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
-        SDL_UnRLESurface(src, 1);
-    }
     SDL_InvalidateMap(map);
 
     /* Figure out what kind of mapping we're doing */
@@ -35,6 +35,8 @@ extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
 /* Miscellaneous functions */
 extern int SDL_CalculatePitch(SDL_Surface * surface);
+extern void *SDL_AllocSurfacePixels(size_t size);
+extern void SDL_FreeSurfacePixels(void *pixels);
 extern void SDL_DitherColors(SDL_Color * colors, int bpp);
 extern Uint8 SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 
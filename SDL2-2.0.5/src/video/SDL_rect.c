@@ -22,7 +22,14 @@
 
 #include "SDL_rect.h"
 #include "SDL_rect_c.h"
+#include "SDL_cpuinfo.h"
 
+#if defined(__SSE2__)
+#define SDL_SSE2_RECTS  1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define SDL_NEON_RECTS  1
+#include <arm_neon.h>
+#endif
 
 SDL_bool
 SDL_HasIntersection(const SDL_Rect * A, const SDL_Rect * B)
@@ -290,6 +297,245 @@ SDL_EnclosePoints(const SDL_Point * points, int count, const SDL_Rect * clip,
     return SDL_TRUE;
 }
 
+/* Batched clipping and culling.
+
+   The vector versions handle one rectangle (or two points) per iteration
+   and compact the visible ones with an unconditional store followed by a
+   conditional advance of the output index, so there is no branch on the
+   visibility of each item. The output never gets ahead of the input, which
+   lets the result array be the same as the source array.
+ */
+
+#if !SDL_SSE2_RECTS && !SDL_NEON_RECTS
+static int
+SDL_ClipRectsScalar(const SDL_Rect * rects, int count, const SDL_Rect * clip,
+                    SDL_Rect * result, SDL_bool cull)
+{
+    const int clip_x1 = clip->x;
+    const int clip_y1 = clip->y;
+    const int clip_x2 = clip->x + clip->w;
+    const int clip_y2 = clip->y + clip->h;
+    int i, n = 0;
+
+    for (i = 0; i < count; ++i) {
+        const SDL_Rect rect = rects[i];
+        const int x1 = SDL_max(rect.x, clip_x1);
+        const int y1 = SDL_max(rect.y, clip_y1);
+        const int x2 = SDL_min(rect.x + rect.w, clip_x2);
+        const int y2 = SDL_min(rect.y + rect.h, clip_y2);
+
+        if (x2 <= x1 || y2 <= y1) {
+            continue;
+        }
+        if (cull) {
+            result[n] = rect;
+        } else {
+            result[n].x = x1;
+            result[n].y = y1;
+            result[n].w = x2 - x1;
+            result[n].h = y2 - y1;
+        }
+        ++n;
+    }
+    return n;
+}
+#endif
+
+#if SDL_SSE2_RECTS
+static int
+SDL_ClipRectsSSE2(const SDL_Rect * rects, int count, const SDL_Rect * clip,
+                  SDL_Rect * result, SDL_bool cull)
+{
+    /* Negating the far edges turns both min() and max() into one max() */
+    const __m128i negate_hi = _mm_set_epi32(-1, -1, 0, 0);
+    const __m128i bounds = _mm_set_epi32(-(clip->y + clip->h), -(clip->x + clip->w),
+                                         clip->y, clip->x);
+    int i, n = 0;
+
+    for (i = 0; i < count; ++i) {
+        const __m128i rect = _mm_loadu_si128((const __m128i *) &rects[i]);
+        /* x, y, x + w, y + h */
+        __m128i edges = _mm_add_epi32(rect, _mm_slli_si128(rect, 8));
+        __m128i greater, clipped, sizes;
+
+        /* x, y, -(x + w), -(y + h) clamped to the clip rect */
+        edges = _mm_sub_epi32(_mm_xor_si128(edges, negate_hi), negate_hi);
+        greater = _mm_cmpgt_epi32(edges, bounds);
+        edges = _mm_or_si128(_mm_and_si128(greater, edges),
+                             _mm_andnot_si128(greater, bounds));
+
+        /* The upper lanes now hold -w and -h of the clipped rectangle */
+        sizes = _mm_add_epi32(edges, _mm_shuffle_epi32(edges, _MM_SHUFFLE(1, 0, 3, 2)));
+        if (cull) {
+            clipped = rect;
+        } else {
+            clipped = _mm_castpd_si128(_mm_move_sd(_mm_castsi128_pd(sizes),
+                                                   _mm_castsi128_pd(edges)));
+            clipped = _mm_sub_epi32(_mm_xor_si128(clipped, negate_hi), negate_hi);
+        }
+        _mm_storeu_si128((__m128i *) &result[n], clipped);
+        n += ((_mm_movemask_ps(_mm_castsi128_ps(sizes)) & 0xC) == 0xC);
+    }
+    return n;
+}
+
+static int
+SDL_ClipPointsSSE2(const SDL_Point * points, int count, const SDL_Rect * clip,
+                   SDL_Point * result)
+{
+    const __m128i minimum = _mm_set_epi32(clip->y, clip->x, clip->y, clip->x);
+    const __m128i maximum = _mm_set_epi32(clip->y + clip->h - 1, clip->x + clip->w - 1,
+                                          clip->y + clip->h - 1, clip->x + clip->w - 1);
+    int i, n = 0;
+
+    for (i = 0; i + 2 <= count; i += 2) {
+        const __m128i pair = _mm_loadu_si128((const __m128i *) &points[i]);
+        const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(pair, minimum),
+                                             _mm_cmpgt_epi32(pair, maximum));
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(outside));
+
+        _mm_storel_epi64((__m128i *) &result[n], pair);
+        n += ((mask & 0x3) == 0);
+        _mm_storel_epi64((__m128i *) &result[n], _mm_srli_si128(pair, 8));
+        n += ((mask & 0xC) == 0);
+    }
+    if (i < count && SDL_PointInRect(&points[i], clip)) {
+        result[n++] = points[i];
+    }
+    return n;
+}
+#endif /* SDL_SSE2_RECTS */
+
+#if SDL_NEON_RECTS
+static int
+SDL_ClipRectsNEON(const SDL_Rect * rects, int count, const SDL_Rect * clip,
+                  SDL_Rect * result, SDL_bool cull)
+{
+    const int32x2_t zero = vdup_n_s32(0);
+    int32x2_t minimum = vdup_n_s32(clip->x);
+    int32x2_t maximum = vdup_n_s32(clip->x + clip->w);
+    int i, n = 0;
+
+    minimum = vset_lane_s32(clip->y, minimum, 1);
+    maximum = vset_lane_s32(clip->y + clip->h, maximum, 1);
+
+    for (i = 0; i < count; ++i) {
+        const int32x4_t rect = vld1q_s32((const int32_t *) &rects[i]);
+        const int32x2_t origin = vget_low_s32(rect);
+        const int32x2_t x1y1 = vmax_s32(origin, minimum);
+        const int32x2_t x2y2 = vmin_s32(vadd_s32(origin, vget_high_s32(rect)), maximum);
+        const int32x2_t sizes = vsub_s32(x2y2, x1y1);
+        const uint64_t visible = vget_lane_u64(vreinterpret_u64_u32(vcgt_s32(sizes, zero)), 0);
+
+        vst1q_s32((int32_t *) &result[n], cull ? rect : vcombine_s32(x1y1, sizes));
+        n += (visible == ~(uint64_t) 0);
+    }
+    return n;
+}
+
+static int
+SDL_ClipPointsNEON(const SDL_Point * points, int count, const SDL_Rect * clip,
+                   SDL_Point * result)
+{
+    int32x2_t minimum = vdup_n_s32(clip->x);
+    int32x2_t maximum = vdup_n_s32(clip->x + clip->w - 1);
+    int i, n = 0;
+
+    minimum = vset_lane_s32(clip->y, minimum, 1);
+    maximum = vset_lane_s32(clip->y + clip->h - 1, maximum, 1);
+
+    for (i = 0; i < count; ++i) {
+        const int32x2_t point = vld1_s32((const int32_t *) &points[i]);
+        const uint32x2_t inside = vand_u32(vcge_s32(point, minimum), vcle_s32(point, maximum));
+
+        vst1_s32((int32_t *) &result[n], point);
+        n += (vget_lane_u64(vreinterpret_u64_u32(inside), 0) == ~(uint64_t) 0);
+    }
+    return n;
+}
+#endif /* SDL_NEON_RECTS */
+
+static int
+SDL_ClipRects(const SDL_Rect * rects, int count, const SDL_Rect * clip,
+              SDL_Rect * result, SDL_bool cull)
+{
+    if (!rects) {
+        return SDL_InvalidParamError("rects");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    if (!clip) {
+        return SDL_InvalidParamError("clip");
+    }
+    if (!result) {
+        return SDL_InvalidParamError("result");
+    }
+    if (SDL_RectEmpty(clip)) {
+        return 0;
+    }
+
+#if SDL_SSE2_RECTS
+    return SDL_ClipRectsSSE2(rects, count, clip, result, cull);
+#elif SDL_NEON_RECTS
+    return SDL_ClipRectsNEON(rects, count, clip, result, cull);
+#else
+    return SDL_ClipRectsScalar(rects, count, clip, result, cull);
+#endif
+}
+
+int
+SDL_IntersectRects(const SDL_Rect * rects, int count, const SDL_Rect * clip,
+                   SDL_Rect * result)
+{
+    return SDL_ClipRects(rects, count, clip, result, SDL_FALSE);
+}
+
+int
+SDL_CullRects(const SDL_Rect * rects, int count, const SDL_Rect * clip,
+              SDL_Rect * result)
+{
+    return SDL_ClipRects(rects, count, clip, result, SDL_TRUE);
+}
+
+int
+SDL_ClipPoints(const SDL_Point * points, int count, const SDL_Rect * clip,
+               SDL_Point * result)
+{
+    if (!points) {
+        return SDL_InvalidParamError("points");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    if (!clip) {
+        return SDL_InvalidParamError("clip");
+    }
+    if (!result) {
+        return SDL_InvalidParamError("result");
+    }
+    if (SDL_RectEmpty(clip)) {
+        return 0;
+    }
+
+#if SDL_SSE2_RECTS
+    return SDL_ClipPointsSSE2(points, count, clip, result);
+#elif SDL_NEON_RECTS
+    return SDL_ClipPointsNEON(points, count, clip, result);
+#else
+    {
+        int i, n = 0;
+
+        for (i = 0; i < count; ++i) {
+            if (SDL_PointInRect(&points[i], clip)) {
+                result[n++] = points[i];
+            }
+        }
+        return n;
+    }
+#endif
+}
+
 /* Use the Cohen-Sutherland algorithm for line clipping */
 #define CODE_BOTTOM 1
 #define CODE_TOP    2
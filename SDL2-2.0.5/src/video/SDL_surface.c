@@ -23,24 +23,21 @@
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
+#include "SDL_blit_swizzle.h"
+#include "SDL_blit_premultiply.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
-
-/* Public routines */
+#include "SDL_surface_pool.h"
 
 /*
- * Create an empty RGB surface of the appropriate depth using the given
- * enum SDL_PIXELFORMAT_* format
+ * Create an empty surface, with pixels from the temporary surface pool
+ * if pooled is set
  */
-SDL_Surface *
-SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
-                               Uint32 format)
+static SDL_Surface *
+SDL_CreateSurface(int width, int height, Uint32 format, SDL_bool pooled)
 {
     SDL_Surface *surface;
 
-    /* The flags are no longer used, make the compiler happy */
-    (void)flags;
-
     /* Allocate the surface */
     surface = (SDL_Surface *) SDL_calloc(1, sizeof(*surface));
     if (surface == NULL) {
@@ -80,12 +77,22 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
 
     /* Get the pixels */
     if (surface->w && surface->h) {
-        surface->pixels = SDL_malloc(surface->h * surface->pitch);
+        if (pooled) {
+            surface->pixels = SDL_AllocPooledPixels(surface->h * surface->pitch);
+        } else {
+            surface->pixels = SDL_AllocSurfacePixels(surface->h * surface->pitch);
+        }
         if (!surface->pixels) {
             SDL_FreeSurface(surface);
             SDL_OutOfMemory();
             return NULL;
         }
+        if (pooled) {
+            /* Keeps RLE encoding from releasing the pixels early */
+            surface->flags |= (SDL_PREALLOC | SDL_POOLED_PIXELS | SDL_SIMD_ALIGNED);
+        } else {
+            surface->flags |= SDL_SIMD_ALIGNED;
+        }
         /* This is important for bitmaps */
         SDL_memset(surface->pixels, 0, surface->h * surface->pitch);
     }
@@ -107,6 +114,31 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
     return surface;
 }
 
+/* Public routines */
+
+/*
+ * Create an empty RGB surface of the appropriate depth using the given
+ * enum SDL_PIXELFORMAT_* format
+ */
+SDL_Surface *
+SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
+                               Uint32 format)
+{
+    /* The flags are no longer used, make the compiler happy */
+    (void)flags;
+
+    return SDL_CreateSurface(width, height, format, SDL_FALSE);
+}
+
+/*
+ * Create an empty surface for short-lived use inside SDL
+ */
+SDL_Surface *
+SDL_CreatePooledSurface(int width, int height, Uint32 format)
+{
+    return SDL_CreateSurface(width, height, format, SDL_TRUE);
+}
+
 /*
  * Create an empty RGB surface of the appropriate depth
  */
@@ -434,7 +466,7 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
     status = 0;
     flags = surface->map->info.flags;
     surface->map->info.flags &=
-        ~(SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+        ~(SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_PREMULTIPLIED);
     switch (blendMode) {
     case SDL_BLENDMODE_NONE:
         break;
@@ -447,6 +479,9 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
     case SDL_BLENDMODE_MOD:
         surface->map->info.flags |= SDL_COPY_MOD;
         break;
+    case SDL_BLENDMODE_PREMULTIPLIED:
+        surface->map->info.flags |= SDL_COPY_PREMULTIPLIED;
+        break;
     default:
         status = SDL_Unsupported();
         break;
@@ -471,7 +506,8 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     }
 
     switch (surface->map->
-            info.flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD)) {
+            info.flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD |
+                          SDL_COPY_PREMULTIPLIED)) {
     case SDL_COPY_BLEND:
         *blendMode = SDL_BLENDMODE_BLEND;
         break;
@@ -481,6 +517,9 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     case SDL_COPY_MOD:
         *blendMode = SDL_BLENDMODE_MOD;
         break;
+    case SDL_COPY_PREMULTIPLIED:
+        *blendMode = SDL_BLENDMODE_PREMULTIPLIED;
+        break;
     default:
         *blendMode = SDL_BLENDMODE_NONE;
         break;
@@ -814,7 +853,7 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
         SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD |
-        SDL_COPY_COLORKEY
+        SDL_COPY_PREMULTIPLIED | SDL_COPY_COLORKEY
     );
 
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
@@ -873,11 +912,12 @@ SDL_UnlockSurface(SDL_Surface * surface)
 /*
  * Convert a surface into the specified pixel format.
  */
-SDL_Surface *
-SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
-                   Uint32 flags)
+static SDL_Surface *
+SDL_ConvertSurfaceInternal(SDL_Surface * surface, const SDL_PixelFormat * format,
+                           Uint32 flags, SDL_bool pooled)
 {
     SDL_Surface *convert;
+    Uint32 pixel_format;
     Uint32 copy_flags;
     SDL_Color copy_color;
     SDL_Rect bounds;
@@ -898,10 +938,14 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     }
 
     /* Create a new surface with the desired format */
-    convert = SDL_CreateRGBSurface(flags, surface->w, surface->h,
-                                   format->BitsPerPixel, format->Rmask,
-                                   format->Gmask, format->Bmask,
-                                   format->Amask);
+    pixel_format = SDL_MasksToPixelFormatEnum(format->BitsPerPixel,
+                                              format->Rmask, format->Gmask,
+                                              format->Bmask, format->Amask);
+    if (pixel_format == SDL_PIXELFORMAT_UNKNOWN) {
+        SDL_SetError("Unknown pixel format");
+        return (NULL);
+    }
+    convert = SDL_CreateSurface(surface->w, surface->h, pixel_format, pooled);
     if (convert == NULL) {
         return (NULL);
     }
@@ -997,6 +1041,22 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     return (convert);
 }
 
+SDL_Surface *
+SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
+                   Uint32 flags)
+{
+    return SDL_ConvertSurfaceInternal(surface, format, flags, SDL_FALSE);
+}
+
+/*
+ * Convert a surface for short-lived use inside SDL
+ */
+SDL_Surface *
+SDL_ConvertSurfacePooled(SDL_Surface * surface, const SDL_PixelFormat * format)
+{
+    return SDL_ConvertSurfaceInternal(surface, format, 0, SDL_TRUE);
+}
+
 SDL_Surface *
 SDL_ConvertSurfaceFormat(SDL_Surface * surface, Uint32 pixel_format,
                          Uint32 flags)
@@ -1126,6 +1186,12 @@ int SDL_ConvertPixels(int width, int height,
         return 0;
     }
 
+    /* Fast path for common channel reorders, without any blit setup */
+    if (SDL_SwizzlePixels(width, height, src_format, src, src_pitch,
+                          dst_format, dst, dst_pitch)) {
+        return 0;
+    }
+
     if (!SDL_CreateSurfaceOnStack(width, height, src_format, nonconst_src,
                                   src_pitch,
                                   &src_surface, &src_fmt, &src_blitmap)) {
@@ -1144,6 +1210,45 @@ int SDL_ConvertPixels(int width, int height,
     return SDL_LowerBlit(&src_surface, &rect, &dst_surface, &rect);
 }
 
+int SDL_PremultiplyAlpha(int width, int height,
+                         Uint32 src_format, const void * src, int src_pitch,
+                         Uint32 dst_format, void * dst, int dst_pitch)
+{
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+    if (!src_pitch) {
+        return SDL_InvalidParamError("src_pitch");
+    }
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (!dst_pitch) {
+        return SDL_InvalidParamError("dst_pitch");
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(dst_format) ||
+        SDL_PIXELLAYOUT(dst_format) != SDL_PACKEDLAYOUT_8888 ||
+        !SDL_ISPIXELFORMAT_ALPHA(dst_format)) {
+        return SDL_SetError("Can't premultiply alpha into %s",
+                            SDL_GetPixelFormatName(dst_format));
+    }
+
+    /* Other formats are converted first, then premultiplied in place */
+    if (src_format != dst_format) {
+        if (SDL_ConvertPixels(width, height, src_format, src, src_pitch,
+                              dst_format, dst, dst_pitch) < 0) {
+            return -1;
+        }
+        src = dst;
+        src_pitch = dst_pitch;
+    }
+    if (width > 0 && height > 0) {
+        SDL_PremultiplyPixels8888(width, height, dst_format, src, src_pitch,
+                                  dst, dst_pitch);
+    }
+    return 0;
+}
+
 /*
  * Free a surface created by the above function.
  */
@@ -1174,7 +1279,13 @@ SDL_FreeSurface(SDL_Surface * surface)
         SDL_FreeBlitMap(surface->map);
         surface->map = NULL;
     }
-    if (!(surface->flags & SDL_PREALLOC)) {
+    if (surface->flags & SDL_POOLED_PIXELS) {
+        SDL_FreePooledPixels(surface->pixels);
+    } else if (surface->flags & SDL_PREALLOC) {
+        /* Don't free */
+    } else if (surface->flags & SDL_SIMD_ALIGNED) {
+        SDL_FreeSurfacePixels(surface->pixels);
+    } else {
         SDL_free(surface->pixels);
     }
     SDL_free(surface);
@@ -0,0 +1,255 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_surface_pool.h"
+
+/* Recycling pool for the pixels of temporary surfaces.
+
+   The renderers and the conversion paths create and free whole surfaces
+   or pixel buffers for a single call, often megabytes each frame. Freed
+   buffers are kept in size classes of four steps per power of two, so a
+   cached buffer wastes at most a quarter of its size, and handed out
+   again to the next request of the same class.
+ */
+
+#define SDL_POOL_MIN_SHIFT          12  /* 4 KB */
+#define SDL_POOL_MAX_SHIFT          28  /* 256 MB */
+#define SDL_POOL_NUM_BUCKETS        (((SDL_POOL_MAX_SHIFT - SDL_POOL_MIN_SHIFT) * 4) + 1)
+#define SDL_POOL_ALIGNMENT          64
+#define SDL_DEFAULT_POOL_SIZE       (64 * 1024 * 1024)
+
+typedef struct SDL_PooledBuffer
+{
+    void *memory;
+    struct SDL_PooledBuffer *next;
+    size_t capacity;
+    int bucket;
+} SDL_PooledBuffer;
+
+static struct
+{
+    SDL_PooledBuffer *buckets[SDL_POOL_NUM_BUCKETS];
+    size_t cached;
+    Uint64 hits;
+    Uint64 misses;
+} SDL_surface_pool;
+
+static SDL_SpinLock SDL_surface_pool_lock;
+static SDL_atomic_t SDL_surface_pool_hint_watched;
+static size_t SDL_surface_pool_limit = SDL_DEFAULT_POOL_SIZE;
+
+/* Free cached buffers, largest first, until at most 'limit' bytes are left */
+static void
+SDL_TrimPoolToLimit(size_t limit)
+{
+    SDL_PooledBuffer *buffers = NULL;
+    int i;
+
+    /* Unlink under the lock, free outside of it */
+    SDL_AtomicLock(&SDL_surface_pool_lock);
+    for (i = SDL_POOL_NUM_BUCKETS - 1; i >= 0 && SDL_surface_pool.cached > limit; --i) {
+        while (SDL_surface_pool.buckets[i] && SDL_surface_pool.cached > limit) {
+            SDL_PooledBuffer *buffer = SDL_surface_pool.buckets[i];
+            SDL_surface_pool.buckets[i] = buffer->next;
+            SDL_surface_pool.cached -= buffer->capacity;
+            buffer->next = buffers;
+            buffers = buffer;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_surface_pool_lock);
+
+    while (buffers) {
+        SDL_PooledBuffer *next = buffers->next;
+        SDL_free(buffers->memory);
+        buffers = next;
+    }
+}
+
+static void SDLCALL
+SDL_SurfacePoolSizeChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    size_t limit = SDL_DEFAULT_POOL_SIZE;
+
+    if (hint && *hint) {
+        int value = SDL_atoi(hint);
+        limit = (value > 0) ? (size_t) value : 0;
+    }
+    SDL_surface_pool_limit = limit;
+    SDL_TrimPoolToLimit(limit);
+}
+
+/* Returns the size class for a request, or -1 if it is too big to cache */
+static int
+SDL_GetPoolBucket(size_t size, size_t *capacity)
+{
+    size_t step;
+    int shift, sub;
+
+    if (size <= ((size_t) 1 << SDL_POOL_MIN_SHIFT)) {
+        *capacity = (size_t) 1 << SDL_POOL_MIN_SHIFT;
+        return 0;
+    }
+    if (size > ((size_t) 1 << SDL_POOL_MAX_SHIFT)) {
+        *capacity = size;
+        return -1;
+    }
+
+    /* 2^shift < size <= 2^(shift+1), split into four steps */
+    shift = SDL_POOL_MIN_SHIFT;
+    while (((size_t) 1 << (shift + 1)) < size) {
+        ++shift;
+    }
+    step = (size_t) 1 << (shift - 2);
+    sub = (int) ((size - ((size_t) 1 << shift) + step - 1) / step);
+    *capacity = ((size_t) 1 << shift) + sub * step;
+    return (shift - SDL_POOL_MIN_SHIFT) * 4 + sub;
+}
+
+/* The hint is watched rather than parsed on every free */
+static size_t
+SDL_GetPoolLimit(void)
+{
+    if (!SDL_AtomicGet(&SDL_surface_pool_hint_watched) &&
+        SDL_AtomicCAS(&SDL_surface_pool_hint_watched, 0, 1)) {
+        /* This calls SDL_SurfacePoolSizeChanged() with the current value */
+        SDL_AddHintCallback(SDL_HINT_SURFACE_POOL_SIZE, SDL_SurfacePoolSizeChanged, NULL);
+    }
+    return SDL_surface_pool_limit;
+}
+
+void *
+SDL_AllocPooledPixels(size_t size)
+{
+    SDL_PooledBuffer *buffer;
+    size_t capacity;
+    Uint8 *memory, *pixels;
+    int bucket;
+
+    bucket = SDL_GetPoolBucket(size, &capacity);
+    if (bucket >= 0) {
+        SDL_AtomicLock(&SDL_surface_pool_lock);
+        buffer = SDL_surface_pool.buckets[bucket];
+        if (buffer) {
+            SDL_surface_pool.buckets[bucket] = buffer->next;
+            SDL_surface_pool.cached -= buffer->capacity;
+            ++SDL_surface_pool.hits;
+        } else {
+            ++SDL_surface_pool.misses;
+        }
+        SDL_AtomicUnlock(&SDL_surface_pool_lock);
+
+        if (buffer) {
+            buffer->next = NULL;
+            return buffer + 1;
+        }
+    } else {
+        SDL_AtomicLock(&SDL_surface_pool_lock);
+        ++SDL_surface_pool.misses;
+        SDL_AtomicUnlock(&SDL_surface_pool_lock);
+    }
+
+    /* The header sits right in front of the aligned pixels */
+    memory = (Uint8 *) SDL_malloc(capacity + sizeof(SDL_PooledBuffer) + SDL_POOL_ALIGNMENT - 1);
+    if (!memory) {
+        return NULL;
+    }
+    pixels = memory + sizeof(SDL_PooledBuffer);
+    pixels += (SDL_POOL_ALIGNMENT - ((uintptr_t) pixels & (SDL_POOL_ALIGNMENT - 1))) & (SDL_POOL_ALIGNMENT - 1);
+
+    buffer = (SDL_PooledBuffer *) pixels - 1;
+    buffer->memory = memory;
+    buffer->next = NULL;
+    buffer->capacity = capacity;
+    buffer->bucket = bucket;
+    return pixels;
+}
+
+void
+SDL_FreePooledPixels(void *pixels)
+{
+    SDL_PooledBuffer *buffer;
+    SDL_bool cached = SDL_FALSE;
+
+    if (!pixels) {
+        return;
+    }
+
+    buffer = (SDL_PooledBuffer *) pixels - 1;
+    if (buffer->bucket >= 0) {
+        const size_t limit = SDL_GetPoolLimit();
+
+        SDL_AtomicLock(&SDL_surface_pool_lock);
+        if (SDL_surface_pool.cached + buffer->capacity <= limit) {
+            buffer->next = SDL_surface_pool.buckets[buffer->bucket];
+            SDL_surface_pool.buckets[buffer->bucket] = buffer;
+            SDL_surface_pool.cached += buffer->capacity;
+            cached = SDL_TRUE;
+        }
+        SDL_AtomicUnlock(&SDL_surface_pool_lock);
+    }
+
+    if (!cached) {
+        SDL_free(buffer->memory);
+    }
+}
+
+void
+SDL_GetSurfacePoolStats(Uint64 *hits, Uint64 *misses, Uint64 *cached)
+{
+    SDL_AtomicLock(&SDL_surface_pool_lock);
+    if (hits) {
+        *hits = SDL_surface_pool.hits;
+    }
+    if (misses) {
+        *misses = SDL_surface_pool.misses;
+    }
+    if (cached) {
+        *cached = SDL_surface_pool.cached;
+    }
+    SDL_AtomicUnlock(&SDL_surface_pool_lock);
+}
+
+void
+SDL_TrimSurfacePool(void)
+{
+    SDL_TrimPoolToLimit(0);
+}
+
+void
+SDL_SurfacePoolQuit(void)
+{
+    SDL_TrimSurfacePool();
+
+    if (SDL_AtomicCAS(&SDL_surface_pool_hint_watched, 1, 0)) {
+        SDL_DelHintCallback(SDL_HINT_SURFACE_POOL_SIZE, SDL_SurfacePoolSizeChanged, NULL);
+    }
+    SDL_surface_pool_limit = SDL_DEFAULT_POOL_SIZE;
+
+    SDL_AtomicLock(&SDL_surface_pool_lock);
+    SDL_surface_pool.hits = 0;
+    SDL_surface_pool.misses = 0;
+    SDL_AtomicUnlock(&SDL_surface_pool_lock);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
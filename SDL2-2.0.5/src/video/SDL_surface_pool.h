@@ -0,0 +1,50 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef _SDL_surface_pool_h
+#define _SDL_surface_pool_h
+
+#include "SDL_surface.h"
+
+/* Set on surfaces whose pixels came from the pool, never on surfaces
+   handed out to the application. */
+#define SDL_POOLED_PIXELS   0x00000010
+
+/* Pixel buffers for short-lived surfaces and conversions.
+   The buffers are 64-byte aligned and not cleared. */
+extern void *SDL_AllocPooledPixels(size_t size);
+extern void SDL_FreePooledPixels(void *pixels);
+
+/* Temporary surfaces backed by pooled pixels, SDL_FreeSurface() returns
+   the pixels to the pool. */
+extern SDL_Surface *SDL_CreatePooledSurface(int width, int height, Uint32 format);
+extern SDL_Surface *SDL_ConvertSurfacePooled(SDL_Surface * src, const SDL_PixelFormat * fmt);
+
+/* Release all cached buffers, called on SDL_APP_LOWMEMORY */
+extern void SDL_TrimSurfacePool(void);
+
+/* Release all cached buffers, called from SDL_Quit() */
+extern void SDL_SurfacePoolQuit(void);
+
+#endif /* _SDL_surface_pool_h */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,120 @@
+/*
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times SDL_ConvertAudio() on ten seconds of audio for conversions that
+   are common when loading sound effects. */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static const struct
+{
+    SDL_AudioFormat src_format;
+    Uint8 src_channels;
+    int src_rate;
+    SDL_AudioFormat dst_format;
+    Uint8 dst_channels;
+    int dst_rate;
+} conversions[] = {
+    { AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 44100 },
+    { AUDIO_S16SYS, 1, 44100, AUDIO_F32SYS, 2, 44100 },
+    { AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 6, 44100 },
+    { AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 1, 44100 },
+    { AUDIO_U8, 1, 22050, AUDIO_S16SYS, 2, 22050 },
+    { AUDIO_S16MSB, 6, 48000, AUDIO_F32SYS, 2, 48000 },
+    { AUDIO_F32SYS, 2, 48000, AUDIO_S16SYS, 1, 48000 },
+    { AUDIO_S16SYS, 2, 44100, AUDIO_S16SYS, 2, 48000 },
+    { AUDIO_S16SYS, 1, 22050, AUDIO_F32SYS, 6, 48000 }
+};
+
+static const char *
+FormatName(SDL_AudioFormat format)
+{
+    switch (format) {
+    case AUDIO_U8: return "U8";
+    case AUDIO_S8: return "S8";
+    case AUDIO_S16LSB: return "S16LSB";
+    case AUDIO_S16MSB: return "S16MSB";
+    case AUDIO_S32LSB: return "S32LSB";
+    case AUDIO_S32MSB: return "S32MSB";
+    case AUDIO_F32LSB: return "F32LSB";
+    case AUDIO_F32MSB: return "F32MSB";
+    default: return "?";
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    int iterations = 10;
+    double freq;
+    int i, n;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_max(SDL_atoi(argv[1]), 1);
+    }
+    freq = (double) SDL_GetPerformanceFrequency();
+
+    for (i = 0; i < SDL_arraysize(conversions); ++i) {
+        const int frames = conversions[i].src_rate * 10;
+        const int len = frames * conversions[i].src_channels * (SDL_AUDIO_BITSIZE(conversions[i].src_format) / 8);
+        SDL_AudioCVT cvt;
+        Uint8 *src;
+        Uint64 start, total = 0;
+
+        if (SDL_BuildAudioCVT(&cvt, conversions[i].src_format, conversions[i].src_channels, conversions[i].src_rate,
+                              conversions[i].dst_format, conversions[i].dst_channels, conversions[i].dst_rate) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_BuildAudioCVT() failed: %s\n", SDL_GetError());
+            return 1;
+        }
+        src = (Uint8 *) SDL_malloc(len);
+        cvt.buf = (Uint8 *) SDL_malloc(len * cvt.len_mult);
+        if (!src || !cvt.buf) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+            return 1;
+        }
+        if (SDL_AUDIO_ISFLOAT(conversions[i].src_format)) {
+            for (n = 0; n < len / 4; ++n) {
+                ((float *) src)[n] = ((float) rand() / RAND_MAX) * 2.0f - 1.0f;
+            }
+        } else {
+            for (n = 0; n < len; ++n) {
+                src[n] = (Uint8) rand();
+            }
+        }
+
+        for (n = 0; n < iterations; ++n) {
+            SDL_memcpy(cvt.buf, src, len);
+            cvt.len = len;
+            start = SDL_GetPerformanceCounter();
+            SDL_ConvertAudio(&cvt);
+            total += SDL_GetPerformanceCounter() - start;
+        }
+
+        SDL_Log("%-6s %d ch %5d Hz -> %-6s %d ch %5d Hz: %8.3f ms\n",
+                FormatName(conversions[i].src_format), conversions[i].src_channels, conversions[i].src_rate,
+                FormatName(conversions[i].dst_format), conversions[i].dst_channels, conversions[i].dst_rate,
+                (total * 1000.0) / (freq * iterations));
+
+        SDL_free(src);
+        SDL_free(cvt.buf);
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,158 @@
+/*
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Renders looping tones through an SDL_AudioMixer to a file with the disk
+   audio driver in offline mode, and reports how much faster than real time
+   the audio thread got through it. */
+
+#include "SDL.h"
+
+#define RATE 48000
+
+static const struct
+{
+    SDL_AudioFormat format;
+    Uint8 channels;
+    float frequency;
+} voices[] = {
+    { AUDIO_S16SYS, 1, 220.0f },
+    { AUDIO_F32SYS, 2, 330.0f },
+    { AUDIO_U8, 1, 440.0f },
+    { AUDIO_S16SYS, 2, 550.0f }
+};
+
+/* One second of a tone, which loops without a click */
+static Uint8 *
+MakeTone(SDL_AudioFormat format, Uint8 channels, float frequency, Uint32 *len)
+{
+    const int samples = RATE * channels;
+    Uint8 *buf = (Uint8 *) SDL_malloc(samples * (SDL_AUDIO_BITSIZE(format) / 8));
+    int i;
+
+    if (!buf) {
+        return NULL;
+    }
+    for (i = 0; i < samples; ++i) {
+        const float value = 0.25f * (float) SDL_sin(2.0 * M_PI * frequency * (i / channels) / RATE);
+        switch (format) {
+        case AUDIO_U8:
+            buf[i] = (Uint8) (128 + (int) (value * 127.0f));
+            break;
+        case AUDIO_S16SYS:
+            ((Sint16 *) buf)[i] = (Sint16) (value * 32767.0f);
+            break;
+        default:
+            ((float *) buf)[i] = value;
+            break;
+        }
+    }
+    *len = samples * (SDL_AUDIO_BITSIZE(format) / 8);
+    return buf;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *file = "testaudiooffline.raw";
+    int seconds = 60;
+    int copies = 4;
+    Uint8 *tones[SDL_arraysize(voices)];
+    SDL_AudioSpec spec;
+    SDL_AudioMixer *mixer;
+    SDL_AudioDeviceID dev;
+    SDL_AudioDeviceStats stats;
+    Uint64 start, end, frames;
+    double elapsed;
+    int i, n;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        seconds = SDL_max(SDL_atoi(argv[1]), 1);
+    }
+    if (argc > 2) {
+        copies = SDL_max(SDL_atoi(argv[2]), 1);
+    }
+    if (argc > 3) {
+        file = argv[3];
+    }
+
+    SDL_setenv("SDL_AUDIODRIVER", "disk", 1);
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_OFFLINE, "1");
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't start the disk audio driver: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    mixer = SDL_NewAudioMixer(AUDIO_F32SYS, 2, RATE);
+    if (!mixer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create the mixer: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    for (i = 0; i < SDL_arraysize(voices); ++i) {
+        Uint32 len;
+        tones[i] = MakeTone(voices[i].format, voices[i].channels, voices[i].frequency, &len);
+        if (!tones[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+            SDL_Quit();
+            return 1;
+        }
+        for (n = 0; n < copies; ++n) {
+            SDL_AudioMixerAddBuffer(mixer, voices[i].format, voices[i].channels, tones[i], len, SDL_TRUE);
+        }
+    }
+
+    SDL_zero(spec);
+    spec.freq = RATE;
+    spec.format = AUDIO_F32SYS;
+    spec.channels = 2;
+    spec.samples = 1024;
+    spec.callback = SDL_AudioMixerCallback;
+    spec.userdata = mixer;
+    dev = SDL_OpenAudioDevice(file, 0, &spec, NULL, 0);
+    if (!dev) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", file, SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    SDL_PauseAudioDevice(dev, 0);
+    while (SDL_GetAudioDevicePosition(dev) < (Uint64) seconds * RATE) {
+        SDL_Delay(1);
+    }
+    SDL_PauseAudioDevice(dev, 1);
+    end = SDL_GetPerformanceCounter();
+
+    frames = SDL_GetAudioDevicePosition(dev);
+    SDL_GetAudioDeviceStats(dev, &stats);
+    SDL_CloseAudioDevice(dev);
+
+    elapsed = (double) (end - start) / SDL_GetPerformanceFrequency();
+    SDL_Log("%d voices, %.3f s of audio in %.3f s: %.1fx real time\n",
+            (int) (copies * SDL_arraysize(voices)), (double) frames / RATE,
+            elapsed, ((double) frames / RATE) / elapsed);
+    SDL_Log("%u callbacks, %.1f us average, %u us longest\n", stats.callbacks,
+            stats.callbacks ? (double) stats.callback_total_us / stats.callbacks : 0.0,
+            stats.callback_max_us);
+
+    SDL_FreeAudioMixer(mixer);
+    for (i = 0; i < SDL_arraysize(voices); ++i) {
+        SDL_free(tones[i]);
+    }
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -968,6 +968,1151 @@ int audio_openCloseAudioDeviceConnected()
 }
 
 
+/* Feeds (inlen) bytes to a new stream, in random sized chunks if (chunked) is set */
+static int
+_audioStreamConvert(const Uint8 *in, int inlen, Uint8 *out, int outlen, SDL_bool chunked)
+{
+  SDL_AudioStream *stream;
+  int pos = 0;
+  int got = 0;
+  int n;
+
+  stream = SDL_NewAudioStream(AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 48000);
+  SDLTest_AssertPass("Call to SDL_NewAudioStream()");
+  SDLTest_AssertCheck(stream != NULL, "Verify stream is not NULL");
+  if (stream == NULL) {
+    return -1;
+  }
+
+  while (pos < inlen) {
+    n = chunked ? SDLTest_RandomIntegerInRange(1, 1000) : inlen;
+    n = SDL_min(n, inlen - pos);
+    if (SDL_AudioStreamPut(stream, in + pos, n) < 0) {
+      SDLTest_LogError("SDL_AudioStreamPut() failed: %s", SDL_GetError());
+      break;
+    }
+    pos += n;
+  }
+  SDL_AudioStreamFlush(stream);
+  SDLTest_AssertPass("Call to SDL_AudioStreamPut() and SDL_AudioStreamFlush()");
+
+  n = SDL_AudioStreamAvailable(stream);
+  SDLTest_AssertCheck(n <= outlen, "Verify available bytes fit; expected: <=%i, got: %i", outlen, n);
+  if (n <= outlen) {
+    got = SDL_AudioStreamGet(stream, out, n);
+    SDLTest_AssertCheck(got == n, "Verify bytes read; expected: %i, got: %i", n, got);
+  }
+
+  /* Reading partial sample frames is an error */
+  n = SDL_AudioStreamGet(stream, out, 3);
+  SDLTest_AssertCheck(n == -1, "Verify partial frame read fails; expected: -1, got: %i", n);
+
+  SDL_FreeAudioStream(stream);
+  return got;
+}
+
+/**
+ * \brief Converts audio in pieces with an SDL_AudioStream.
+ *
+ * Resampling in arbitrary chunks has to give the same output as resampling
+ * the whole buffer at once, with the exact expected length.
+ *
+ * \sa SDL_NewAudioStream
+ * \sa SDL_AudioStreamPut
+ * \sa SDL_AudioStreamGet
+ */
+int audio_audioStream()
+{
+  const int frames = 44100 / 4;
+  const int inlen = frames * 2 * sizeof (Sint16);
+  const int outlen = (((frames * 480) / 441) + 100) * 2 * sizeof (float);
+  Sint16 *in = (Sint16 *)SDL_malloc(inlen);
+  Uint8 *whole = (Uint8 *)SDL_malloc(outlen);
+  Uint8 *chunked = (Uint8 *)SDL_malloc(outlen);
+  int wholelen, chunkedlen, i;
+
+  SDLTest_AssertCheck(in && whole && chunked, "Check buffers are not NULL");
+  if (!in || !whole || !chunked) {
+    SDL_free(in);
+    SDL_free(whole);
+    SDL_free(chunked);
+    return TEST_ABORTED;
+  }
+
+  for (i = 0; i < frames * 2; i++) {
+    in[i] = (Sint16)SDLTest_RandomSint16();
+  }
+
+  wholelen = _audioStreamConvert((const Uint8 *)in, inlen, whole, outlen, SDL_FALSE);
+  chunkedlen = _audioStreamConvert((const Uint8 *)in, inlen, chunked, outlen, SDL_TRUE);
+
+  /* 44100 -> 48000 Hz: ceil(frames * 480 / 441) output frames */
+  i = ((frames * 480) + 440) / 441;
+  SDLTest_AssertCheck(wholelen == i * 2 * (int)sizeof (float), "Verify output length; expected: %i, got: %i", i * 2 * (int)sizeof (float), wholelen);
+  SDLTest_AssertCheck(chunkedlen == wholelen, "Verify chunked output length; expected: %i, got: %i", wholelen, chunkedlen);
+  if (chunkedlen == wholelen && wholelen > 0) {
+    SDLTest_AssertCheck(SDL_memcmp(whole, chunked, wholelen) == 0, "Verify chunked output matches");
+  }
+
+  SDL_free(in);
+  SDL_free(whole);
+  SDL_free(chunked);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Queues audio on a paused device and checks the queued size.
+ *
+ * Queues far more than the device starts with room for, in odd sizes, so
+ * the queue has to grow while keeping an exact count.
+ *
+ * \sa SDL_QueueAudio
+ * \sa SDL_GetQueuedAudioSize
+ * \sa SDL_ClearQueuedAudio
+ */
+int audio_queueAudio()
+{
+  SDL_AudioSpec desired;
+  SDL_AudioDeviceID id;
+  Uint8 *data;
+  Uint32 queued = 0;
+  Uint32 size;
+  int i, len, result;
+  SDL_bool started = SDL_FALSE;
+
+  /* Earlier tests may have stopped the driver with SDL_AudioQuit() */
+  if (SDL_GetCurrentAudioDriver() == NULL) {
+    result = SDL_AudioInit(NULL);
+    SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+    SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+    if (result != 0) {
+      return TEST_ABORTED;
+    }
+    started = SDL_TRUE;
+  }
+
+  SDL_memset(&desired, 0, sizeof (desired));
+  desired.freq = 22050;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 512;
+  id = SDL_OpenAudioDevice(NULL, 0, &desired, NULL, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 0, ...)");
+  if (id == 0) {
+    SDLTest_Log("No playback device could be opened: %s", SDL_GetError());
+    if (started) {
+      SDL_AudioQuit();
+    }
+    return TEST_SKIPPED;
+  }
+
+  data = (Uint8 *)SDL_malloc(100000);
+  SDLTest_AssertCheck(data != NULL, "Check buffer is not NULL");
+  if (data == NULL) {
+    SDL_CloseAudioDevice(id);
+    if (started) {
+      SDL_AudioQuit();
+    }
+    return TEST_ABORTED;
+  }
+  SDL_memset(data, 0x5A, 100000);
+
+  /* The device starts paused, so nothing drains */
+  for (i = 0; i < 40; i++) {
+    len = SDLTest_RandomIntegerInRange(1, 100000);
+    result = SDL_QueueAudio(id, data, len);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_QueueAudio() result; expected: 0, got: %i", result);
+    if (result == 0) {
+      queued += len;
+    }
+  }
+  size = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertPass("Call to SDL_GetQueuedAudioSize()");
+  SDLTest_AssertCheck(size == queued, "Verify queued size; expected: %u, got: %u", queued, size);
+
+  SDL_ClearQueuedAudio(id);
+  SDLTest_AssertPass("Call to SDL_ClearQueuedAudio()");
+  size = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(size == 0, "Verify queued size after clearing; expected: 0, got: %u", size);
+
+  result = SDL_QueueAudio(id, data, 1000);
+  SDLTest_AssertCheck(result == 0, "Verify SDL_QueueAudio() result after clearing; expected: 0, got: %i", result);
+  size = SDL_GetQueuedAudioSize(id);
+  SDLTest_AssertCheck(size == 1000, "Verify queued size after clearing and queueing; expected: 1000, got: %u", size);
+
+  SDL_CloseAudioDevice(id);
+  SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+  SDL_free(data);
+  if (started) {
+    SDL_AudioQuit();
+  }
+  return TEST_COMPLETED;
+}
+
+/* Converts len bytes of in between formats, with the given CPU feature mask */
+int _audioConvertWithFeatures(SDL_AudioFormat src, SDL_AudioFormat dst, const Uint8 *in, int len, Uint8 *out, const char *features)
+{
+  SDL_AudioCVT cvt;
+  int result;
+
+  SDL_setenv("SDL_AUDIO_CPU_FEATURES", features, 1);
+  result = SDL_BuildAudioCVT(&cvt, src, 1, 22050, dst, 1, 22050);
+  if (result != 1) {
+    return -1;
+  }
+  SDL_memcpy(out, in, len);
+  cvt.buf = out;
+  cvt.len = len;
+  if (SDL_ConvertAudio(&cvt) != 0) {
+    return -1;
+  }
+  return cvt.len_cvt;
+}
+
+/**
+ * \brief Checks the vectorized sample type converters against the C ones.
+ *
+ * Uses a length that isn't a multiple of any vector width, and floats
+ * outside [-1.0, 1.0], which all converters have to handle the same way.
+ *
+ * \sa SDL_BuildAudioCVT
+ * \sa SDL_ConvertAudio
+ */
+int audio_convertTypesSIMD()
+{
+  const SDL_AudioFormat formats[] = { AUDIO_U8, AUDIO_S8, AUDIO_S16LSB, AUDIO_S16MSB, AUDIO_S32LSB, AUDIO_S32MSB, AUDIO_F32LSB, AUDIO_F32MSB };
+  const float specials[] = { 1.0f, -1.0f, 1.5f, -1.5f, 0.0f, -0.0f, 0.5f, -0.5f, 2.0f, -2.0f, 1e20f, -1e20f, 1e-20f, -1e-20f };
+  const int samples = 1003;
+  Uint8 *in = (Uint8 *)SDL_malloc(samples * 4);
+  Uint8 *expected = (Uint8 *)SDL_malloc(samples * 16);
+  Uint8 *actual = (Uint8 *)SDL_malloc(samples * 16);
+  int i, j, len, expectedlen, actuallen;
+
+  SDLTest_AssertCheck(in && expected && actual, "Check buffers are not NULL");
+  if (!in || !expected || !actual) {
+    SDL_free(in);
+    SDL_free(expected);
+    SDL_free(actual);
+    return TEST_ABORTED;
+  }
+
+  /* Random bits, with the first samples as interesting floats */
+  for (i = 0; i < samples * 4; i++) {
+    in[i] = (Uint8)SDLTest_RandomUint8();
+  }
+  for (i = 0; i < SDL_arraysize(specials); i++) {
+    SDL_memcpy(in + i * 4, &specials[i], 4);
+  }
+  for (i = SDL_arraysize(specials); i < samples / 2; i++) {
+    const float f = (SDLTest_RandomFloat() * 2.4f) - 1.2f;
+    SDL_memcpy(in + i * 4, &f, 4);
+  }
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    for (j = 0; j < SDL_arraysize(formats); j++) {
+      if (i == j) {
+        continue;
+      }
+      len = samples * (SDL_AUDIO_BITSIZE(formats[i]) / 8);
+      expectedlen = _audioConvertWithFeatures(formats[i], formats[j], in, len, expected, "0");
+      actuallen = _audioConvertWithFeatures(formats[i], formats[j], in, len, actual, "");
+      SDLTest_AssertCheck(expectedlen == actuallen && expectedlen == samples * (SDL_AUDIO_BITSIZE(formats[j]) / 8),
+                          "Verify length for 0x%.4x -> 0x%.4x; expected: %i, got: %i", formats[i], formats[j], expectedlen, actuallen);
+      if (expectedlen == actuallen && expectedlen > 0) {
+        SDLTest_AssertCheck(SDL_memcmp(expected, actual, expectedlen) == 0,
+                            "Verify output for 0x%.4x -> 0x%.4x matches the C converter", formats[i], formats[j]);
+      }
+    }
+  }
+  SDL_setenv("SDL_AUDIO_CPU_FEATURES", "", 1);
+
+  SDL_free(in);
+  SDL_free(expected);
+  SDL_free(actual);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Checks the vectorized SDL_MixAudioFormat() paths against the C ones.
+ *
+ * Mixes at every volume, with odd lengths and unaligned buffers. Floats are
+ * multiples of 1/1024, which mix exactly however the float math is done.
+ *
+ * \sa SDL_MixAudioFormat
+ */
+int audio_mixAudioSIMD()
+{
+  const SDL_AudioFormat formats[] = { AUDIO_S16SYS, AUDIO_S32SYS, AUDIO_F32SYS };
+  const int samples = 1003;
+  const int buflen = samples * 4 + 3;
+  Uint8 *src = (Uint8 *)SDL_malloc(buflen);
+  Uint8 *dst = (Uint8 *)SDL_malloc(buflen);
+  Uint8 *expected = (Uint8 *)SDL_malloc(buflen);
+  Uint8 *actual = (Uint8 *)SDL_malloc(buflen);
+  int i, j, volume, offset, len, failures;
+  float f;
+
+  SDLTest_AssertCheck(src && dst && expected && actual, "Check buffers are not NULL");
+  if (!src || !dst || !expected || !actual) {
+    SDL_free(src);
+    SDL_free(dst);
+    SDL_free(expected);
+    SDL_free(actual);
+    return TEST_ABORTED;
+  }
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    failures = 0;
+    for (volume = 1; volume <= SDL_MIX_MAXVOLUME; volume++) {
+      offset = volume % 4;
+      len = (samples - (volume % 7)) * (SDL_AUDIO_BITSIZE(formats[i]) / 8);
+      for (j = 0; j < buflen; j++) {
+        src[j] = (Uint8)SDLTest_RandomUint8();
+        dst[j] = (Uint8)SDLTest_RandomUint8();
+      }
+      if (SDL_AUDIO_ISFLOAT(formats[i])) {
+        for (j = 0; j < samples; j++) {
+          f = SDLTest_RandomIntegerInRange(-1536, 1536) / 1024.0f;
+          SDL_memcpy(src + offset + j * 4, &f, 4);
+          f = SDLTest_RandomIntegerInRange(-1536, 1536) / 1024.0f;
+          SDL_memcpy(dst + offset + j * 4, &f, 4);
+        }
+      }
+      SDL_memcpy(expected, dst, buflen);
+      SDL_memcpy(actual, dst, buflen);
+
+      SDL_setenv("SDL_AUDIO_CPU_FEATURES", "0", 1);
+      SDL_MixAudioFormat(expected + offset, src + offset, formats[i], len, volume);
+      SDL_setenv("SDL_AUDIO_CPU_FEATURES", "", 1);
+      SDL_MixAudioFormat(actual + offset, src + offset, formats[i], len, volume);
+      if (SDL_memcmp(expected, actual, buflen) != 0) {
+        failures++;
+      }
+    }
+    SDLTest_AssertPass("Call to SDL_MixAudioFormat() for format 0x%.4x at all volumes", formats[i]);
+    SDLTest_AssertCheck(failures == 0, "Verify output matches the C mixer; expected: 0 failures, got: %i", failures);
+  }
+
+  SDL_free(src);
+  SDL_free(dst);
+  SDL_free(expected);
+  SDL_free(actual);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Renders a few voices with an audio mixer and checks the sum.
+ *
+ * Uses float output and sample values that add up exactly, so the checks
+ * don't depend on how the float math is done.
+ *
+ * \sa SDL_NewAudioMixer
+ * \sa SDL_AudioMixerRender
+ */
+int audio_audioMixer()
+{
+  const int frames = 600;
+  SDL_AudioMixer *mixer;
+  float mono[300];
+  float stereo[6] = { 0.5f, -0.5f, 0.25f, -0.25f, 0.125f, -0.125f };
+  float streamed[128];
+  float *out = (float *)SDL_malloc(frames * 2 * sizeof (float));
+  int a, b, c, i, failures;
+  float l, r;
+
+  SDLTest_AssertCheck(out != NULL, "Check output buffer is not NULL");
+  if (!out) {
+    return TEST_ABORTED;
+  }
+
+  mixer = SDL_NewAudioMixer(AUDIO_F32SYS, 2, 44100);
+  SDLTest_AssertPass("Call to SDL_NewAudioMixer(AUDIO_F32SYS, 2, 44100)");
+  SDLTest_AssertCheck(mixer != NULL, "Verify mixer is not NULL");
+  if (!mixer) {
+    SDL_free(out);
+    return TEST_ABORTED;
+  }
+
+  SDLTest_AssertCheck(SDL_NewAudioMixer(AUDIO_F32SYS, 6, 44100) == NULL, "Verify 6 channel mixer is rejected");
+  SDLTest_AssertCheck(SDL_AudioMixerRender(mixer, out, 7) == -1, "Verify partial frames are rejected");
+
+  /* A mono buffer panned hard left, played once */
+  for (i = 0; i < SDL_arraysize(mono); i++) {
+    mono[i] = 0.25f;
+  }
+  a = SDL_AudioMixerAddBuffer(mixer, AUDIO_F32SYS, 1, mono, sizeof (mono), SDL_FALSE);
+  SDLTest_AssertCheck(a > 0, "Verify buffer voice was added; got: %i", a);
+  SDLTest_AssertCheck(SDL_AudioMixerSetVoiceVolume(mixer, a, 1.0f, -1.0f) == 0, "Pan voice left");
+
+  /* A stereo float buffer at half gain, looped */
+  b = SDL_AudioMixerAddBuffer(mixer, AUDIO_F32SYS, 2, stereo, sizeof (stereo), SDL_TRUE);
+  SDLTest_AssertCheck(b > 0 && b != a, "Verify looped voice was added; got: %i", b);
+  SDLTest_AssertCheck(SDL_AudioMixerSetVoiceVolume(mixer, b, 0.5f, 0.0f) == 0, "Set looped voice gain");
+
+  SDLTest_AssertCheck(SDL_AudioMixerRender(mixer, out, frames * 2 * sizeof (float)) == 0, "Render mixer");
+  failures = 0;
+  for (i = 0; i < frames; i++) {
+    l = stereo[(i % 3) * 2] * 0.5f + ((i < 300) ? 0.25f : 0.0f);
+    r = stereo[(i % 3) * 2 + 1] * 0.5f;
+    if (out[i * 2] != l || out[i * 2 + 1] != r) {
+      failures++;
+    }
+  }
+  SDLTest_AssertCheck(failures == 0, "Verify mixed output; expected: 0 wrong frames, got: %i", failures);
+  SDLTest_AssertCheck(!SDL_AudioMixerVoicePlaying(mixer, a), "Verify played voice is finished");
+  SDLTest_AssertCheck(SDL_AudioMixerVoicePlaying(mixer, b), "Verify looped voice is playing");
+
+  /* A streamed voice loud enough to clip */
+  SDL_AudioMixerRemoveVoice(mixer, b);
+  c = SDL_AudioMixerAddStream(mixer, AUDIO_F32SYS, 1, 44100);
+  SDLTest_AssertCheck(c > 0, "Verify stream voice was added; got: %i", c);
+  SDL_AudioMixerSetVoiceVolume(mixer, c, 4.0f, 0.5f);
+  for (i = 0; i < SDL_arraysize(streamed); i++) {
+    streamed[i] = (i & 1) ? -0.5f : 0.125f;
+  }
+  SDLTest_AssertCheck(SDL_AudioMixerPutVoice(mixer, c, streamed, sizeof (streamed)) == 0, "Put audio on stream voice");
+  SDLTest_AssertCheck(SDL_AudioMixerPutVoice(mixer, a, streamed, sizeof (streamed)) == -1, "Verify finished voice is gone");
+  SDL_AudioMixerRender(mixer, out, 256 * 2 * sizeof (float));
+  failures = 0;
+  for (i = 0; i < 256; i++) {
+    l = (i >= 128) ? 0.0f : (i & 1) ? -1.0f : 0.25f;
+    r = (i >= 128) ? 0.0f : (i & 1) ? -1.0f : 0.5f;
+    if (out[i * 2] != l || out[i * 2 + 1] != r) {
+      failures++;
+    }
+  }
+  SDLTest_AssertCheck(failures == 0, "Verify clipped output; expected: 0 wrong frames, got: %i", failures);
+  SDLTest_AssertCheck(SDL_AudioMixerVoicePlaying(mixer, c), "Verify stream voice keeps playing");
+
+  SDL_FreeAudioMixer(mixer);
+  SDLTest_AssertPass("Call to SDL_FreeAudioMixer()");
+  SDL_free(out);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Resamples a sine wave with the sinc resamplers and checks its accuracy.
+ *
+ * \sa SDL_BuildAudioCVT
+ * \sa SDL_NewAudioStream
+ */
+int audio_resampleSinc()
+{
+  const char *modes[] = { "medium", "best" };
+  const double min_snr[] = { 60.0, 90.0 };
+  const int rates[][2] = { { 44100, 48000 }, { 48000, 44100 }, { 11025, 48000 }, { 44100, 44101 } };
+  const int frames = 4096;
+  SDL_AudioCVT cvt;
+  SDL_AudioStream *stream;
+  float *in = (float *)SDL_malloc(frames * sizeof (float));
+  float *out = (float *)SDL_malloc(frames * 6 * sizeof (float));
+  double signal, noise, ideal, snr;
+  int i, j, m, outframes, expected, result;
+
+  SDLTest_AssertCheck(in && out, "Check buffers are not NULL");
+  if (!in || !out) {
+    SDL_free(in);
+    SDL_free(out);
+    return TEST_ABORTED;
+  }
+
+  for (m = 0; m < SDL_arraysize(modes); m++) {
+    SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, modes[m]);
+    for (i = 0; i < SDL_arraysize(rates); i++) {
+      for (j = 0; j < frames; j++) {
+        in[j] = 0.5f * (float)SDL_sin(2.0 * M_PI * 1000.0 * j / rates[i][0]);
+      }
+
+      /* The whole buffer at once */
+      result = SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 1, rates[i][0], AUDIO_F32SYS, 1, rates[i][1]);
+      SDLTest_AssertCheck(result == 1, "Verify SDL_BuildAudioCVT(%i -> %i Hz, %s) result; expected: 1, got: %i", rates[i][0], rates[i][1], modes[m], result);
+      SDLTest_AssertCheck(frames * 4 * cvt.len_mult <= frames * 6 * (int)sizeof (float), "Verify buffer is large enough");
+      cvt.buf = (Uint8 *)out;
+      cvt.len = frames * sizeof (float);
+      SDL_memcpy(out, in, cvt.len);
+      SDL_ConvertAudio(&cvt);
+      expected = (int)(frames * cvt.rate_incr);
+      SDLTest_AssertCheck(cvt.len_cvt == expected * 4, "Verify converted length; expected: %i, got: %i", expected * 4, cvt.len_cvt);
+
+      /* Away from the edges, where the input runs out */
+      signal = noise = 0.0;
+      for (j = 100; j < expected - 100; j++) {
+        ideal = 0.5 * SDL_sin(2.0 * M_PI * 1000.0 * j / rates[i][1]);
+        signal += ideal * ideal;
+        noise += (out[j] - ideal) * (out[j] - ideal);
+      }
+      snr = 10.0 * SDL_log(signal / noise) / SDL_log(10.0);
+      SDLTest_AssertCheck(snr >= min_snr[m], "Verify SDL_ConvertAudio() SNR; expected: >= %.0f dB, got: %.1f dB", min_snr[m], snr);
+
+      /* The same through a stream, in uneven pieces */
+      stream = SDL_NewAudioStream(AUDIO_F32SYS, 1, rates[i][0], AUDIO_F32SYS, 1, rates[i][1]);
+      SDLTest_AssertCheck(stream != NULL, "Verify SDL_NewAudioStream() result is not NULL");
+      if (stream == NULL) {
+        continue;
+      }
+      for (j = 0; j < frames; j += 333) {
+        SDL_AudioStreamPut(stream, in + j, SDL_min(333, frames - j) * sizeof (float));
+      }
+      SDL_AudioStreamFlush(stream);
+      outframes = SDL_AudioStreamGet(stream, out, frames * 6 * sizeof (float)) / sizeof (float);
+      SDL_FreeAudioStream(stream);
+      expected = (int)((((Sint64)frames * rates[i][1]) + rates[i][0] - 1) / rates[i][0]);
+      SDLTest_AssertCheck(outframes == expected, "Verify stream output length; expected: %i, got: %i", expected, outframes);
+
+      signal = noise = 0.0;
+      for (j = 100; j < outframes - 100; j++) {
+        ideal = 0.5 * SDL_sin(2.0 * M_PI * 1000.0 * j / rates[i][1]);
+        signal += ideal * ideal;
+        noise += (out[j] - ideal) * (out[j] - ideal);
+      }
+      snr = 10.0 * SDL_log(signal / noise) / SDL_log(10.0);
+      SDLTest_AssertCheck(snr >= min_snr[m], "Verify SDL_AudioStream SNR; expected: >= %.0f dB, got: %.1f dB", min_snr[m], snr);
+    }
+  }
+
+  SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, "");
+  SDL_free(in);
+  SDL_free(out);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Checks that converting a long buffer, which is done in blocks,
+ *  gives what converting it in short pieces gives, and checks the values
+ *  of the converters that change the type and the channels at once.
+ *
+ * \sa SDL_BuildAudioCVT
+ * \sa SDL_ConvertAudio
+ */
+int audio_convertAudioBlocked()
+{
+  const struct {
+    SDL_AudioFormat src_format;
+    Uint8 src_channels;
+    SDL_AudioFormat dst_format;
+    Uint8 dst_channels;
+  } conversions[] = {
+    { AUDIO_S16SYS, 2, AUDIO_F32SYS, 6 },
+    { AUDIO_S16SYS, 2, AUDIO_F32SYS, 4 },
+    { AUDIO_S16SYS, 2, AUDIO_F32SYS, 1 },
+    { AUDIO_S16SYS, 1, AUDIO_F32SYS, 2 },
+    { AUDIO_F32SYS, 2, AUDIO_S16SYS, 1 },
+    { AUDIO_F32SYS, 1, AUDIO_S16SYS, 2 },
+    { AUDIO_S16MSB, 2, AUDIO_F32MSB, 6 },
+    { AUDIO_U8, 1, AUDIO_S32LSB, 4 },
+    { AUDIO_S32MSB, 6, AUDIO_U8, 1 },
+    { AUDIO_F32LSB, 4, AUDIO_S16MSB, 2 }
+  };
+  const char *features[] = { "0", "" };
+  const int frames = 20001;
+  const int piece = 500;
+  Uint8 *in = (Uint8 *)SDL_malloc(frames * 8 * 4);
+  Uint8 *whole = (Uint8 *)SDL_malloc(frames * 8 * 4 * 8);
+  Uint8 *pieces = (Uint8 *)SDL_malloc(frames * 8 * 4 * 8);
+  SDL_AudioCVT cvt;
+  int i, j, f, framesize, wholelen, pieceslen, result;
+  float maxerror;
+
+  SDLTest_AssertCheck(in && whole && pieces, "Check buffers are not NULL");
+  if (!in || !whole || !pieces) {
+    SDL_free(in);
+    SDL_free(whole);
+    SDL_free(pieces);
+    return TEST_ABORTED;
+  }
+
+  for (f = 0; f < SDL_arraysize(features); f++) {
+    SDL_setenv("SDL_AUDIO_CPU_FEATURES", features[f], 1);
+    for (i = 0; i < SDL_arraysize(conversions); i++) {
+      framesize = conversions[i].src_channels * (SDL_AUDIO_BITSIZE(conversions[i].src_format) / 8);
+      if (SDL_AUDIO_ISFLOAT(conversions[i].src_format)) {
+        for (j = 0; j < frames * conversions[i].src_channels; j++) {
+          float sample = (SDLTest_RandomFloat() * 2.0f) - 1.0f;
+          if (SDL_AUDIO_ISBIGENDIAN(conversions[i].src_format) != (SDL_BYTEORDER == SDL_BIG_ENDIAN)) {
+            sample = SDL_SwapFloat(sample);
+          }
+          SDL_memcpy(in + j * 4, &sample, 4);
+        }
+      } else {
+        for (j = 0; j < frames * framesize; j++) {
+          in[j] = (Uint8)SDLTest_RandomUint8();
+        }
+      }
+
+      result = SDL_BuildAudioCVT(&cvt, conversions[i].src_format, conversions[i].src_channels, 44100,
+                                 conversions[i].dst_format, conversions[i].dst_channels, 44100);
+      SDLTest_AssertCheck(result == 1, "Verify SDL_BuildAudioCVT(0x%.4x %i ch -> 0x%.4x %i ch) result; expected: 1, got: %i",
+                          conversions[i].src_format, conversions[i].src_channels,
+                          conversions[i].dst_format, conversions[i].dst_channels, result);
+      if (result != 1) {
+        continue;
+      }
+
+      cvt.buf = whole;
+      cvt.len = frames * framesize;
+      SDL_memcpy(cvt.buf, in, cvt.len);
+      SDL_ConvertAudio(&cvt);
+      wholelen = cvt.len_cvt;
+
+      pieceslen = 0;
+      for (j = 0; j < frames; j += piece) {
+        cvt.buf = pieces + pieceslen;
+        cvt.len = SDL_min(piece, frames - j) * framesize;
+        SDL_memcpy(cvt.buf, in + j * framesize, cvt.len);
+        SDL_ConvertAudio(&cvt);
+        pieceslen += cvt.len_cvt;
+      }
+
+      SDLTest_AssertCheck(wholelen == pieceslen, "Verify converted lengths match; whole: %i, in pieces: %i", wholelen, pieceslen);
+      SDLTest_AssertCheck(wholelen == pieceslen && SDL_memcmp(whole, pieces, wholelen) == 0,
+                          "Verify output for 0x%.4x %i ch -> 0x%.4x %i ch matches converting in pieces",
+                          conversions[i].src_format, conversions[i].src_channels,
+                          conversions[i].dst_format, conversions[i].dst_channels);
+
+      /* Stereo S16 to float 5.1, which is done in one pass */
+      if (i == 0) {
+        const Sint16 *src = (const Sint16 *)in;
+        const float *dst = (const float *)whole;
+        maxerror = 0.0f;
+        for (j = 0; j < frames; j++, src += 2, dst += 6) {
+          const float lf = src[0] / 32767.0f;
+          const float rf = src[1] / 32767.0f;
+          const float ce = (lf + rf) / 2.0f;
+          const float expected[6] = { lf, rf, lf - ce, rf - ce, ce, ce };
+          int chan;
+          for (chan = 0; chan < 6; chan++) {
+            maxerror = SDL_max(maxerror, (float)SDL_fabs(dst[chan] - expected[chan]));
+          }
+        }
+        SDLTest_AssertCheck(maxerror < 1e-6f, "Verify stereo to 5.1 output; expected: error < 1e-6, got: %g", maxerror);
+      }
+    }
+  }
+  SDL_setenv("SDL_AUDIO_CPU_FEATURES", "", 1);
+
+  SDL_free(in);
+  SDL_free(whole);
+  SDL_free(pieces);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Checks the timing counters of a playing device and the queued
+ *  latency of a device using the audio queue.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ * \sa SDL_ResetAudioDeviceStats
+ */
+int audio_deviceStats()
+{
+  SDL_AudioSpec desired, obtained;
+  SDL_AudioDeviceStats stats;
+  SDL_AudioDeviceID id;
+  Uint32 expected, total;
+  Uint8 *data;
+  int i, result;
+  SDL_bool started = SDL_FALSE;
+
+  /* Earlier tests may have stopped the driver with SDL_AudioQuit() */
+  if (SDL_GetCurrentAudioDriver() == NULL) {
+    result = SDL_AudioInit(NULL);
+    SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+    SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+    if (result != 0) {
+      return TEST_ABORTED;
+    }
+    started = SDL_TRUE;
+  }
+
+  SDL_memset(&desired, 0, sizeof (desired));
+  desired.freq = 22050;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 512;
+  desired.callback = _audio_testCallback;
+  id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 0, ...)");
+  if (id == 0) {
+    SDLTest_Log("No playback device could be opened: %s", SDL_GetError());
+    if (started) {
+      SDL_AudioQuit();
+    }
+    return TEST_SKIPPED;
+  }
+
+  /* Negative cases */
+  result = SDL_GetAudioDeviceStats(id, NULL);
+  SDLTest_AssertCheck(result == -1, "Verify SDL_GetAudioDeviceStats(id, NULL) result; expected: -1, got: %i", result);
+  result = SDL_GetAudioDeviceStats(id + 100, &stats);
+  SDLTest_AssertCheck(result == -1, "Verify SDL_GetAudioDeviceStats() result with an invalid device; expected: -1, got: %i", result);
+
+  /* Let the callback run a few times */
+  _audio_testCallbackCounter = 0;
+  SDL_PauseAudioDevice(id, 0);
+  for (i = 0; (i < 200) && (_audio_testCallbackCounter < 4); i++) {
+    SDL_Delay(10);
+  }
+  SDL_PauseAudioDevice(id, 1);
+  SDLTest_AssertCheck(_audio_testCallbackCounter >= 4, "Verify the callback ran; expected: >= 4, got: %i", _audio_testCallbackCounter);
+
+  result = SDL_GetAudioDeviceStats(id, &stats);
+  SDLTest_AssertPass("Call to SDL_GetAudioDeviceStats()");
+  SDLTest_AssertCheck(result == 0, "Verify SDL_GetAudioDeviceStats() result; expected: 0, got: %i", result);
+  expected = (Uint32) (((Uint64) obtained.samples * 1000000) / obtained.freq);
+  SDLTest_AssertCheck(stats.buffer_us == expected, "Verify buffer duration; expected: %u, got: %u", expected, stats.buffer_us);
+  SDLTest_AssertCheck(stats.callbacks == (Uint32) _audio_testCallbackCounter, "Verify callback count; expected: %i, got: %u", _audio_testCallbackCounter, stats.callbacks);
+  total = 0;
+  for (i = 0; i < SDL_AUDIO_STATS_HISTOGRAM_BUCKETS; i++) {
+    total += stats.callback_histogram[i];
+  }
+  SDLTest_AssertCheck(total == stats.callbacks, "Verify the histogram adds up to the callback count; expected: %u, got: %u", stats.callbacks, total);
+  SDLTest_AssertCheck(stats.callback_total_us >= stats.callback_max_us, "Verify total callback time is at least the longest callback");
+  SDLTest_AssertCheck(stats.underruns <= stats.late_wakes, "Verify every underrun is also a late wake; underruns: %u, late wakes: %u", stats.underruns, stats.late_wakes);
+
+  SDL_ResetAudioDeviceStats(id);
+  SDLTest_AssertPass("Call to SDL_ResetAudioDeviceStats()");
+  result = SDL_GetAudioDeviceStats(id, &stats);
+  SDLTest_AssertCheck(result == 0, "Verify SDL_GetAudioDeviceStats() result after reset; expected: 0, got: %i", result);
+  /* A paused device keeps playing silence, but never calls the callback */
+  SDLTest_AssertCheck(stats.callbacks == 0, "Verify callback count after reset; expected: 0, got: %u", stats.callbacks);
+  SDLTest_AssertCheck(stats.callback_max_us == 0 && stats.callback_total_us == 0, "Verify callback times after reset are 0");
+  total = 0;
+  for (i = 0; i < SDL_AUDIO_STATS_HISTOGRAM_BUCKETS; i++) {
+    total += stats.callback_histogram[i];
+  }
+  SDLTest_AssertCheck(total == 0, "Verify the histogram is empty after reset; expected: 0, got: %u", total);
+  SDLTest_AssertCheck(stats.buffer_us == expected, "Verify buffer duration after reset; expected: %u, got: %u", expected, stats.buffer_us);
+
+  SDL_CloseAudioDevice(id);
+  SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+  /* A second of queued audio on a paused device */
+  desired.callback = NULL;
+  id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+  SDLTest_AssertCheck(id != 0, "Verify queueing device was opened");
+  if (id != 0) {
+    const int len = obtained.freq * obtained.channels * 2;
+    data = (Uint8 *) SDL_calloc(1, len);
+    SDLTest_AssertCheck(data != NULL, "Check buffer is not NULL");
+    if (data != NULL) {
+      SDL_QueueAudio(id, data, len);
+      result = SDL_GetAudioDeviceStats(id, &stats);
+      SDLTest_AssertCheck(result == 0, "Verify SDL_GetAudioDeviceStats() result; expected: 0, got: %i", result);
+      SDLTest_AssertCheck(stats.queued_us == 1000000, "Verify queued latency; expected: 1000000, got: %u", stats.queued_us);
+      SDL_free(data);
+    }
+    SDL_CloseAudioDevice(id);
+  }
+
+  if (started) {
+    SDL_AudioQuit();
+  }
+  return TEST_COMPLETED;
+}
+
+
+/* Fills the buffer with a running byte count, starting from 0 */
+static Uint8 _audio_offlineCounter;
+
+void _audio_offlineCallback(void *userdata, Uint8 *stream, int len)
+{
+  int i;
+  for (i = 0; i < len; i++) {
+    stream[i] = _audio_offlineCounter++;
+  }
+}
+
+/**
+ * \brief Renders to a file with the disk audio driver in offline mode and
+ *  checks the device position against what was written.
+ *
+ * \sa SDL_HINT_AUDIO_DISK_OFFLINE
+ * \sa SDL_GetAudioDevicePosition
+ */
+int audio_diskOffline()
+{
+  const Uint64 target = 22050 * 5;
+  SDL_AudioSpec desired, obtained;
+  SDL_AudioDeviceID id;
+  SDL_RWops *rw;
+  Uint64 position, paused, start;
+  Sint64 size;
+  Uint8 head[64];
+  int i, result;
+
+  SDL_AudioQuit();
+  SDL_SetHint(SDL_HINT_AUDIO_DISK_OFFLINE, "1");
+  result = SDL_AudioInit("disk");
+  SDLTest_AssertPass("Call to SDL_AudioInit(\"disk\")");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+  if (result != 0) {
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_OFFLINE, "0");
+    SDL_AudioInit(NULL);
+    return TEST_ABORTED;
+  }
+
+  SDL_memset(&desired, 0, sizeof (desired));
+  desired.freq = 22050;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 512;
+  desired.callback = _audio_offlineCallback;
+  _audio_offlineCounter = 0;
+  id = SDL_OpenAudioDevice("sdlaudio.raw", 0, &desired, &obtained, 0);
+  SDLTest_AssertCheck(id != 0, "Verify disk device was opened");
+  if (id == 0) {
+    SDL_AudioQuit();
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_OFFLINE, "0");
+    SDL_AudioInit(NULL);
+    return TEST_ABORTED;
+  }
+
+  /* Nothing is written until the device is unpaused */
+  SDL_Delay(50);
+  position = SDL_GetAudioDevicePosition(id);
+  SDLTest_AssertCheck(position == 0, "Verify position of paused device; expected: 0, got: %u", (unsigned int) position);
+
+  /* Five seconds of audio take a lot less than five seconds */
+  start = SDL_GetTicks();
+  SDL_PauseAudioDevice(id, 0);
+  for (i = 0; (i < 5000) && (SDL_GetAudioDevicePosition(id) < target); i++) {
+    SDL_Delay(1);
+  }
+  SDL_PauseAudioDevice(id, 1);
+  position = SDL_GetAudioDevicePosition(id);
+  SDLTest_AssertCheck(position >= target, "Verify position; expected: >= %u, got: %u", (unsigned int) target, (unsigned int) position);
+  SDLTest_AssertCheck(SDL_GetTicks() - start < 5000, "Verify the device ran faster than real time; took %u ms", SDL_GetTicks() - (Uint32) start);
+
+  /* A paused offline device finishes the buffer it was working on at most */
+  SDL_Delay(50);
+  paused = SDL_GetAudioDevicePosition(id);
+  SDLTest_AssertCheck(paused - position <= obtained.samples, "Verify a paused device stops; position went from %u to %u", (unsigned int) position, (unsigned int) paused);
+  SDL_CloseAudioDevice(id);
+  SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+  rw = SDL_RWFromFile("sdlaudio.raw", "rb");
+  SDLTest_AssertCheck(rw != NULL, "Verify output file can be opened");
+  if (rw != NULL) {
+    size = SDL_RWsize(rw);
+    SDLTest_AssertCheck(size == (Sint64) (paused * 4), "Verify file size; expected: %u, got: %d", (unsigned int) (paused * 4), (int) size);
+    result = (int) SDL_RWread(rw, head, 1, sizeof (head));
+    SDLTest_AssertCheck(result == (int) sizeof (head), "Verify start of file can be read");
+    for (i = 0; i < (int) sizeof (head); i++) {
+      if (head[i] != (Uint8) i) {
+        break;
+      }
+    }
+    SDLTest_AssertCheck(i == (int) sizeof (head), "Verify the file starts with the first callback's data");
+    SDL_RWclose(rw);
+  }
+
+  SDL_AudioQuit();
+  SDL_SetHint(SDL_HINT_AUDIO_DISK_OFFLINE, "0");
+  result = SDL_AudioInit(NULL);
+  SDLTest_AssertCheck(result == 0, "Validate restarting the default driver; expected: 0 got: %d", result);
+  return TEST_COMPLETED;
+}
+
+/* Writes a WAVE file with random audio data into buf, returns its length */
+static int _audio_makeWAV(Uint8 *buf, Uint16 encoding, Uint16 channels, Uint16 bits, Uint16 align, Uint16 spb, int blocks)
+{
+  const Sint16 coeff[7][2] = { { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 }, { 240, 0 }, { 460, -208 }, { 392, -232 } };
+  const int fmtlen = (encoding == 2) ? 50 : (encoding == 0x11) ? 20 : 16;
+  const int datalen = align * blocks;
+  Uint8 *p = buf;
+  int i, b, c;
+
+#define PUT16(v) do { *p++ = (Uint8)((v) & 0xFF); *p++ = (Uint8)(((v) >> 8) & 0xFF); } while (0)
+#define PUT32(v) do { PUT16((v) & 0xFFFF); PUT16(((Uint32)(v)) >> 16); } while (0)
+  SDL_memcpy(p, "RIFF", 4); p += 4;
+  PUT32(4 + 8 + fmtlen + 8 + 3 + 1 + 8 + datalen);
+  SDL_memcpy(p, "WAVE", 4); p += 4;
+  SDL_memcpy(p, "fmt ", 4); p += 4;
+  PUT32(fmtlen);
+  PUT16(encoding);
+  PUT16(channels);
+  PUT32(22050);
+  PUT32(22050 * align);
+  PUT16(align);
+  PUT16(bits);
+  if (encoding == 2) {
+    PUT16(32);
+    PUT16(spb);
+    PUT16(7);
+    for (i = 0; i < 7; i++) {
+      PUT16(coeff[i][0]);
+      PUT16(coeff[i][1]);
+    }
+  } else if (encoding == 0x11) {
+    PUT16(2);
+    PUT16(spb);
+  }
+  /* An odd length chunk, which is followed by a pad byte */
+  SDL_memcpy(p, "JUNK", 4); p += 4;
+  PUT32(3);
+  *p++ = 1; *p++ = 2; *p++ = 3; *p++ = 0;
+  SDL_memcpy(p, "data", 4); p += 4;
+  PUT32(datalen);
+  for (b = 0; b < blocks; b++) {
+    Uint8 *block = p;
+    for (i = 0; i < align; i++) {
+      *p++ = (Uint8)SDLTest_RandomUint8();
+    }
+    for (c = 0; c < channels; c++) {
+      if (encoding == 2) {
+        block[c] = (Uint8)SDLTest_RandomIntegerInRange(0, 6);
+      } else if (encoding == 0x11) {
+        block[c * 4 + 2] = (Uint8)SDLTest_RandomIntegerInRange(0, 88);
+        block[c * 4 + 3] = 0;
+      }
+    }
+  }
+#undef PUT16
+#undef PUT32
+  return (int)(p - buf);
+}
+
+/**
+ * \brief Checks that reading a WAVE file with a reader, in pieces and after
+ *  seeking, gives the same audio as loading the whole file.
+ *
+ * \sa SDL_NewWAVReader
+ * \sa SDL_WAVReaderRead
+ * \sa SDL_WAVReaderSeek
+ * \sa SDL_LoadWAV_RW
+ */
+int audio_wavReader()
+{
+  const struct {
+    Uint16 encoding, channels, bits, align, spb;
+    int blocks;
+  } files[] = {
+    { 1, 1, 8, 1, 0, 10001 },
+    { 1, 2, 16, 4, 0, 9000 },
+    { 3, 2, 32, 8, 0, 5000 },
+    { 2, 1, 4, 256, 500, 20 },
+    { 2, 2, 4, 512, 500, 20 },
+    { 0x11, 1, 4, 256, 505, 20 },
+    { 0x11, 2, 4, 512, 505, 20 }
+  };
+  const int maxlen = 128 + 8 * 5000;
+  Uint8 *file, *whole, *pieces;
+  SDL_AudioSpec spec, readerspec;
+  SDL_WAVReader *reader;
+  Uint32 len, length, frame, pos;
+  int i, j, n, frame_size, filelen, result;
+
+  file = (Uint8 *)SDL_malloc(maxlen);
+  pieces = (Uint8 *)SDL_malloc(20 * 505 * 4 + 1024);
+  SDLTest_AssertCheck(file != NULL && pieces != NULL, "Check buffers are not NULL");
+  if (file == NULL || pieces == NULL) {
+    SDL_free(file);
+    SDL_free(pieces);
+    return TEST_ABORTED;
+  }
+
+  for (i = 0; i < SDL_arraysize(files); i++) {
+    filelen = _audio_makeWAV(file, files[i].encoding, files[i].channels, files[i].bits, files[i].align, files[i].spb, files[i].blocks);
+    if (SDL_LoadWAV_RW(SDL_RWFromConstMem(file, filelen), 1, &spec, &whole, &len) == NULL) {
+      SDLTest_AssertCheck(SDL_FALSE, "Load WAVE encoding 0x%x, %d channels: %s", files[i].encoding, files[i].channels, SDL_GetError());
+      continue;
+    }
+    reader = SDL_NewWAVReader(SDL_RWFromConstMem(file, filelen), 1, &readerspec);
+    SDLTest_AssertCheck(reader != NULL, "Verify reader for encoding 0x%x, %d channels was made", files[i].encoding, files[i].channels);
+    if (reader == NULL) {
+      SDL_FreeWAV(whole);
+      continue;
+    }
+    SDLTest_AssertCheck(readerspec.format == spec.format && readerspec.channels == spec.channels && readerspec.freq == spec.freq,
+                        "Verify reader spec matches SDL_LoadWAV_RW() spec");
+    frame_size = (SDL_AUDIO_BITSIZE(spec.format) / 8) * spec.channels;
+    length = SDL_WAVReaderLength(reader);
+    SDLTest_AssertCheck(length * frame_size == len, "Verify length; expected: %u, got: %u", len, length * frame_size);
+
+    /* Read it all in random pieces */
+    pos = 0;
+    do {
+      n = SDL_WAVReaderRead(reader, pieces + pos, SDLTest_RandomIntegerInRange(frame_size, 3000));
+      if (n > 0) {
+        pos += n;
+      }
+    } while (n > 0);
+    SDLTest_AssertCheck(n == 0, "Verify last read result; expected: 0, got: %d", n);
+    SDLTest_AssertCheck(pos == len && SDL_memcmp(pieces, whole, len) == 0, "Verify piecewise read matches for encoding 0x%x, %d channels", files[i].encoding, files[i].channels);
+
+    /* Seek around */
+    for (j = 0; j < 50; j++) {
+      const int want = SDLTest_RandomIntegerInRange(1, 2000);
+      frame = (Uint32)SDLTest_RandomIntegerInRange(0, length);
+      result = SDL_WAVReaderSeek(reader, frame);
+      n = SDL_WAVReaderRead(reader, pieces, want * frame_size);
+      if (result != 0 || n != (int)(SDL_min((Uint32)want, length - frame) * frame_size) ||
+          SDL_memcmp(pieces, whole + frame * frame_size, n) != 0 || SDL_WAVReaderTell(reader) != frame + n / frame_size) {
+        break;
+      }
+    }
+    SDLTest_AssertCheck(j == 50, "Verify reads after seeking match for encoding 0x%x, %d channels", files[i].encoding, files[i].channels);
+    result = SDL_WAVReaderSeek(reader, length + 1);
+    SDLTest_AssertCheck(result == -1, "Verify seeking past the end fails; expected: -1, got: %d", result);
+
+    SDL_FreeWAVReader(reader);
+    SDL_FreeWAV(whole);
+  }
+
+  /* A predictor past the coefficient table is an error, not a crash */
+  filelen = _audio_makeWAV(file, 2, 1, 4, 256, 500, 2);
+  file[filelen - 256] = 7;
+  reader = SDL_NewWAVReader(SDL_RWFromConstMem(file, filelen), 1, &readerspec);
+  SDLTest_AssertCheck(reader != NULL, "Verify reader was made");
+  if (reader != NULL) {
+    n = SDL_WAVReaderRead(reader, pieces, 1000 * 2);
+    SDLTest_AssertCheck(n == 500 * 2, "Verify reading stops at the bad block; expected: %d, got: %d", 500 * 2, n);
+    n = SDL_WAVReaderRead(reader, pieces, 1000 * 2);
+    SDLTest_AssertCheck(n == -1, "Verify reading the bad block fails; expected: -1, got: %d", n);
+    SDL_FreeWAVReader(reader);
+  }
+
+  /* More samples per block than the block can hold */
+  filelen = _audio_makeWAV(file, 0x11, 1, 4, 256, 513, 2);
+  reader = SDL_NewWAVReader(SDL_RWFromConstMem(file, filelen), 1, &readerspec);
+  SDLTest_AssertCheck(reader == NULL, "Verify a bad block layout is rejected");
+  SDL_FreeWAVReader(reader);
+
+  /* More channels than an SDL_AudioSpec holds */
+  filelen = _audio_makeWAV(file, 1, 256, 8, 256, 1, 2);
+  reader = SDL_NewWAVReader(SDL_RWFromConstMem(file, filelen), 1, &readerspec);
+  SDLTest_AssertCheck(reader == NULL, "Verify 256 channels are rejected");
+  SDL_FreeWAVReader(reader);
+
+  /* A zero sample rate */
+  filelen = _audio_makeWAV(file, 1, 1, 8, 1, 1, 2);
+  SDL_memset(file + 24, 0, 4);
+  reader = SDL_NewWAVReader(SDL_RWFromConstMem(file, filelen), 1, &readerspec);
+  SDLTest_AssertCheck(reader == NULL, "Verify a zero sample rate is rejected");
+  SDL_FreeWAVReader(reader);
+
+  reader = SDL_NewWAVReader(NULL, 0, &readerspec);
+  SDLTest_AssertCheck(reader == NULL, "Verify SDL_NewWAVReader(NULL, ...) fails");
+
+  SDL_free(file);
+  SDL_free(pieces);
+  return TEST_COMPLETED;
+}
+
+
+/**
+ * \brief Checks that ADPCM blocks decode to the samples the MS ADPCM and
+ *  IMA ADPCM specifications give for them.
+ *
+ * The expected samples were worked out from the specifications, apart
+ * from SDL, so they also catch changes SDL_LoadWAV_RW() would share.
+ *
+ * \sa SDL_LoadWAV_RW
+ * \sa SDL_NewWAVReader
+ */
+int audio_wavDecodeKnownBlocks()
+{
+  const struct {
+    Uint16 encoding, channels, align, spb;
+    Uint8 block[24];
+    Sint16 samples[34];
+  } blocks[] = {
+    /* MS ADPCM, mono */
+    { 2, 1, 16, 20,
+      {
+        0x05, 0x2c, 0x01, 0x50, 0xfb, 0x7c, 0xfc, 0x3c, 0xa3, 0x34, 0x72, 0xd7, 0xfb, 0xe1, 0x7a,
+        0x01
+      },
+      {
+        -900, -1200, -525, -1045, -3383, -3297, -1441, 2165, 9415, 18140, 20928, 31287, 32767,
+        20502, 1938, -9457, 4813, -31728, -32768, -18709
+      }
+    },
+    /* MS ADPCM, stereo */
+    { 2, 2, 24, 12,
+      {
+        0x01, 0x06, 0x10, 0x00, 0x90, 0x01, 0xb8, 0x0b, 0xec, 0xff, 0x54, 0x0b, 0x2d, 0x00, 0x29,
+        0x38, 0x93, 0x32, 0xe6, 0x05, 0xfb, 0xa0, 0x6b, 0xcb
+      },
+      {
+        2900, 45, 3000, -20, 3132, -2871, 3312, -12050, 3380, -7218, 3562, 5036, 3676, 28178, 3790,
+        32767, 3878, -12442, 3828, -32768, 4054, -32768, 3912, -32768
+      }
+    },
+    /* IMA ADPCM, mono */
+    { 0x11, 1, 16, 25,
+      {
+        0x30, 0xf8, 0x1e, 0x00, 0x80, 0xb2, 0xb6, 0xc0, 0x27, 0xae, 0x2d, 0x95, 0x93, 0xea, 0x48,
+        0x9e
+      },
+      {
+        -2000, -1984, -1998, -1932, -2016, -1873, -2009, -1992, -2138, -1845, -1635, -2133, -2473,
+        -3151, -2699, -1795, -2155, -1389, -1687, -2139, -3208, -3353, -2161, -4244, -5096
+      }
+    },
+    /* IMA ADPCM, stereo */
+    { 0x11, 2, 24, 17,
+      {
+        0xe8, 0x03, 0x00, 0x00, 0x00, 0x7d, 0x32, 0x00, 0x0c, 0xbc, 0xba, 0xec, 0xd8, 0x2e, 0xcc,
+        0xff, 0x3b, 0xd9, 0xfb, 0xcb, 0x84, 0xd7, 0xf5, 0x0c
+      },
+      {
+        1000, 32000, 993, 31891, 994, 30797, 985, 28903, 977, 30194, 972, 28082, 965, 25526, 958,
+        20373, 944, 9323, 930, 23537, 941, 21626, 937, 32767, 921, -8199, 907, 32767, 877, -28669,
+        848, -32768, 814, -28673
+      }
+    }
+  };
+  Uint8 file[128 + 24];
+  Uint8 decoded[34 * 2];
+  SDL_AudioSpec spec;
+  SDL_WAVReader *reader;
+  Uint8 *whole;
+  Uint32 len;
+  int i, j, n, count, filelen, mismatches;
+
+  for (i = 0; i < SDL_arraysize(blocks); i++) {
+    count = blocks[i].spb * blocks[i].channels;
+    filelen = _audio_makeWAV(file, blocks[i].encoding, blocks[i].channels, 4, blocks[i].align, blocks[i].spb, 1);
+    SDL_memcpy(file + filelen - blocks[i].align, blocks[i].block, blocks[i].align);
+
+    if (SDL_LoadWAV_RW(SDL_RWFromConstMem(file, filelen), 1, &spec, &whole, &len) == NULL) {
+      SDLTest_AssertCheck(SDL_FALSE, "Load WAVE encoding 0x%x, %d channels: %s", blocks[i].encoding, blocks[i].channels, SDL_GetError());
+      continue;
+    }
+    SDLTest_AssertCheck(spec.format == AUDIO_S16LSB && len == (Uint32)count * 2,
+                        "Verify decoded format and length; expected: 0x%x and %d, got: 0x%x and %u", AUDIO_S16LSB, count * 2, spec.format, len);
+    mismatches = 0;
+    for (j = 0; j < count && (Uint32)j * 2 < len; j++) {
+      if ((Sint16)(whole[j * 2] | (whole[j * 2 + 1] << 8)) != blocks[i].samples[j]) {
+        mismatches++;
+      }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify SDL_LoadWAV_RW() samples for encoding 0x%x, %d channels, got %d mismatches",
+                        blocks[i].encoding, blocks[i].channels, mismatches);
+    SDL_FreeWAV(whole);
+
+    reader = SDL_NewWAVReader(SDL_RWFromConstMem(file, filelen), 1, &spec);
+    SDLTest_AssertCheck(reader != NULL, "Verify reader for encoding 0x%x, %d channels was made", blocks[i].encoding, blocks[i].channels);
+    if (reader == NULL) {
+      continue;
+    }
+    n = SDL_WAVReaderRead(reader, decoded, sizeof (decoded));
+    SDLTest_AssertCheck(n == count * 2, "Verify read length; expected: %d, got: %d", count * 2, n);
+    mismatches = 0;
+    for (j = 0; j < count && j * 2 < n; j++) {
+      if ((Sint16)(decoded[j * 2] | (decoded[j * 2 + 1] << 8)) != blocks[i].samples[j]) {
+        mismatches++;
+      }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify reader samples for encoding 0x%x, %d channels, got %d mismatches",
+                        blocks[i].encoding, blocks[i].channels, mismatches);
+    SDL_FreeWAVReader(reader);
+  }
+
+  return TEST_COMPLETED;
+}
+
 
 /* ================= Test Case References ================== */
 
@@ -1022,11 +2167,45 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_audioStream, "audio_audioStream", "Convert audio in chunks with an audio stream.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_convertTypesSIMD, "audio_convertTypesSIMD", "Compare vectorized sample type conversion with the C converters.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_mixAudioSIMD, "audio_mixAudioSIMD", "Compare vectorized audio mixing with the C mixer.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_queueAudio, "audio_queueAudio", "Queue audio and check the queued size.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest20 =
+        { (SDLTest_TestCaseFp)audio_audioMixer, "audio_audioMixer", "Mix voices with an audio mixer.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest21 =
+        { (SDLTest_TestCaseFp)audio_resampleSinc, "audio_resampleSinc", "Check the accuracy of the sinc resamplers.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest22 =
+        { (SDLTest_TestCaseFp)audio_convertAudioBlocked, "audio_convertAudioBlocked", "Check long conversions done in blocks.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest23 =
+        { (SDLTest_TestCaseFp)audio_deviceStats, "audio_deviceStats", "Check the timing counters of an audio device.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest24 =
+        { (SDLTest_TestCaseFp)audio_diskOffline, "audio_diskOffline", "Render to a file faster than real time with the disk driver.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest25 =
+        { (SDLTest_TestCaseFp)audio_wavReader, "audio_wavReader", "Stream WAVE files in pieces and with seeking.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest26 =
+        { (SDLTest_TestCaseFp)audio_wavDecodeKnownBlocks, "audio_wavDecodeKnownBlocks", "Decode ADPCM blocks with known samples.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, &audioTest17, &audioTest18, &audioTest19,
+    &audioTest20, &audioTest21, &audioTest22, &audioTest23, &audioTest24, &audioTest25, &audioTest26, NULL
 };
 
 /* Audio test suite (global) */
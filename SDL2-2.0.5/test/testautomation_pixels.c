@@ -500,6 +500,279 @@ pixels_calcGammaRamp(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Call to SDL_MapRGB with a palettized format, often enough for SDL to build an inverse colormap
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_MapRGB
+ */
+int
+pixels_mapRGBPalette(void *arg)
+{
+  SDL_PixelFormat *format;
+  SDL_Palette *palette;
+  SDL_Color colors[256];
+  int i, j, failures = 0;
+
+  format = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+  SDLTest_AssertPass("Call to SDL_AllocFormat()");
+  SDLTest_AssertCheck(format != NULL, "Verify result is not NULL");
+  palette = SDL_AllocPalette(256);
+  SDLTest_AssertPass("Call to SDL_AllocPalette()");
+  SDLTest_AssertCheck(palette != NULL, "Verify result is not NULL");
+  if (format == NULL || palette == NULL) {
+    SDL_FreeFormat(format);
+    SDL_FreePalette(palette);
+    return TEST_ABORTED;
+  }
+
+  /* Random colors with a few duplicates and one transparent entry */
+  for (i = 0; i < 256; i++) {
+    colors[i].r = SDLTest_RandomUint8();
+    colors[i].g = SDLTest_RandomUint8();
+    colors[i].b = SDLTest_RandomUint8();
+    colors[i].a = 255;
+    if (i % 17 == 16) {
+      colors[i] = colors[i / 2];
+    }
+  }
+  colors[5].a = 0;
+  SDL_SetPaletteColors(palette, colors, 0, 256);
+  SDLTest_AssertPass("Call to SDL_SetPaletteColors()");
+  SDL_SetPixelFormatPalette(format, palette);
+  SDLTest_AssertPass("Call to SDL_SetPixelFormatPalette()");
+
+  for (i = 0; i < 20000; i++) {
+    Uint8 r = SDLTest_RandomUint8(), g = SDLTest_RandomUint8(), b = SDLTest_RandomUint8();
+    Uint32 pixel = SDL_MapRGB(format, r, g, b);
+    unsigned int smallest = ~0u;
+    int expected = 0;
+
+    /* The closest color, first one on ties */
+    for (j = 0; j < 256; j++) {
+      int rd = colors[j].r - r, gd = colors[j].g - g, bd = colors[j].b - b, ad = colors[j].a - 255;
+      unsigned int distance = rd * rd + gd * gd + bd * bd + ad * ad;
+      if (distance < smallest) {
+        smallest = distance;
+        expected = j;
+      }
+    }
+    if (pixel != (Uint32)expected) {
+      failures++;
+    }
+  }
+  SDLTest_AssertCheck(failures == 0, "Verify SDL_MapRGB() returns the closest palette entries, got %i failures", failures);
+
+  SDL_FreeFormat(format);
+  SDLTest_AssertPass("Call to SDL_FreeFormat()");
+  SDL_FreePalette(palette);
+  SDLTest_AssertPass("Call to SDL_FreePalette()");
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Calls to SDL_MapRGB with more palettized formats in turn than SDL keeps inverse colormaps for
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_MapRGB
+ */
+int
+pixels_mapRGBPalettes(void *arg)
+{
+  SDL_PixelFormat *formats[6];
+  SDL_Palette *palettes[6];
+  SDL_Color colors[6][256];
+  int i, j, p, ret, failures = 0;
+
+  SDL_zero(formats);
+  SDL_zero(palettes);
+  for (p = 0; p < SDL_arraysize(formats); p++) {
+    formats[p] = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+    palettes[p] = SDL_AllocPalette(256);
+    SDLTest_AssertCheck(formats[p] != NULL && palettes[p] != NULL, "Verify format and palette %i are not NULL", p);
+    if (formats[p] == NULL || palettes[p] == NULL) {
+      goto out;
+    }
+    for (i = 0; i < 256; i++) {
+      colors[p][i].r = SDLTest_RandomUint8();
+      colors[p][i].g = SDLTest_RandomUint8();
+      colors[p][i].b = SDLTest_RandomUint8();
+      colors[p][i].a = 255;
+    }
+    SDL_SetPaletteColors(palettes[p], colors[p], 0, 256);
+    ret = SDL_SetPixelFormatPalette(formats[p], palettes[p]);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SetPixelFormatPalette(), expected: 0, got: %i", ret);
+  }
+
+  /* Enough calls to build maps and give some of them up again */
+  for (i = 0; i < 60000; i++) {
+    Uint8 r = SDLTest_RandomUint8(), g = SDLTest_RandomUint8(), b = SDLTest_RandomUint8();
+    Uint32 pixel;
+    unsigned int smallest = ~0u;
+    int expected = 0;
+
+    p = i % SDL_arraysize(formats);
+    pixel = SDL_MapRGB(formats[p], r, g, b);
+    for (j = 0; j < 256; j++) {
+      int rd = colors[p][j].r - r, gd = colors[p][j].g - g, bd = colors[p][j].b - b;
+      unsigned int distance = rd * rd + gd * gd + bd * bd;
+      if (distance < smallest) {
+        smallest = distance;
+        expected = j;
+      }
+    }
+    if (pixel != (Uint32)expected) {
+      failures++;
+    }
+  }
+  SDLTest_AssertCheck(failures == 0, "Verify SDL_MapRGB() returns the closest palette entries, got %i failures", failures);
+
+out:
+  for (p = 0; p < SDL_arraysize(formats); p++) {
+    if (formats[p] != NULL) {
+      SDL_FreeFormat(formats[p]);
+    }
+    if (palettes[p] != NULL) {
+      SDL_FreePalette(palettes[p]);
+    }
+  }
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Repeated calls to SDL_AllocFormat share one reference counted format, except for indexed formats
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_AllocFormat
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_FreeFormat
+ */
+int
+pixels_sharedFormats(void *arg)
+{
+  SDL_PixelFormat *first, *second;
+  Uint32 format;
+  int i, refcount;
+
+  /* Every RGB format is shared, other tests may hold references to it too */
+  for (i = 0; i < _numRGBPixelFormats; i++) {
+    format = _RGBPixelFormats[i];
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+      continue;
+    }
+    first = SDL_AllocFormat(format);
+    SDLTest_AssertCheck(first != NULL, "Verify %s is not NULL", _RGBPixelFormatsVerbose[i]);
+    if (first == NULL) {
+      continue;
+    }
+    refcount = first->refcount;
+    second = SDL_AllocFormat(format);
+    SDLTest_AssertCheck(second == first, "Verify %s is shared", _RGBPixelFormatsVerbose[i]);
+    SDLTest_AssertCheck(first->refcount == refcount + 1, "Verify refcount of %s; expected: %i, got %i",
+                        _RGBPixelFormatsVerbose[i], refcount + 1, first->refcount);
+    SDL_FreeFormat(second);
+    SDLTest_AssertCheck(first->refcount == refcount, "Verify refcount of %s after SDL_FreeFormat(); expected: %i, got %i",
+                        _RGBPixelFormatsVerbose[i], refcount, first->refcount);
+    SDL_FreeFormat(first);
+  }
+
+  /* Indexed formats own their palettes, so they aren't */
+  first = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+  second = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+  SDLTest_AssertCheck(first != NULL && second != NULL, "Verify SDL_PIXELFORMAT_INDEX8 is not NULL");
+  if (first != NULL && second != NULL) {
+    SDLTest_AssertCheck(first != second, "Verify SDL_PIXELFORMAT_INDEX8 is not shared");
+    SDLTest_AssertCheck(first->refcount == 1 && second->refcount == 1, "Verify refcounts of SDL_PIXELFORMAT_INDEX8; expected: 1 and 1, got %i and %i",
+                        first->refcount, second->refcount);
+  }
+  SDL_FreeFormat(first);
+  SDL_FreeFormat(second);
+
+  /* A format nothing else uses goes away with its last reference, and comes back in one piece */
+  for (i = 0; i < 3; i++) {
+    first = SDL_AllocFormat(SDL_PIXELFORMAT_BGRA4444);
+    SDLTest_AssertCheck(first != NULL, "Verify SDL_PIXELFORMAT_BGRA4444 is not NULL");
+    if (first == NULL) {
+      return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(first->refcount == 1, "Verify refcount of a new format; expected: 1, got %i", first->refcount);
+    SDLTest_AssertCheck(first->format == SDL_PIXELFORMAT_BGRA4444 && first->BytesPerPixel == 2 && first->Amask == 0x000F,
+                        "Verify fields of SDL_PIXELFORMAT_BGRA4444");
+    second = SDL_AllocFormat(SDL_PIXELFORMAT_BGRA4444);
+    SDLTest_AssertCheck(second == first && first->refcount == 2, "Verify SDL_PIXELFORMAT_BGRA4444 is shared again");
+    SDL_FreeFormat(second);
+    SDL_FreeFormat(first);
+  }
+
+  return TEST_COMPLETED;
+}
+
+/* State shared by the threads of pixels_sharedFormatsThreads */
+typedef struct
+{
+  SDL_atomic_t failures;
+  int iterations;
+} _SharedFormatsData;
+
+static int SDLCALL
+_sharedFormatsThread(void *arg)
+{
+  _SharedFormatsData *data = (_SharedFormatsData *)arg;
+  const Uint32 formats[] = {
+    SDL_PIXELFORMAT_BGRA4444, SDL_PIXELFORMAT_ABGR1555, SDL_PIXELFORMAT_BGR565, SDL_PIXELFORMAT_INDEX8
+  };
+  SDL_PixelFormat *held[SDL_arraysize(formats)];
+  int i, j;
+
+  for (i = 0; i < data->iterations; i++) {
+    for (j = 0; j < SDL_arraysize(formats); j++) {
+      held[j] = SDL_AllocFormat(formats[(i + j) % SDL_arraysize(formats)]);
+    }
+    for (j = 0; j < SDL_arraysize(formats); j++) {
+      if (held[j] == NULL || held[j]->format != formats[(i + j) % SDL_arraysize(formats)] || held[j]->refcount < 1) {
+        SDL_AtomicIncRef(&data->failures);
+      }
+    }
+    for (j = 0; j < SDL_arraysize(formats); j++) {
+      SDL_FreeFormat(held[j]);
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief SDL_AllocFormat and SDL_FreeFormat of the same formats on several threads at once
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_AllocFormat
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_FreeFormat
+ */
+int
+pixels_sharedFormatsThreads(void *arg)
+{
+  _SharedFormatsData data;
+  SDL_Thread *threads[4];
+  SDL_PixelFormat *format;
+  int i;
+
+  SDL_AtomicSet(&data.failures, 0);
+  data.iterations = 5000;
+  for (i = 0; i < SDL_arraysize(threads); i++) {
+    threads[i] = SDL_CreateThread(_sharedFormatsThread, "SharedFormats", &data);
+    SDLTest_AssertCheck(threads[i] != NULL, "Verify SDL_CreateThread() result is not NULL");
+  }
+  for (i = 0; i < SDL_arraysize(threads); i++) {
+    SDL_WaitThread(threads[i], NULL);
+  }
+  SDLTest_AssertCheck(SDL_AtomicGet(&data.failures) == 0, "Verify formats allocated on threads, got %i failures",
+                      SDL_AtomicGet(&data.failures));
+
+  /* Every reference was given back */
+  format = SDL_AllocFormat(SDL_PIXELFORMAT_BGRA4444);
+  SDLTest_AssertCheck(format != NULL && format->refcount == 1, "Verify refcount after the threads; expected: 1, got %i",
+                      format ? format->refcount : 0);
+  SDL_FreeFormat(format);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -515,9 +788,21 @@ static const SDLTest_TestCaseReference pixelsTest3 =
 static const SDLTest_TestCaseReference pixelsTest4 =
         { (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference pixelsTest5 =
+        { (SDLTest_TestCaseFp)pixels_mapRGBPalette, "pixels_mapRGBPalette", "Call to SDL_MapRGB with a palettized format", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference pixelsTest6 =
+        { (SDLTest_TestCaseFp)pixels_sharedFormats, "pixels_sharedFormats", "Calls to SDL_AllocFormat sharing one format", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference pixelsTest7 =
+        { (SDLTest_TestCaseFp)pixels_sharedFormatsThreads, "pixels_sharedFormatsThreads", "Calls to SDL_AllocFormat and SDL_FreeFormat on several threads", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference pixelsTest8 =
+        { (SDLTest_TestCaseFp)pixels_mapRGBPalettes, "pixels_mapRGBPalettes", "Calls to SDL_MapRGB with several palettized formats in turn", TEST_ENABLED };
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] =  {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, &pixelsTest6, &pixelsTest7, &pixelsTest8, NULL
 };
 
 /* Pixels test suite (global) */
@@ -1574,6 +1574,88 @@ int rect_testRectEqualsParam(void *arg)
     return TEST_COMPLETED;
 }
 
+/* !
+ * \brief Tests SDL_IntersectRects(), SDL_CullRects() and SDL_ClipPoints() against their single item counterparts
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_IntersectRect
+ * http://wiki.libsdl.org/moin.cgi/SDL_HasIntersection
+ */
+int rect_testIntersectRects(void *arg)
+{
+    const int numItems = 33;
+    SDL_Rect clip;
+    SDL_Rect rects[33];
+    SDL_Rect result[33];
+    SDL_Point points[33];
+    SDL_Point pointResult[33];
+    SDL_Rect expected;
+    int count, n, i;
+
+    clip.x = SDLTest_RandomIntegerInRange(-64, 64);
+    clip.y = SDLTest_RandomIntegerInRange(-64, 64);
+    clip.w = SDLTest_RandomIntegerInRange(1, 128);
+    clip.h = SDLTest_RandomIntegerInRange(1, 128);
+    for (i = 0; i < numItems; i++) {
+        rects[i].x = SDLTest_RandomIntegerInRange(-256, 256);
+        rects[i].y = SDLTest_RandomIntegerInRange(-256, 256);
+        rects[i].w = SDLTest_RandomIntegerInRange(-8, 256);
+        rects[i].h = SDLTest_RandomIntegerInRange(-8, 256);
+        points[i].x = SDLTest_RandomIntegerInRange(-256, 256);
+        points[i].y = SDLTest_RandomIntegerInRange(-256, 256);
+    }
+
+    count = SDL_IntersectRects(rects, numItems, &clip, result);
+    for (i = 0, n = 0; i < numItems; i++) {
+        if (SDL_IntersectRect(&rects[i], &clip, &expected)) {
+            SDLTest_AssertCheck(n < count && SDL_RectEquals(&result[n], &expected),
+                "Check SDL_IntersectRects() result %d: expected (%d,%d,%d,%d)",
+                n, expected.x, expected.y, expected.w, expected.h);
+            n++;
+        }
+    }
+    SDLTest_AssertCheck(count == n, "Check SDL_IntersectRects() count: expected %d, got %d", n, count);
+
+    count = SDL_CullRects(rects, numItems, &clip, result);
+    for (i = 0, n = 0; i < numItems; i++) {
+        if (SDL_HasIntersection(&rects[i], &clip)) {
+            SDLTest_AssertCheck(n < count && SDL_RectEquals(&result[n], &rects[i]),
+                "Check SDL_CullRects() result %d: expected (%d,%d,%d,%d)",
+                n, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+            n++;
+        }
+    }
+    SDLTest_AssertCheck(count == n, "Check SDL_CullRects() count: expected %d, got %d", n, count);
+
+    count = SDL_ClipPoints(points, numItems, &clip, pointResult);
+    for (i = 0, n = 0; i < numItems; i++) {
+        if (SDL_PointInRect(&points[i], &clip)) {
+            SDLTest_AssertCheck(n < count && pointResult[n].x == points[i].x && pointResult[n].y == points[i].y,
+                "Check SDL_ClipPoints() result %d: expected (%d,%d)", n, points[i].x, points[i].y);
+            n++;
+        }
+    }
+    SDLTest_AssertCheck(count == n, "Check SDL_ClipPoints() count: expected %d, got %d", n, count);
+
+    /* The result may be the source array */
+    SDL_memcpy(result, rects, sizeof(rects));
+    n = SDL_IntersectRects(rects, numItems, &clip, rects);
+    count = SDL_IntersectRects(result, numItems, &clip, result);
+    SDLTest_AssertCheck(count == n && SDL_memcmp(result, rects, n * sizeof(SDL_Rect)) == 0,
+        "Check SDL_IntersectRects() in place");
+
+    /* Invalid parameters */
+    count = SDL_IntersectRects(NULL, numItems, &clip, result);
+    SDLTest_AssertCheck(count == -1, "Check that SDL_IntersectRects() returns -1 when rects is NULL");
+    count = SDL_CullRects(rects, numItems, NULL, result);
+    SDLTest_AssertCheck(count == -1, "Check that SDL_CullRects() returns -1 when clip is NULL");
+    count = SDL_ClipPoints(points, -1, &clip, pointResult);
+    SDLTest_AssertCheck(count == -1, "Check that SDL_ClipPoints() returns -1 when count is negative");
+    SDL_ClearError();
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Rect test cases */
@@ -1673,6 +1755,11 @@ static const SDLTest_TestCaseReference rectTest28 =
 static const SDLTest_TestCaseReference rectTest29 =
         { (SDLTest_TestCaseFp)rect_testRectEqualsParam, "rect_testRectEqualsParam", "Negative tests against SDL_RectEquals with invalid parameters", TEST_ENABLED };
 
+/* SDL_IntersectRects, SDL_CullRects, SDL_ClipPoints */
+
+static const SDLTest_TestCaseReference rectTest30 =
+        { (SDLTest_TestCaseFp)rect_testIntersectRects, "rect_testIntersectRects", "Tests the batched SDL_IntersectRects, SDL_CullRects and SDL_ClipPoints", TEST_ENABLED };
+
 
 /* !
  * \brief Sequence of Rect test cases; functions that handle simple rectangles including overlaps and merges.
@@ -1683,7 +1770,7 @@ static const SDLTest_TestCaseReference rectTest29 =
 static const SDLTest_TestCaseReference *rectTests[] =  {
     &rectTest1, &rectTest2, &rectTest3, &rectTest4, &rectTest5, &rectTest6, &rectTest7, &rectTest8, &rectTest9, &rectTest10, &rectTest11, &rectTest12, &rectTest13, &rectTest14,
     &rectTest15, &rectTest16, &rectTest17, &rectTest18, &rectTest19, &rectTest20, &rectTest21, &rectTest22, &rectTest23, &rectTest24, &rectTest25, &rectTest26, &rectTest27,
-    &rectTest28, &rectTest29, NULL
+    &rectTest28, &rectTest29, &rectTest30, NULL
 };
 
 
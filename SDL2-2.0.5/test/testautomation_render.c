@@ -36,6 +36,11 @@ static SDL_Texture *_loadTestFace(void);
 static int _hasBlendModes(void);
 static int _hasDrawColor(void);
 static int _isSupported(int code);
+static int _readTextureLuma(SDL_Texture *texture);
+static void _renderTiledCase(SDL_Renderer *target, SDL_Texture *texture, int which);
+static int _countDifferingPixels(SDL_Surface *a, SDL_Surface *b);
+static Uint32 _referenceYUVPixel(Uint32 format, int mode, const Uint8 *frame, int w, int h, int x, int y);
+static int _convertYUVFrame(Uint32 format, const Uint8 *frame, SDL_Surface *target);
 
 /**
  * Create software renderer for tests
@@ -765,6 +770,109 @@ render_testBlitBlend (void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Tests queueing frames for a YUV texture.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateYUVTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testUpdateYUVTextureAsync(void *arg)
+{
+   Uint8 planes[64 * 32 * 3 / 2];
+   Uint8 *Yplane = planes, *Uplane = planes + 64 * 32, *Vplane = Uplane + 64 * 32 / 4;
+   SDL_Texture *texture;
+   int frame, tries, luma, ret;
+
+   texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, 64, 32);
+   SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   if (texture == NULL) {
+       return TEST_ABORTED;
+   }
+
+   /* Queue flat grey frames, each brighter than the one before */
+   SDL_memset(Uplane, 128, 64 * 32 / 2);
+   for (frame = 1; frame <= 4; ++frame) {
+      SDL_memset(Yplane, frame * 50, 64 * 32);
+      ret = SDL_UpdateYUVTextureAsync(texture, Yplane, 64, Uplane, 32, Vplane, 32);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateYUVTextureAsync, expected: 0, got: %i", ret);
+   }
+
+   /* The last frame shows up once it is converted, and then stays */
+   luma = 0;
+   for (tries = 0; tries < 200 && luma != 200; ++tries) {
+      luma = _readTextureLuma(texture);
+      SDLTest_AssertCheck(luma == 0 || luma == 50 || luma == 100 || luma == 150 || luma == 200,
+                          "Validate frame luma, got: %i", luma);
+      if (luma != 200) {
+         SDL_Delay(10);
+      }
+   }
+   SDLTest_AssertCheck(luma == 200, "Validate last queued frame is shown, expected: 200, got: %i", luma);
+   luma = _readTextureLuma(texture);
+   SDLTest_AssertCheck(luma == 200, "Validate last queued frame stays, expected: 200, got: %i", luma);
+
+   /* A direct update goes after the queued frames */
+   SDL_memset(Yplane, 200, 64 * 32);
+   ret = SDL_UpdateYUVTextureAsync(texture, Yplane, 64, Uplane, 32, Vplane, 32);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateYUVTextureAsync, expected: 0, got: %i", ret);
+   SDL_memset(Yplane, 30, 64 * 32);
+   ret = SDL_UpdateYUVTexture(texture, NULL, Yplane, 64, Uplane, 32, Vplane, 32);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateYUVTexture, expected: 0, got: %i", ret);
+   luma = _readTextureLuma(texture);
+   SDLTest_AssertCheck(luma == 30, "Validate direct update is shown, expected: 30, got: %i", luma);
+
+   SDL_DestroyTexture(texture);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests drawing lines wider than a pixel.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_SetRenderDrawLineWidth
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderDrawLine
+ */
+int
+render_testLineWidth(void *arg)
+{
+   SDL_Rect rect;
+   Uint32 pixels[7];
+   float width = 0.0f;
+   int ret, i;
+
+   ret = SDL_SetRenderDrawLineWidth(renderer, 0.0f);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_SetRenderDrawLineWidth(0), expected: -1, got: %i", ret);
+   ret = SDL_SetRenderDrawLineWidth(renderer, 3.0f);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderDrawLineWidth, expected: 0, got: %i", ret);
+   ret = SDL_GetRenderDrawLineWidth(renderer, &width);
+   SDLTest_AssertCheck(ret == 0 && width == 3.0f, "Validate line width, expected: 3, got: %f", width);
+
+   /* A horizontal line three pixels wide covers the row above and below */
+   _clearScreen();
+   ret = SDL_SetRenderDrawColor(renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderDrawColor, expected: 0, got: %i", ret);
+   ret = SDL_RenderDrawLine(renderer, 10, 20, 50, 20);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderDrawLine, expected: 0, got: %i", ret);
+
+   rect.x = 30;
+   rect.y = 17;
+   rect.w = 1;
+   rect.h = 7;
+   ret = SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_ARGB8888, pixels, 4);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   for (i = 0; i < 7; ++i) {
+      const Uint32 expected = (i >= 2 && i <= 4) ? 0xFFFFFFFF : 0xFF000000;
+      SDLTest_AssertCheck(pixels[i] == expected, "Validate row %i, expected: 0x%.8x, got: 0x%.8x",
+                          rect.y + i, expected, pixels[i]);
+   }
+
+   ret = SDL_SetRenderDrawLineWidth(renderer, 1.0f);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderDrawLineWidth, expected: 0, got: %i", ret);
+   return TEST_COMPLETED;
+}
+
 
 /**
  * @brief Checks to see if functionality is supported. Helper function.
@@ -1058,6 +1166,457 @@ _clearScreen(void)
    return 0;
 }
 
+/**
+ * @brief Draws the texture and reads back the blue channel of its first pixel. Helper function.
+ */
+static int
+_readTextureLuma(SDL_Texture *texture)
+{
+   SDL_Rect rect;
+   Uint32 pixel = 0;
+
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = 1;
+   rect.h = 1;
+   SDL_RenderCopy(renderer, texture, NULL, NULL);
+   SDL_RenderReadPixels(renderer, &rect, SDL_PIXELFORMAT_ARGB8888, &pixel, 4);
+   return (int)(pixel & 0xFF);
+}
+
+/* The copies render_testTiledTexture() does with both of its renderers */
+#define TILED_CASES 12
+
+static void
+_renderTiledCase(SDL_Renderer *target, SDL_Texture *texture, int which)
+{
+   const double angles[] = { 0.0, 90.0, 180.0, 270.0, 0.0, 0.0, 0.0, 90.0 };
+   const SDL_RendererFlip flips[] = {
+      SDL_FLIP_NONE, SDL_FLIP_NONE, SDL_FLIP_NONE, SDL_FLIP_NONE,
+      SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL,
+      (SDL_RendererFlip)(SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL), SDL_FLIP_HORIZONTAL
+   };
+   SDL_Rect srcrect, dstrect;
+   SDL_Point center;
+   int ret;
+
+   SDL_SetRenderDrawColor(target, 20, 40, 60, 255);
+   SDL_RenderClear(target);
+
+   if (which == 0) {
+      /* The whole texture */
+      dstrect.x = 7;
+      dstrect.y = 9;
+      dstrect.w = 150;
+      dstrect.h = 100;
+      ret = SDL_RenderCopy(target, texture, NULL, &dstrect);
+   } else if (which == 1) {
+      /* Crossing a vertical and a horizontal tile edge */
+      srcrect.x = 50;
+      srcrect.y = 40;
+      srcrect.w = 30;
+      srcrect.h = 40;
+      dstrect.x = 100;
+      dstrect.y = 20;
+      dstrect.w = 30;
+      dstrect.h = 40;
+      ret = SDL_RenderCopy(target, texture, &srcrect, &dstrect);
+   } else if (which == 2) {
+      /* Scaled up, each tile to whole pixels */
+      srcrect.x = 30;
+      srcrect.y = 20;
+      srcrect.w = 100;
+      srcrect.h = 70;
+      dstrect.x = 0;
+      dstrect.y = 0;
+      dstrect.w = 200;
+      dstrect.h = 140;
+      ret = SDL_RenderCopy(target, texture, &srcrect, &dstrect);
+   } else if (which == 3) {
+      /* Past the edge of the viewport */
+      dstrect.x = 180;
+      dstrect.y = -30;
+      dstrect.w = 150;
+      dstrect.h = 100;
+      ret = SDL_RenderCopy(target, texture, NULL, &dstrect);
+   } else {
+      /* Turned and flipped around a point off center */
+      srcrect.x = 40;
+      srcrect.y = 30;
+      srcrect.w = 90;
+      srcrect.h = 60;
+      dstrect.x = 60;
+      dstrect.y = 50;
+      dstrect.w = 90;
+      dstrect.h = 60;
+      center.x = 30;
+      center.y = 20;
+      ret = SDL_RenderCopyEx(target, texture, &srcrect, &dstrect,
+                             angles[which - 4], &center, flips[which - 4]);
+   }
+   SDLTest_AssertCheck(ret == 0, "Validate result from copy %i, expected: 0, got: %i", which, ret);
+}
+
+/* Count the pixels that differ between two surfaces of the same size and format */
+static int
+_countDifferingPixels(SDL_Surface *a, SDL_Surface *b)
+{
+   int x, y, differing = 0;
+
+   for (y = 0; y < a->h; ++y) {
+      const Uint32 *pa = (const Uint32 *)((const Uint8 *)a->pixels + y * a->pitch);
+      const Uint32 *pb = (const Uint32 *)((const Uint8 *)b->pixels + y * b->pitch);
+      for (x = 0; x < a->w; ++x) {
+         if (pa[x] != pb[x]) {
+            differing++;
+         }
+      }
+   }
+   return differing;
+}
+
+/**
+ * @brief Tests textures that are bigger than the renderer can hold, and are split into tiles.
+ *
+ * Every copy is done with a software renderer limited to 64x64 textures,
+ * and with one that isn't, and the two must give the same pixels.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopyEx
+ */
+int
+render_testTiledTexture(void *arg)
+{
+   SDL_Surface *source = NULL, *tiled_surface = NULL, *whole_surface = NULL;
+   SDL_Renderer *tiled = NULL, *whole = NULL;
+   SDL_Texture *tiled_texture = NULL, *whole_texture = NULL, *texture;
+   SDL_RendererInfo info;
+   SDL_BlendMode blendMode;
+   Uint8 r, g, b, alpha;
+   int i, ret, pass, differing;
+
+   source = SDL_CreateRGBSurfaceWithFormat(0, 150, 100, 32, SDL_PIXELFORMAT_ARGB8888);
+   tiled_surface = SDL_CreateRGBSurfaceWithFormat(0, 256, 192, 32, SDL_PIXELFORMAT_ARGB8888);
+   whole_surface = SDL_CreateRGBSurfaceWithFormat(0, 256, 192, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(source && tiled_surface && whole_surface, "Verify surfaces are not NULL");
+   if (!source || !tiled_surface || !whole_surface) {
+      goto out;
+   }
+   for (i = 0; i < source->h * source->pitch; ++i) {
+      ((Uint8 *)source->pixels)[i] = SDLTest_RandomUint8();
+   }
+
+   SDL_SetHint(SDL_HINT_RENDER_MAX_TEXTURE_SIZE, "64");
+   tiled = SDL_CreateSoftwareRenderer(tiled_surface);
+   SDL_SetHint(SDL_HINT_RENDER_MAX_TEXTURE_SIZE, "");
+   whole = SDL_CreateSoftwareRenderer(whole_surface);
+   SDLTest_AssertCheck(tiled && whole, "Verify software renderers are not NULL");
+   if (!tiled || !whole) {
+      goto out;
+   }
+   ret = SDL_GetRendererInfo(tiled, &info);
+   SDLTest_AssertCheck(ret == 0 && info.max_texture_width == 64 && info.max_texture_height == 64,
+                       "Verify maximum texture size, expected: 64x64, got: %ix%i", info.max_texture_width, info.max_texture_height);
+
+   /* Textures are split once they're bigger than the maximum size */
+   texture = SDL_CreateTexture(tiled, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 64, 64);
+   SDLTest_AssertCheck(texture != NULL, "Verify 64x64 texture is not NULL");
+   if (texture) {
+      SDL_GL_BindTexture(texture, NULL, NULL);
+      SDLTest_AssertCheck(SDL_strcmp(SDL_GetError(), "Texture is split into tiles") != 0, "Verify 64x64 texture is not split");
+      SDL_DestroyTexture(texture);
+   }
+   texture = SDL_CreateTexture(tiled, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 64, 65);
+   SDLTest_AssertCheck(texture != NULL, "Verify 64x65 texture is not NULL");
+   if (texture) {
+      SDL_GL_BindTexture(texture, NULL, NULL);
+      SDLTest_AssertCheck(SDL_strcmp(SDL_GetError(), "Texture is split into tiles") == 0, "Verify 64x65 texture is split");
+      SDL_DestroyTexture(texture);
+   }
+   texture = SDL_CreateTexture(tiled, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, 65, 64);
+   SDLTest_AssertCheck(texture == NULL, "Verify 65x64 target texture can't be created");
+   if (texture) {
+      SDL_DestroyTexture(texture);
+   }
+
+   tiled_texture = SDL_CreateTextureFromSurface(tiled, source);
+   whole_texture = SDL_CreateTextureFromSurface(whole, source);
+   SDLTest_AssertCheck(tiled_texture && whole_texture, "Verify textures are not NULL");
+   if (!tiled_texture || !whole_texture) {
+      goto out;
+   }
+
+   /* The second time around, the mods and blend mode must reach every tile */
+   for (pass = 0; pass < 2; ++pass) {
+      if (pass == 1) {
+         for (i = 0; i < 2; ++i) {
+            texture = i ? whole_texture : tiled_texture;
+            SDL_SetTextureColorMod(texture, 200, 100, 50);
+            SDL_SetTextureAlphaMod(texture, 160);
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_ADD);
+         }
+         SDL_GetTextureColorMod(tiled_texture, &r, &g, &b);
+         SDL_GetTextureAlphaMod(tiled_texture, &alpha);
+         SDL_GetTextureBlendMode(tiled_texture, &blendMode);
+         SDLTest_AssertCheck(r == 200 && g == 100 && b == 50 && alpha == 160 && blendMode == SDL_BLENDMODE_ADD,
+                             "Verify mods and blend mode of tiled texture");
+      }
+      for (i = 0; i < TILED_CASES; ++i) {
+         _renderTiledCase(tiled, tiled_texture, i);
+         _renderTiledCase(whole, whole_texture, i);
+         differing = _countDifferingPixels(tiled_surface, whole_surface);
+         SDLTest_AssertCheck(differing == 0, "Verify tiled copy %i (pass %i) matches, got %i differing pixels", i, pass, differing);
+      }
+   }
+
+out:
+   if (tiled_texture) {
+      SDL_DestroyTexture(tiled_texture);
+   }
+   if (whole_texture) {
+      SDL_DestroyTexture(whole_texture);
+   }
+   if (tiled) {
+      SDL_DestroyRenderer(tiled);
+   }
+   if (whole) {
+      SDL_DestroyRenderer(whole);
+   }
+   SDL_FreeSurface(source);
+   SDL_FreeSurface(tiled_surface);
+   SDL_FreeSurface(whole_surface);
+   return TEST_COMPLETED;
+}
+
+#define YUV_TEST_KG(kr, kb) (1.0 - (kr) - (kb))
+#define YUV_TEST_COEFFICIENTS(kr, kb) \
+   2.0 * (1.0 - (kr)), 2.0 * (kr) * (1.0 - (kr)) / YUV_TEST_KG(kr, kb), \
+   2.0 * (kb) * (1.0 - (kb)) / YUV_TEST_KG(kr, kb), 2.0 * (1.0 - (kb))
+
+/* The SDL_HINT_YUV_CONVERSION_MODE values and the conversions they stand for */
+static const struct
+{
+   const char *name;
+   SDL_bool limited;
+   double cr_r, cr_g, cb_g, cb_b;
+} _yuvModes[] = {
+   { "JPEG", SDL_FALSE, 0.419 / 0.299, 0.299 / 0.419, 0.114 / 0.331, 0.587 / 0.331 },
+   { "BT601", SDL_TRUE, YUV_TEST_COEFFICIENTS(0.299, 0.114) },
+   { "BT709", SDL_TRUE, YUV_TEST_COEFFICIENTS(0.2126, 0.0722) },
+   { "BT709_FULL", SDL_FALSE, YUV_TEST_COEFFICIENTS(0.2126, 0.0722) }
+};
+
+/**
+ * @brief Converts one pixel of a YUV frame to RGB in floating point. Helper function.
+ *
+ * Planar frames have chroma planes of (w/2)x(h/2), and an odd last row or
+ * column uses the chroma of the one before it.
+ */
+static Uint32
+_referenceYUVPixel(Uint32 format, int mode, const Uint8 *frame, int w, int h, int x, int y)
+{
+   const double luma_scale = _yuvModes[mode].limited ? 255.0 / 219.0 : 1.0;
+   const double chroma_scale = _yuvModes[mode].limited ? 255.0 / 224.0 : 1.0;
+   const int cx = SDL_min(x / 2, w / 2 - 1);
+   const int cy = SDL_min(y / 2, h / 2 - 1);
+   const Uint8 *chroma = frame + w * h;
+   const Uint8 *row = frame + y * w * 2;
+   double Y, U, V, rgb[3];
+   int lum, u, v, i;
+   Uint32 pixel = 0;
+
+   switch (format) {
+   case SDL_PIXELFORMAT_IYUV:
+      lum = frame[y * w + x];
+      u = chroma[cy * (w / 2) + cx];
+      v = chroma[(h / 2) * (w / 2) + cy * (w / 2) + cx];
+      break;
+   case SDL_PIXELFORMAT_YV12:
+      lum = frame[y * w + x];
+      v = chroma[cy * (w / 2) + cx];
+      u = chroma[(h / 2) * (w / 2) + cy * (w / 2) + cx];
+      break;
+   case SDL_PIXELFORMAT_NV12:
+      lum = frame[y * w + x];
+      u = chroma[cy * w + cx * 2];
+      v = chroma[cy * w + cx * 2 + 1];
+      break;
+   case SDL_PIXELFORMAT_NV21:
+      lum = frame[y * w + x];
+      v = chroma[cy * w + cx * 2];
+      u = chroma[cy * w + cx * 2 + 1];
+      break;
+   case SDL_PIXELFORMAT_YUY2:
+      lum = row[x * 2];
+      u = row[cx * 4 + 1];
+      v = row[cx * 4 + 3];
+      break;
+   case SDL_PIXELFORMAT_UYVY:
+      lum = row[x * 2 + 1];
+      u = row[cx * 4];
+      v = row[cx * 4 + 2];
+      break;
+   default: /* SDL_PIXELFORMAT_YVYU */
+      lum = row[x * 2];
+      v = row[cx * 4 + 1];
+      u = row[cx * 4 + 3];
+      break;
+   }
+
+   Y = (lum - (_yuvModes[mode].limited ? 16 : 0)) * luma_scale;
+   U = (u - 128) * chroma_scale;
+   V = (v - 128) * chroma_scale;
+   rgb[0] = Y + _yuvModes[mode].cr_r * V;
+   rgb[1] = Y - _yuvModes[mode].cb_g * U - _yuvModes[mode].cr_g * V;
+   rgb[2] = Y + _yuvModes[mode].cb_b * U;
+   for (i = 0; i < 3; ++i) {
+      const int c = (int)SDL_floor(rgb[i] + 0.5);
+      pixel = (pixel << 8) | (Uint32)SDL_max(0, SDL_min(c, 255));
+   }
+   return pixel;
+}
+
+/**
+ * @brief Draws a YUV frame onto a surface of its size with a software renderer. Helper function.
+ */
+static int
+_convertYUVFrame(Uint32 format, const Uint8 *frame, SDL_Surface *target)
+{
+   const int w = target->w, h = target->h;
+   SDL_Renderer *target_renderer;
+   SDL_Texture *texture;
+   int ret = -1;
+
+   target_renderer = SDL_CreateSoftwareRenderer(target);
+   if (target_renderer == NULL) {
+      return -1;
+   }
+   texture = SDL_CreateTexture(target_renderer, format, SDL_TEXTUREACCESS_STREAMING, w, h);
+   if (texture != NULL) {
+      if (format == SDL_PIXELFORMAT_IYUV || format == SDL_PIXELFORMAT_YV12) {
+         const Uint8 *first = frame + w * h;
+         const Uint8 *second = first + (w / 2) * (h / 2);
+         if (format == SDL_PIXELFORMAT_IYUV) {
+            ret = SDL_UpdateYUVTexture(texture, NULL, frame, w, first, w / 2, second, w / 2);
+         } else {
+            ret = SDL_UpdateYUVTexture(texture, NULL, frame, w, second, w / 2, first, w / 2);
+         }
+      } else if (format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21) {
+         ret = SDL_UpdateTexture(texture, NULL, frame, w);
+      } else {
+         ret = SDL_UpdateTexture(texture, NULL, frame, w * 2);
+      }
+      if (ret == 0) {
+         ret = SDL_RenderCopy(target_renderer, texture, NULL, NULL);
+      }
+      SDL_DestroyTexture(texture);
+   }
+   SDL_DestroyRenderer(target_renderer);
+   return ret;
+}
+
+/**
+ * @brief Tests the YUV to RGB conversions of every format, mode and CPU tier.
+ *
+ * Each frame is converted with the vectorized row converters forced down
+ * with SDL_HINT_BLIT_CPU_FEATURES, and compared with a floating point
+ * reference.
+ * The lookup tables used without them only handle even sizes and are
+ * known to be off by a few steps, so they're checked more loosely.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateYUVTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_HINT_YUV_CONVERSION_MODE
+ */
+int
+render_testYUVConversion(void *arg)
+{
+   const Uint32 formats[] = {
+      SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21,
+      SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_UYVY, SDL_PIXELFORMAT_YVYU
+   };
+   const int sizes[][2] = { { 64, 32 }, { 37, 23 }, { 41, 19 }, { 6, 4 }, { 19, 2 } };
+   /* The best the CPU has, SSE2 only and no vectorized converter at all */
+   const char *tiers[] = { "", "8", "0" };
+   const int tolerances[] = { 1, 1, 4 };
+   SDL_Surface *surfaces[SDL_arraysize(tiers)];
+   Uint8 *frame = NULL;
+   int f, m, s, t, i, x, y, w, h, ret, worst, differing;
+
+   SDL_zero(surfaces);
+   frame = (Uint8 *)SDL_malloc(sizes[0][0] * sizes[0][1] * 2);
+   SDLTest_AssertCheck(frame != NULL, "Validate allocated YUV frame");
+   if (frame == NULL) {
+      return TEST_ABORTED;
+   }
+
+   for (m = 0; m < SDL_arraysize(_yuvModes); ++m) {
+      SDL_SetHint(SDL_HINT_YUV_CONVERSION_MODE, _yuvModes[m].name);
+      for (f = 0; f < SDL_arraysize(formats); ++f) {
+         for (s = 0; s < SDL_arraysize(sizes); ++s) {
+            w = sizes[s][0];
+            h = sizes[s][1];
+            for (i = 0; i < w * h * 2; ++i) {
+               frame[i] = SDLTest_RandomUint8();
+            }
+
+            for (t = 0; t < SDL_arraysize(tiers); ++t) {
+               surfaces[t] = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+               if (surfaces[t] == NULL) {
+                  SDLTest_AssertCheck(surfaces[t] != NULL, "Verify surface is not NULL");
+                  goto out;
+               }
+               SDL_SetHint(SDL_HINT_BLIT_CPU_FEATURES, tiers[t]);
+               ret = _convertYUVFrame(formats[f], frame, surfaces[t]);
+               SDLTest_AssertCheck(ret == 0, "Validate %s conversion of %s, expected: 0, got: %i",
+                                   _yuvModes[m].name, SDL_GetPixelFormatName(formats[f]), ret);
+               if (ret < 0) {
+                  goto out;
+               }
+               if (tiers[t][0] == '0' && ((w & 1) || (h & 1))) {
+                  continue;
+               }
+
+               worst = 0;
+               for (y = 0; y < h; ++y) {
+                  const Uint32 *row = (const Uint32 *)((const Uint8 *)surfaces[t]->pixels + y * surfaces[t]->pitch);
+                  for (x = 0; x < w; ++x) {
+                     const Uint32 expected = _referenceYUVPixel(formats[f], m, frame, w, h, x, y);
+                     for (i = 0; i < 24; i += 8) {
+                        const int error = SDL_abs((int)((row[x] >> i) & 0xFF) - (int)((expected >> i) & 0xFF));
+                        worst = SDL_max(worst, error);
+                     }
+                  }
+               }
+               SDLTest_AssertCheck(worst <= tolerances[t],
+                                   "Verify %s conversion of %ix%i %s with CPU features '%s', expected error <= %i, got: %i",
+                                   _yuvModes[m].name, w, h, SDL_GetPixelFormatName(formats[f]), tiers[t], tolerances[t], worst);
+            }
+
+            /* The vectorized tiers compute the same thing */
+            differing = _countDifferingPixels(surfaces[0], surfaces[1]);
+            SDLTest_AssertCheck(differing == 0, "Verify %s conversion of %ix%i %s is the same for all vectorized tiers, got %i differing pixels",
+                                _yuvModes[m].name, w, h, SDL_GetPixelFormatName(formats[f]), differing);
+
+            for (t = 0; t < SDL_arraysize(tiers); ++t) {
+               SDL_FreeSurface(surfaces[t]);
+               surfaces[t] = NULL;
+            }
+         }
+      }
+   }
+
+out:
+   for (t = 0; t < SDL_arraysize(tiers); ++t) {
+      SDL_FreeSurface(surfaces[t]);
+   }
+   SDL_free(frame);
+   SDL_SetHint(SDL_HINT_BLIT_CPU_FEATURES, "");
+   SDL_SetHint(SDL_HINT_YUV_CONVERSION_MODE, "");
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -1085,9 +1644,21 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testUpdateYUVTextureAsync, "render_testUpdateYUVTextureAsync", "Tests queueing YUV texture frames", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testLineWidth, "render_testLineWidth", "Tests drawing wide lines", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testTiledTexture, "render_testTiledTexture", "Tests textures split into tiles", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_testYUVConversion, "render_testYUVConversion", "Tests YUV to RGB conversions on every CPU tier", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, NULL
 };
 
 /* Render test suite (global) */
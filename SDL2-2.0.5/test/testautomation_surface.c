@@ -564,6 +564,82 @@ surface_testBlitBlendMod(void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Tests premultiplying alpha and blitting with premultiplied blending.
+ */
+int
+surface_testBlitBlendPremultiplied(void *arg)
+{
+   const int w = 67, h = 5;
+   SDL_Surface *src, *dst;
+   SDL_BlendMode mode;
+   Uint32 *pixels, *expected;
+   int i, ret, failures = 0;
+
+   src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+   dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+   expected = (Uint32 *)SDL_malloc(w * h * sizeof(Uint32));
+   SDLTest_AssertCheck(src != NULL && dst != NULL && expected != NULL, "Verify surfaces are not NULL");
+   if (src == NULL || dst == NULL || expected == NULL) {
+      goto out;
+   }
+
+   /* Straight alpha source, including opaque, transparent and additive pixels */
+   pixels = (Uint32 *)src->pixels;
+   for (i = 0; i < w * h; i++) {
+      pixels[i] = (Uint32)SDLTest_RandomUint32();
+      if (i % 5 == 0) {
+         pixels[i] |= 0xFF000000;
+      } else if (i % 5 == 1) {
+         pixels[i] &= 0x00FFFFFF;
+      }
+      ((Uint32 *)dst->pixels)[i] = (Uint32)SDLTest_RandomUint32();
+   }
+   ret = SDL_PremultiplyAlpha(w, h, src->format->format, src->pixels, src->pitch,
+                              src->format->format, src->pixels, src->pitch);
+   SDLTest_AssertPass("Call to SDL_PremultiplyAlpha()");
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_PremultiplyAlpha(), expected: 0, got: %i", ret);
+
+   for (i = 0; i < w * h; i++) {
+      const Uint32 s = pixels[i], d = ((Uint32 *)dst->pixels)[i];
+      const Uint32 inva = 255 - (s >> 24);
+      Uint32 c, result = ((s >> 24) + ((d >> 24) * inva) / 255) << 24;
+      int shift;
+
+      for (shift = 0; shift < 24; shift += 8) {
+         if (((s >> shift) & 0xFF) > (s >> 24)) {
+            failures++;
+         }
+         c = ((s >> shift) & 0xFF) + (((d >> shift) & 0xFF) * inva) / 255;
+         result |= SDL_min(c, 0xFF) << shift;
+      }
+      expected[i] = result;
+   }
+   SDLTest_AssertCheck(failures == 0, "Verify premultiplied colors don't exceed alpha, got %i failures", failures);
+
+   ret = SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_PREMULTIPLIED);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SetSurfaceBlendMode(), expected: 0, got: %i", ret);
+   ret = SDL_GetSurfaceBlendMode(src, &mode);
+   SDLTest_AssertCheck(ret == 0 && mode == SDL_BLENDMODE_PREMULTIPLIED, "Verify SDL_GetSurfaceBlendMode() returns SDL_BLENDMODE_PREMULTIPLIED, got: %i", mode);
+
+   ret = SDL_BlitSurface(src, NULL, dst, NULL);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface(), expected: 0, got: %i", ret);
+   failures = 0;
+   for (i = 0; i < w * h; i++) {
+      if (((Uint32 *)dst->pixels)[i] != expected[i]) {
+         failures++;
+      }
+   }
+   SDLTest_AssertCheck(failures == 0, "Verify blitted pixels, got %i failures", failures);
+
+out:
+   SDL_free(expected);
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+
+   return TEST_COMPLETED;
+}
+
 /**
  * @brief Tests some more blitting routines with loop
  */
@@ -588,6 +664,561 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/* Clipped on both sides and scaled by different factors; SDL_BlitScaled() changes the rectangles */
+static void
+_setScaledRects(int w, int h, SDL_Rect *srcrect, SDL_Rect *dstrect)
+{
+   srcrect->x = 3;
+   srcrect->y = 2;
+   srcrect->w = w - 10;
+   srcrect->h = h - 5;
+   dstrect->x = -7;
+   dstrect->y = 5;
+   dstrect->w = 2 * w - 9;
+   dstrect->h = (3 * h) / 2;
+}
+
+/**
+ * @brief Tests scaled blitting of RLE accelerated surfaces against the same blits without RLE.
+ */
+int
+surface_testBlitScaledRLE(void *arg)
+{
+   const int w = 61, h = 37;
+   const Uint32 key = 0x00FF00FF;
+   SDL_Rect srcrect, dstrect;
+   SDL_Surface *src, *dst, *ref;
+   Uint32 *pixels;
+   int i, ret, failures = 0;
+
+   src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGB888);
+   dst = SDL_CreateRGBSurfaceWithFormat(0, 2 * w, 2 * h, 32, SDL_PIXELFORMAT_RGB888);
+   ref = SDL_CreateRGBSurfaceWithFormat(0, 2 * w, 2 * h, 32, SDL_PIXELFORMAT_RGB888);
+   SDLTest_AssertCheck(src != NULL && dst != NULL && ref != NULL, "Verify surfaces are not NULL");
+   if (src == NULL || dst == NULL || ref == NULL) {
+      goto out;
+   }
+
+   /* Opaque pixels with transparent spans of varying length */
+   pixels = (Uint32 *)src->pixels;
+   for (i = 0; i < w * h; i++) {
+      pixels[i] = (Uint32)SDLTest_RandomUint32() & 0x00FFFFFE;
+      if ((i / 7 + i / w) % 3 == 0) {
+         pixels[i] = key;
+      }
+   }
+   ret = SDL_SetColorKey(src, SDL_TRUE, key);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SetColorKey(), expected: 0, got: %i", ret);
+
+   /* Unscaled and scaled blits in turn, so the map is recalculated each time */
+   SDL_SetSurfaceRLE(src, 0);
+   SDL_BlitSurface(src, NULL, ref, NULL);
+   _setScaledRects(w, h, &srcrect, &dstrect);
+   SDL_BlitScaled(src, &srcrect, ref, &dstrect);
+   SDL_SetSurfaceRLE(src, 1);
+   SDL_BlitSurface(src, NULL, dst, NULL);
+   _setScaledRects(w, h, &srcrect, &dstrect);
+   ret = SDL_BlitScaled(src, &srcrect, dst, &dstrect);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitScaled(), expected: 0, got: %i", ret);
+   SDLTest_AssertCheck((src->flags & SDL_RLEACCEL) != 0, "Verify the source is still RLE accelerated");
+
+   for (i = 0; i < dst->w * dst->h; i++) {
+      if ((((Uint32 *)dst->pixels)[i] ^ ((Uint32 *)ref->pixels)[i]) & 0x00FFFFFF) {
+         failures++;
+      }
+   }
+   SDLTest_AssertCheck(failures == 0, "Verify blitted pixels, got %i failures", failures);
+
+out:
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+   SDL_FreeSurface(ref);
+
+   return TEST_COMPLETED;
+}
+
+/* Reads a pixel of a 16 or 32-bit surface */
+static Uint32
+_getPixel(SDL_Surface *surface, int x, int y)
+{
+   const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+
+   if (surface->format->BytesPerPixel == 2) {
+      return ((const Uint16 *)row)[x];
+   }
+   return ((const Uint32 *)row)[x];
+}
+
+/**
+ * @brief Tests scaled blitting of RLE accelerated surfaces with per-pixel alpha against the same blits without RLE.
+ *
+ * The destination rects reach past the edges of the destination and its clip rect.
+ */
+int
+surface_testBlitScaledRLEAlpha(void *arg)
+{
+   const int w = 53, h = 31;
+   const Uint32 formats[] = { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565 };
+   /* The RLE encoding keeps 5 bits of alpha for 16-bit destinations */
+   const int tolerances[] = { 4, 24 };
+   /* Source rect, destination rect and destination clip rect of each blit */
+   const SDL_Rect rects[][3] = {
+      { { 3, 2, 43, 26 }, { -7, 5, 97, 46 }, { 0, 0, 106, 62 } },
+      { { 0, 0, 53, 31 }, { 60, -9, 106, 59 }, { 0, 0, 106, 62 } },
+      { { 5, 4, 48, 27 }, { -3, 45, 27, 18 }, { 0, 0, 106, 62 } },
+      { { 1, 3, 50, 25 }, { 10, 8, 80, 50 }, { 17, 12, 61, 30 } }
+   };
+   SDL_Surface *src = NULL, *dst = NULL, *ref = NULL;
+   SDL_Rect srcrect, dstrect;
+   Uint32 *pixels;
+   Uint8 alpha, rgb[2][3];
+   int f, c, i, x, y, ret, worst, differing;
+
+   src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(src != NULL, "Verify source surface is not NULL");
+   if (src == NULL) {
+      goto out;
+   }
+
+   /* Opaque, translucent and transparent spans of varying length */
+   pixels = (Uint32 *)src->pixels;
+   for (i = 0; i < w * h; i++) {
+      switch ((i / 5 + i / w) % 4) {
+      case 0:
+         alpha = 0;
+         break;
+      case 1:
+         alpha = 255;
+         break;
+      default:
+         alpha = SDLTest_RandomUint8();
+         break;
+      }
+      pixels[i] = ((Uint32)alpha << 24) | ((Uint32)SDLTest_RandomUint32() & 0x00FFFFFF);
+   }
+   ret = SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SetSurfaceBlendMode(), expected: 0, got: %i", ret);
+
+   for (f = 0; f < SDL_arraysize(formats); f++) {
+      for (c = 0; c < SDL_arraysize(rects); c++) {
+         dst = SDL_CreateRGBSurfaceWithFormat(0, 2 * w, 2 * h, 32, SDL_PIXELFORMAT_ARGB8888);
+         SDLTest_AssertCheck(dst != NULL, "Verify destination surface is not NULL");
+         if (dst == NULL) {
+            goto out;
+         }
+         pixels = (Uint32 *)dst->pixels;
+         for (i = 0; i < dst->w * dst->h; i++) {
+            pixels[i] = SDLTest_RandomUint32();
+         }
+         ref = SDL_ConvertSurfaceFormat(dst, formats[f], 0);
+         SDL_FreeSurface(dst);
+         dst = SDL_ConvertSurfaceFormat(ref, formats[f], 0);
+         SDLTest_AssertCheck(dst != NULL && ref != NULL, "Verify %s destination surfaces are not NULL", SDL_GetPixelFormatName(formats[f]));
+         if (dst == NULL || ref == NULL) {
+            goto out;
+         }
+         SDL_SetClipRect(dst, &rects[c][2]);
+         SDL_SetClipRect(ref, &rects[c][2]);
+
+         SDL_SetSurfaceRLE(src, 0);
+         srcrect = rects[c][0];
+         dstrect = rects[c][1];
+         SDL_BlitScaled(src, &srcrect, ref, &dstrect);
+         SDL_SetSurfaceRLE(src, 1);
+         srcrect = rects[c][0];
+         dstrect = rects[c][1];
+         ret = SDL_BlitScaled(src, &srcrect, dst, &dstrect);
+         SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitScaled(), expected: 0, got: %i", ret);
+         SDLTest_AssertCheck((src->flags & SDL_RLEACCEL) != 0, "Verify the source is still RLE accelerated");
+
+         /* The blitters round translucent pixels differently, but must touch the same pixels */
+         worst = 0;
+         differing = 0;
+         for (y = 0; y < dst->h; y++) {
+            for (x = 0; x < dst->w; x++) {
+               SDL_GetRGB(_getPixel(dst, x, y), dst->format, &rgb[0][0], &rgb[0][1], &rgb[0][2]);
+               SDL_GetRGB(_getPixel(ref, x, y), ref->format, &rgb[1][0], &rgb[1][1], &rgb[1][2]);
+               for (i = 0; i < 3; i++) {
+                  worst = SDL_max(worst, SDL_abs(rgb[0][i] - rgb[1][i]));
+               }
+               if (SDL_memcmp(rgb[0], rgb[1], 3) != 0) {
+                  differing++;
+               }
+            }
+         }
+         SDLTest_AssertCheck(worst <= tolerances[f], "Verify blit %i to %s, expected error <= %i, got %i in %i pixels",
+                             c, SDL_GetPixelFormatName(formats[f]), tolerances[f], worst, differing);
+
+         SDL_FreeSurface(dst);
+         SDL_FreeSurface(ref);
+         dst = NULL;
+         ref = NULL;
+      }
+   }
+
+out:
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+   SDL_FreeSurface(ref);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests the alignment of surface pixels and copy blits between rows of any alignment.
+ */
+int
+surface_testAlignedPixels(void *arg)
+{
+   const int w = 67, h = 9;
+   SDL_Surface *src = NULL, *dst = NULL;
+   SDL_Rect srcrect, dstrect;
+   Uint8 *pixels;
+   int i, x, y, ret, failures = 0;
+
+   SDL_SetHint(SDL_HINT_SURFACE_ALIGNED_PITCH, "1");
+   src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 24, SDL_PIXELFORMAT_RGB24);
+   SDL_SetHint(SDL_HINT_SURFACE_ALIGNED_PITCH, "0");
+   dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 24, SDL_PIXELFORMAT_RGB24);
+   SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+   if (src == NULL || dst == NULL) {
+      goto out;
+   }
+
+   SDLTest_AssertCheck((src->flags & SDL_SIMD_ALIGNED) != 0, "Verify surface has SDL_SIMD_ALIGNED set");
+   SDLTest_AssertCheck(((uintptr_t)src->pixels & 63) == 0, "Verify pixels are 64 byte aligned");
+   SDLTest_AssertCheck((src->pitch & 63) == 0 && src->pitch >= w * 3, "Verify aligned pitch, got: %i", src->pitch);
+   SDLTest_AssertCheck(dst->pitch == ((w * 3 + 3) & ~3), "Verify default pitch, got: %i", dst->pitch);
+
+   pixels = (Uint8 *)src->pixels;
+   for (i = 0; i < src->h * src->pitch; i++) {
+      pixels[i] = SDLTest_RandomUint8();
+   }
+
+   /* Source and destination rows start at different alignments */
+   srcrect.x = 1;
+   srcrect.y = 1;
+   srcrect.w = w - 3;
+   srcrect.h = h - 2;
+   dstrect.x = 2;
+   dstrect.y = 0;
+   dstrect.w = 0;
+   dstrect.h = 0;
+   SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+   ret = SDL_BlitSurface(src, &srcrect, dst, &dstrect);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface(), expected: 0, got: %i", ret);
+
+   for (y = 0; y < h - 2; y++) {
+      for (x = 0; x < (w - 3) * 3; x++) {
+         if (((Uint8 *)dst->pixels)[y * dst->pitch + 2 * 3 + x] != pixels[(y + 1) * src->pitch + 3 + x]) {
+            failures++;
+         }
+      }
+   }
+   SDLTest_AssertCheck(failures == 0, "Verify blitted pixels, got %i failures", failures);
+
+out:
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that temporary surfaces of the software renderer are recycled.
+ */
+int
+surface_testPoolStats(void *arg)
+{
+   SDL_Surface *target = NULL, *image = NULL;
+   SDL_Renderer *renderer = NULL;
+   SDL_Texture *texture;
+   Uint64 hits, misses, cached, hits2, misses2;
+   int i;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+   image = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 24, SDL_PIXELFORMAT_RGB24);
+   SDLTest_AssertCheck(target != NULL && image != NULL, "Verify surfaces are not NULL");
+   if (target == NULL || image == NULL) {
+      goto out;
+   }
+   renderer = SDL_CreateSoftwareRenderer(target);
+   SDLTest_AssertCheck(renderer != NULL, "Verify renderer is not NULL");
+   if (renderer == NULL) {
+      goto out;
+   }
+
+   /* Each texture converts the image through a temporary surface */
+   SDL_GetSurfacePoolStats(&hits, &misses, &cached);
+   SDLTest_AssertPass("Call to SDL_GetSurfacePoolStats()");
+   for (i = 0; i < 4; i++) {
+      texture = SDL_CreateTextureFromSurface(renderer, image);
+      SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+      SDL_DestroyTexture(texture);
+   }
+   SDL_GetSurfacePoolStats(&hits2, &misses2, NULL);
+   SDLTest_AssertCheck(hits2 - hits >= 3, "Verify pool hits, expected: >= 3, got: %i", (int)(hits2 - hits));
+   SDLTest_AssertCheck(misses2 - misses <= 1, "Verify pool misses, expected: <= 1, got: %i", (int)(misses2 - misses));
+
+   /* A limit below the buffer size empties the pool and stops caching */
+   SDL_SetHint(SDL_HINT_SURFACE_POOL_SIZE, "1");
+   SDL_GetSurfacePoolStats(&hits, &misses, &cached);
+   SDLTest_AssertCheck(cached == 0, "Verify pool is trimmed to the new limit, expected: 0, got: %i", (int)cached);
+   for (i = 0; i < 4; i++) {
+      texture = SDL_CreateTextureFromSurface(renderer, image);
+      SDLTest_AssertCheck(texture != NULL, "Verify texture is not NULL");
+      SDL_DestroyTexture(texture);
+   }
+   SDL_GetSurfacePoolStats(&hits2, &misses2, NULL);
+   SDLTest_AssertCheck(hits2 - hits <= 1, "Verify pool hits with a small limit, expected: <= 1, got: %i", (int)(hits2 - hits));
+   SDLTest_AssertCheck(misses2 - misses >= 3, "Verify pool misses with a small limit, expected: >= 3, got: %i", (int)(misses2 - misses));
+   SDL_SetHint(SDL_HINT_SURFACE_POOL_SIZE, "");
+
+out:
+   if (renderer) {
+      SDL_DestroyRenderer(renderer);
+   }
+   SDL_FreeSurface(target);
+   SDL_FreeSurface(image);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that blits split across worker threads give the same pixels as single threaded blits.
+ */
+int
+surface_testParallelBlit(void *arg)
+{
+   const struct {
+      Uint32 src_format;
+      Uint32 dst_format;
+      SDL_BlendMode blend;
+   } blits[] = {
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_BLENDMODE_NONE },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND },
+      { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ABGR8888, SDL_BLENDMODE_NONE },
+      { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_ADD }
+   };
+   const char *threads[] = { "4", "3", "4" };
+   const int w = 203, h = 331;
+   SDL_Surface *src = NULL, *dst = NULL, *ref = NULL;
+   Uint8 *background = NULL;
+   SDL_Rect dstrect;
+   int i, j, k, ret, failures;
+
+   SDL_SetHint(SDL_HINT_BLIT_THREADS_MIN_PIXELS, "1024");
+   for (i = 0; i < SDL_arraysize(blits); i++) {
+      src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, blits[i].src_format);
+      dst = SDL_CreateRGBSurfaceWithFormat(0, w + 9, h + 5, 32, blits[i].dst_format);
+      ref = SDL_CreateRGBSurfaceWithFormat(0, w + 9, h + 5, 32, blits[i].dst_format);
+      SDLTest_AssertCheck(src != NULL && dst != NULL && ref != NULL, "Verify surfaces are not NULL");
+      if (src == NULL || dst == NULL || ref == NULL) {
+         break;
+      }
+      for (k = 0; k < src->h * src->pitch; k++) {
+         ((Uint8 *)src->pixels)[k] = SDLTest_RandomUint8();
+      }
+      background = (Uint8 *)SDL_malloc(ref->h * ref->pitch);
+      SDLTest_AssertCheck(background != NULL, "Verify background is not NULL");
+      if (background == NULL) {
+         break;
+      }
+      for (k = 0; k < ref->h * ref->pitch; k++) {
+         background[k] = SDLTest_RandomUint8();
+      }
+      SDL_SetSurfaceBlendMode(src, blits[i].blend);
+
+      /* The threads hint changes in between, which restarts the workers */
+      for (j = 0; j < SDL_arraysize(threads); j++) {
+         SDL_memcpy(dst->pixels, background, dst->h * dst->pitch);
+         SDL_memcpy(ref->pixels, background, ref->h * ref->pitch);
+
+         SDL_SetHint(SDL_HINT_BLIT_THREADS, threads[j]);
+         dstrect.x = 5;
+         dstrect.y = 3;
+         ret = SDL_BlitSurface(src, NULL, dst, &dstrect);
+         SDLTest_AssertCheck(ret == 0, "Verify result from parallel SDL_BlitSurface(), expected: 0, got: %i", ret);
+
+         SDL_SetHint(SDL_HINT_BLIT_THREADS, "1");
+         dstrect.x = 5;
+         dstrect.y = 3;
+         ret = SDL_BlitSurface(src, NULL, ref, &dstrect);
+         SDLTest_AssertCheck(ret == 0, "Verify result from single threaded SDL_BlitSurface(), expected: 0, got: %i", ret);
+
+         failures = 0;
+         for (k = 0; k < dst->h; k++) {
+            if (SDL_memcmp((Uint8 *)dst->pixels + k * dst->pitch, (Uint8 *)ref->pixels + k * ref->pitch, dst->w * dst->format->BytesPerPixel) != 0) {
+               failures++;
+            }
+         }
+         SDLTest_AssertCheck(failures == 0, "Verify %s -> %s with %s threads, got %i differing rows",
+                             SDL_GetPixelFormatName(blits[i].src_format), SDL_GetPixelFormatName(blits[i].dst_format),
+                             threads[j], failures);
+      }
+
+      SDL_free(background);
+      SDL_FreeSurface(src);
+      SDL_FreeSurface(dst);
+      SDL_FreeSurface(ref);
+      background = NULL;
+      src = dst = ref = NULL;
+   }
+   SDL_free(background);
+   SDL_FreeSurface(src);
+   SDL_FreeSurface(dst);
+   SDL_FreeSurface(ref);
+   SDL_SetHint(SDL_HINT_BLIT_THREADS, "");
+   SDL_SetHint(SDL_HINT_BLIT_THREADS_MIN_PIXELS, "");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that blits and pixel conversions give the same pixels at every CPU tier.
+ *
+ * The vectorized blitters are turned off one tier at a time with SDL_HINT_BLIT_CPU_FEATURES.
+ */
+int
+surface_testBlitCPUTiers(void *arg)
+{
+   const struct {
+      Uint32 src_format;
+      Uint32 dst_format;
+      SDL_BlendMode blend;
+   } blits[] = {
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_BLEND },
+      { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ABGR8888, SDL_BLENDMODE_BLEND },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_PREMULTIPLIED },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_BLENDMODE_NONE },
+      { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR24, SDL_BLENDMODE_NONE },
+      { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_BLENDMODE_NONE }
+   };
+   /* Everything detected, no AVX2, MMX and SSE2 only, and plain C */
+   const char *tiers[] = { "", "127", "15", "0" };
+   const int w = 67, h = 13;
+   SDL_Surface *src = NULL, *dst[SDL_arraysize(tiers)];
+   Uint8 *background = NULL;
+   Uint32 mask;
+   int i, t, k, x, y, bpp, ret, worst, tolerance, failures;
+
+   SDL_zero(dst);
+   for (i = 0; i < SDL_arraysize(blits); i++) {
+      src = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, blits[i].src_format);
+      SDLTest_AssertCheck(src != NULL, "Verify source surface is not NULL");
+      if (src == NULL) {
+         goto out;
+      }
+      for (t = 0; t < SDL_arraysize(tiers); t++) {
+         /* A new destination each time, so the blit is chosen again */
+         dst[t] = SDL_CreateRGBSurfaceWithFormat(0, w + 5, h + 3, 32, blits[i].dst_format);
+         SDLTest_AssertCheck(dst[t] != NULL, "Verify destination surface is not NULL");
+         if (dst[t] == NULL) {
+            goto out;
+         }
+      }
+
+      /* Transparent, opaque and translucent pixels, including runs of each */
+      for (y = 0; y < h; y++) {
+         for (k = 0; k < src->pitch; k++) {
+            ((Uint8 *)src->pixels)[y * src->pitch + k] = SDLTest_RandomUint8();
+         }
+         if (src->format->Amask) {
+            for (x = 0; x < w; x++) {
+               Uint32 *pixel = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch) + x;
+               switch ((x / 9 + y) % 4) {
+               case 0:
+                  *pixel &= ~src->format->Amask;
+                  break;
+               case 1:
+                  *pixel |= src->format->Amask;
+                  break;
+               default:
+                  break;
+               }
+            }
+         }
+      }
+      background = (Uint8 *)SDL_malloc(dst[0]->h * dst[0]->pitch);
+      SDLTest_AssertCheck(background != NULL, "Verify background is not NULL");
+      if (background == NULL) {
+         goto out;
+      }
+      for (k = 0; k < dst[0]->h * dst[0]->pitch; k++) {
+         background[k] = SDLTest_RandomUint8();
+      }
+      SDL_SetSurfaceBlendMode(src, blits[i].blend);
+
+      for (t = 0; t < SDL_arraysize(tiers); t++) {
+         SDL_SetHint(SDL_HINT_BLIT_CPU_FEATURES, tiers[t]);
+         SDL_memcpy(dst[t]->pixels, background, dst[t]->h * dst[t]->pitch);
+         if (blits[i].blend == SDL_BLENDMODE_NONE) {
+            ret = SDL_ConvertPixels(w, h, blits[i].src_format, src->pixels, src->pitch,
+                                    blits[i].dst_format, (Uint8 *)dst[t]->pixels + dst[t]->pitch + 8, dst[t]->pitch);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels(), expected: 0, got: %i", ret);
+         } else {
+            SDL_Rect dstrect;
+            dstrect.x = 2;
+            dstrect.y = 1;
+            ret = SDL_BlitSurface(src, NULL, dst[t], &dstrect);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface(), expected: 0, got: %i", ret);
+         }
+      }
+      SDL_SetHint(SDL_HINT_BLIT_CPU_FEATURES, "");
+
+      /* The unused byte of RGB888 pixels may differ. The plain C alpha
+         blitter rounds differently from the vectorized ones, every other
+         tier must match exactly. */
+      bpp = dst[0]->format->BytesPerPixel;
+      mask = (bpp == 4) ? (dst[0]->format->Rmask | dst[0]->format->Gmask | dst[0]->format->Bmask | dst[0]->format->Amask) : 0xFFFFFFFF;
+      for (t = 1; t < SDL_arraysize(tiers); t++) {
+         tolerance = (*tiers[t] == '0' && blits[i].blend == SDL_BLENDMODE_BLEND) ? 2 : 0;
+         worst = 0;
+         failures = 0;
+         for (y = 0; y < dst[0]->h; y++) {
+            for (x = 0; x < dst[0]->w; x++) {
+               Uint32 a = 0, b = 0;
+               SDL_memcpy(&a, (Uint8 *)dst[0]->pixels + y * dst[0]->pitch + x * bpp, bpp);
+               SDL_memcpy(&b, (Uint8 *)dst[t]->pixels + y * dst[t]->pitch + x * bpp, bpp);
+               a &= mask;
+               b &= mask;
+               if (a != b) {
+                  failures++;
+               }
+               for (k = 0; k < 32; k += 8) {
+                  worst = SDL_max(worst, SDL_abs((int)((a >> k) & 0xFF) - (int)((b >> k) & 0xFF)));
+               }
+            }
+         }
+         SDLTest_AssertCheck(worst <= tolerance, "Verify %s -> %s with blend mode %i at CPU tier \"%s\", expected error <= %i, got %i in %i pixels",
+                             SDL_GetPixelFormatName(blits[i].src_format), SDL_GetPixelFormatName(blits[i].dst_format),
+                             (int)blits[i].blend, tiers[t], tolerance, worst, failures);
+      }
+
+      SDL_free(background);
+      SDL_FreeSurface(src);
+      background = NULL;
+      src = NULL;
+      for (t = 0; t < SDL_arraysize(tiers); t++) {
+         SDL_FreeSurface(dst[t]);
+         dst[t] = NULL;
+      }
+   }
+
+out:
+   SDL_SetHint(SDL_HINT_BLIT_CPU_FEATURES, "");
+   SDL_free(background);
+   SDL_FreeSurface(src);
+   for (t = 0; t < SDL_arraysize(tiers); t++) {
+      SDL_FreeSurface(dst[t]);
+   }
+
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -630,11 +1261,32 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testBlitBlendPremultiplied, "surface_testBlitBlendPremultiplied", "Tests premultiplying alpha and blitting with premultiplied blending.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testBlitScaledRLE, "surface_testBlitScaledRLE", "Tests scaled blitting of RLE accelerated surfaces.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testAlignedPixels, "surface_testAlignedPixels", "Tests alignment of surface pixels and copy blits.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest16 =
+        { (SDLTest_TestCaseFp)surface_testPoolStats, "surface_testPoolStats", "Tests recycling of temporary surfaces.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest17 =
+        { (SDLTest_TestCaseFp)surface_testParallelBlit, "surface_testParallelBlit", "Tests blits split across worker threads.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest18 =
+        { (SDLTest_TestCaseFp)surface_testBlitScaledRLEAlpha, "surface_testBlitScaledRLEAlpha", "Tests scaled blitting of RLE accelerated surfaces with per-pixel alpha.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest19 =
+        { (SDLTest_TestCaseFp)surface_testBlitCPUTiers, "surface_testBlitCPUTiers", "Tests that blits give the same pixels at every CPU tier.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15, &surfaceTest16, &surfaceTest17, &surfaceTest18, &surfaceTest19, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,138 @@
+/*
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times SDL_ConvertPixels() against an SDL_LowerBlit() between surfaces,
+   which is what SDL_ConvertPixels() used to do for every conversion, and
+   checks that both give the same pixels. */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static const Uint32 formats[] = {
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_BGRA8888,
+    SDL_PIXELFORMAT_RGB888,
+    SDL_PIXELFORMAT_BGR888,
+    SDL_PIXELFORMAT_RGBX8888,
+    SDL_PIXELFORMAT_BGRX8888,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_BGR565
+};
+
+static int
+BlitPixels(int width, int height,
+           Uint32 src_format, void *src, int src_pitch,
+           Uint32 dst_format, void *dst, int dst_pitch)
+{
+    SDL_Surface *src_surface, *dst_surface;
+    SDL_Rect rect;
+    int retval = -1;
+
+    src_surface = SDL_CreateRGBSurfaceWithFormatFrom(src, width, height,
+                      SDL_BITSPERPIXEL(src_format), src_pitch, src_format);
+    dst_surface = SDL_CreateRGBSurfaceWithFormatFrom(dst, width, height,
+                      SDL_BITSPERPIXEL(dst_format), dst_pitch, dst_format);
+    if (src_surface && dst_surface) {
+        SDL_SetSurfaceBlendMode(src_surface, SDL_BLENDMODE_NONE);
+        rect.x = rect.y = 0;
+        rect.w = width;
+        rect.h = height;
+        retval = SDL_LowerBlit(src_surface, &rect, dst_surface, &rect);
+    }
+    SDL_FreeSurface(src_surface);
+    SDL_FreeSurface(dst_surface);
+    return retval;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const int width = 1920 + 3;  /* Not a multiple of any SIMD width */
+    const int height = 1080;
+    const int pitch = width * 4;
+    int iterations = 20;
+    Uint8 *src, *dst, *ref;
+    double freq;
+    int failed = 0;
+    int i, j, n;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_max(SDL_atoi(argv[1]), 1);
+    }
+
+    src = (Uint8 *) SDL_malloc(pitch * height);
+    dst = (Uint8 *) SDL_malloc(pitch * height);
+    ref = (Uint8 *) SDL_malloc(pitch * height);
+    if (!src || !dst || !ref) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        return 1;
+    }
+    for (i = 0; i < pitch * height; ++i) {
+        src[i] = (Uint8) rand();
+    }
+    freq = (double) SDL_GetPerformanceFrequency();
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(formats); ++j) {
+            const Uint32 src_format = formats[i];
+            const Uint32 dst_format = formats[j];
+            Uint64 start, convert_time, blit_time;
+
+            if (src_format == dst_format) {
+                continue;
+            }
+
+            SDL_memset(ref, 0xCC, pitch * height);
+            SDL_memset(dst, 0xCC, pitch * height);
+            BlitPixels(width, height, src_format, src, pitch, dst_format, ref, pitch);
+            SDL_ConvertPixels(width, height, src_format, src, pitch, dst_format, dst, pitch);
+            if (SDL_memcmp(ref, dst, pitch * height) != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s -> %s: output differs from SDL_LowerBlit()\n",
+                             SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format));
+                failed = 1;
+            }
+
+            start = SDL_GetPerformanceCounter();
+            for (n = 0; n < iterations; ++n) {
+                BlitPixels(width, height, src_format, src, pitch, dst_format, ref, pitch);
+            }
+            blit_time = SDL_GetPerformanceCounter() - start;
+
+            start = SDL_GetPerformanceCounter();
+            for (n = 0; n < iterations; ++n) {
+                SDL_ConvertPixels(width, height, src_format, src, pitch, dst_format, dst, pitch);
+            }
+            convert_time = SDL_GetPerformanceCounter() - start;
+
+            SDL_Log("%-24s -> %-24s blit %7.3f ms, convert %7.3f ms\n",
+                    SDL_GetPixelFormatName(src_format), SDL_GetPixelFormatName(dst_format),
+                    (blit_time * 1000.0) / (freq * iterations),
+                    (convert_time * 1000.0) / (freq * iterations));
+        }
+    }
+
+    SDL_free(src);
+    SDL_free(dst);
+    SDL_free(ref);
+    SDL_Quit();
+    return failed;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
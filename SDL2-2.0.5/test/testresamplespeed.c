@@ -0,0 +1,118 @@
+/*
+  Copyright (C) 1997-2016 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times SDL_ConvertAudio() rate conversion with each setting of
+   SDL_HINT_AUDIO_RESAMPLING_MODE, and measures how closely each one
+   reproduces a sine wave at the new rate. */
+
+#include <math.h>
+
+#include "SDL.h"
+
+static const struct
+{
+    int src_rate;
+    int dst_rate;
+} rates[] = {
+    { 44100, 48000 },
+    { 48000, 44100 },
+    { 22050, 44100 },
+    { 48000, 16000 },
+    { 32000, 44100 }
+};
+
+static const char *modes[] = { "fast", "medium", "best" };
+
+/* Signal to noise ratio of (buf) against the ideal sine, leaving out the
+   edges where every resampler runs out of input. */
+static double
+SineSNR(const Sint16 *buf, int frames, int rate, double freq)
+{
+    double signal = 0.0, noise = 0.0;
+    int i;
+
+    for (i = rate / 100; i < frames - rate / 100; ++i) {
+        const double ideal = 16384.0 * SDL_sin(2.0 * M_PI * freq * i / rate);
+        const double diff = buf[i * 2] - ideal;
+        signal += ideal * ideal;
+        noise += diff * diff;
+    }
+    return (noise > 0.0) ? 10.0 * log10(signal / noise) : 999.0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const double freq = 1000.0;
+    int iterations = 20;
+    double perf_freq;
+    int i, j, n;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_max(SDL_atoi(argv[1]), 1);
+    }
+    perf_freq = (double) SDL_GetPerformanceFrequency();
+
+    for (i = 0; i < SDL_arraysize(rates); ++i) {
+        const int frames = rates[i].src_rate;  /* one second */
+        const int len = frames * 2 * sizeof (Sint16);
+        Sint16 *src = (Sint16 *) SDL_malloc(len);
+
+        if (!src) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+            return 1;
+        }
+        for (n = 0; n < frames; ++n) {
+            src[n * 2] = src[n * 2 + 1] = (Sint16) (16384.0 * SDL_sin(2.0 * M_PI * freq * n / rates[i].src_rate));
+        }
+
+        for (j = 0; j < SDL_arraysize(modes); ++j) {
+            SDL_AudioCVT cvt;
+            Uint64 start, elapsed = 0;
+
+            SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, modes[j]);
+            if (SDL_BuildAudioCVT(&cvt, AUDIO_S16SYS, 2, rates[i].src_rate,
+                                  AUDIO_S16SYS, 2, rates[i].dst_rate) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_BuildAudioCVT() failed: %s\n", SDL_GetError());
+                return 1;
+            }
+            cvt.len = len;
+            cvt.buf = (Uint8 *) SDL_malloc(len * cvt.len_mult);
+            if (!cvt.buf) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+                return 1;
+            }
+
+            for (n = 0; n < iterations; ++n) {
+                SDL_memcpy(cvt.buf, src, len);
+                start = SDL_GetPerformanceCounter();
+                SDL_ConvertAudio(&cvt);
+                elapsed += SDL_GetPerformanceCounter() - start;
+            }
+
+            SDL_Log("%5d -> %5d Hz %-6s %7.3f ms per second of stereo S16, SNR %6.1f dB\n",
+                    rates[i].src_rate, rates[i].dst_rate, modes[j],
+                    (elapsed * 1000.0) / (perf_freq * iterations),
+                    SineSNR((const Sint16 *) cvt.buf, cvt.len_cvt / 4, rates[i].dst_rate, freq));
+            SDL_free(cvt.buf);
+        }
+        SDL_free(src);
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */